@@ -0,0 +1,166 @@
+#!/usr/bin/env python3
+"""
+Convert binary data files (.bts) from the SD card back to CSV.
+
+The dashboard logs price, fee, block and mempool samples to
+/logs/data/btc_<kind>_YYYY-MM-DD.bts (see src/utils/BinarySeries.h).
+This prints the same CSV the firmware's EXPORT_DATA command produces.
+
+Usage:
+    python3 scripts/bts_to_csv.py btc_price_2025-11-29.bts > price.csv
+    python3 scripts/bts_to_csv.py /Volumes/SD/logs/data/*.bts -o export/
+"""
+
+import argparse
+import os
+import struct
+import sys
+from datetime import datetime, timezone
+
+HEADER = struct.Struct("<4sBBBBI4B")  # 16 bytes
+TIME_MARK = 0xFFFF        # Version 1: record holds an absolute time offset
+BLOCK_HEADER = struct.Struct("<HHI")  # Version 2: payload bytes, samples, first time
+
+COLUMNS = {
+    1: "price_usd,price_eur",
+    2: "block_height,tx_count,block_timestamp,size_bytes",
+    3: "tx_count,size_mb",
+    4: "fee_fast,fee_medium,fee_slow",
+}
+
+
+def read_header(data):
+    if len(data) < HEADER.size:
+        raise ValueError("file shorter than the header")
+    magic, version, kind, field_count, record_size, base_time, *decimals = HEADER.unpack_from(data)
+    if magic != b"BTSD":
+        raise ValueError("not a .bts file")
+    if version not in (1, 2):
+        raise ValueError(f"schema version {version}, this converter reads 1 and 2")
+    expected_size = 2 + 4 * field_count if version == 1 else 0
+    if record_size != expected_size or not 1 <= field_count <= 4 or kind not in COLUMNS:
+        raise ValueError("inconsistent header")
+    return version, kind, field_count, record_size, base_time, decimals[:field_count]
+
+
+def format_field(value, decimals):
+    if decimals == 0:
+        return str(value)
+    scale = 10 ** decimals
+    return f"{value // scale}.{value % scale:0{decimals}d}"
+
+
+def records_v1(data, field_count, record_size, base_time):
+    """Fixed-size records: uint16 delta seconds, uint32 per field."""
+    record = struct.Struct(f"<H{field_count}I")
+    time = base_time
+    end = len(data) - (len(data) - HEADER.size) % record_size  # Ignore a torn record
+    for offset in range(HEADER.size, end, record_size):
+        delta, *fields = record.unpack_from(data, offset)
+        if delta == TIME_MARK:
+            time = base_time + fields[0]
+            continue
+        time += delta
+        yield time, fields
+
+
+class BitReader:
+    def __init__(self, payload):
+        self.value = int.from_bytes(payload, "big")
+        self.left = len(payload) * 8
+
+    def read(self, count):
+        self.left -= count
+        if self.left < 0:
+            raise ValueError("block ends early")
+        return (self.value >> self.left) & ((1 << count) - 1)
+
+
+def signed(value, bits):
+    return value - (1 << bits) if value >= 1 << (bits - 1) else value
+
+
+def records_v2(data, field_count):
+    """Gorilla blocks (src/utils/Gorilla.h): delta-of-delta times, zigzag deltas."""
+    offset = HEADER.size
+    while offset + BLOCK_HEADER.size <= len(data):
+        payload, count, time = BLOCK_HEADER.unpack_from(data, offset)
+        start = offset + BLOCK_HEADER.size
+        if start + payload > len(data):
+            break  # Torn block
+        bits = BitReader(data[start:start + payload])
+        offset = start + payload
+
+        last = [bits.read(32) for _ in range(field_count)]
+        window = [(0, 0)] * field_count
+        delta = 0
+        yield time, list(last)
+        for _ in range(count - 1):
+            if bits.read(1):
+                for width in (7, 9, 12):
+                    if not bits.read(1):
+                        delta += signed(bits.read(width), width)
+                        break
+                else:
+                    delta += signed(bits.read(32), 32)
+            time = (time + delta) & 0xFFFFFFFF
+            for i in range(field_count):
+                if not bits.read(1):
+                    continue
+                if bits.read(1):
+                    leading = bits.read(5)
+                    window[i] = (leading, 32 - leading - (bits.read(5) + 1))
+                leading, trailing = window[i]
+                x = bits.read(32 - leading - trailing) << trailing
+                last[i] = (last[i] + ((x >> 1) ^ -(x & 1))) & 0xFFFFFFFF
+            yield time, list(last)
+
+
+def convert(data, out):
+    version, kind, field_count, record_size, base_time, decimals = read_header(data)
+    if version == 1:
+        samples = records_v1(data, field_count, record_size, base_time)
+    else:
+        samples = records_v2(data, field_count)
+
+    out.write(f"timestamp,{COLUMNS[kind]}\n")
+    rows = 0
+    for time, fields in samples:
+        stamp = datetime.fromtimestamp(time, timezone.utc).strftime("%Y-%m-%d %H:%M:%S")
+        values = ",".join(format_field(v, d) for v, d in zip(fields, decimals))
+        out.write(f"{stamp},{values}\n")
+        rows += 1
+    return rows
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert .bts data files to CSV")
+    parser.add_argument("files", nargs="+", help=".bts files to convert")
+    parser.add_argument("-o", "--output-dir", help="Write <name>.csv files here instead of stdout")
+    args = parser.parse_args()
+
+    if args.output_dir:
+        os.makedirs(args.output_dir, exist_ok=True)
+
+    failed = 0
+    for path in args.files:
+        try:
+            with open(path, "rb") as f:
+                data = f.read()
+            if args.output_dir:
+                name = os.path.splitext(os.path.basename(path))[0] + ".csv"
+                target = os.path.join(args.output_dir, name)
+                with open(target, "w", newline="") as out:
+                    rows = convert(data, out)
+                print(f"✓ {path} -> {target} ({rows} rows)", file=sys.stderr)
+            else:
+                convert(data, sys.stdout)
+        except (OSError, ValueError) as e:
+            print(f"❌ {path}: {e}", file=sys.stderr)
+            failed += 1
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
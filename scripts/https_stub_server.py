@@ -0,0 +1,213 @@
+#!/usr/bin/env python3
+"""
+Local HTTPS stub for the mempool.space endpoints used by the dashboard.
+
+Serves canned responses over HTTP/1.1 with keep-alive so the firmware's
+connection pool can be checked without hitting the real API. Every request is
+logged with the TLS connection it arrived on, making handshakes vs. reused
+connections visible. Responses carry an ETag and answer If-None-Match with
+304 Not Modified, exercising the firmware's conditional GET cache.
+
+Usage:
+    # Serve on 0.0.0.0:8443 (self-signed cert is generated in .tmp/)
+    python3 scripts/https_stub_server.py
+
+    # Build firmware against it
+    PLATFORMIO_BUILD_FLAGS='-DMEMPOOL_BASE_URL=\\"https://192.168.1.10:8443\\"' pio run -t upload
+
+    # Check keep-alive behaviour from Linux (no device needed)
+    python3 scripts/https_stub_server.py --self-test
+
+Requirements:
+    - Python 3.7+
+    - openssl CLI (only to generate the certificate)
+"""
+
+import argparse
+import hashlib
+import http.client
+import http.server
+import itertools
+import json
+import os
+import ssl
+import subprocess
+import sys
+import threading
+import time
+
+CERT_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", ".tmp")
+CERT_FILE = os.path.join(CERT_DIR, "stub_cert.pem")
+KEY_FILE = os.path.join(CERT_DIR, "stub_key.pem")
+
+TIP_HASH = "00000000000000000001c2a8e0e3b1e2f4d6a7b8c9d0e1f2a3b4c5d6e7f8a9b0"
+
+# Same paths the firmware requests in src/api/MempoolClient.cpp
+ROUTES = {
+    "/api/v1/prices": {"time": 1700000000, "USD": 97123, "EUR": 89456, "GBP": 76543},
+    "/api/blocks/tip/height": 870123,
+    "/api/block-height/870123": TIP_HASH,
+    "/api/block/" + TIP_HASH: {
+        "id": TIP_HASH, "height": 870123, "timestamp": 1731234567,
+        "tx_count": 3512, "size": 1623456, "weight": 3993012,
+        "extras": {"pool": {"name": "Stub Pool"}},
+    },
+    "/api/v1/fees/recommended": {
+        "fastestFee": 12, "halfHourFee": 8, "hourFee": 5, "economyFee": 3, "minimumFee": 1,
+    },
+    "/api/mempool": {
+        "count": 45231,
+        "vsize": 28123456,
+        "total_fee": 123456789,
+        "fee_histogram": [[round(50.0 / (i + 1), 3), 10000 + i * 137] for i in range(400)],
+    },
+}
+
+connection_ids = itertools.count(1)
+stats_lock = threading.Lock()
+stats = {"connections": 0, "requests": 0, "not_modified": 0}
+
+
+class StubHandler(http.server.BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"  # Keep-alive unless the client closes
+
+    def setup(self):
+        super().setup()
+        self.conn_id = next(connection_ids)
+        self.conn_requests = 0
+        with stats_lock:
+            stats["connections"] += 1
+        print(f"[conn {self.conn_id}] TLS handshake from {self.client_address[0]}")
+
+    def do_GET(self):
+        path = self.path.split("?", 1)[0]
+        self.conn_requests += 1
+        with stats_lock:
+            stats["requests"] += 1
+
+        status = 200
+        if path not in ROUTES:
+            status = 404
+            self._send(404, "text/plain", b"Not Found")
+        else:
+            value = ROUTES[path]
+            if isinstance(value, (dict, list)):
+                body, content_type = json.dumps(value).encode(), "application/json"
+            else:
+                body, content_type = str(value).encode(), "text/plain"
+
+            etag = '"%s"' % hashlib.md5(body).hexdigest()[:16]
+            if self.headers.get("If-None-Match") == etag:
+                status = 304
+                with stats_lock:
+                    stats["not_modified"] += 1
+                self.send_response(304)
+                self.send_header("ETag", etag)
+                self.send_header("Keep-Alive", "timeout=60")
+                self.end_headers()
+            else:
+                self._send(200, content_type, body, etag)
+
+        reuse = "reused" if self.conn_requests > 1 else "new"
+        print(f"[conn {self.conn_id}] #{self.conn_requests} GET {path} -> {status} ({reuse})")
+
+    def _send(self, code, content_type, body, etag=None):
+        self.send_response(code)
+        self.send_header("Content-Type", content_type)
+        if etag:
+            self.send_header("ETag", etag)
+        self.send_header("Content-Length", str(len(body)))
+        self.send_header("Keep-Alive", "timeout=60")
+        self.end_headers()
+        self.wfile.write(body)
+
+    def log_message(self, fmt, *args):
+        pass  # Replaced by the per-connection log lines above
+
+
+def ensure_certificate():
+    if os.path.exists(CERT_FILE) and os.path.exists(KEY_FILE):
+        return
+    os.makedirs(CERT_DIR, exist_ok=True)
+    print("Generating self-signed certificate...")
+    subprocess.run(
+        ["openssl", "req", "-x509", "-newkey", "rsa:2048", "-nodes",
+         "-keyout", KEY_FILE, "-out", CERT_FILE, "-days", "365",
+         "-subj", "/CN=mempool-stub"],
+        check=True, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+
+
+def make_server(host, port):
+    ensure_certificate()
+    server = http.server.ThreadingHTTPServer((host, port), StubHandler)
+    ctx = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+    ctx.load_cert_chain(CERT_FILE, KEY_FILE)
+    server.socket = ctx.wrap_socket(server.socket, server_side=True)
+    return server
+
+
+def self_test(port):
+    """Run two fetch cycles over one connection; check reuse and 304 handling."""
+    server = make_server("127.0.0.1", port)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+
+    ctx = ssl.create_default_context()
+    ctx.check_hostname = False
+    ctx.verify_mode = ssl.CERT_NONE
+
+    conn = http.client.HTTPSConnection("127.0.0.1", port, context=ctx, timeout=5)
+    latencies = []
+    etags = {}
+    # Two fetch cycles: full responses, then conditional requests
+    for cycle in range(2):
+        for path in ROUTES:
+            headers = {"If-None-Match": etags[path]} if path in etags else {}
+            start = time.monotonic()
+            conn.request("GET", path, headers=headers)
+            resp = conn.getresponse()
+            resp.read()  # Drain body so the connection can be reused
+            etags[path] = resp.getheader("ETag")
+            latencies.append((path, resp.status, (time.monotonic() - start) * 1000))
+    conn.close()
+    server.shutdown()
+
+    for path, status, ms in latencies:
+        print(f"  {status} {path:28s} {ms:7.1f} ms")
+    print(f"Connections: {stats['connections']}, requests: {stats['requests']}, "
+          f"not modified: {stats['not_modified']}")
+
+    ok = True
+    if stats["connections"] == 1 and stats["requests"] == 2 * len(ROUTES):
+        print("✓ All requests shared one TLS connection")
+    else:
+        print("❌ Expected 1 connection for both cycles")
+        ok = False
+    if stats["not_modified"] == len(ROUTES):
+        print("✓ Second cycle answered with 304 Not Modified")
+    else:
+        print("❌ Expected every conditional request to get a 304")
+        ok = False
+    return 0 if ok else 1
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Local HTTPS mempool.space stub")
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=8443)
+    parser.add_argument("--self-test", action="store_true",
+                        help="Run a keep-alive check against the stub and exit")
+    args = parser.parse_args()
+
+    if args.self_test:
+        sys.exit(self_test(args.port))
+
+    server = make_server(args.host, args.port)
+    print(f"Serving mempool stub on https://{args.host}:{args.port}")
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        print(f"\nConnections: {stats['connections']}, requests: {stats['requests']}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+"""
+Local stand-in for the mempool.space WebSocket API (/api/v1/ws).
+
+Answers the dashboard's {"action":"want","data":["blocks","stats"]} with the
+same initial payload shape as mempool.space, then pushes a stats message every
+few seconds and a new block every minute. Use --drop-after to close the
+connection periodically and watch the firmware back off, reconnect and fall
+back to REST polling in between.
+
+Usage:
+    # Plain ws:// on port 8765
+    python3 scripts/ws_stub_server.py
+
+    # wss:// (self-signed cert shared with https_stub_server.py)
+    python3 scripts/ws_stub_server.py --tls --port 8443
+
+    # Build firmware against it
+    PLATFORMIO_BUILD_FLAGS='-DMEMPOOL_WS_HOST=\\"192.168.1.10\\" -DMEMPOOL_WS_PORT=8765 -DMEMPOOL_WS_SSL=0' pio run -t upload
+
+    # Drop every connection after 30s, refuse the next 3 reconnects
+    python3 scripts/ws_stub_server.py --drop-after 30 --refuse 3
+
+Requirements:
+    - Python 3.7+ (standard library only)
+"""
+
+import argparse
+import base64
+import hashlib
+import json
+import random
+import socket
+import ssl
+import struct
+import threading
+import time
+
+WS_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11"
+
+state_lock = threading.Lock()
+state = {"height": 870123, "price": 97123.0, "count": 45231, "refused": 0}
+
+
+def block(height):
+    return {
+        "id": "%064x" % (0xABCDEF00 + height),
+        "height": height,
+        "timestamp": int(time.time()),
+        "tx_count": random.randint(2500, 4500),
+        "size": random.randint(1400000, 1800000),
+    }
+
+
+def stats_message():
+    with state_lock:
+        state["count"] += random.randint(-200, 300)
+        count = state["count"]
+    fast = random.randint(8, 20)
+    return {
+        "mempoolInfo": {"loaded": True, "size": count, "bytes": count * 620,
+                        "total_fee": round(count * 0.0000275, 8)},
+        "vBytesPerSecond": random.randint(1200, 2500),
+        "fees": {"fastestFee": fast, "halfHourFee": fast - 3, "hourFee": fast - 6,
+                 "economyFee": 2, "minimumFee": 1},
+        "da": {"progressPercent": 42.5, "difficultyChange": 1.2},
+    }
+
+
+def initial_message():
+    with state_lock:
+        height = state["height"]
+        price = state["price"]
+    msg = stats_message()
+    msg["blocks"] = [block(h) for h in range(height - 7, height + 1)]
+    msg["conversions"] = {"time": int(time.time()), "USD": price, "EUR": round(price * 0.92)}
+    return msg
+
+
+def send_frame(conn, payload, opcode=0x1):
+    data = payload.encode() if isinstance(payload, str) else payload
+    header = bytes([0x80 | opcode])
+    if len(data) < 126:
+        header += bytes([len(data)])
+    elif len(data) < 65536:
+        header += bytes([126]) + struct.pack(">H", len(data))
+    else:
+        header += bytes([127]) + struct.pack(">Q", len(data))
+    conn.sendall(header + data)
+
+
+def recv_exact(conn, n):
+    buf = b""
+    while len(buf) < n:
+        chunk = conn.recv(n - len(buf))
+        if not chunk:
+            raise ConnectionError("closed")
+        buf += chunk
+    return buf
+
+
+def recv_frame(conn):
+    b1, b2 = recv_exact(conn, 2)
+    opcode = b1 & 0x0F
+    length = b2 & 0x7F
+    if length == 126:
+        length = struct.unpack(">H", recv_exact(conn, 2))[0]
+    elif length == 127:
+        length = struct.unpack(">Q", recv_exact(conn, 8))[0]
+    mask = recv_exact(conn, 4) if b2 & 0x80 else b"\0\0\0\0"
+    data = bytes(b ^ mask[i % 4] for i, b in enumerate(recv_exact(conn, length)))
+    return opcode, data
+
+
+def handshake(conn):
+    request = b""
+    while b"\r\n\r\n" not in request:
+        chunk = conn.recv(1024)
+        if not chunk:
+            raise ConnectionError("closed during handshake")
+        request += chunk
+    headers = {}
+    for line in request.decode(errors="replace").split("\r\n")[1:]:
+        if ":" in line:
+            k, v = line.split(":", 1)
+            headers[k.strip().lower()] = v.strip()
+    accept = base64.b64encode(hashlib.sha1((headers["sec-websocket-key"] + WS_GUID).encode()).digest())
+    conn.sendall(b"HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\n"
+                 b"Connection: Upgrade\r\nSec-WebSocket-Accept: " + accept + b"\r\n\r\n")
+
+
+def serve_client(conn, addr, args, conn_id):
+    print(f"[conn {conn_id}] {addr[0]} connected")
+    stop = threading.Event()
+    subscribed = threading.Event()
+
+    def pusher():
+        last_block = time.time()
+        while not stop.wait(args.stats_interval):
+            if not subscribed.is_set():
+                continue
+            try:
+                send_frame(conn, json.dumps(stats_message()))
+                if time.time() - last_block >= args.block_interval:
+                    last_block = time.time()
+                    with state_lock:
+                        state["height"] += 1
+                        height = state["height"]
+                    send_frame(conn, json.dumps({"block": block(height)}))
+                    print(f"[conn {conn_id}] pushed block {height}")
+            except OSError:
+                break
+
+    threading.Thread(target=pusher, daemon=True).start()
+    started = time.time()
+    conn.settimeout(1.0)
+
+    try:
+        handshake(conn)
+        while True:
+            if args.drop_after and time.time() - started > args.drop_after:
+                print(f"[conn {conn_id}] dropping connection (--drop-after)")
+                break
+            try:
+                opcode, data = recv_frame(conn)
+            except socket.timeout:
+                continue
+            if opcode == 0x8:
+                break
+            if opcode == 0x9:
+                send_frame(conn, data, opcode=0xA)
+                continue
+            if opcode == 0x1:
+                msg = json.loads(data.decode() or "{}")
+                print(f"[conn {conn_id}] <- {msg}")
+                if msg.get("action") == "want":
+                    send_frame(conn, json.dumps(initial_message()))
+                    subscribed.set()
+    except (ConnectionError, OSError, KeyError, ValueError) as exc:
+        print(f"[conn {conn_id}] closed: {exc}")
+    finally:
+        stop.set()
+        conn.close()
+        print(f"[conn {conn_id}] disconnected")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="mempool.space WebSocket stand-in")
+    parser.add_argument("--host", default="0.0.0.0")
+    parser.add_argument("--port", type=int, default=8765)
+    parser.add_argument("--tls", action="store_true", help="Serve wss:// with a self-signed cert")
+    parser.add_argument("--stats-interval", type=float, default=5.0)
+    parser.add_argument("--block-interval", type=float, default=60.0)
+    parser.add_argument("--drop-after", type=float, default=0, help="Close each connection after N seconds")
+    parser.add_argument("--refuse", type=int, default=0, help="Refuse N connections after each drop")
+    args = parser.parse_args()
+
+    server = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    server.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    server.bind((args.host, args.port))
+    server.listen(4)
+
+    ctx = None
+    if args.tls:
+        from https_stub_server import CERT_FILE, KEY_FILE, ensure_certificate
+        ensure_certificate()
+        ctx = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+        ctx.load_cert_chain(CERT_FILE, KEY_FILE)
+
+    scheme = "wss" if args.tls else "ws"
+    print(f"WebSocket stand-in on {scheme}://{args.host}:{args.port}/api/v1/ws")
+
+    conn_id = 0
+    try:
+        while True:
+            conn, addr = server.accept()
+            if state["refused"] > 0:
+                state["refused"] -= 1
+                print(f"refusing {addr[0]} ({state['refused']} more)")
+                conn.close()
+                continue
+            if ctx:
+                try:
+                    conn = ctx.wrap_socket(conn, server_side=True)
+                except ssl.SSLError as exc:
+                    print(f"TLS handshake failed: {exc}")
+                    conn.close()
+                    continue
+            conn_id += 1
+            if args.drop_after:
+                state["refused"] = args.refuse
+            threading.Thread(target=serve_client, args=(conn, addr, args, conn_id), daemon=True).start()
+    except KeyboardInterrupt:
+        pass
+    finally:
+        server.close()
+
+
+if __name__ == "__main__":
+    main()
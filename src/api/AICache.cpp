@@ -0,0 +1,151 @@
+#include "AICache.h"
+#include <Preferences.h>
+#include <time.h>
+#include "../utils/SDLogger.h"
+#include "../utils/WallClock.h"
+
+// Global instance
+AICache aiCache;
+
+// Guards the cache table; NVS access happens outside it
+static portMUX_TYPE aiCacheLock = portMUX_INITIALIZER_UNLOCKED;
+
+static void slotKey(int slot, char* key) {
+    key[0] = 'e';
+    key[1] = (char)('0' + slot);
+    key[2] = '\0';
+}
+
+AICache::AICache() {
+    loaded = false;
+}
+
+void AICache::begin() {
+    if (loaded) return;
+    loaded = true;
+
+    Preferences prefs;
+    if (!prefs.begin(AI_CACHE_NAMESPACE, true)) {
+        // Namespace does not exist until the first store
+        return;
+    }
+
+    int restored = 0;
+    AICacheEntry entry;
+    for (int i = 0; i < AISignalCache::capacity(); i++) {
+        char key[3];
+        slotKey(i, key);
+        if (prefs.getBytesLength(key) != sizeof(AICacheEntry)) continue;
+
+        prefs.getBytes(key, &entry, sizeof(entry));
+        portENTER_CRITICAL(&aiCacheLock);
+        bool ok = cache.restore(i, entry);
+        portEXIT_CRITICAL(&aiCacheLock);
+        if (ok) restored++;
+    }
+    prefs.end();
+
+    Serial.printf("✓ AI cache: %d answer(s) restored from NVS\n", restored);
+    sdLogger.logf(LOG_INFO, "AI cache: restored %d entries from NVS", restored);
+}
+
+bool AICache::lookup(AICacheKind kind, const BTCData& data, void* value, size_t size) {
+    uint32_t fingerprint = marketFingerprint(data.priceUSD, data.feeFast, data.mempoolSize);
+    uint32_t nowS = wallClockNow();
+
+    portENTER_CRITICAL(&aiCacheLock);
+    bool hit = cache.lookup(kind, fingerprint, value, size, nowS);
+    portEXIT_CRITICAL(&aiCacheLock);
+
+    if (hit) {
+        Serial.printf("✓ AI cache hit: %s (fingerprint %08x)\n", kindName(kind), fingerprint);
+    }
+    logStats();
+    return hit;
+}
+
+void AICache::store(AICacheKind kind, const BTCData& data, const void* value, size_t size) {
+    uint32_t fingerprint = marketFingerprint(data.priceUSD, data.feeFast, data.mempoolSize);
+    uint32_t nowS = wallClockNow();
+    AICacheEntry entry;
+
+    portENTER_CRITICAL(&aiCacheLock);
+    int slot = cache.store(kind, fingerprint, value, size, nowS);
+    if (slot >= 0) entry = cache.entry(slot);
+    portEXIT_CRITICAL(&aiCacheLock);
+
+    if (slot < 0) {
+        if (nowS == 0) Serial.println("⚠️  AI cache: clock not synced, answer not cached");
+        return;
+    }
+
+    Preferences prefs;
+    if (prefs.begin(AI_CACHE_NAMESPACE, false)) {
+        char key[3];
+        slotKey(slot, key);
+        prefs.putBytes(key, &entry, sizeof(entry));
+        prefs.end();
+    }
+}
+
+void AICache::clear() {
+    portENTER_CRITICAL(&aiCacheLock);
+    cache.clear();
+    portEXIT_CRITICAL(&aiCacheLock);
+
+    Preferences prefs;
+    if (prefs.begin(AI_CACHE_NAMESPACE, false)) {
+        prefs.clear();
+        prefs.end();
+    }
+}
+
+void AICache::printStatus() {
+    portENTER_CRITICAL(&aiCacheLock);
+    uint32_t hits = cache.getHits();
+    uint32_t misses = cache.getMisses();
+    uint32_t expired = cache.getExpired();
+    uint8_t rate = cache.hitRate();
+    portEXIT_CRITICAL(&aiCacheLock);
+
+    Serial.printf("AI Cache: %u%% hit rate (%u hits, %u misses, %u expired)\n",
+                 rate, hits, misses, expired);
+
+    uint32_t nowS = wallClockNow();
+    for (int i = 0; i < AISignalCache::capacity(); i++) {
+        portENTER_CRITICAL(&aiCacheLock);
+        AICacheKind kind = (AICacheKind)cache.entry(i).kind;
+        uint32_t fingerprint = cache.entry(i).fingerprint;
+        uint32_t storedAt = cache.entry(i).storedAt;
+        bool used = cache.entry(i).used();
+        portEXIT_CRITICAL(&aiCacheLock);
+
+        if (!used) continue;
+        if (nowS > 0) {
+            Serial.printf("  %-10s %08x age=%us\n", kindName(kind), fingerprint, nowS - storedAt);
+        } else {
+            Serial.printf("  %-10s %08x age=unknown\n", kindName(kind), fingerprint);
+        }
+    }
+}
+
+const char* AICache::kindName(AICacheKind kind) {
+    switch (kind) {
+        case AI_CACHE_MARKET_SIGNALS:     return "signals";
+        case AI_CACHE_TRADING_SUGGESTION: return "suggestion";
+        default:                          return "unknown";
+    }
+}
+
+void AICache::logStats() {
+    portENTER_CRITICAL(&aiCacheLock);
+    uint32_t lookups = cache.getLookups();
+    uint32_t hits = cache.getHits();
+    uint32_t misses = cache.getMisses();
+    uint8_t rate = cache.hitRate();
+    portEXIT_CRITICAL(&aiCacheLock);
+
+    if (lookups % AI_CACHE_LOG_EVERY == 0) {
+        sdLogger.logf(LOG_INFO, "AI cache: %u%% hit rate (%u hits, %u misses)", rate, hits, misses);
+    }
+}
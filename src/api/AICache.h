@@ -0,0 +1,52 @@
+#ifndef AI_CACHE_H
+#define AI_CACHE_H
+
+#include <Arduino.h>
+#include "AISignalCache.h"
+#include "BTCData.h"
+
+// NVS namespace holding one blob per cache slot ("e0".."e3")
+#define AI_CACHE_NAMESPACE "ai_cache"
+
+/**
+ * AICache - AISignalCache shared by the AI clients, persisted to NVS
+ *
+ * AIRouter and OpenAIClient look up the answer for the current quantized
+ * market snapshot before sending a request, and store each fresh answer.
+ * Stored slots are written to NVS right away, so a reboot or crash does not
+ * force new (paid, slow) API calls for an unchanged market.
+ *
+ * Safe to call from the fetch worker and the loop task.
+ */
+class AICache {
+public:
+    AICache();
+
+    // Load persisted entries (call once after boot)
+    void begin();
+
+    // Copy the cached answer for data into value; false on miss or expiry
+    bool lookup(AICacheKind kind, const BTCData& data, void* value, size_t size);
+
+    // Remember a fresh answer for data and persist it
+    void store(AICacheKind kind, const BTCData& data, const void* value, size_t size);
+
+    // Drop all entries, in RAM and NVS (AI_CACHE_CLEAR command)
+    void clear();
+
+    // Print hit rate and entries to serial (STATUS command)
+    void printStatus();
+
+    static const char* kindName(AICacheKind kind);
+
+private:
+    AISignalCache cache;
+    bool loaded;
+
+    void logStats();
+};
+
+// Global instance
+extern AICache aiCache;
+
+#endif // AI_CACHE_H
@@ -0,0 +1,177 @@
+#ifndef AI_PROMPTS_H
+#define AI_PROMPTS_H
+
+#include "JsonBodyWriter.h"
+#include "MarketSignals.h"
+
+// Request buffer inside each AI client (AIRouter keeps one client per provider);
+// the largest body (market signals with its response schema) is ~1.1KB
+#define AI_REQUEST_BUFFER_SIZE 2048
+
+// Generation settings for free-text Gemini requests
+#define GEMINI_MAX_OUTPUT_TOKENS 1024 // Limit response length
+#define GEMINI_TEMPERATURE 0.7        // Creativity level (0.0-1.0)
+
+// OpenAI trading suggestion settings
+#define OPENAI_MAX_TOKENS 500
+#define OPENAI_TEMPERATURE 0.7
+
+/*
+ * Request bodies for the AI clients, written with JsonBodyWriter.
+ *
+ * The writers are templates over the market data type so the firmware passes
+ * BTCData while native tests and benchmarks pass a plain struct with the same
+ * fields (BTCData pulls in Arduino.h). All return ok() of the writer: false
+ * means the body did not fit and must not be sent.
+ */
+
+// Market data lines shared by the prompts
+template <typename TData>
+void writeMarketDataLines(JsonBodyWriter& out, const TData& data, bool withEUR, bool withBlock) {
+    out.textf("CURRENT DATA:\n- BTC Price: $%.2f USD", data.priceUSD);
+    if (withEUR && data.priceEUR > 0) {
+        out.textf(" (€%.2f EUR)", data.priceEUR);
+    }
+    out.text("\n");
+
+    if (withBlock && data.blockHeight > 0) {
+        out.textf("- Latest Block: #%lu", (unsigned long)data.blockHeight);
+        if (data.blockTxCount > 0) {
+            out.textf(" (%d transactions)", data.blockTxCount);
+        }
+        out.text("\n");
+    }
+
+    if (data.mempoolCount > 0) {
+        out.textf("- Mempool: %lu pending transactions", (unsigned long)data.mempoolCount);
+        if (data.mempoolSize > 0) {
+            out.textf(" (%.2f vMB)", data.mempoolSize);
+        }
+        out.text("\n");
+    }
+
+    if (data.feeFast > 0) {
+        out.textf("- Network Fees: Fast=%d Medium=%d Slow=%d sat/vB\n",
+                  data.feeFast, data.feeMedium, data.feeSlow);
+    }
+}
+
+// Gemini generateContent body for a fixed prompt (connection test)
+inline bool writeGeminiTextRequest(JsonBodyWriter& out, const char* prompt) {
+    out.reset();
+    out.raw("{\"contents\":[{\"parts\":[{\"text\":\"").text(prompt).raw("\"}]}],");
+    out.rawf("\"generationConfig\":{\"temperature\":%.1f,\"maxOutputTokens\":%d}}",
+             GEMINI_TEMPERATURE, GEMINI_MAX_OUTPUT_TOKENS);
+    return out.ok();
+}
+
+// Gemini generateContent body for the market analysis shown on the news screen
+template <typename TData>
+bool writeGeminiNewsRequest(JsonBodyWriter& out, const TData& data) {
+    out.reset();
+    out.raw("{\"contents\":[{\"parts\":[{\"text\":\"");
+    out.text("You are a Bitcoin market analyst. Based on the following real-time data, "
+             "provide a concise market analysis (max 800 words):\n\n");
+    writeMarketDataLines(out, data, true, true);
+    out.text("\nProvide:\n"
+             "1. 📈 Market Summary (2-3 sentences)\n"
+             "2. 💡 Technical Analysis (key levels, trends)\n"
+             "3. 📊 Market Sentiment (bullish/bearish indicators)\n"
+             "4. ⚠️ Risk Assessment (volatility, warnings)\n"
+             "5. 🎯 Price Outlook (short-term forecast)\n\n"
+             "Format with clear sections using emoji headers. Be concise and actionable.");
+    out.raw("\"}]}],");
+    out.rawf("\"generationConfig\":{\"temperature\":%.1f,\"maxOutputTokens\":%d}}",
+             GEMINI_TEMPERATURE, GEMINI_MAX_OUTPUT_TOKENS);
+    return out.ok();
+}
+
+// Market signals prompt shared by Gemini and OpenAI (escaped string content)
+template <typename TData>
+void writeMarketSignalsPrompt(JsonBodyWriter& out, const TData& data) {
+    out.text("You are a Bitcoin market advisor. Based on the following current market data, "
+             "give a DCA (Dollar Cost Average) recommendation and a short-term trading signal.\n\n");
+    writeMarketDataLines(out, data, false, false);
+    out.text("\ndca - BUY: good time to accumulate; SELL: consider taking profits; "
+             "WAIT: hold off (high fees, extreme volatility, uncertainty).\n"
+             "signal - BUY: upward momentum; SELL: downward momentum; HOLD: no clear direction.\n"
+             "timeframe - horizon the signal applies to. confidence - 0 to 100.");
+}
+
+/**
+ * Gemini body asking for a JSON object instead of prose. responseSchema pins
+ * the keys and the allowed words, so the reply needs no text scraping and fits
+ * in SIGNALS_MAX_OUTPUT_TOKENS (see parseMarketSignals).
+ */
+template <typename TData>
+bool writeMarketSignalsRequest(JsonBodyWriter& out, const TData& data) {
+    out.reset();
+    out.raw("{\"contents\":[{\"parts\":[{\"text\":\"");
+    writeMarketSignalsPrompt(out, data);
+    out.raw("\"}]}],");
+    out.rawf("\"generationConfig\":{\"temperature\":%.1f,\"maxOutputTokens\":%d,",
+             SIGNALS_TEMPERATURE, SIGNALS_MAX_OUTPUT_TOKENS);
+    out.raw("\"responseMimeType\":\"application/json\",\"responseSchema\":{\"type\":\"OBJECT\","
+            "\"properties\":{"
+            "\"dca\":{\"type\":\"STRING\",\"format\":\"enum\",\"enum\":[\"BUY\",\"SELL\",\"WAIT\"]},"
+            "\"signal\":{\"type\":\"STRING\",\"format\":\"enum\",\"enum\":[\"BUY\",\"SELL\",\"HOLD\"]},"
+            "\"timeframe\":{\"type\":\"STRING\",\"format\":\"enum\",\"enum\":[\"15m-1h\",\"1h-4h\",\"4h-1d\"]},"
+            "\"confidence\":{\"type\":\"INTEGER\"}},"
+            "\"required\":[\"dca\",\"signal\",\"timeframe\",\"confidence\"]}}}");
+    return out.ok();
+}
+
+/**
+ * OpenAI chat/completions body for the same market signals. There is no
+ * schema here: JSON mode guarantees an object and the prompt spells out the
+ * keys and words, which parseMarketSignals checks.
+ */
+template <typename TData>
+bool writeOpenAIMarketSignalsRequest(JsonBodyWriter& out, const char* model, const TData& data) {
+    out.reset();
+    out.raw("{\"model\":\"").text(model).raw("\",");
+    out.rawf("\"max_tokens\":%d,\"temperature\":%.1f,", SIGNALS_MAX_OUTPUT_TOKENS, SIGNALS_TEMPERATURE);
+    out.raw("\"response_format\":{\"type\":\"json_object\"},");
+    out.raw("\"messages\":[{\"role\":\"system\",\"content\":\"");
+    out.text("Reply with a single JSON object: {\"dca\":\"BUY|SELL|WAIT\",\"signal\":\"BUY|SELL|HOLD\","
+             "\"timeframe\":\"15m-1h|1h-4h|4h-1d\",\"confidence\":0-100}");
+    out.raw("\"},{\"role\":\"user\",\"content\":\"");
+    writeMarketSignalsPrompt(out, data);
+    out.raw("\"}]}");
+    return out.ok();
+}
+
+// OpenAI chat/completions body for a trading suggestion
+template <typename TData>
+bool writeOpenAITradingRequest(JsonBodyWriter& out, const char* model, const TData& data) {
+    out.reset();
+    out.raw("{\"model\":\"").text(model).raw("\",");
+    out.rawf("\"max_tokens\":%d,\"temperature\":%.1f,", OPENAI_MAX_TOKENS, OPENAI_TEMPERATURE);
+    out.raw("\"messages\":[{\"role\":\"system\",\"content\":\"");
+    out.text("You are a professional Bitcoin trading analyst. Provide concise, actionable "
+             "trading suggestions based on market data.");
+    out.raw("\"},{\"role\":\"user\",\"content\":\"");
+    out.text("You are a professional Bitcoin trading analyst. Analyze the following Bitcoin market "
+             "data and provide a concise trading suggestion.\n\nMarket Data:\n");
+    out.textf("- Current Price: $%.0f USD\n"
+              "- Block Height: %lu\n"
+              "- Mempool: %lu pending transactions\n"
+              "- Mempool Size: %.1f MB\n"
+              "- Fee Rates: Fast %d sat/vB, Medium %d sat/vB, Slow %d sat/vB\n\n",
+              data.priceUSD, (unsigned long)data.blockHeight, (unsigned long)data.mempoolCount,
+              data.mempoolSize, data.feeFast, data.feeMedium, data.feeSlow);
+    out.text("Provide your analysis in this format:\n\n"
+             "Signal: [STRONG_BUY|BUY|HOLD|SELL|STRONG_SELL]\n"
+             "Confidence: [0-100]%\n\n"
+             "Recommendation:\n"
+             "[2-3 sentences with actionable advice, including entry points, stop-loss, and targets if applicable]\n\n"
+             "Key Factors:\n"
+             "- [Factor 1]\n"
+             "- [Factor 2]\n"
+             "- [Factor 3]\n\n"
+             "Keep your response under 400 words. Focus on actionable insights.");
+    out.raw("\"}]}");
+    return out.ok();
+}
+
+#endif // AI_PROMPTS_H
@@ -0,0 +1,36 @@
+#ifndef AI_PROVIDER_H
+#define AI_PROVIDER_H
+
+#include <Arduino.h>
+#include "BTCData.h"
+#include "MarketSignals.h"
+
+/**
+ * AIProvider - A backend that can answer the market signals request
+ *
+ * Implemented by GeminiClient and OpenAIClient so AIRouter can race them.
+ * fetchMarketSignals() always goes to the network; caching is the router's
+ * job. cancelled is checked before the request is sent: once HTTPClient is
+ * blocked in POST it cannot be interrupted from another task, so a request
+ * already in flight runs to completion and the router drops its answer.
+ */
+class AIProvider {
+public:
+    AIProvider() : lastLatencyMs(0) {}
+    virtual ~AIProvider() {}
+
+    virtual bool fetchMarketSignals(const BTCData& data, MarketSignals& signals,
+                                    const volatile bool* cancelled) = 0;
+
+    // Duration of the last HTTP request, 0 when the last call sent none
+    uint32_t getLastLatencyMs() const { return lastLatencyMs; }
+
+protected:
+    uint32_t lastLatencyMs;
+
+    static bool isCancelled(const volatile bool* cancelled) {
+        return cancelled != nullptr && *cancelled;
+    }
+};
+
+#endif // AI_PROVIDER_H
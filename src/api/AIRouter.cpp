@@ -0,0 +1,279 @@
+#include "AIRouter.h"
+#include <WiFi.h>
+#include "AICache.h"
+#include "GeminiClient.h"
+#include "OpenAIClient.h"
+#include "../Config.h"
+#include "../utils/SDLogger.h"
+#include "../network/EndpointHealth.h"
+
+static_assert(AI_PROVIDER_COUNT <= HEDGE_MAX_PROVIDERS, "HedgePolicy tracks too few providers");
+
+// Global instance
+AIRouter aiRouter;
+
+// Guards the policy and counters; attempt tasks record into it
+static portMUX_TYPE aiRouterLock = portMUX_INITIALIZER_UNLOCKED;
+
+AIRouter::AIRouter() : policy(AI_PROVIDER_GEMINI) {
+    doneQueue = nullptr;
+    raceId = 0;
+    cached = false;
+    races = 0;
+    hedgedRaces = 0;
+    hedgeWins = 0;
+    failovers = 0;
+    for (int i = 0; i < AI_PROVIDER_COUNT; i++) {
+        attempts[i].router = this;
+        attempts[i].provider = (uint8_t)i;
+        attempts[i].client = nullptr;
+        attempts[i].raceId = 0;
+        attempts[i].ok = false;
+        attempts[i].cancelled = false;
+        attempts[i].running = false;
+    }
+}
+
+const char* AIRouter::providerName(uint8_t provider) {
+    switch (provider) {
+        case AI_PROVIDER_GEMINI: return "gemini";
+        case AI_PROVIDER_OPENAI: return "openai";
+        default:                 return "unknown";
+    }
+}
+
+AIProvider* AIRouter::clientFor(uint8_t provider) {
+    // One client per provider for the router's lifetime, so a race does not
+    // allocate a request buffer; only called while its attempt is not running.
+    // The key is re-read every time so settings changes apply right away.
+    Attempt& attempt = attempts[provider];
+    switch (provider) {
+        case AI_PROVIDER_GEMINI: {
+            if (attempt.client == nullptr) attempt.client = new GeminiClient(GEMINI_API_KEY);
+            String key = globalConfig.getGeminiApiKey();
+            static_cast<GeminiClient*>(attempt.client)->setApiKey(key.length() > 0 ? key : String(GEMINI_API_KEY));
+            break;
+        }
+        case AI_PROVIDER_OPENAI:
+            if (attempt.client == nullptr) attempt.client = new OpenAIClient();
+            static_cast<OpenAIClient*>(attempt.client)->setApiKey(globalConfig.getOpenAIApiKey());
+            break;
+        default:
+            return nullptr;
+    }
+    return attempt.client;
+}
+
+bool AIRouter::isAvailable(uint8_t provider) {
+    if (attempts[provider].running) return false;  // Last race's loser still in flight
+
+    switch (provider) {
+        case AI_PROVIDER_GEMINI:
+            // GeminiClient falls back to the built-in key
+            return endpointHealth.getState(ENDPOINT_GEMINI) != CIRCUIT_OPEN;
+        case AI_PROVIDER_OPENAI:
+            return globalConfig.hasOpenAIKey() && endpointHealth.getState(ENDPOINT_OPENAI) != CIRCUIT_OPEN;
+        default:
+            return false;
+    }
+}
+
+void AIRouter::attemptTask(void* param) {
+    Attempt* attempt = (Attempt*)param;
+    AIRouter* router = attempt->router;
+
+    AIProvider* provider = attempt->client;
+    attempt->ok = provider->fetchMarketSignals(attempt->data, attempt->signals, &attempt->cancelled);
+
+    // Losers are measured too: their latency is what decides the next primary
+    if (provider->getLastLatencyMs() > 0) {
+        router->recordAttempt(attempt->provider, provider->getLastLatencyMs(), attempt->ok);
+    }
+
+    AttemptDone done = {attempt->provider, attempt->raceId};
+    xQueueSend(router->doneQueue, &done, 0);
+    attempt->running = false;
+    vTaskDelete(nullptr);
+}
+
+bool AIRouter::startAttempt(uint8_t provider, const BTCData& data, uint32_t id) {
+    Attempt& attempt = attempts[provider];
+    if (clientFor(provider) == nullptr) return false;
+    attempt.raceId = id;
+    attempt.data = data;
+    attempt.ok = false;
+    attempt.cancelled = false;
+    attempt.running = true;
+
+    char name[16];
+    snprintf(name, sizeof(name), "ai_%s", providerName(provider));
+    BaseType_t created = xTaskCreatePinnedToCore(
+        attemptTask, name, AI_ATTEMPT_STACK_SIZE, &attempt,
+        AI_ATTEMPT_PRIORITY, nullptr, AI_ATTEMPT_CORE);
+
+    if (created != pdPASS) {
+        attempt.running = false;
+        Serial.printf("❌ AI router: failed to start %s request task\n", providerName(provider));
+        return false;
+    }
+    return true;
+}
+
+void AIRouter::recordAttempt(uint8_t provider, uint32_t latencyMs, bool ok) {
+    portENTER_CRITICAL(&aiRouterLock);
+    uint8_t before = policy.getPrimary();
+    policy.record(provider, latencyMs, ok);
+    uint8_t after = policy.getPrimary();
+    portEXIT_CRITICAL(&aiRouterLock);
+
+    if (after != before) {
+        Serial.printf("✓ AI router: %s is now primary\n", providerName(after));
+        sdLogger.logf(LOG_INFO, "AI primary switched from %s to %s", providerName(before), providerName(after));
+    }
+}
+
+bool AIRouter::fetchMarketSignals(const BTCData& data, MarketSignals& signals,
+                                  void (*idle)(void* ctx), void* ctx) {
+    // An unchanged market gets the answer it got last time
+    cached = aiCache.lookup(AI_CACHE_MARKET_SIGNALS, data, &signals, sizeof(signals));
+    if (cached) {
+        return true;
+    }
+
+    if (WiFi.status() != WL_CONNECTED) {
+        Serial.println("WiFi not connected");
+        return false;
+    }
+
+    if (doneQueue == nullptr) {
+        // Room for a late loser of the previous race plus both attempts of this one
+        doneQueue = xQueueCreate(AI_PROVIDER_COUNT * 2, sizeof(AttemptDone));
+        if (doneQueue == nullptr) {
+            Serial.println("❌ AI router: failed to create result queue");
+            return false;
+        }
+    }
+
+    bool available[AI_PROVIDER_COUNT];
+    for (int i = 0; i < AI_PROVIDER_COUNT; i++) {
+        available[i] = isAvailable((uint8_t)i);
+    }
+
+    uint8_t order[HEDGE_MAX_PROVIDERS];
+    portENTER_CRITICAL(&aiRouterLock);
+    uint8_t count = policy.order(available, AI_PROVIDER_COUNT, order);
+    uint32_t hedgeMs = count > 0 ? policy.hedgeDelayMs(order[0]) : 0;
+    portEXIT_CRITICAL(&aiRouterLock);
+
+    if (count == 0) {
+        Serial.println("❌ AI router: no provider available");
+        return false;
+    }
+
+    uint32_t id = ++raceId;
+    uint32_t startMs = millis();
+    HedgedRace race;
+    race.begin(order, count, hedgeMs, startMs);
+
+    while (!race.done()) {
+        uint32_t now = millis();
+        int provider;
+        while ((provider = race.launch(now)) >= 0) {
+            if (race.getLaunched() > 1) {
+                Serial.printf("⏱️  AI router: %s after %lu ms, starting %s\n",
+                             race.wasHedged() ? "no answer" : "primary failed",
+                             (unsigned long)(now - startMs), providerName(provider));
+            }
+            if (!startAttempt(provider, data, id)) {
+                race.finish(provider, false, now);
+            }
+        }
+        if (race.done()) break;
+
+        uint32_t elapsed = now - startMs;
+        if (elapsed >= AI_RACE_TIMEOUT_MS) {
+            Serial.println("❌ AI router: no answer before the race timeout");
+            break;
+        }
+        uint32_t waitMs = race.msUntilLaunch(now);
+        if (waitMs > AI_RACE_TIMEOUT_MS - elapsed) waitMs = AI_RACE_TIMEOUT_MS - elapsed;
+        if (idle != nullptr) {
+            idle(ctx);
+            if (waitMs > AI_RACE_IDLE_MS) waitMs = AI_RACE_IDLE_MS;
+        }
+
+        AttemptDone done;
+        if (xQueueReceive(doneQueue, &done, pdMS_TO_TICKS(waitMs > 0 ? waitMs : 1)) != pdTRUE) {
+            continue;
+        }
+        if (done.raceId != id) continue;  // Late answer from an earlier race
+
+        Attempt& attempt = attempts[done.provider];
+        if (race.finish(done.provider, attempt.ok, millis())) {
+            signals = attempt.signals;
+        }
+    }
+
+    // Whatever is still running has lost
+    for (int i = 0; i < AI_PROVIDER_COUNT; i++) {
+        if (race.isRunning((uint8_t)i) && attempts[i].raceId == id) {
+            attempts[i].cancelled = true;
+        }
+    }
+
+    int winner = race.getWinner();
+    bool hedgeWin = winner >= 0 && winner != order[0] && race.isRunning(order[0]);
+    bool failover = winner >= 0 && winner != order[0] && !hedgeWin;
+
+    portENTER_CRITICAL(&aiRouterLock);
+    races++;
+    if (race.wasHedged()) hedgedRaces++;
+    if (hedgeWin) hedgeWins++;
+    if (failover) failovers++;
+    if (winner >= 0) policy.recordWin((uint8_t)winner);
+    portEXIT_CRITICAL(&aiRouterLock);
+
+    if (winner < 0) {
+        Serial.println("❌ AI router: every provider failed");
+        return false;
+    }
+
+    Serial.printf("✓ Market signals from %s in %lu ms%s\n", providerName(winner),
+                 (unsigned long)race.getElapsedMs(),
+                 hedgeWin ? " (hedged)" : failover ? " (failover)" : "");
+    if (hedgeWin || failover) {
+        sdLogger.logf(LOG_INFO, "AI signals answered by %s after %s (%u ms, hedge delay %u ms)",
+                     providerName(winner), hedgeWin ? "hedge" : "failover",
+                     race.getElapsedMs(), hedgeMs);
+    }
+
+    aiCache.store(AI_CACHE_MARKET_SIGNALS, data, &signals, sizeof(signals));
+    return true;
+}
+
+void AIRouter::printStatus() {
+    // Copy under the lock, print outside it
+    portENTER_CRITICAL(&aiRouterLock);
+    HedgePolicy snapshot = policy;
+    uint32_t raceCount = races;
+    uint32_t hedged = hedgedRaces;
+    uint32_t wonByHedge = hedgeWins;
+    uint32_t failedOver = failovers;
+    portEXIT_CRITICAL(&aiRouterLock);
+
+    uint8_t primary = snapshot.getPrimary();
+    Serial.println("\n=== AI Providers ===");
+    Serial.printf("  Primary: %s, hedge after %u ms\n", providerName(primary),
+                 snapshot.hedgeDelayMs(primary));
+    Serial.printf("  Races: %u, hedged %u (%u%%), won by hedge %u, failovers %u\n",
+                 raceCount, hedged, raceCount > 0 ? hedged * 100 / raceCount : 0,
+                 wonByHedge, failedOver);
+
+    for (int i = 0; i < AI_PROVIDER_COUNT; i++) {
+        const LatencyHistogram& latency = snapshot.getLatency((uint8_t)i);
+        const HedgeProviderStats& s = snapshot.getStats((uint8_t)i);
+        Serial.printf("  %-7s requests=%u fail=%u wins=%u p50=%ums p95=%ums (%u samples)\n",
+                     providerName((uint8_t)i), s.attempts, s.failures, s.wins,
+                     latency.percentile(50), latency.percentile(95), latency.samples());
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef AI_ROUTER_H
+#define AI_ROUTER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include "AIProvider.h"
+#include "BTCData.h"
+#include "MarketSignals.h"
+#include "../network/HedgedRace.h"
+
+// Attempt task settings (one task per provider request)
+#define AI_ATTEMPT_CORE 0              // Same core as the fetch worker
+#define AI_ATTEMPT_STACK_SIZE 12288    // TLS handshakes need ~8KB of stack
+#define AI_ATTEMPT_PRIORITY 1
+#define AI_RACE_TIMEOUT_MS 35000       // Longer than any client timeout (30s)
+#define AI_RACE_IDLE_MS 50             // Longest wait between idle callbacks during a race
+
+// AI backends, in default preference order
+enum AIProviderId {
+    AI_PROVIDER_GEMINI = 0,
+    AI_PROVIDER_OPENAI,
+    AI_PROVIDER_COUNT
+};
+
+/**
+ * AIRouter - Hedged market signals requests across Gemini and OpenAI
+ *
+ * A request goes to the primary provider first. If it has not answered
+ * within its p95 latency (HedgePolicy), the secondary is started as well and
+ * the first valid answer wins; a provider that fails hands over at once.
+ * Each request runs in its own short-lived task so the fetch worker can wait
+ * on both. The losing attempt is cancelled: if it has not sent its request
+ * yet it never does, otherwise its answer is dropped when it arrives.
+ *
+ * Every completed request, winner or not, feeds its provider's latency
+ * histogram, which decides the primary and the hedge delay of the next race.
+ * Answers are looked up in and stored to AICache here, not in the clients.
+ *
+ * Called from the fetch worker; printStatus() from the loop task.
+ */
+class AIRouter {
+public:
+    AIRouter();
+
+    // DCA recommendation and trading signal from whichever provider is fastest.
+    // idle(ctx), if given, is called at least every AI_RACE_IDLE_MS while
+    // waiting, so the caller's task keeps up with other work (WebSocket pushes).
+    bool fetchMarketSignals(const BTCData& data, MarketSignals& signals,
+                            void (*idle)(void* ctx) = nullptr, void* ctx = nullptr);
+
+    // Last fetchMarketSignals() was answered from AICache (no request sent)
+    bool wasCached() const { return cached; }
+
+    // Print primary, hedge delay and per-provider latency (NET_STATUS command)
+    void printStatus();
+
+    static const char* providerName(uint8_t provider);
+
+private:
+    // One request in flight; a slot is reused only after its task has exited
+    struct Attempt {
+        AIRouter* router;
+        uint8_t provider;
+        AIProvider* client;  // Created on first use, reused by every later race
+        uint32_t raceId;
+        BTCData data;
+        MarketSignals signals;
+        bool ok;
+        volatile bool cancelled;
+        volatile bool running;
+    };
+
+    // Posted by an attempt task when its request is done
+    struct AttemptDone {
+        uint8_t provider;
+        uint32_t raceId;
+    };
+
+    Attempt attempts[AI_PROVIDER_COUNT];
+    HedgePolicy policy;
+    QueueHandle_t doneQueue;
+    uint32_t raceId;
+    bool cached;
+
+    // Race counters
+    uint32_t races;
+    uint32_t hedgedRaces;
+    uint32_t hedgeWins;   // Races answered by the provider started as a hedge
+    uint32_t failovers;   // Races answered after the primary failed
+
+    bool isAvailable(uint8_t provider);
+    bool startAttempt(uint8_t provider, const BTCData& data, uint32_t id);
+    void recordAttempt(uint8_t provider, uint32_t latencyMs, bool ok);
+
+    AIProvider* clientFor(uint8_t provider);
+    static void attemptTask(void* param);
+};
+
+// Global instance
+extern AIRouter aiRouter;
+
+#endif // AI_ROUTER_H
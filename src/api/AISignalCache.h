@@ -0,0 +1,186 @@
+#ifndef AI_SIGNAL_CACHE_H
+#define AI_SIGNAL_CACHE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+// Cache settings
+#define AI_CACHE_ENTRIES 4             // Recent market states per cache
+#define AI_CACHE_VALUE_SIZE 512        // Largest cached answer (CachedSuggestion)
+#define AI_CACHE_TTL_S 1800            // Reuse an answer for up to 30 minutes
+#define AI_CACHE_LOG_EVERY 12          // Log the hit rate every N lookups
+#define AI_CACHE_VERSION 1             // Bump when the entry layout changes
+
+// Quantization of the market snapshot
+#define AI_CACHE_PRICE_STEP_PCT 0.5f   // Price buckets are 0.5% wide
+
+// Which AI answer an entry holds
+enum AICacheKind {
+    AI_CACHE_MARKET_SIGNALS = 0,   // Gemini DCA + trading signal (MarketSignals)
+    AI_CACHE_TRADING_SUGGESTION,   // OpenAI trading suggestion (CachedSuggestion)
+    AI_CACHE_KIND_COUNT
+};
+
+/**
+ * Quantized market state. Two snapshots with the same fingerprint would get
+ * the same answer from the model, so the answer can be reused.
+ *   price:   0.5% log buckets (~$500 wide at $100k)
+ *   fees:    fast fee tier (<=2, 5, 10, 20, 50, 100, >100 sat/vB)
+ *   mempool: size tier (<=1, 5, 20, 50, 100, 300, >300 vMB)
+ */
+inline uint32_t priceBucket(float priceUSD) {
+    if (!(priceUSD > 1.0f)) return 0;
+    return (uint32_t)(logf(priceUSD) / log1pf(AI_CACHE_PRICE_STEP_PCT / 100.0f));
+}
+
+inline uint8_t feeTier(int feeFast) {
+    static const int TIERS[] = {2, 5, 10, 20, 50, 100};
+    uint8_t tier = 0;
+    while (tier < 6 && feeFast > TIERS[tier]) tier++;
+    return tier;
+}
+
+inline uint8_t mempoolTier(float mempoolSizeVMB) {
+    static const float TIERS[] = {1.0f, 5.0f, 20.0f, 50.0f, 100.0f, 300.0f};
+    uint8_t tier = 0;
+    while (tier < 6 && mempoolSizeVMB > TIERS[tier]) tier++;
+    return tier;
+}
+
+// price bucket in the low 24 bits, fee tier and mempool tier in 4 bits each
+inline uint32_t marketFingerprint(float priceUSD, int feeFast, float mempoolSizeVMB) {
+    return (priceBucket(priceUSD) & 0xFFFFFF) |
+           ((uint32_t)feeTier(feeFast) << 24) |
+           ((uint32_t)mempoolTier(mempoolSizeVMB) << 28);
+}
+
+// One cached answer
+struct AICacheEntry {
+    uint8_t version;      // AI_CACHE_VERSION when stored; anything else is ignored
+    uint8_t kind;         // AICacheKind
+    uint16_t valueSize;
+    uint32_t fingerprint;
+    uint32_t storedAt;    // Unix time (s); survives reboots unlike millis()
+    uint8_t value[AI_CACHE_VALUE_SIZE];
+
+    bool used() const { return version == AI_CACHE_VERSION && valueSize > 0; }
+};
+
+/**
+ * AISignalCache - Reuses AI answers while the market has not moved
+ *
+ * Entries are keyed on (kind, fingerprint) and expire after AI_CACHE_TTL_S
+ * even if the market is unchanged, so a flat market still gets a fresh
+ * opinion every half hour. Times are Unix seconds so persisted entries stay
+ * valid across a reboot; a clock of 0 (not synced yet) never hits.
+ *
+ * The caller persists entries (see AICache).
+ */
+class AISignalCache {
+public:
+    AISignalCache() { clear(); }
+
+    void clear() {
+        memset(entries, 0, sizeof(entries));
+        hits = 0;
+        misses = 0;
+        expired = 0;
+    }
+
+    /**
+     * Copy a fresh answer for fingerprint into value.
+     * Counts a hit, a miss, or an expired entry (also a miss).
+     */
+    bool lookup(AICacheKind kind, uint32_t fingerprint, void* value, size_t size, uint32_t nowS) {
+        int i = find(kind, fingerprint);
+        if (i < 0 || nowS == 0 || entries[i].valueSize != size) {
+            misses++;
+            return false;
+        }
+
+        if (nowS - entries[i].storedAt >= AI_CACHE_TTL_S) {
+            expired++;
+            misses++;
+            return false;
+        }
+
+        memcpy(value, entries[i].value, size);
+        hits++;
+        return true;
+    }
+
+    /**
+     * Remember an answer. Returns the slot written (for persistence) or -1
+     * if the value does not fit or the clock is not set.
+     */
+    int store(AICacheKind kind, uint32_t fingerprint, const void* value, size_t size, uint32_t nowS) {
+        if (kind >= AI_CACHE_KIND_COUNT || size == 0 || size > AI_CACHE_VALUE_SIZE || nowS == 0) {
+            return -1;
+        }
+
+        int i = find(kind, fingerprint);
+        if (i < 0) i = victim();
+
+        AICacheEntry& e = entries[i];
+        memset(&e, 0, sizeof(e));
+        e.version = AI_CACHE_VERSION;
+        e.kind = (uint8_t)kind;
+        e.valueSize = (uint16_t)size;
+        e.fingerprint = fingerprint;
+        e.storedAt = nowS;
+        memcpy(e.value, value, size);
+        return i;
+    }
+
+    // Put back a persisted entry (ignored if it came from another layout)
+    bool restore(int slot, const AICacheEntry& entry) {
+        if (slot < 0 || slot >= AI_CACHE_ENTRIES || !entry.used() ||
+            entry.kind >= AI_CACHE_KIND_COUNT || entry.valueSize > AI_CACHE_VALUE_SIZE) {
+            return false;
+        }
+        entries[slot] = entry;
+        return true;
+    }
+
+    uint32_t getHits() const { return hits; }
+    uint32_t getMisses() const { return misses; }
+    uint32_t getExpired() const { return expired; }
+    uint32_t getLookups() const { return hits + misses; }
+
+    // Percentage of lookups answered from the cache
+    uint8_t hitRate() const {
+        uint32_t total = getLookups();
+        return total > 0 ? (uint8_t)((hits * 100 + total / 2) / total) : 0;
+    }
+
+    const AICacheEntry& entry(int i) const { return entries[i]; }
+    static int capacity() { return AI_CACHE_ENTRIES; }
+
+private:
+    AICacheEntry entries[AI_CACHE_ENTRIES];
+    uint32_t hits;
+    uint32_t misses;
+    uint32_t expired;
+
+    int find(AICacheKind kind, uint32_t fingerprint) const {
+        for (int i = 0; i < AI_CACHE_ENTRIES; i++) {
+            if (entries[i].used() && entries[i].kind == kind && entries[i].fingerprint == fingerprint) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // Free slot, else the oldest answer
+    int victim() const {
+        int oldest = 0;
+        for (int i = 0; i < AI_CACHE_ENTRIES; i++) {
+            if (!entries[i].used()) return i;
+            if ((int32_t)(entries[i].storedAt - entries[oldest].storedAt) < 0) oldest = i;
+        }
+        return oldest;
+    }
+};
+
+#endif // AI_SIGNAL_CACHE_H
@@ -2,16 +2,22 @@
 #define BTC_DATA_H
 
 #include <Arduino.h>
+#include "MempoolStats.h"
+#include "../utils/RollingChange.h"
 
 struct BTCData {
     float priceUSD = 0;
     float priceEUR = 0;
+    PriceChange priceChange[CHANGE_WINDOW_COUNT];  // 1h, 24h, 7d (see RollingChange.h)
     unsigned long blockHeight = 0;
     char blockHash[65] = "";
     int blockTxCount = 0;
     uint32_t blockTime = 0;
+    uint32_t blockSize = 0;                        // Bytes
     unsigned long mempoolCount = 0;
-    float mempoolSize = 0;
+    float mempoolSize = 0;                         // Virtual size in vMB
+    uint64_t mempoolTotalFee = 0;                  // Total fees waiting (sat)
+    uint32_t feeHistogram[MEMPOOL_FEE_BINS] = {};  // vB per fee bin (see MempoolStats.h)
     int feeFast = 0;
     int feeMedium = 0;
     int feeSlow = 0;
@@ -20,6 +26,14 @@ struct BTCData {
     char dcaRecommendation[32] = "Wait";  // BUY/SELL/WAIT
     char tradingSignal[32] = "HOLD";      // BUY/SELL/HOLD
     char signalTimeframe[16] = "15m-1h";  // Timeframe for signal
+    uint8_t signalConfidence = 0;         // 0-100, reported with the signal
+
+    // On-device indicators (see Indicators.h)
+    char localSignal[8] = "";             // BUY/SELL/HOLD, empty while warming up
+    uint8_t localConfidence = 0;          // 0-100
+    float rsi = -1;                       // 0-100, -1 until enough samples
+    float bandWidthPct = 0;               // Bollinger band width, % of price
+    float volatilityPct = 0;              // Hourly volatility, %
 };
 
 #endif
@@ -0,0 +1,57 @@
+#ifndef BLOCK_INFO_H
+#define BLOCK_INFO_H
+
+#include <stdint.h>
+#include <string.h>
+#include <ArduinoJson.h>
+#include "MempoolStats.h"
+
+#define BLOCK_HASH_LEN 64
+
+// Header fields of one block (/api/block/:hash)
+struct BlockInfo {
+    uint32_t height;
+    char hash[BLOCK_HASH_LEN + 1];
+    uint32_t timestamp;
+    uint32_t txCount;
+    uint32_t size;  // Serialized size in bytes
+};
+
+/**
+ * Parse a block straight from the HTTP body.
+ *
+ * /api/block/:hash also carries extras (pool info, fee ranges, merkle root)
+ * that the dashboard never shows; the filter drops them while the body
+ * streams past. Fails with InvalidInput if the id or height is missing, so a
+ * half-parsed block is never reported as a new one.
+ */
+template <typename TSource>
+DeserializationError parseBlockInfo(HttpBodyReader<TSource>& reader, BlockInfo& out) {
+    StaticJsonDocument<128> filter;
+    filter["id"] = true;
+    filter["height"] = true;
+    filter["timestamp"] = true;
+    filter["tx_count"] = true;
+    filter["size"] = true;
+
+    StaticJsonDocument<256> doc;
+    DeserializationError error = deserializeJson(doc, reader, DeserializationOption::Filter(filter));
+    reader.drain();
+
+    if (error) return error;
+
+    const char* id = doc["id"] | "";
+    if (strlen(id) != BLOCK_HASH_LEN || !doc["height"].is<unsigned long>()) {
+        return DeserializationError::InvalidInput;
+    }
+
+    memset(&out, 0, sizeof(out));
+    out.height = doc["height"];
+    strcpy(out.hash, id);
+    out.timestamp = doc["timestamp"] | 0UL;
+    out.txCount = doc["tx_count"] | 0UL;
+    out.size = doc["size"] | 0UL;
+    return error;
+}
+
+#endif // BLOCK_INFO_H
@@ -2,6 +2,7 @@
 #include "BTCData.h"
 #include "../Config.h"
 #include "../utils/SDLogger.h"
+#include "../network/EndpointHealth.h"
 
 GeminiClient::GeminiClient() {
     // Load API key from global config, fallback to hardcoded
@@ -24,29 +25,26 @@ GeminiClient::~GeminiClient() {
     http.end();
 }
 
-String GeminiClient::buildEndpointURL() {
-    return String(GEMINI_BASE_URL) + model + ":generateContent?key=" + apiKey;
+String GeminiClient::buildEndpointURL(bool stream) {
+    return String(GEMINI_BASE_URL) + model +
+           (stream ? ":streamGenerateContent?alt=sse&key=" : ":generateContent?key=") + apiKey;
 }
 
-String GeminiClient::buildRequestBody(const String& prompt) {
-    // Create JSON request body for Gemini API
-    DynamicJsonDocument doc(2048);
-
-    JsonArray contents = doc.createNestedArray("contents");
-    JsonObject content = contents.createNestedObject();
-    JsonArray parts = content.createNestedArray("parts");
-    JsonObject part = parts.createNestedObject();
-    part["text"] = prompt;
-
-    // Generation configuration
-    JsonObject config = doc.createNestedObject("generationConfig");
-    config["temperature"] = GEMINI_TEMPERATURE;
-    config["maxOutputTokens"] = GEMINI_MAX_OUTPUT_TOKENS;
+int GeminiClient::post(const String& endpoint, const JsonBodyWriter& body) {
+    http.begin(endpoint);
+    http.addHeader("Content-Type", "application/json");
+    http.setTimeout(GEMINI_TIMEOUT);
 
-    String requestBody;
-    serializeJson(doc, requestBody);
+    // Needed to decode a streamed body ourselves
+    const char* headerKeys[] = {"Transfer-Encoding"};
+    http.collectHeaders(headerKeys, 1);
 
-    return requestBody;
+    unsigned long startTime = millis();
+    int httpCode = http.POST((uint8_t*)body.c_str(), body.length());
+    lastLatencyMs = millis() - startTime;
+    if (lastLatencyMs == 0) lastLatencyMs = 1;
+    endpointHealth.record(ENDPOINT_GEMINI, httpCode, lastLatencyMs);
+    return httpCode;
 }
 
 bool GeminiClient::parseResponse(const String& response, String& outputText) {
@@ -95,128 +93,129 @@ bool GeminiClient::parseResponse(const String& response, String& outputText) {
     return false;
 }
 
-String GeminiClient::generatePrompt(const BTCData& data) {
-    String prompt = "You are a Bitcoin market analyst. Based on the following real-time data, ";
-    prompt += "provide a concise market analysis (max 800 words):\n\n";
-
-    prompt += "CURRENT DATA:\n";
-    prompt += "- BTC Price: $" + String(data.priceUSD, 2) + " USD";
-    if (data.priceEUR > 0) {
-        prompt += " (€" + String(data.priceEUR, 2) + " EUR)";
-    }
-    prompt += "\n";
-
-    if (data.blockHeight > 0) {
-        prompt += "- Latest Block: #" + String(data.blockHeight);
-        if (data.blockTxCount > 0) {
-            prompt += " (" + String(data.blockTxCount) + " transactions)";
-        }
-        prompt += "\n";
+// Tracks time to first text while forwarding to the caller's callback
+struct NewsStreamContext {
+    GeminiTextCallback onText;
+    void* context;
+    unsigned long startMs;
+    unsigned long firstTextMs;
+};
+
+static void forwardNewsText(const char* text, size_t len, void* context) {
+    NewsStreamContext* stream = (NewsStreamContext*)context;
+    if (stream->firstTextMs == 0) {
+        stream->firstTextMs = millis() - stream->startMs;
+        if (stream->firstTextMs == 0) stream->firstTextMs = 1;
     }
+    if (stream->onText) stream->onText(text, len, stream->context);
+}
 
-    if (data.mempoolCount > 0) {
-        prompt += "- Mempool: " + String(data.mempoolCount) + " pending transactions";
-        if (data.mempoolSize > 0) {
-            prompt += " (" + String(data.mempoolSize, 2) + " MB)";
-        }
-        prompt += "\n";
-    }
+static void appendNewsText(const char* text, size_t len, void* context) {
+    ((String*)context)->concat(text, len);
+}
 
-    if (data.feeFast > 0) {
-        prompt += "- Network Fees: Fast=" + String(data.feeFast);
-        prompt += " Medium=" + String(data.feeMedium);
-        prompt += " Slow=" + String(data.feeSlow) + " sat/vB\n";
+bool GeminiClient::fetchBitcoinNews(const BTCData& data, String& newsText) {
+    newsText = "";
+    String errorText;
+    if (!streamBitcoinNews(data, appendNewsText, &newsText, errorText)) {
+        newsText = errorText;
+        return false;
     }
 
-    prompt += "\nProvide:\n";
-    prompt += "1. 📈 Market Summary (2-3 sentences)\n";
-    prompt += "2. 💡 Technical Analysis (key levels, trends)\n";
-    prompt += "3. 📊 Market Sentiment (bullish/bearish indicators)\n";
-    prompt += "4. ⚠️ Risk Assessment (volatility, warnings)\n";
-    prompt += "5. 🎯 Price Outlook (short-term forecast)\n\n";
-    prompt += "Format with clear sections using emoji headers. Be concise and actionable.";
-
-    return prompt;
+    Serial.println("News fetched successfully!");
+    Serial.println("---");
+    Serial.println(newsText);
+    Serial.println("---");
+    return true;
 }
 
-bool GeminiClient::fetchBitcoinNews(const BTCData& data, String& newsText) {
+bool GeminiClient::streamBitcoinNews(const BTCData& data, GeminiTextCallback onText, void* context,
+                                     String& errorText) {
     // Check WiFi connection
     if (WiFi.status() != WL_CONNECTED) {
         Serial.println("WiFi not connected");
-        newsText = "Error: No WiFi connection. Please connect to WiFi first.";
+        errorText = "Error: No WiFi connection. Please connect to WiFi first.";
         return false;
     }
 
-    // Generate prompt from Bitcoin data
-    String prompt = generatePrompt(data);
-    Serial.println("Generated Prompt:");
-    Serial.println(prompt);
-    Serial.println("---");
-
-    // Build API endpoint
-    String endpoint = buildEndpointURL();
-    Serial.print("Gemini API Endpoint: ");
-    Serial.println(endpoint);
-
-    // Build request body
-    String requestBody = buildRequestBody(prompt);
+    // Build request body (prompt included) in the preallocated buffer
+    JsonBodyWriter body(requestBuffer, sizeof(requestBuffer));
+    if (!writeGeminiNewsRequest(body, data)) {
+        Serial.println("❌ Gemini request body does not fit the request buffer");
+        errorText = "Error: Request too large";
+        return false;
+    }
 
-    // Make HTTP POST request
-    http.begin(endpoint);
-    http.addHeader("Content-Type", "application/json");
-    http.setTimeout(GEMINI_TIMEOUT);
+    if (!endpointHealth.allow(ENDPOINT_GEMINI)) {
+        errorText = "Gemini API unavailable. Retrying shortly.";
+        return false;
+    }
 
-    Serial.println("Sending request to Gemini API...");
+    // Server-sent events: one small JSON object per generated chunk
+    String endpoint = buildEndpointURL(true);
+    Serial.println("Streaming news from Gemini API...");
     unsigned long startTime = millis();
-    int httpCode = http.POST(requestBody);
-    unsigned long duration = millis() - startTime;
-
-    if (httpCode > 0) {
-        Serial.printf("HTTP Response code: %d\n", httpCode);
-
-        if (httpCode == HTTP_CODE_OK) {
-            String response = http.getString();
-            size_t responseSize = response.length();
+    int httpCode = post(endpoint, body);
 
-            // Log successful API call
-            sdLogger.logAPI("gemini", "/generateContent", httpCode, duration, responseSize);
-
-            Serial.println("Response received, parsing...");
+    if (httpCode != HTTP_CODE_OK) {
+        unsigned long duration = millis() - startTime;
+        if (httpCode > 0) {
+            Serial.printf("HTTP Response code: %d\n", httpCode);
+            Serial.println("HTTP Error Response:");
+            Serial.println(http.getString());
+            sdLogger.logAPIError("gemini", "/streamGenerateContent", httpCode, "HTTP error");
+            errorText = "API Error: HTTP " + String(httpCode);
+        } else {
+            Serial.printf("HTTP Request failed: %s\n", http.errorToString(httpCode).c_str());
+            sdLogger.logAPIError("gemini", "/streamGenerateContent", httpCode, "Connection failed");
+            errorText = "Network Error: Failed to connect to Gemini API";
+        }
+        Serial.printf("Gemini stream failed after %lu ms\n", duration);
+        http.end();
+        return false;
+    }
 
-            bool success = parseResponse(response, newsText);
-            http.end();
+    // Feed the body to the parser as it arrives; text reaches onText per event
+    NewsStreamContext stream = {onText, context, startTime, 0};
+    GeminiStreamParser parser(forwardNewsText, &stream);
+    bool chunked = http.header("Transfer-Encoding").equalsIgnoreCase("chunked");
+    HttpBodyReader<WiFiClient> reader(*http.getStreamPtr(), chunked, http.getSize());
 
-            if (success) {
-                Serial.println("News fetched successfully!");
-                Serial.println("---");
-                Serial.println(newsText);
-                Serial.println("---");
-            } else {
-                sdLogger.logAPIError("gemini", "/generateContent", httpCode, "Response parse error");
-            }
+    int c;
+    while ((c = reader.read()) >= 0) {
+        parser.feed((char)c);
+    }
+    parser.feed('\n');  // Close an event the server did not terminate
+    parser.flush();
 
-            return success;
-        } else {
-            String response = http.getString();
-            Serial.println("HTTP Error Response:");
-            Serial.println(response);
+    unsigned long duration = millis() - startTime;
+    bool truncated = reader.failed();
+    http.end();
 
-            // Log API error
-            sdLogger.logAPIError("gemini", "/generateContent", httpCode, "HTTP error");
+    sdLogger.logAPI("gemini", "/streamGenerateContent", httpCode, duration, reader.bytesRead());
+    Serial.printf("Gemini stream: %u events, %u text bytes, first text after %lu ms, done in %lu ms (%s)\n",
+                 parser.getEvents(), parser.getTextBytes(), stream.firstTextMs, duration,
+                 parser.finished() ? parser.getFinishReason() : "no finish reason");
 
-            newsText = "API Error: HTTP " + String(httpCode);
-            http.end();
-            return false;
-        }
-    } else {
-        // Log connection failure
-        sdLogger.logAPIError("gemini", "/generateContent", httpCode, "Connection failed");
+    if (parser.hasError()) {
+        Serial.printf("Gemini API Error: %s\n", parser.getErrorMessage());
+        sdLogger.logAPIError("gemini", "/streamGenerateContent", httpCode, "Error in stream");
+        errorText = "API Error: " + String(parser.getErrorMessage());
+        return false;
+    }
 
-        Serial.printf("HTTP Request failed: %s\n", http.errorToString(httpCode).c_str());
-        newsText = "Network Error: Failed to connect to Gemini API";
-        http.end();
+    if (parser.getTextBytes() == 0) {
+        sdLogger.logAPIError("gemini", "/streamGenerateContent", httpCode,
+                             truncated ? "Stream interrupted" : "Empty response");
+        errorText = "API Error: Empty response";
         return false;
     }
+
+    if (truncated) {
+        // Keep what arrived; the caller already has it
+        sdLogger.logAPIError("gemini", "/streamGenerateContent", httpCode, "Stream interrupted");
+    }
+    return true;
 }
 
 bool GeminiClient::testConnection() {
@@ -225,18 +224,18 @@ bool GeminiClient::testConnection() {
         return false;
     }
 
+    if (!endpointHealth.allow(ENDPOINT_GEMINI)) {
+        return false;
+    }
+
     Serial.println("Testing Gemini API connection...");
 
     String endpoint = buildEndpointURL();
-    String testPrompt = "Say 'Hello from Bitcoin Dashboard!' in one sentence.";
-    String requestBody = buildRequestBody(testPrompt);
-
-    http.begin(endpoint);
-    http.addHeader("Content-Type", "application/json");
-    http.setTimeout(GEMINI_TIMEOUT);
+    JsonBodyWriter body(requestBuffer, sizeof(requestBuffer));
+    writeGeminiTextRequest(body, "Say 'Hello from Bitcoin Dashboard!' in one sentence.");
 
     unsigned long startTime = millis();
-    int httpCode = http.POST(requestBody);
+    int httpCode = post(endpoint, body);
     unsigned long duration = millis() - startTime;
 
     if (httpCode == HTTP_CODE_OK) {
@@ -264,179 +263,54 @@ void GeminiClient::setApiKey(const String& key) {
     apiKey = key;
 }
 
-bool GeminiClient::fetchDCARecommendation(const BTCData& data, String& recommendation) {
+bool GeminiClient::fetchMarketSignals(const BTCData& data, MarketSignals& signals,
+                                      const volatile bool* cancelled) {
+    lastLatencyMs = 0;
+
     // Check WiFi connection
     if (WiFi.status() != WL_CONNECTED) {
         Serial.println("WiFi not connected");
-        recommendation = "WAIT";
         return false;
     }
 
-    // Generate DCA-specific prompt
-    String prompt = "You are a Bitcoin DCA (Dollar Cost Average) advisor. ";
-    prompt += "Based on the following current market data, provide a ONE-WORD recommendation: BUY, SELL, or WAIT.\n\n";
-
-    prompt += "CURRENT DATA:\n";
-    prompt += "- BTC Price: $" + String(data.priceUSD, 2) + " USD\n";
-
-    if (data.feeFast > 0) {
-        prompt += "- Network Fees: Fast=" + String(data.feeFast) + " sat/vB\n";
-    }
-
-    if (data.mempoolCount > 0) {
-        prompt += "- Mempool: " + String(data.mempoolCount) + " pending transactions\n";
-    }
-
-    prompt += "\nDCA STRATEGY CONSIDERATIONS:\n";
-    prompt += "- BUY: Good time to accumulate (favorable price, low volatility, or regular schedule)\n";
-    prompt += "- SELL: Consider taking profits (extreme highs, bearish signals)\n";
-    prompt += "- WAIT: Hold off on buying (high fees, extreme volatility, or uncertain conditions)\n\n";
-    prompt += "Respond with ONLY ONE WORD: BUY, SELL, or WAIT. No explanation needed.";
-
-    Serial.println("DCA Prompt:");
-    Serial.println(prompt);
-
-    // Build and send request
-    String endpoint = buildEndpointURL();
-    String requestBody = buildRequestBody(prompt);
-
-    http.begin(endpoint);
-    http.addHeader("Content-Type", "application/json");
-    http.setTimeout(GEMINI_TIMEOUT);
-
-    Serial.println("Fetching DCA recommendation from Gemini...");
-    unsigned long startTime = millis();
-    int httpCode = http.POST(requestBody);
-    unsigned long duration = millis() - startTime;
-
-    if (httpCode == HTTP_CODE_OK) {
-        String response = http.getString();
-        size_t responseSize = response.length();
-
-        sdLogger.logAPI("gemini", "/dca-recommendation", httpCode, duration, responseSize);
-
-        String fullResponse;
-        bool success = parseResponse(response, fullResponse);
-        http.end();
-
-        if (success) {
-            // Extract first word from response
-            fullResponse.trim();
-            fullResponse.toUpperCase();
-
-            if (fullResponse.indexOf("BUY") >= 0) {
-                recommendation = "BUY";
-            } else if (fullResponse.indexOf("SELL") >= 0) {
-                recommendation = "SELL";
-            } else if (fullResponse.indexOf("WAIT") >= 0) {
-                recommendation = "WAIT";
-            } else {
-                recommendation = "WAIT"; // Default to WAIT if unclear
-            }
-
-            Serial.printf("DCA Recommendation: %s\n", recommendation.c_str());
-            return true;
-        } else {
-            sdLogger.logAPIError("gemini", "/dca-recommendation", httpCode, "Parse error");
-            recommendation = "WAIT";
-            return false;
-        }
-    } else {
-        sdLogger.logAPIError("gemini", "/dca-recommendation", httpCode, "HTTP error");
-        Serial.printf("DCA request failed: %d\n", httpCode);
-        recommendation = "WAIT";
-        http.end();
+    // One prompt for both answers; the response schema fixes the output format
+    JsonBodyWriter body(requestBuffer, sizeof(requestBuffer));
+    if (!writeMarketSignalsRequest(body, data)) {
+        Serial.println("❌ Market signals body does not fit the request buffer");
         return false;
     }
-}
 
-bool GeminiClient::fetchTradingSignal(const BTCData& data, String& signal) {
-    // Check WiFi connection
-    if (WiFi.status() != WL_CONNECTED) {
-        Serial.println("WiFi not connected");
-        signal = "HOLD";
+    // Lost the race before starting: do not spend a request (or a breaker probe)
+    if (isCancelled(cancelled) || !endpointHealth.allow(ENDPOINT_GEMINI)) {
         return false;
     }
 
-    // Generate short-term trading signal prompt
-    String prompt = "You are a Bitcoin short-term trading analyst. ";
-    prompt += "Based on the following current market data, provide a ONE-WORD trading signal for the 15-minute to 1-hour timeframe: BUY, SELL, or HOLD.\n\n";
-
-    prompt += "CURRENT DATA:\n";
-    prompt += "- BTC Price: $" + String(data.priceUSD, 2) + " USD\n";
-
-    if (data.blockHeight > 0) {
-        prompt += "- Latest Block: #" + String(data.blockHeight) + "\n";
-    }
-
-    if (data.feeFast > 0) {
-        prompt += "- Network Fees: Fast=" + String(data.feeFast);
-        prompt += " Medium=" + String(data.feeMedium);
-        prompt += " Slow=" + String(data.feeSlow) + " sat/vB\n";
-    }
-
-    if (data.mempoolCount > 0) {
-        prompt += "- Mempool: " + String(data.mempoolCount) + " pending transactions\n";
-    }
-
-    prompt += "\nSHORT-TERM TRADING CONSIDERATIONS (15m-1h timeframe):\n";
-    prompt += "- BUY: Bullish momentum, accumulation signals, support levels holding\n";
-    prompt += "- SELL: Bearish signals, profit-taking opportunity, resistance rejection\n";
-    prompt += "- HOLD: Consolidation, unclear direction, wait for confirmation\n\n";
-    prompt += "Respond with ONLY ONE WORD: BUY, SELL, or HOLD. No explanation needed.";
-
-    Serial.println("Trading Signal Prompt:");
-    Serial.println(prompt);
-
-    // Build and send request
     String endpoint = buildEndpointURL();
-    String requestBody = buildRequestBody(prompt);
-
-    http.begin(endpoint);
-    http.addHeader("Content-Type", "application/json");
-    http.setTimeout(GEMINI_TIMEOUT);
-
-    Serial.println("Fetching trading signal from Gemini...");
+    Serial.println("Fetching market signals from Gemini...");
     unsigned long startTime = millis();
-    int httpCode = http.POST(requestBody);
+    int httpCode = post(endpoint, body);
     unsigned long duration = millis() - startTime;
 
     if (httpCode == HTTP_CODE_OK) {
         String response = http.getString();
         size_t responseSize = response.length();
-
-        sdLogger.logAPI("gemini", "/trading-signal", httpCode, duration, responseSize);
-
-        String fullResponse;
-        bool success = parseResponse(response, fullResponse);
         http.end();
 
-        if (success) {
-            // Extract first word from response
-            fullResponse.trim();
-            fullResponse.toUpperCase();
-
-            if (fullResponse.indexOf("BUY") >= 0) {
-                signal = "BUY";
-            } else if (fullResponse.indexOf("SELL") >= 0) {
-                signal = "SELL";
-            } else if (fullResponse.indexOf("HOLD") >= 0) {
-                signal = "HOLD";
-            } else {
-                signal = "HOLD"; // Default to HOLD if unclear
-            }
+        sdLogger.logAPI("gemini", "/market-signals", httpCode, duration, responseSize);
 
-            Serial.printf("Trading Signal (15m-1h): %s\n", signal.c_str());
+        String outputText;
+        if (parseResponse(response, outputText) && parseMarketSignals(outputText.c_str(), signals)) {
+            Serial.printf("Market Signals: DCA=%s signal=%s (%s) confidence=%u%%\n",
+                         signals.dca, signals.signal, signals.timeframe, signals.confidence);
             return true;
-        } else {
-            sdLogger.logAPIError("gemini", "/trading-signal", httpCode, "Parse error");
-            signal = "HOLD";
-            return false;
         }
+
+        sdLogger.logAPIError("gemini", "/market-signals", httpCode, "Parse error");
+        Serial.printf("Unexpected market signals reply: %s\n", outputText.c_str());
+        return false;
     } else {
-        sdLogger.logAPIError("gemini", "/trading-signal", httpCode, "HTTP error");
-        Serial.printf("Trading signal request failed: %d\n", httpCode);
-        signal = "HOLD";
+        sdLogger.logAPIError("gemini", "/market-signals", httpCode, "HTTP error");
+        Serial.printf("Market signals request failed: %d\n", httpCode);
         http.end();
         return false;
     }
@@ -16,42 +16,54 @@
 // API Settings
 #define GEMINI_TIMEOUT 30000          // 30 seconds
 #define GEMINI_MAX_RESPONSE_SIZE 4096 // 4KB response buffer
-#define GEMINI_MAX_OUTPUT_TOKENS 1024 // Limit response length
-#define GEMINI_TEMPERATURE 0.7        // Creativity level (0.0-1.0)
 
 #include "BTCData.h"
+#include "MarketSignals.h"
+#include "AIProvider.h"
+#include "AIPrompts.h"
+#include "GeminiStream.h"
+#include "MempoolStats.h"     // HttpBodyReader
 
-class GeminiClient {
+class GeminiClient : public AIProvider {
 private:
     HTTPClient http;
     String apiKey;
     String model;
 
-    // Build the full API endpoint URL
-    String buildEndpointURL();
+    // Request body, owned by this instance: AIRouter keeps one client per
+    // provider and races them in parallel, so they never share a buffer
+    char requestBuffer[AI_REQUEST_BUFFER_SIZE];
 
-    // Create the JSON request body
-    String buildRequestBody(const String& prompt);
+    // Build the full API endpoint URL (stream: streamGenerateContent as SSE)
+    String buildEndpointURL(bool stream = false);
 
     // Parse Gemini API response
     bool parseResponse(const String& response, String& outputText);
 
+    // POST a body built in requestBuffer and report the
+    // outcome to the circuit breaker
+    int post(const String& endpoint, const JsonBodyWriter& body);
+
 public:
     GeminiClient();
     GeminiClient(const String& key, const String& modelName = GEMINI_MODEL);
     ~GeminiClient();
 
-    // Main method to get Bitcoin news/analysis
+    // Legacy String API, kept for compatibility: collects the whole stream
+    // below, so peak memory is the full answer. New views should stream.
     bool fetchBitcoinNews(const BTCData& data, String& newsText);
 
-    // Get DCA (Dollar Cost Average) recommendation
-    bool fetchDCARecommendation(const BTCData& data, String& recommendation);
-
-    // Get short-term trading signal (15m-1h timeframe)
-    bool fetchTradingSignal(const BTCData& data, String& signal);
-
-    // Generate prompt from Bitcoin data
-    String generatePrompt(const BTCData& data);
+    // Stream the news analysis: onText receives each piece of text as soon as
+    // its chunk arrives, so a view can render before the answer is complete.
+    // On failure errorText holds a message for the screen.
+    bool streamBitcoinNews(const BTCData& data, GeminiTextCallback onText, void* context,
+                           String& errorText);
+
+    // DCA recommendation, trading signal, timeframe and confidence in one
+    // structured-output request (see MarketSignals.h). Not cached; go
+    // through AIRouter.
+    bool fetchMarketSignals(const BTCData& data, MarketSignals& signals,
+                            const volatile bool* cancelled) override;
 
     // Test API connectivity
     bool testConnection();
@@ -0,0 +1,324 @@
+#ifndef GEMINI_STREAM_H
+#define GEMINI_STREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// Streaming settings
+#define GEMINI_STREAM_FRAGMENT 64      // Text handed to the callback at most this many bytes at a time
+#define GEMINI_STREAM_KEY_LEN 16       // Longest key name tracked ("finishReason")
+#define GEMINI_STREAM_VALUE_LEN 96     // finishReason / error message kept for the caller
+
+// Receives each decoded piece of candidate text (UTF-8, never split mid-character)
+typedef void (*GeminiTextCallback)(const char* text, size_t len, void* context);
+
+/**
+ * GeminiStreamParser - Incremental parser for streamGenerateContent?alt=sse
+ *
+ * The response is a series of server-sent events, one JSON object per
+ * "data:" line:
+ *   data: {"candidates":[{"content":{"parts":[{"text":"📈 Market"}]}}]}
+ *
+ * Bytes are fed as they come off the socket. A byte-level scanner follows the
+ * JSON of each event and decodes the value of every "text" key (escapes and
+ * \uXXXX included) straight into a 64-byte fragment buffer. The buffer goes to
+ * the callback whenever it fills and at the end of each text part, so the
+ * caller sees text as soon as an event arrives. Nothing else is stored, so
+ * memory is fixed regardless of how long the answer or any single event is.
+ *
+ * "finishReason" and an "error" object's "message" are captured for the
+ * caller.
+ */
+class GeminiStreamParser {
+public:
+    GeminiStreamParser(GeminiTextCallback callback = nullptr, void* callbackContext = nullptr)
+        : onText(callback), context(callbackContext) {
+        reset();
+    }
+
+    void reset() {
+        line = LINE_START;
+        fieldLen = 0;
+        lastCR = false;
+        resetEvent();
+        events = 0;
+        textBytes = 0;
+        fragmentLen = 0;
+        finishReason[0] = '\0';
+        errorMessage[0] = '\0';
+        errorSeen = false;
+    }
+
+    void feed(const char* data, size_t len) {
+        for (size_t i = 0; i < len; i++) {
+            feed(data[i]);
+        }
+    }
+
+    void feed(char c) {
+        if (c == '\n' || c == '\r') {
+            // CRLF is one line end
+            if (!(c == '\n' && lastCR)) endLine();
+            lastCR = c == '\r';
+            return;
+        }
+        lastCR = false;
+
+        switch (line) {
+            case LINE_START:
+                if (c == ':') {
+                    // "data:" is the only field we care about; ":" alone is a comment
+                    line = (fieldLen == 4 && memcmp(field, "data", 4) == 0) ? LINE_DATA_SPACE : LINE_SKIP;
+                } else if (fieldLen < sizeof(field)) {
+                    field[fieldLen++] = c;
+                } else {
+                    line = LINE_SKIP;
+                }
+                break;
+            case LINE_DATA_SPACE:
+                line = LINE_DATA;
+                if (c != ' ') json(c);
+                break;
+            case LINE_DATA:
+                json(c);
+                break;
+            case LINE_SKIP:
+                break;
+        }
+    }
+
+    // Hand any buffered text to the callback (call once the body has ended)
+    void flush() {
+        if (fragmentLen == 0) return;
+        fragment[fragmentLen] = '\0';
+        if (onText) onText(fragment, fragmentLen, context);
+        fragmentLen = 0;
+    }
+
+    uint32_t getEvents() const { return events; }        // "data:" events completed
+    uint32_t getTextBytes() const { return textBytes; }  // Decoded text bytes
+    bool finished() const { return finishReason[0] != '\0'; }
+    const char* getFinishReason() const { return finishReason; }
+    bool hasError() const { return errorSeen; }
+    const char* getErrorMessage() const { return errorMessage; }
+
+private:
+    enum LineState { LINE_START, LINE_DATA_SPACE, LINE_DATA, LINE_SKIP };
+    enum ValueTarget { TARGET_NONE, TARGET_TEXT, TARGET_FINISH, TARGET_ERROR };
+
+    GeminiTextCallback onText;
+    void* context;
+
+    // SSE line framing
+    LineState line;
+    char field[8];
+    uint8_t fieldLen;
+    bool lastCR;
+    bool eventHasData;
+
+    // JSON scanner (per event)
+    bool inString;
+    bool escaped;
+    uint8_t unicodeDigits;   // > 0 while reading \uXXXX
+    uint32_t unicode;
+    uint32_t highSurrogate;
+    char lastString[GEMINI_STREAM_KEY_LEN];
+    uint8_t lastStringLen;
+    bool stringMayBeKey;     // Last string can still turn out to be a key (awaiting ':')
+    char key[GEMINI_STREAM_KEY_LEN];
+    uint8_t keyLen;
+    bool awaitingValue;      // A ':' was seen, the next token is the value of key
+    ValueTarget target;      // Where the current string value goes
+    size_t valueLen;
+
+    // Output
+    char fragment[GEMINI_STREAM_FRAGMENT + 4];
+    size_t fragmentLen;
+    uint32_t events;
+    uint32_t textBytes;
+    char finishReason[GEMINI_STREAM_VALUE_LEN];
+    char errorMessage[GEMINI_STREAM_VALUE_LEN];
+    bool errorSeen;
+
+    void resetEvent() {
+        eventHasData = false;
+        inString = false;
+        escaped = false;
+        unicodeDigits = 0;
+        unicode = 0;
+        highSurrogate = 0;
+        lastStringLen = 0;
+        stringMayBeKey = false;
+        keyLen = 0;
+        awaitingValue = false;
+        target = TARGET_NONE;
+        valueLen = 0;
+    }
+
+    void endLine() {
+        if (line == LINE_START && fieldLen == 0) {
+            // Blank line: end of event
+            if (eventHasData) events++;
+            resetEvent();
+        } else if (line == LINE_DATA || line == LINE_DATA_SPACE) {
+            eventHasData = true;
+        }
+        line = LINE_START;
+        fieldLen = 0;
+    }
+
+    static bool isSpace(char c) { return c == ' ' || c == '\t'; }
+
+    bool keyIs(const char* name) const {
+        size_t n = strlen(name);
+        return keyLen == n && memcmp(key, name, n) == 0;
+    }
+
+    void json(char c) {
+        if (inString) {
+            stringChar(c);
+            return;
+        }
+
+        if (isSpace(c)) return;
+
+        if (c == ':' && stringMayBeKey) {
+            memcpy(key, lastString, lastStringLen);
+            keyLen = lastStringLen;
+            awaitingValue = true;
+            stringMayBeKey = false;
+            if (keyIs("error")) errorSeen = true;
+            return;
+        }
+        stringMayBeKey = false;
+
+        if (c == '"') {
+            inString = true;
+            lastStringLen = 0;
+            valueLen = 0;
+            target = TARGET_NONE;
+            if (awaitingValue) {
+                if (keyIs("text")) target = TARGET_TEXT;
+                else if (keyIs("finishReason")) target = TARGET_FINISH;
+                else if (keyIs("message") && errorSeen) target = TARGET_ERROR;
+            }
+            awaitingValue = false;
+            return;
+        }
+
+        // Any other token (number, object, array, comma) ends the key/value
+        awaitingValue = false;
+    }
+
+    void stringChar(char c) {
+        if (unicodeDigits > 0) {
+            unicode = (unicode << 4) | hexValue(c);
+            if (--unicodeDigits == 0) codePoint(unicode);
+            return;
+        }
+
+        if (escaped) {
+            escaped = false;
+            switch (c) {
+                case 'n': put('\n'); break;
+                case 't': put('\t'); break;
+                case 'r': put('\r'); break;
+                case 'b': put('\b'); break;
+                case 'f': put('\f'); break;
+                case 'u': unicodeDigits = 4; unicode = 0; break;
+                default:  put(c); break;  // \" \\ \/
+            }
+            return;
+        }
+
+        if (c == '\\') {
+            escaped = true;
+        } else if (c == '"') {
+            endString();
+        } else {
+            put(c);
+        }
+    }
+
+    void endString() {
+        inString = false;
+        highSurrogate = 0;
+
+        if (target == TARGET_TEXT) {
+            // Each part goes out as soon as it is complete
+            flush();
+        } else if (target == TARGET_FINISH) {
+            finishReason[valueLen < sizeof(finishReason) ? valueLen : sizeof(finishReason) - 1] = '\0';
+        } else if (target == TARGET_ERROR) {
+            errorMessage[valueLen < sizeof(errorMessage) ? valueLen : sizeof(errorMessage) - 1] = '\0';
+        }
+
+        stringMayBeKey = target == TARGET_NONE;
+        target = TARGET_NONE;
+    }
+
+    // One decoded byte of the current string
+    void put(char c) {
+        switch (target) {
+            case TARGET_TEXT:
+                // Flush only before a character's first byte so UTF-8 is never split
+                if (fragmentLen >= GEMINI_STREAM_FRAGMENT && ((unsigned char)c & 0xC0) != 0x80) {
+                    flush();
+                }
+                fragment[fragmentLen++] = c;
+                textBytes++;
+                break;
+            case TARGET_FINISH:
+                if (valueLen < sizeof(finishReason) - 1) finishReason[valueLen] = c;
+                valueLen++;
+                break;
+            case TARGET_ERROR:
+                if (valueLen < sizeof(errorMessage) - 1) errorMessage[valueLen] = c;
+                valueLen++;
+                break;
+            case TARGET_NONE:
+                // Longer strings are cut; they never equal a key we look for
+                if (lastStringLen < sizeof(lastString)) lastString[lastStringLen++] = c;
+                break;
+        }
+    }
+
+    // \uXXXX to UTF-8, joining surrogate pairs
+    void codePoint(uint32_t cp) {
+        if (cp >= 0xD800 && cp <= 0xDBFF) {
+            highSurrogate = cp;
+            return;
+        }
+        if (cp >= 0xDC00 && cp <= 0xDFFF) {
+            if (highSurrogate == 0) return;  // Lone low surrogate: drop it
+            cp = 0x10000 + ((highSurrogate - 0xD800) << 10) + (cp - 0xDC00);
+        }
+        highSurrogate = 0;
+
+        if (cp < 0x80) {
+            put((char)cp);
+        } else if (cp < 0x800) {
+            put((char)(0xC0 | (cp >> 6)));
+            put((char)(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            put((char)(0xE0 | (cp >> 12)));
+            put((char)(0x80 | ((cp >> 6) & 0x3F)));
+            put((char)(0x80 | (cp & 0x3F)));
+        } else {
+            put((char)(0xF0 | (cp >> 18)));
+            put((char)(0x80 | ((cp >> 12) & 0x3F)));
+            put((char)(0x80 | ((cp >> 6) & 0x3F)));
+            put((char)(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    static uint32_t hexValue(char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return 0;
+    }
+};
+
+#endif // GEMINI_STREAM_H
@@ -0,0 +1,382 @@
+#ifndef INDICATORS_H
+#define INDICATORS_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Sampling
+#define INDICATOR_SAMPLE_MS 60000       // At most one price sample per minute
+
+// Periods (in samples)
+#define INDICATOR_EMA_FAST 12
+#define INDICATOR_EMA_SLOW 26
+#define INDICATOR_MACD_SIGNAL 9
+#define INDICATOR_RSI_PERIOD 14
+#define INDICATOR_BB_PERIOD 20
+#define INDICATOR_VOL_LAMBDA_PCT 94     // EWMA decay of squared returns (RiskMetrics)
+
+// Local signal and AI trigger thresholds
+#define INDICATOR_RSI_OVERSOLD 30
+#define INDICATOR_RSI_OVERBOUGHT 70
+#define INDICATOR_MACD_DEADBAND_PPM 200  // |histogram| under 0.02% of price counts as flat
+#define INDICATOR_VOL_ALERT_PPM 10000    // Hourly volatility of 1% is a volatility event
+#define INDICATOR_VOL_REARM_PCT 80       // ...re-armed once it drops below 80% of that
+
+// Fixed point: prices are integer cents, averages carry 16 fractional bits
+#define INDICATOR_FRAC_BITS 16
+
+// Why an AI call is worth making (bits returned by add() / peekEvents())
+#define INDICATOR_EVENT_SIGNAL 0x01     // Local signal changed
+#define INDICATOR_EVENT_RSI 0x02        // RSI crossed the oversold or overbought line
+#define INDICATOR_EVENT_MACD 0x04       // MACD crossed its signal line (beyond the dead band)
+#define INDICATOR_EVENT_VOLATILITY 0x08 // Hourly volatility rose through the alert level
+
+enum LocalSignal {
+    LOCAL_SIGNAL_NONE = 0,  // Not enough samples yet
+    LOCAL_SIGNAL_BUY,
+    LOCAL_SIGNAL_SELL,
+    LOCAL_SIGNAL_HOLD
+};
+
+// Floor of the square root, fixed 32 iterations
+inline uint64_t isqrt64(uint64_t n) {
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > n) bit >>= 2;
+    while (bit != 0) {
+        if (n >= root + bit) {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+/**
+ * FixedEma - Exponential moving average in Q16 fixed point
+ *
+ * Seeded with the simple average of the first period samples, then
+ * ema += (x - ema) * 2 / (period + 1), as most charting tools do.
+ */
+class FixedEma {
+public:
+    explicit FixedEma(uint16_t period) : n(period) { reset(); }
+
+    void reset() {
+        value = 0;
+        count = 0;
+    }
+
+    void add(int64_t xq) {
+        if (count < n) {
+            // Running mean until the seed is complete
+            count++;
+            value += (xq - value) / (int64_t)count;
+            return;
+        }
+        value += (xq - value) * 2 / (int64_t)(n + 1);
+    }
+
+    bool ready() const { return count >= n; }
+    int64_t get() const { return value; }
+
+private:
+    uint16_t n;
+    uint16_t count;
+    int64_t value;
+};
+
+/**
+ * IndicatorEngine - EMA, RSI, MACD, Bollinger width and volatility on device
+ *
+ * Fed with every price the fetch worker sees; one sample is taken per
+ * INDICATOR_SAMPLE_MS and each sample updates every indicator in O(1):
+ * running EMAs, Wilder-smoothed RSI, a 20-sample ring with running sum and
+ * sum of squares for the bands, and an EWMA of squared returns. Everything is
+ * integer arithmetic (cents, Q16, ppm), so results do not depend on float
+ * rounding and the ESP32 never touches its slow double-precision path.
+ *
+ * The indicators give a local BUY/SELL/HOLD signal and a set of events
+ * (threshold crossings). The fetch worker only asks the AI when an event is
+ * pending, instead of on every AI interval.
+ *
+ * The caller passes the clock in; samples closer than INDICATOR_SAMPLE_MS
+ * to the last one are ignored.
+ */
+class IndicatorEngine {
+public:
+    IndicatorEngine()
+        : emaFast(INDICATOR_EMA_FAST), emaSlow(INDICATOR_EMA_SLOW), macdSignal(INDICATOR_MACD_SIGNAL) {
+        reset();
+    }
+
+    void reset() {
+        emaFast.reset();
+        emaSlow.reset();
+        macdSignal.reset();
+        samples = 0;
+        lastSampleMs = 0;
+        lastPrice = 0;
+        avgGain = 0;
+        avgLoss = 0;
+        rsiCount = 0;
+        memset(window, 0, sizeof(window));
+        windowSum = 0;
+        windowSumSq = 0;
+        windowCount = 0;
+        windowPos = 0;
+        variancePpm2 = 0;
+        lastSignal = LOCAL_SIGNAL_NONE;
+        rsiZone = 0;
+        macdSide = 0;
+        volAlert = false;
+        events = 0;
+    }
+
+    /**
+     * Offer a price; it becomes a sample if INDICATOR_SAMPLE_MS has passed
+     * since the last one. Returns true when a sample was taken.
+     */
+    bool update(float priceUSD, uint32_t nowMs) {
+        if (!(priceUSD > 0.0f)) return false;
+        if (samples > 0 && nowMs - lastSampleMs < INDICATOR_SAMPLE_MS) return false;
+
+        lastSampleMs = nowMs;
+        add((int32_t)(priceUSD * 100.0f + 0.5f));
+        return true;
+    }
+
+    // Take one sample (price in cents). Returns the events it raised.
+    uint8_t add(int32_t priceCents) {
+        if (priceCents <= 0) return 0;
+        int64_t xq = (int64_t)priceCents << INDICATOR_FRAC_BITS;
+
+        // EMAs and MACD; the signal line starts once the slow EMA is seeded
+        emaFast.add(xq);
+        emaSlow.add(xq);
+        if (emaSlow.ready()) macdSignal.add(emaFast.get() - emaSlow.get());
+
+        if (samples > 0) {
+            addChange(priceCents - lastPrice);
+            addReturn(priceCents);
+        }
+        addToWindow(priceCents);
+
+        lastPrice = priceCents;
+        samples++;
+
+        uint8_t raised = detectEvents();
+        events |= raised;
+        return raised;
+    }
+
+    uint32_t getSamples() const { return samples; }
+    int32_t getPriceCents() const { return lastPrice; }
+
+    // All indicators have enough history for the local signal
+    bool ready() const { return macdSignal.ready() && rsiReady(); }
+
+    // Moving averages in cents (Q16 internally)
+    int32_t emaFastCents() const { return (int32_t)(emaFast.get() >> INDICATOR_FRAC_BITS); }
+    int32_t emaSlowCents() const { return (int32_t)(emaSlow.get() >> INDICATOR_FRAC_BITS); }
+
+    // MACD line, signal line and histogram in Q16 cents
+    int64_t macdQ() const { return emaFast.get() - emaSlow.get(); }
+    int64_t macdSignalQ() const { return macdSignal.get(); }
+    int64_t macdHistogramQ() const { return macdQ() - macdSignal.get(); }
+
+    // Histogram relative to price, parts per million
+    int32_t macdHistogramPpm() const {
+        if (lastPrice <= 0) return 0;
+        return (int32_t)(macdHistogramQ() * 1000000 / ((int64_t)lastPrice << INDICATOR_FRAC_BITS));
+    }
+
+    // RSI in hundredths (0-10000); -1 until INDICATOR_RSI_PERIOD changes are in
+    int32_t rsiX100() const {
+        if (!rsiReady()) return -1;
+        if (avgGain + avgLoss == 0) return 5000;
+        return (int32_t)(avgGain * 10000 / (avgGain + avgLoss));
+    }
+
+    // (upper - lower) / middle for 2 standard deviations, ppm; 0 until the window is full
+    uint32_t bandWidthPpm() const {
+        if (windowCount < INDICATOR_BB_PERIOD || windowSum <= 0) return 0;
+        // n^2 * variance, exact in integers
+        int64_t n = INDICATOR_BB_PERIOD;
+        int64_t scaledVar = n * windowSumSq - windowSum * windowSum;
+        if (scaledVar < 0) scaledVar = 0;
+        uint64_t nSd = isqrt64((uint64_t)scaledVar);
+        return (uint32_t)(4000000ULL * nSd / (uint64_t)windowSum);
+    }
+
+    // Standard deviation of one sample's return, ppm (EWMA)
+    uint32_t volatilityPpm() const { return (uint32_t)isqrt64(variancePpm2); }
+
+    // Same scaled to an hour of samples
+    uint32_t hourlyVolatilityPpm() const {
+        return (uint32_t)isqrt64(variancePpm2 * (3600000ULL / INDICATOR_SAMPLE_MS));
+    }
+
+    /**
+     * Local signal from RSI and MACD:
+     *   RSI at or below 30 -> BUY (oversold), at or above 70 -> SELL
+     *   otherwise the MACD histogram beyond the dead band -> BUY / SELL
+     *   otherwise HOLD
+     */
+    LocalSignal signal() const {
+        if (!ready()) return LOCAL_SIGNAL_NONE;
+        int32_t rsi = rsiX100();
+        if (rsi <= INDICATOR_RSI_OVERSOLD * 100) return LOCAL_SIGNAL_BUY;
+        if (rsi >= INDICATOR_RSI_OVERBOUGHT * 100) return LOCAL_SIGNAL_SELL;
+
+        int32_t hist = macdHistogramPpm();
+        if (hist > INDICATOR_MACD_DEADBAND_PPM) return LOCAL_SIGNAL_BUY;
+        if (hist < -INDICATOR_MACD_DEADBAND_PPM) return LOCAL_SIGNAL_SELL;
+        return LOCAL_SIGNAL_HOLD;
+    }
+
+    // 0-100: how far past its threshold the deciding indicator is
+    uint8_t confidence() const {
+        LocalSignal s = signal();
+        if (s == LOCAL_SIGNAL_NONE) return 0;
+
+        int32_t rsi = rsiX100();
+        int32_t beyond = -1;
+        if (rsi <= INDICATOR_RSI_OVERSOLD * 100) beyond = INDICATOR_RSI_OVERSOLD * 100 - rsi;
+        if (rsi >= INDICATOR_RSI_OVERBOUGHT * 100) beyond = rsi - INDICATOR_RSI_OVERBOUGHT * 100;
+        if (beyond >= 0) {
+            // 60% at the line, +2% per RSI point beyond it
+            int32_t c = 60 + beyond / 50;
+            return (uint8_t)(c > 95 ? 95 : c);
+        }
+
+        if (s == LOCAL_SIGNAL_HOLD) return 50;
+
+        // 40% at the dead band, +10% per dead band width beyond it
+        int32_t hist = macdHistogramPpm();
+        if (hist < 0) hist = -hist;
+        int32_t c = 40 + (hist - INDICATOR_MACD_DEADBAND_PPM) * 10 / INDICATOR_MACD_DEADBAND_PPM;
+        return (uint8_t)(c > 80 ? 80 : c);
+    }
+
+    // Events raised since the last clearEvents()
+    uint8_t peekEvents() const { return events; }
+    void clearEvents() { events = 0; }
+
+    static const char* signalName(LocalSignal s) {
+        switch (s) {
+            case LOCAL_SIGNAL_BUY:  return "BUY";
+            case LOCAL_SIGNAL_SELL: return "SELL";
+            case LOCAL_SIGNAL_HOLD: return "HOLD";
+            default:                return "";
+        }
+    }
+
+private:
+    FixedEma emaFast;
+    FixedEma emaSlow;
+    FixedEma macdSignal;
+    uint32_t samples;
+    uint32_t lastSampleMs;
+    int32_t lastPrice;
+
+    // RSI (Wilder): seeded with plain averages of the first period changes
+    int64_t avgGain;   // Q16 cents
+    int64_t avgLoss;
+    uint16_t rsiCount;
+
+    // Bollinger window
+    int32_t window[INDICATOR_BB_PERIOD];
+    int64_t windowSum;
+    int64_t windowSumSq;
+    uint16_t windowCount;
+    uint16_t windowPos;
+
+    // EWMA variance of returns, ppm^2
+    uint64_t variancePpm2;
+
+    // Event detection state
+    LocalSignal lastSignal;
+    int8_t rsiZone;    // -1 oversold, 0 neutral, +1 overbought
+    int8_t macdSide;   // Last side the histogram left the dead band on
+    bool volAlert;
+    uint8_t events;
+
+    bool rsiReady() const { return rsiCount >= INDICATOR_RSI_PERIOD; }
+
+    void addChange(int32_t change) {
+        int64_t gain = change > 0 ? ((int64_t)change << INDICATOR_FRAC_BITS) : 0;
+        int64_t loss = change < 0 ? ((int64_t)-change << INDICATOR_FRAC_BITS) : 0;
+
+        if (rsiCount < INDICATOR_RSI_PERIOD) {
+            rsiCount++;
+            avgGain += (gain - avgGain) / rsiCount;
+            avgLoss += (loss - avgLoss) / rsiCount;
+            return;
+        }
+        avgGain = (avgGain * (INDICATOR_RSI_PERIOD - 1) + gain) / INDICATOR_RSI_PERIOD;
+        avgLoss = (avgLoss * (INDICATOR_RSI_PERIOD - 1) + loss) / INDICATOR_RSI_PERIOD;
+    }
+
+    void addReturn(int32_t priceCents) {
+        int64_t r = (int64_t)(priceCents - lastPrice) * 1000000 / lastPrice;
+        uint64_t r2 = (uint64_t)(r * r);
+        if (samples == 1) {
+            variancePpm2 = r2;
+        } else {
+            variancePpm2 = (variancePpm2 * INDICATOR_VOL_LAMBDA_PCT + r2 * (100 - INDICATOR_VOL_LAMBDA_PCT)) / 100;
+        }
+    }
+
+    void addToWindow(int32_t priceCents) {
+        if (windowCount == INDICATOR_BB_PERIOD) {
+            int64_t old = window[windowPos];
+            windowSum -= old;
+            windowSumSq -= old * old;
+        } else {
+            windowCount++;
+        }
+        window[windowPos] = priceCents;
+        windowSum += priceCents;
+        windowSumSq += (int64_t)priceCents * priceCents;
+        windowPos = (uint16_t)((windowPos + 1) % INDICATOR_BB_PERIOD);
+    }
+
+    uint8_t detectEvents() {
+        uint8_t raised = 0;
+
+        LocalSignal s = signal();
+        if (s != lastSignal && lastSignal != LOCAL_SIGNAL_NONE) raised |= INDICATOR_EVENT_SIGNAL;
+        lastSignal = s;
+
+        if (rsiReady()) {
+            int32_t rsi = rsiX100();
+            int8_t zone = rsi <= INDICATOR_RSI_OVERSOLD * 100 ? -1 : rsi >= INDICATOR_RSI_OVERBOUGHT * 100 ? 1 : 0;
+            if (zone != rsiZone) raised |= INDICATOR_EVENT_RSI;
+            rsiZone = zone;
+        }
+
+        if (macdSignal.ready()) {
+            int32_t hist = macdHistogramPpm();
+            int8_t side = hist > INDICATOR_MACD_DEADBAND_PPM ? 1 : hist < -INDICATOR_MACD_DEADBAND_PPM ? -1 : 0;
+            if (side != 0 && side != macdSide) {
+                if (macdSide != 0) raised |= INDICATOR_EVENT_MACD;
+                macdSide = side;
+            }
+        }
+
+        uint32_t vol = hourlyVolatilityPpm();
+        if (!volAlert && samples > INDICATOR_RSI_PERIOD && vol >= INDICATOR_VOL_ALERT_PPM) {
+            volAlert = true;
+            raised |= INDICATOR_EVENT_VOLATILITY;
+        } else if (volAlert && vol < (uint32_t)INDICATOR_VOL_ALERT_PPM * INDICATOR_VOL_REARM_PCT / 100) {
+            volAlert = false;
+        }
+        return raised;
+    }
+};
+
+#endif // INDICATORS_H
@@ -0,0 +1,171 @@
+#ifndef JSON_BODY_WRITER_H
+#define JSON_BODY_WRITER_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+
+/**
+ * JsonBodyWriter - Builds a JSON request body in a caller-owned buffer
+ *
+ * The fixed parts of a body are written verbatim with raw()/rawf(); string
+ * values (prompts) go through text()/textf(), which escape as they write.
+ * textf() formats straight into the buffer and escapes in place, so there is
+ * no intermediate String, JsonDocument or chunk buffer: building a request
+ * makes no heap allocations at all.
+ *
+ * Overflow is sticky: once something does not fit, ok() stays false and the
+ * body must not be sent.
+ */
+class JsonBodyWriter {
+public:
+    JsonBodyWriter(char* buffer, size_t capacity)
+        : buf(buffer), cap(capacity) {
+        reset();
+    }
+
+    void reset() {
+        len = 0;
+        overflow = cap == 0;
+        if (cap > 0) buf[0] = '\0';
+    }
+
+    // Verbatim JSON fragment
+    JsonBodyWriter& raw(const char* fragment) {
+        append(fragment, strlen(fragment));
+        return *this;
+    }
+
+    // Verbatim JSON fragment from a format (numbers in generationConfig etc.)
+    JsonBodyWriter& rawf(const char* format, ...) {
+        va_list args;
+        va_start(args, format);
+        formatAt(format, args);
+        va_end(args);
+        return *this;
+    }
+
+    // Escaped string content (the surrounding quotes come from raw())
+    JsonBodyWriter& text(const char* value) {
+        if (overflow || value == nullptr) return *this;
+
+        size_t n = strlen(value);
+        size_t extra = escapedExtra(value, n);
+        if (len + n + extra >= cap) {
+            overflow = true;
+            return *this;
+        }
+        memcpy(buf + len, value, n);
+        escapeInPlace(len, n, extra);
+        return *this;
+    }
+
+    // Escaped formatted string content
+    JsonBodyWriter& textf(const char* format, ...) {
+        if (overflow) return *this;
+
+        size_t start = len;
+        va_list args;
+        va_start(args, format);
+        formatAt(format, args);
+        va_end(args);
+        if (overflow) return *this;
+
+        size_t n = len - start;
+        size_t extra = escapedExtra(buf + start, n);
+        if (len + extra >= cap) {
+            overflow = true;
+            return *this;
+        }
+        len = start;
+        escapeInPlace(start, n, extra);
+        return *this;
+    }
+
+    bool ok() const { return !overflow; }
+    const char* c_str() const { return buf; }
+    size_t length() const { return len; }
+    size_t capacity() const { return cap; }
+
+private:
+    char* buf;
+    size_t cap;
+    size_t len;
+    bool overflow;
+
+    void append(const char* data, size_t n) {
+        if (overflow) return;
+        if (len + n >= cap) {
+            overflow = true;
+            return;
+        }
+        memcpy(buf + len, data, n);
+        len += n;
+        buf[len] = '\0';
+    }
+
+    void formatAt(const char* format, va_list args) {
+        if (overflow) return;
+        int n = vsnprintf(buf + len, cap - len, format, args);
+        if (n < 0 || len + (size_t)n >= cap) {
+            overflow = true;
+            buf[len] = '\0';
+            return;
+        }
+        len += (size_t)n;
+    }
+
+    // Bytes that escaping adds to n characters of s
+    static size_t escapedExtra(const char* s, size_t n) {
+        size_t extra = 0;
+        for (size_t i = 0; i < n; i++) {
+            unsigned char c = (unsigned char)s[i];
+            if (c == '"' || c == '\\' || c == '\n' || c == '\r' || c == '\t') {
+                extra += 1;
+            } else if (c < 0x20) {
+                extra += 5;  // \u00XX
+            }
+        }
+        return extra;
+    }
+
+    // Escape the n raw characters at start, growing them by extra bytes.
+    // Works from the back so nothing is overwritten before it is read.
+    void escapeInPlace(size_t start, size_t n, size_t extra) {
+        static const char HEX[] = "0123456789abcdef";
+        size_t src = start + n;
+        size_t dst = start + n + extra;
+        buf[dst] = '\0';
+
+        while (src > start) {
+            unsigned char c = (unsigned char)buf[--src];
+            char esc = 0;
+            switch (c) {
+                case '"':  esc = '"'; break;
+                case '\\': esc = '\\'; break;
+                case '\n': esc = 'n'; break;
+                case '\r': esc = 'r'; break;
+                case '\t': esc = 't'; break;
+                default: break;
+            }
+
+            if (esc) {
+                buf[--dst] = esc;
+                buf[--dst] = '\\';
+            } else if (c < 0x20) {
+                buf[--dst] = HEX[c & 0x0F];
+                buf[--dst] = HEX[c >> 4];
+                buf[--dst] = '0';
+                buf[--dst] = '0';
+                buf[--dst] = 'u';
+                buf[--dst] = '\\';
+            } else {
+                buf[--dst] = (char)c;
+            }
+        }
+        len = start + n + extra;
+    }
+};
+
+#endif // JSON_BODY_WRITER_H
@@ -0,0 +1,68 @@
+#ifndef MARKET_SIGNALS_H
+#define MARKET_SIGNALS_H
+
+#include <stdint.h>
+#include <string.h>
+#include <ArduinoJson.h>
+
+// Structured-output request settings (request body: writeMarketSignalsRequest in AIPrompts.h)
+#define SIGNALS_MAX_OUTPUT_TOKENS 64   // Reply is a ~30 token JSON object
+#define SIGNALS_TEMPERATURE 0.2        // Classification, not prose
+#define SIGNALS_DEFAULT_TIMEFRAME "15m-1h"
+
+// DCA recommendation, trading signal, timeframe and confidence from one request
+struct MarketSignals {
+    char dca[8];         // BUY / SELL / WAIT
+    char signal[8];      // BUY / SELL / HOLD
+    char timeframe[16];  // e.g. 15m-1h
+    uint8_t confidence;  // 0-100
+};
+
+// Copy value into out if it is one of the allowed words
+inline bool pickWord(const char* value, const char* const* allowed, size_t count,
+                     char* out, size_t outSize) {
+    if (value == nullptr) return false;
+    for (size_t i = 0; i < count; i++) {
+        if (strcmp(value, allowed[i]) == 0 && strlen(value) < outSize) {
+            strcpy(out, value);
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Parse the model's JSON reply (the text of the first candidate part).
+ * Both words must be valid; timeframe falls back to the default and
+ * confidence is clamped to 0-100.
+ */
+inline bool parseMarketSignals(const char* json, MarketSignals& out) {
+    static const char* const DCA_WORDS[] = {"BUY", "SELL", "WAIT"};
+    static const char* const SIGNAL_WORDS[] = {"BUY", "SELL", "HOLD"};
+
+    StaticJsonDocument<256> doc;
+    if (json == nullptr || deserializeJson(doc, json)) {
+        return false;
+    }
+
+    MarketSignals parsed;
+    memset(&parsed, 0, sizeof(parsed));
+    if (!pickWord(doc["dca"].as<const char*>(), DCA_WORDS, 3, parsed.dca, sizeof(parsed.dca)) ||
+        !pickWord(doc["signal"].as<const char*>(), SIGNAL_WORDS, 3, parsed.signal, sizeof(parsed.signal))) {
+        return false;
+    }
+
+    const char* timeframe = doc["timeframe"] | SIGNALS_DEFAULT_TIMEFRAME;
+    if (timeframe[0] == '\0' || strlen(timeframe) >= sizeof(parsed.timeframe)) {
+        timeframe = SIGNALS_DEFAULT_TIMEFRAME;
+    }
+    strcpy(parsed.timeframe, timeframe);
+
+    long confidence = doc["confidence"] | 0L;
+    parsed.confidence = (uint8_t)(confidence < 0 ? 0 : (confidence > 100 ? 100 : confidence));
+
+    out = parsed;
+    return true;
+}
+
+#endif // MARKET_SIGNALS_H
@@ -0,0 +1,429 @@
+#include "MempoolClient.h"
+#include "../network/HttpConnectionPool.h"
+#include "../network/EndpointHealth.h"
+#include "../utils/SDLogger.h"
+
+// Endpoints
+#define MEMPOOL_PATH_PRICES "/api/v1/prices"
+#define MEMPOOL_PATH_TIP_HEIGHT "/api/blocks/tip/height"
+#define MEMPOOL_PATH_FEES "/api/v1/fees/recommended"
+#define MEMPOOL_PATH_MEMPOOL "/api/mempool"
+#define MEMPOOL_PATH_BLOCK_HASH "/api/block-height/"  // + height, returns the hash
+#define MEMPOOL_PATH_BLOCK "/api/block/"              // + hash
+
+// Parsed values kept in the response cache
+struct CachedPrice {
+    float usd;
+    float eur;
+};
+
+struct CachedFees {
+    int fast;
+    int medium;
+    int slow;
+};
+
+static_assert(sizeof(MempoolStats) <= HTTP_CACHE_VALUE_SIZE, "MempoolStats must fit a cache entry");
+
+MempoolClient::MempoolClient() {
+    unchanged = false;
+    lastEtag[0] = '\0';
+    lastModified[0] = '\0';
+}
+
+HTTPClient* MempoolClient::beginConditional(const char* url) {
+    HTTPClient* http = httpPool.begin(url, MEMPOOL_TIMEOUT);
+    if (http == nullptr) {
+        return nullptr;
+    }
+
+    const char* headerKeys[] = {"ETag", "Last-Modified", "Transfer-Encoding"};
+    http->collectHeaders(headerKeys, 3);
+
+    const HttpCacheEntry* entry = cache.lookup(url);
+    if (entry != nullptr) {
+        if (entry->etag[0] != '\0') {
+            http->addHeader("If-None-Match", entry->etag);
+        }
+        if (entry->lastModified[0] != '\0') {
+            http->addHeader("If-Modified-Since", entry->lastModified);
+        }
+    }
+
+    lastEtag[0] = '\0';
+    lastModified[0] = '\0';
+    return http;
+}
+
+void MempoolClient::readValidators(HTTPClient* http) {
+    String etag = http->header("ETag");
+    String modified = http->header("Last-Modified");
+
+    // Over-long values are left empty so the cache never sends a truncated validator
+    if (etag.length() < sizeof(lastEtag)) {
+        strcpy(lastEtag, etag.c_str());
+    }
+    if (modified.length() < sizeof(lastModified)) {
+        strcpy(lastModified, modified.c_str());
+    }
+}
+
+int MempoolClient::get(const char* path, String& payload) {
+    char url[128];
+    snprintf(url, sizeof(url), "%s%s", MEMPOOL_BASE_URL, path);
+
+    if (!endpointHealth.allow(ENDPOINT_MEMPOOL)) {
+        return HTTPC_ERROR_CIRCUIT_OPEN;
+    }
+
+    HTTPClient* http = beginConditional(url);
+    if (http == nullptr) {
+        return HTTPC_ERROR_CONNECTION_REFUSED;
+    }
+
+    unsigned long startTime = millis();
+    int httpCode = http->GET();
+    if (httpCode == HTTP_CODE_OK) {
+        readValidators(http);
+    }
+    if (httpCode > 0 && httpCode != HTTP_CODE_NOT_MODIFIED) {
+        // Always drain the body, otherwise the connection cannot be reused.
+        // A 304 has no body; reading it would wait for the timeout.
+        payload = http->getString();
+    }
+    endpointHealth.record(ENDPOINT_MEMPOOL, httpCode, millis() - startTime);
+
+    httpPool.end(http, httpCode);
+    return httpCode;
+}
+
+void MempoolClient::remember(const char* path, const void* value, size_t size) {
+    char url[128];
+    snprintf(url, sizeof(url), "%s%s", MEMPOOL_BASE_URL, path);
+    cache.store(url, lastEtag, lastModified, value, size, millis());
+    logHitRate();
+}
+
+bool MempoolClient::recall(const char* path, void* value, size_t size) {
+    char url[128];
+    snprintf(url, sizeof(url), "%s%s", MEMPOOL_BASE_URL, path);
+    bool found = cache.notModified(url, value, size, millis());
+    if (found) {
+        logHitRate();
+    }
+    return found;
+}
+
+void MempoolClient::logHitRate() {
+    if (cache.getResponses() % HTTP_CACHE_LOG_EVERY == 0) {
+        sdLogger.logf(LOG_INFO, "HTTP cache: %u%% hit rate (%u not modified, %u full responses)",
+                     cache.hitRate(), cache.getHits(), cache.getMisses());
+    }
+}
+
+bool MempoolClient::fetchPrice(BTCData& data) {
+    unchanged = false;
+    if (WiFi.status() != WL_CONNECTED) {
+        Serial.println("❌ Price fetch: WiFi not connected");
+        return false;
+    }
+
+    Serial.println("📡 Fetching BTC price...");
+    String payload;
+    int httpCode = get(MEMPOOL_PATH_PRICES, payload);
+    Serial.printf("HTTP code: %d\n", httpCode);
+
+    CachedPrice price;
+    if (httpCode == HTTP_CODE_NOT_MODIFIED && recall(MEMPOOL_PATH_PRICES, &price, sizeof(price))) {
+        data.priceUSD = price.usd;
+        data.priceEUR = price.eur;
+        unchanged = true;
+        Serial.println("✓ Price not modified (cached)");
+        return true;
+    }
+
+    if (httpCode == 200) {
+        Serial.printf("Price payload: %s\n", payload.c_str());
+
+        StaticJsonDocument<256> doc;
+        DeserializationError error = deserializeJson(doc, payload);
+
+        if (!error) {
+            data.priceUSD = doc["USD"];
+            data.priceEUR = doc["EUR"];
+            Serial.printf("✓ Price: USD $%.2f, EUR €%.2f\n", data.priceUSD, data.priceEUR);
+
+            price.usd = data.priceUSD;
+            price.eur = data.priceEUR;
+            remember(MEMPOOL_PATH_PRICES, &price, sizeof(price));
+            return true;
+        } else {
+            Serial.printf("❌ JSON parse error: %s\n", error.c_str());
+        }
+    }
+
+    return false;
+}
+
+bool MempoolClient::fetchBlockHeight(BTCData& data) {
+    unchanged = false;
+    if (WiFi.status() != WL_CONNECTED) {
+        Serial.println("❌ Block fetch: WiFi not connected");
+        return false;
+    }
+
+    // Use tip/height endpoint instead - much smaller response
+    Serial.println("📡 Fetching block height...");
+    String payload;
+    int httpCode = get(MEMPOOL_PATH_TIP_HEIGHT, payload);
+    Serial.printf("HTTP code: %d\n", httpCode);
+
+    unsigned long height = 0;
+    if (httpCode == HTTP_CODE_NOT_MODIFIED && recall(MEMPOOL_PATH_TIP_HEIGHT, &height, sizeof(height))) {
+        unchanged = true;
+        Serial.println("✓ Block height not modified (cached)");
+    } else if (httpCode == 200) {
+        Serial.printf("Block height payload: %s\n", payload.c_str());
+
+        // Response is just a number
+        height = payload.toInt();
+        remember(MEMPOOL_PATH_TIP_HEIGHT, &height, sizeof(height));
+    } else {
+        return false;
+    }
+
+    if (height != data.blockHeight) {
+        // Details of the previous tip no longer apply
+        data.blockHash[0] = '\0';
+        data.blockTime = 0;
+        data.blockTxCount = 0;
+        data.blockSize = 0;
+    }
+    data.blockHeight = height;
+    Serial.printf("✓ Block height: %lu\n", data.blockHeight);
+
+    // Details are fetched once per new tip (or again if the last attempt failed)
+    if (data.blockHash[0] == '\0' && fetchBlockDetails(data)) {
+        unchanged = false;
+    }
+    return true;
+}
+
+bool MempoolClient::fetchBlockDetails(BTCData& data) {
+    char path[48];
+    snprintf(path, sizeof(path), MEMPOOL_PATH_BLOCK_HASH "%lu", data.blockHeight);
+
+    String hash;
+    int httpCode = get(path, hash);
+    hash.trim();
+    if (httpCode != 200 || hash.length() != BLOCK_HASH_LEN) {
+        Serial.printf("❌ Block hash fetch failed: HTTP %d\n", httpCode);
+        return false;
+    }
+
+    BlockInfo info;
+    httpCode = getBlockInfo(hash.c_str(), info);
+    if (httpCode != 200) {
+        Serial.printf("❌ Block details fetch failed: HTTP %d\n", httpCode);
+        return false;
+    }
+    if (info.height != data.blockHeight) {
+        Serial.printf("⚠️  Block details for %u, expected %lu\n", info.height, data.blockHeight);
+        return false;
+    }
+
+    memcpy(data.blockHash, info.hash, sizeof(data.blockHash));
+    data.blockTime = info.timestamp;
+    data.blockTxCount = info.txCount;
+    data.blockSize = info.size;
+    Serial.printf("✓ Block %lu: %u TX, %u bytes, %.16s...\n",
+                 data.blockHeight, info.txCount, info.size, info.hash);
+    return true;
+}
+
+int MempoolClient::getBlockInfo(const char* hash, BlockInfo& info) {
+    char url[128];
+    snprintf(url, sizeof(url), "%s%s%s", MEMPOOL_BASE_URL, MEMPOOL_PATH_BLOCK, hash);
+
+    if (!endpointHealth.allow(ENDPOINT_MEMPOOL)) {
+        return HTTPC_ERROR_CIRCUIT_OPEN;
+    }
+
+    // Blocks are immutable, so no conditional headers
+    HTTPClient* http = httpPool.begin(url, MEMPOOL_TIMEOUT);
+    if (http == nullptr) {
+        return HTTPC_ERROR_CONNECTION_REFUSED;
+    }
+
+    const char* headerKeys[] = {"Transfer-Encoding"};
+    http->collectHeaders(headerKeys, 1);
+
+    unsigned long startTime = millis();
+    int httpCode = http->GET();
+    if (httpCode == 200) {
+        bool chunked = http->header("Transfer-Encoding").equalsIgnoreCase("chunked");
+        HttpBodyReader<WiFiClient> reader(*http->getStreamPtr(), chunked, http->getSize());
+        DeserializationError error = parseBlockInfo(reader, info);
+
+        if (error || reader.failed()) {
+            Serial.printf("❌ Block parse error: %s\n", error ? error.c_str() : "truncated body");
+            httpCode = HTTPC_ERROR_READ_TIMEOUT;  // Connection state unknown, don't reuse
+        }
+    } else if (httpCode > 0) {
+        http->getString();  // Drain error body so the connection can be reused
+    }
+    endpointHealth.record(ENDPOINT_MEMPOOL, httpCode, millis() - startTime);
+
+    httpPool.end(http, httpCode);
+    return httpCode;
+}
+
+bool MempoolClient::fetchMempool(BTCData& data) {
+    unchanged = false;
+    if (WiFi.status() != WL_CONNECTED) {
+        Serial.println("❌ Mempool fetch: WiFi not connected");
+        return false;
+    }
+
+    // Fetch fee rates (small payload)
+    Serial.println("📡 Fetching fee rates...");
+    String payload;
+    int httpCode = get(MEMPOOL_PATH_FEES, payload);
+    Serial.printf("Fees HTTP code: %d\n", httpCode);
+
+    CachedFees fees;
+    bool feesOk = false;
+    bool feesUnchanged = false;
+    if (httpCode == HTTP_CODE_NOT_MODIFIED && recall(MEMPOOL_PATH_FEES, &fees, sizeof(fees))) {
+        data.feeFast = fees.fast;
+        data.feeMedium = fees.medium;
+        data.feeSlow = fees.slow;
+        feesOk = true;
+        feesUnchanged = true;
+        Serial.println("✓ Fees not modified (cached)");
+    } else if (httpCode == 200) {
+        Serial.printf("Fees payload: %s\n", payload.c_str());
+
+        StaticJsonDocument<256> doc;
+        DeserializationError error = deserializeJson(doc, payload);
+
+        if (!error) {
+            data.feeFast = doc["fastestFee"];
+            data.feeMedium = doc["halfHourFee"];
+            data.feeSlow = doc["hourFee"];
+            Serial.printf("✓ Fees: fast=%d, medium=%d, slow=%d sat/vB\n",
+                         data.feeFast, data.feeMedium, data.feeSlow);
+
+            fees.fast = data.feeFast;
+            fees.medium = data.feeMedium;
+            fees.slow = data.feeSlow;
+            remember(MEMPOOL_PATH_FEES, &fees, sizeof(fees));
+            feesOk = true;
+        } else {
+            Serial.printf("❌ Fees JSON parse error: %s\n", error.c_str());
+        }
+    }
+
+    // Stream /api/mempool through the filtered parser; the fee_histogram is
+    // binned on the fly instead of being buffered
+    Serial.println("📡 Fetching mempool stats...");
+    MempoolStats stats = {};
+    httpCode = getMempoolStats(stats);
+    Serial.printf("Mempool HTTP code: %d\n", httpCode);
+
+    bool statsUnchanged = false;
+    if (httpCode == HTTP_CODE_NOT_MODIFIED && recall(MEMPOOL_PATH_MEMPOOL, &stats, sizeof(stats))) {
+        statsUnchanged = true;
+        Serial.println("✓ Mempool not modified (cached)");
+    } else if (httpCode == 200) {
+        remember(MEMPOOL_PATH_MEMPOOL, &stats, sizeof(stats));
+    } else {
+        return false;
+    }
+
+    data.mempoolCount = stats.count;
+    data.mempoolSize = stats.vsize / 1000000.0f;
+    data.mempoolTotalFee = stats.totalFee;
+    memcpy(data.feeHistogram, stats.feeHistogram, sizeof(data.feeHistogram));
+    Serial.printf("✓ Mempool: %lu TX, %.2f vMB, %.3f BTC fees, %u histogram entries\n",
+                 data.mempoolCount, data.mempoolSize,
+                 stats.totalFee / 100000000.0, stats.histogramEntries);
+
+    // Stats alone are not a successful run: the fees on screen would go stale unnoticed
+    if (!feesOk) {
+        Serial.println("❌ Fees not updated, mempool fetch counted as failed");
+        return false;
+    }
+
+    unchanged = feesUnchanged && statsUnchanged;
+    return true;
+}
+
+int MempoolClient::getMempoolStats(MempoolStats& stats) {
+    char url[128];
+    snprintf(url, sizeof(url), "%s%s", MEMPOOL_BASE_URL, MEMPOOL_PATH_MEMPOOL);
+
+    if (!endpointHealth.allow(ENDPOINT_MEMPOOL)) {
+        return HTTPC_ERROR_CIRCUIT_OPEN;
+    }
+
+    HTTPClient* http = beginConditional(url);
+    if (http == nullptr) {
+        return HTTPC_ERROR_CONNECTION_REFUSED;
+    }
+
+    unsigned long startTime = millis();
+    int httpCode = http->GET();
+    if (httpCode == 200) {
+        readValidators(http);
+
+        // Decode the body ourselves instead of via getString()
+        bool chunked = http->header("Transfer-Encoding").equalsIgnoreCase("chunked");
+        WiFiClient* stream = http->getStreamPtr();
+
+        FeeHistogramTap tap;
+        HttpBodyReader<WiFiClient> reader(*stream, chunked, http->getSize(), &tap);
+        DeserializationError error = parseMempoolStats(reader, tap, stats);
+
+        if (error || reader.failed()) {
+            Serial.printf("❌ Mempool stream parse error: %s (%lu bytes read)\n",
+                         error ? error.c_str() : "truncated body",
+                         (unsigned long)reader.bytesRead());
+            httpCode = HTTPC_ERROR_READ_TIMEOUT;  // Connection state unknown, don't reuse
+        }
+    } else if (httpCode > 0 && httpCode != HTTP_CODE_NOT_MODIFIED) {
+        http->getString();  // Drain error body so the connection can be reused
+    }
+    endpointHealth.record(ENDPOINT_MEMPOOL, httpCode, millis() - startTime);
+
+    httpPool.end(http, httpCode);
+    return httpCode;
+}
+
+void MempoolClient::getCacheStatus(MempoolCacheStatus& status) const {
+    status.hitRate = cache.hitRate();
+    status.hits = cache.getHits();
+    status.misses = cache.getMisses();
+    status.endpoints = 0;
+
+    for (int i = 0; i < HttpResponseCache::capacity(); i++) {
+        const HttpCacheEntry& e = cache.entry(i);
+        if (!e.used) continue;
+
+        auto& out = status.endpoint[status.endpoints++];
+        snprintf(out.path, sizeof(out.path), "%s", e.url + strlen(MEMPOOL_BASE_URL));
+        out.hits = e.hits;
+        out.misses = e.misses;
+        out.validators = e.hasValidators() ? (e.etag[0] ? "etag" : "last-modified") : "no validators";
+    }
+}
+
+void MempoolClient::printCacheStatus(const MempoolCacheStatus& status) {
+    Serial.printf("HTTP Cache: %u%% hit rate (%u not modified, %u full)\n",
+                 status.hitRate, status.hits, status.misses);
+
+    for (int i = 0; i < status.endpoints; i++) {
+        Serial.printf("  %-26s 304=%u 200=%u %s\n", status.endpoint[i].path,
+                     status.endpoint[i].hits, status.endpoint[i].misses, status.endpoint[i].validators);
+    }
+}
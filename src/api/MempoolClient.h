@@ -0,0 +1,93 @@
+#ifndef MEMPOOL_CLIENT_H
+#define MEMPOOL_CLIENT_H
+
+#include <Arduino.h>
+#include <WiFi.h>
+#include <HTTPClient.h>
+#include <ArduinoJson.h>
+#include "BTCData.h"
+#include "MempoolStats.h"
+#include "BlockInfo.h"
+#include "../network/HttpResponseCache.h"
+
+// mempool.space API settings
+#ifndef MEMPOOL_BASE_URL
+#define MEMPOOL_BASE_URL "https://mempool.space"  // Override with -D to target a local stub
+#endif
+#define MEMPOOL_TIMEOUT 10000  // 10 seconds per request
+#define MEMPOOL_CACHE_PATH_LEN 40   // Endpoint path shown by STATUS
+
+// Conditional GET counters, copied out of the worker task for STATUS
+struct MempoolCacheStatus {
+    uint8_t hitRate;
+    uint32_t hits;
+    uint32_t misses;
+    uint8_t endpoints;
+    struct {
+        char path[MEMPOOL_CACHE_PATH_LEN];
+        uint32_t hits;
+        uint32_t misses;
+        const char* validators;
+    } endpoint[HTTP_CACHE_ENTRIES];
+};
+
+/**
+ * mempool.space REST client
+ *
+ * Fetches price, block and mempool data into a caller-owned BTCData.
+ * All calls block until the HTTP request completes, so they are only
+ * made from the background fetch worker (see network/FetchWorker.h).
+ * Requests share one keep-alive connection from the HTTP pool and are sent
+ * as conditional GETs; a 304 reuses the value parsed from the last full
+ * response and is reported through wasUnchanged().
+ */
+class MempoolClient {
+public:
+    MempoolClient();
+
+    // Fetch USD/EUR price (/api/v1/prices)
+    bool fetchPrice(BTCData& data);
+
+    // Fetch current tip height (/api/blocks/tip/height); when the tip moved,
+    // also its hash, time, tx count and size (/api/block/:hash)
+    bool fetchBlockHeight(BTCData& data);
+
+    // Fetch recommended fees and mempool count/vsize/total fee/fee histogram;
+    // false if either part failed (stats that did arrive are still written)
+    bool fetchMempool(BTCData& data);
+
+    // Last fetch was answered only with 304s (values came from the cache)
+    bool wasUnchanged() const { return unchanged; }
+
+    // Copy the conditional GET statistics (worker task) / print a copy (any task)
+    void getCacheStatus(MempoolCacheStatus& status) const;
+    static void printCacheStatus(const MempoolCacheStatus& status);
+
+private:
+    HttpResponseCache cache;
+    bool unchanged;
+
+    // Validators from the last 200 response, stored once its body is parsed
+    char lastEtag[HTTP_CACHE_VALIDATOR_LEN];
+    char lastModified[HTTP_CACHE_VALIDATOR_LEN];
+
+    // Conditional GET of MEMPOOL_BASE_URL + path; payload stays empty on 304
+    int get(const char* path, String& payload);
+
+    // Stream /api/mempool into stats without buffering the body
+    int getMempoolStats(MempoolStats& stats);
+
+    // Look up data.blockHeight's hash, then stream its header fields
+    bool fetchBlockDetails(BTCData& data);
+    int getBlockInfo(const char* hash, BlockInfo& info);
+
+    HTTPClient* beginConditional(const char* url);
+    void readValidators(HTTPClient* http);
+
+    // Cache the parsed value of a 200 response / restore it after a 304
+    void remember(const char* path, const void* value, size_t size);
+    bool recall(const char* path, void* value, size_t size);
+    void logHitRate();
+};
+
+#endif // MEMPOOL_CLIENT_H
@@ -0,0 +1,132 @@
+#ifndef MEMPOOL_SOCKET_MESSAGE_H
+#define MEMPOOL_SOCKET_MESSAGE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <ArduinoJson.h>
+
+// Subscription sent after every (re)connect
+#define MEMPOOL_WS_SUBSCRIBE "{\"action\":\"want\",\"data\":[\"blocks\",\"stats\"]}"
+#define MEMPOOL_WS_DOC_SIZE 4096  // Initial "blocks" list is the largest message kept
+
+// Which parts of a push message carried data
+#define PUSH_HAS_PRICE   0x01
+#define PUSH_HAS_BLOCK   0x02
+#define PUSH_HAS_MEMPOOL 0x04
+
+// Fields extracted from one mempool.space WebSocket message
+struct MempoolPush {
+    uint8_t flags;
+
+    // "conversions"
+    float priceUSD;
+    float priceEUR;
+
+    // "block" (new block) or newest entry of "blocks" (on subscribe)
+    uint32_t blockHeight;
+    char blockHash[65];
+    uint32_t blockTime;
+    int blockTxCount;
+    uint32_t blockSize;
+
+    // "mempoolInfo" + "fees"
+    uint32_t mempoolCount;
+    uint32_t mempoolVsize;
+    uint64_t mempoolTotalFee;  // sat (mempoolInfo reports BTC)
+    bool hasFees;
+    int feeFast;
+    int feeMedium;
+    int feeSlow;
+};
+
+inline void readPushBlock(JsonObjectConst block, MempoolPush& out) {
+    out.blockHeight = block["height"] | 0UL;
+    out.blockTime = block["timestamp"] | 0UL;
+    out.blockTxCount = block["tx_count"] | 0;
+    out.blockSize = block["size"] | 0UL;
+    strncpy(out.blockHash, block["id"] | "", sizeof(out.blockHash) - 1);
+    out.blockHash[sizeof(out.blockHash) - 1] = '\0';
+}
+
+/**
+ * Parse a mempool.space WebSocket text frame.
+ *
+ * Stats pushes carry a large "mempool-blocks"/"da" payload; the filter keeps
+ * only the fields the dashboard shows. Returns PUSH_HAS_* flags (0 if the
+ * message had nothing useful or did not parse).
+ */
+inline uint8_t parseMempoolSocketMessage(const char* payload, size_t length, MempoolPush& out) {
+    memset(&out, 0, sizeof(out));
+
+    StaticJsonDocument<512> filter;
+    filter["conversions"]["USD"] = true;
+    filter["conversions"]["EUR"] = true;
+    filter["block"]["height"] = true;
+    filter["block"]["id"] = true;
+    filter["block"]["timestamp"] = true;
+    filter["block"]["tx_count"] = true;
+    filter["block"]["size"] = true;
+    filter["blocks"][0]["height"] = true;
+    filter["blocks"][0]["id"] = true;
+    filter["blocks"][0]["timestamp"] = true;
+    filter["blocks"][0]["tx_count"] = true;
+    filter["blocks"][0]["size"] = true;
+    filter["mempoolInfo"]["size"] = true;
+    filter["mempoolInfo"]["bytes"] = true;
+    filter["mempoolInfo"]["total_fee"] = true;
+    filter["fees"]["fastestFee"] = true;
+    filter["fees"]["halfHourFee"] = true;
+    filter["fees"]["hourFee"] = true;
+
+    DynamicJsonDocument doc(MEMPOOL_WS_DOC_SIZE);
+    DeserializationError error = deserializeJson(doc, payload, length, DeserializationOption::Filter(filter));
+    if (error) {
+        return 0;
+    }
+
+    JsonObjectConst conversions = doc["conversions"];
+    if (!conversions.isNull() && conversions["USD"].is<float>()) {
+        out.priceUSD = conversions["USD"];
+        out.priceEUR = conversions["EUR"] | 0.0f;
+        out.flags |= PUSH_HAS_PRICE;
+    }
+
+    JsonObjectConst block = doc["block"];
+    if (!block.isNull() && block["height"].is<unsigned long>()) {
+        readPushBlock(block, out);
+        out.flags |= PUSH_HAS_BLOCK;
+    } else {
+        // Subscribe reply lists recent blocks; keep the tip
+        JsonArrayConst blocks = doc["blocks"];
+        unsigned long best = 0;
+        for (JsonObjectConst b : blocks) {
+            unsigned long height = b["height"] | 0UL;
+            if (height > best) {
+                best = height;
+                readPushBlock(b, out);
+                out.flags |= PUSH_HAS_BLOCK;
+            }
+        }
+    }
+
+    JsonObjectConst info = doc["mempoolInfo"];
+    if (!info.isNull() && info["size"].is<unsigned long>()) {
+        out.mempoolCount = info["size"];
+        out.mempoolVsize = info["bytes"] | 0UL;
+        out.mempoolTotalFee = (uint64_t)((info["total_fee"] | 0.0) * 100000000.0 + 0.5);
+        out.flags |= PUSH_HAS_MEMPOOL;
+    }
+
+    JsonObjectConst fees = doc["fees"];
+    if (!fees.isNull() && fees["fastestFee"].is<float>()) {
+        out.hasFees = true;
+        out.feeFast = fees["fastestFee"];
+        out.feeMedium = fees["halfHourFee"] | 0;
+        out.feeSlow = fees["hourFee"] | 0;
+        out.flags |= PUSH_HAS_MEMPOOL;
+    }
+
+    return out.flags;
+}
+
+#endif // MEMPOOL_SOCKET_MESSAGE_H
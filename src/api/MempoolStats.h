@@ -0,0 +1,328 @@
+#ifndef MEMPOOL_STATS_H
+#define MEMPOOL_STATS_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ArduinoJson.h>
+
+// Fee histogram downsampling
+#define MEMPOOL_FEE_BINS 8             // Fixed bins, see mempoolFeeBinFloor()
+#define MEMPOOL_BODY_CHUNK 256         // Bytes read from the socket at a time
+
+/**
+ * Lower bound (sat/vB) of each downsampled fee bin:
+ *   0-2, 2-4, 4-6, 6-10, 10-20, 20-50, 50-100, 100+
+ */
+inline float mempoolFeeBinFloor(int bin) {
+    static const float floors[MEMPOOL_FEE_BINS] = {0, 2, 4, 6, 10, 20, 50, 100};
+    return (bin >= 0 && bin < MEMPOOL_FEE_BINS) ? floors[bin] : 0;
+}
+
+inline int mempoolFeeBin(float feeRate) {
+    int bin = 0;
+    while (bin + 1 < MEMPOOL_FEE_BINS && feeRate >= mempoolFeeBinFloor(bin + 1)) {
+        bin++;
+    }
+    return bin;
+}
+
+// Result of parsing /api/mempool
+struct MempoolStats {
+    uint32_t count;                          // Unconfirmed transactions
+    uint32_t vsize;                          // Total virtual size (vB)
+    uint64_t totalFee;                       // Total fees (sat)
+    uint32_t feeHistogram[MEMPOOL_FEE_BINS]; // vB waiting in each fee bin
+    uint16_t histogramEntries;               // Raw [fee, vsize] pairs seen
+};
+
+/**
+ * FeeHistogramTap - Downsamples "fee_histogram" while the body streams past
+ *
+ * Sees every body byte once and keeps only the running bin totals plus a
+ * number buffer, so memory stays fixed no matter how many entries mempool.space
+ * returns. The ArduinoJson filter drops the histogram; this tap is what
+ * still gets the distribution out of it.
+ */
+class FeeHistogramTap {
+public:
+    FeeHistogramTap() { reset(); }
+
+    void reset() {
+        state = SCAN;
+        depth = 0;
+        inString = false;
+        escaped = false;
+        keyLen = 0;
+        numLen = 0;
+        pairIndex = 0;
+        pair[0] = pair[1] = 0;
+        entries = 0;
+        memset(bins, 0, sizeof(bins));
+    }
+
+    void feed(const char* data, size_t len) {
+        for (size_t i = 0; i < len; i++) {
+            feed(data[i]);
+        }
+    }
+
+    void feed(char c) {
+        switch (state) {
+            case SCAN:        scan(c); break;
+            case AFTER_KEY:   if (c == ':') state = AFTER_COLON;
+                              else if (!isSpace(c)) state = SCAN;
+                              break;
+            case AFTER_COLON: if (c == '[') state = IN_LIST;
+                              else if (!isSpace(c)) { state = SCAN; scan(c); }
+                              break;
+            case IN_LIST:     if (c == '[') { state = IN_PAIR; pairIndex = 0; numLen = 0; }
+                              else if (c == ']') state = DONE;
+                              break;
+            case IN_PAIR:     pairChar(c); break;
+            case DONE:        break;
+        }
+    }
+
+    bool found() const { return state == DONE; }
+    uint16_t getEntries() const { return entries; }
+    const uint32_t* getBins() const { return bins; }
+
+private:
+    enum State { SCAN, AFTER_KEY, AFTER_COLON, IN_LIST, IN_PAIR, DONE };
+
+    State state;
+    int depth;
+    bool inString;
+    bool escaped;
+    char key[16];
+    uint8_t keyLen;
+    char num[24];
+    uint8_t numLen;
+    uint8_t pairIndex;
+    double pair[2];
+    uint16_t entries;
+    uint32_t bins[MEMPOOL_FEE_BINS];
+
+    static bool isSpace(char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+    // Track nesting and top-level keys until "fee_histogram" shows up
+    void scan(char c) {
+        if (inString) {
+            if (escaped) {
+                escaped = false;
+            } else if (c == '\\') {
+                escaped = true;
+            } else if (c == '"') {
+                inString = false;
+                if (depth == 1 && keyLen == 13 && memcmp(key, "fee_histogram", 13) == 0) {
+                    state = AFTER_KEY;
+                }
+            } else if (keyLen <= sizeof(key)) {
+                // Longer keys saturate past sizeof(key) and never match
+                if (keyLen < sizeof(key)) key[keyLen] = c;
+                keyLen++;
+            }
+            return;
+        }
+
+        if (c == '"') {
+            inString = true;
+            keyLen = 0;
+        } else if (c == '{' || c == '[') {
+            depth++;
+        } else if (c == '}' || c == ']') {
+            depth--;
+        }
+    }
+
+    // Collect "[fee, vsize]"
+    void pairChar(char c) {
+        if (c == ',' || c == ']') {
+            commitNumber();
+            if (c == ']') {
+                if (pairIndex >= 2 && pair[1] > 0) {
+                    bins[mempoolFeeBin((float)pair[0])] += (uint32_t)pair[1];
+                    entries++;
+                }
+                state = IN_LIST;
+            }
+        } else if (!isSpace(c) && numLen < sizeof(num) - 1) {
+            num[numLen++] = c;
+        }
+    }
+
+    void commitNumber() {
+        if (numLen > 0 && pairIndex < 2) {
+            num[numLen] = '\0';
+            pair[pairIndex] = strtod(num, nullptr);
+        }
+        pairIndex++;
+        numLen = 0;
+    }
+};
+
+/**
+ * HttpBodyReader - Pull reader over an HTTP response body
+ *
+ * Decodes chunked transfer encoding (or stops at Content-Length) so neither
+ * ArduinoJson nor the socket reads past the end of the body, which keeps the
+ * keep-alive connection usable. Decoded bytes are buffered MEMPOOL_BODY_CHUNK
+ * at a time and passed through the optional tap.
+ *
+ * TSource needs size_t readBytes(char*, size_t) that waits up to a timeout
+ * (Arduino Stream / WiFiClient semantics). Implements the read()/readBytes()
+ * pair ArduinoJson expects from a custom reader.
+ */
+template <class TSource>
+class HttpBodyReader {
+public:
+    // contentLength < 0 means unknown (read until the source runs dry)
+    HttpBodyReader(TSource& source, bool chunked, int32_t contentLength, FeeHistogramTap* bodyTap = nullptr)
+        : src(source), isChunked(chunked), remaining(contentLength), tap(bodyTap),
+          chunkLeft(0), pos(0), len(0), done(false), error(false), total(0) {}
+
+    int read() {
+        if (pos >= len && !fill()) return -1;
+        return (unsigned char)buffer[pos++];
+    }
+
+    size_t readBytes(char* out, size_t n) {
+        size_t copied = 0;
+        while (copied < n) {
+            if (pos >= len && !fill()) break;
+            size_t take = len - pos;
+            if (take > n - copied) take = n - copied;
+            memcpy(out + copied, buffer + pos, take);
+            pos += take;
+            copied += take;
+        }
+        return copied;
+    }
+
+    // Consume whatever the parser left unread (so the socket can be reused)
+    void drain() {
+        pos = len;
+        while (fill()) {
+            pos = len;
+        }
+    }
+
+    bool failed() const { return error; }        // Timed out or malformed framing
+    uint32_t bytesRead() const { return total; }  // Decoded body bytes
+
+private:
+    TSource& src;
+    bool isChunked;
+    int32_t remaining;
+    FeeHistogramTap* tap;
+    uint32_t chunkLeft;
+    char buffer[MEMPOOL_BODY_CHUNK];
+    size_t pos;
+    size_t len;
+    bool done;
+    bool error;
+    uint32_t total;
+
+    bool fill() {
+        pos = len = 0;
+        if (done) return false;
+
+        size_t want = sizeof(buffer);
+        if (isChunked) {
+            if (chunkLeft == 0 && !nextChunk()) return false;
+            if (want > chunkLeft) want = chunkLeft;
+        } else if (remaining >= 0) {
+            if (remaining == 0) { done = true; return false; }
+            if (want > (size_t)remaining) want = remaining;
+        }
+
+        size_t got = src.readBytes(buffer, want);
+        if (got == 0) {
+            // Unknown length ends when the server closes; anything else is a timeout
+            error = isChunked || remaining >= 0;
+            done = true;
+            return false;
+        }
+
+        len = got;
+        total += got;
+        if (tap) tap->feed(buffer, got);
+
+        if (isChunked) {
+            chunkLeft -= got;
+            if (chunkLeft == 0) skipLine();  // CRLF after chunk data
+        } else if (remaining >= 0) {
+            remaining -= got;
+        }
+        return true;
+    }
+
+    // Read the next chunk size line; false at the terminating 0-size chunk
+    bool nextChunk() {
+        char line[20];
+        if (!readLine(line, sizeof(line))) {
+            error = done = true;
+            return false;
+        }
+
+        chunkLeft = strtoul(line, nullptr, 16);
+        if (chunkLeft == 0) {
+            // Trailer section ends with an empty line
+            while (readLine(line, sizeof(line)) && line[0] != '\0') {}
+            done = true;
+            return false;
+        }
+        return true;
+    }
+
+    void skipLine() {
+        char line[4];
+        readLine(line, sizeof(line));
+    }
+
+    bool readLine(char* line, size_t size) {
+        size_t n = 0;
+        char c;
+        while (src.readBytes(&c, 1) == 1) {
+            if (c == '\n') {
+                line[n] = '\0';
+                return true;
+            }
+            if (c != '\r' && n < size - 1) line[n++] = c;
+        }
+        line[n] = '\0';
+        return false;
+    }
+};
+
+/**
+ * Parse /api/mempool from a reader without buffering the body.
+ *
+ * ArduinoJson keeps only count/vsize/total_fee (filter), the tap inside the
+ * reader bins fee_histogram. Both fit in fixed-size stack buffers.
+ */
+template <class TSource>
+DeserializationError parseMempoolStats(HttpBodyReader<TSource>& reader, FeeHistogramTap& tap, MempoolStats& out) {
+    StaticJsonDocument<64> filter;
+    filter["count"] = true;
+    filter["vsize"] = true;
+    filter["total_fee"] = true;
+
+    StaticJsonDocument<128> doc;
+    DeserializationError error = deserializeJson(doc, reader, DeserializationOption::Filter(filter));
+
+    // Rest of the body (usually the tail of fee_histogram) still goes through the tap
+    reader.drain();
+
+    if (error) return error;
+
+    out.count = doc["count"] | 0UL;
+    out.vsize = doc["vsize"] | 0UL;
+    out.totalFee = doc["total_fee"].as<uint64_t>();
+    memcpy(out.feeHistogram, tap.getBins(), sizeof(out.feeHistogram));
+    out.histogramEntries = tap.getEntries();
+    return error;
+}
+
+#endif // MEMPOOL_STATS_H
@@ -1,5 +1,9 @@
 #include "OpenAIClient.h"
+#include "AICache.h"
 #include "../utils/SDLogger.h"
+#include "../network/EndpointHealth.h"
+
+static_assert(sizeof(CachedSuggestion) <= AI_CACHE_VALUE_SIZE, "CachedSuggestion too large for AICache");
 
 OpenAIClient::OpenAIClient() {
     model = "gpt-3.5-turbo";  // Default to cost-effective model
@@ -18,63 +22,6 @@ void OpenAIClient::setModel(const String& modelName) {
     model = modelName;
 }
 
-String OpenAIClient::generateTradingPrompt(const BTCData& data) {
-    char prompt[1024];
-    snprintf(prompt, sizeof(prompt),
-        "You are a professional Bitcoin trading analyst. Analyze the following Bitcoin market data and provide a concise trading suggestion.\n\n"
-        "Market Data:\n"
-        "- Current Price: $%.0f USD\n"
-        "- Block Height: %d\n"
-        "- Mempool: %d pending transactions\n"
-        "- Mempool Size: %.1f MB\n"
-        "- Fee Rates: Fast %d sat/vB, Medium %d sat/vB, Slow %d sat/vB\n\n"
-        "Provide your analysis in this format:\n\n"
-        "Signal: [STRONG_BUY|BUY|HOLD|SELL|STRONG_SELL]\n"
-        "Confidence: [0-100]%%\n\n"
-        "Recommendation:\n"
-        "[2-3 sentences with actionable advice, including entry points, stop-loss, and targets if applicable]\n\n"
-        "Key Factors:\n"
-        "- [Factor 1]\n"
-        "- [Factor 2]\n"
-        "- [Factor 3]\n\n"
-        "Keep your response under 400 words. Focus on actionable insights.",
-        data.priceUSD,
-        data.blockHeight,
-        data.mempoolCount,
-        data.mempoolSize,
-        data.feeFast,
-        data.feeMedium,
-        data.feeSlow
-    );
-
-    return String(prompt);
-}
-
-String OpenAIClient::buildRequestBody(const BTCData& data) {
-    DynamicJsonDocument doc(4096);
-
-    doc["model"] = model;
-    doc["max_tokens"] = 500;
-    doc["temperature"] = 0.7;
-
-    JsonArray messages = doc.createNestedArray("messages");
-
-    // System message
-    JsonObject systemMsg = messages.createNestedObject();
-    systemMsg["role"] = "system";
-    systemMsg["content"] = "You are a professional Bitcoin trading analyst. Provide concise, actionable trading suggestions based on market data.";
-
-    // User message with market data
-    JsonObject userMsg = messages.createNestedObject();
-    userMsg["role"] = "user";
-    userMsg["content"] = generateTradingPrompt(data);
-
-    String requestBody;
-    serializeJson(doc, requestBody);
-
-    return requestBody;
-}
-
 TradingSignal OpenAIClient::parseSignal(const String& signalText) {
     String signal = signalText;
     signal.toUpperCase();
@@ -205,6 +152,24 @@ bool OpenAIClient::fetchTradingSuggestion(const BTCData& data, TradingSuggestion
         return false;
     }
 
+    // An unchanged market gets the answer it got last time
+    CachedSuggestion cached;
+    if (aiCache.lookup(AI_CACHE_TRADING_SUGGESTION, data, &cached, sizeof(cached))) {
+        fromCached(cached, suggestion);
+        return true;
+    }
+
+    // Build request body
+    JsonBodyWriter body(requestBuffer, sizeof(requestBuffer));
+    if (!writeOpenAITradingRequest(body, model.c_str(), data)) {
+        Serial.println("❌ OpenAI request body does not fit the request buffer");
+        return false;
+    }
+
+    if (!endpointHealth.allow(ENDPOINT_OPENAI)) {
+        return false;
+    }
+
     HTTPClient http;
     http.begin(API_URL);
     http.setTimeout(30000);  // 30 second timeout
@@ -213,17 +178,15 @@ bool OpenAIClient::fetchTradingSuggestion(const BTCData& data, TradingSuggestion
     http.addHeader("Content-Type", "application/json");
     http.addHeader("Authorization", "Bearer " + apiKey);
 
-    // Build request body
-    String requestBody = buildRequestBody(data);
-
     Serial.println("\n=== Fetching Trading Suggestion ===");
-    Serial.println("Model: " + model);
-    Serial.println("Request size: " + String(requestBody.length()) + " bytes");
+    Serial.printf("Model: %s\n", model.c_str());
+    Serial.printf("Request size: %u bytes\n", (unsigned)body.length());
 
     // Make POST request
     unsigned long startTime = millis();
-    int httpCode = http.POST(requestBody);
+    int httpCode = http.POST((uint8_t*)body.c_str(), body.length());
     unsigned long duration = millis() - startTime;
+    endpointHealth.record(ENDPOINT_OPENAI, httpCode, duration);
 
     if (httpCode == HTTP_CODE_OK) {
         String response = http.getString();
@@ -236,7 +199,10 @@ bool OpenAIClient::fetchTradingSuggestion(const BTCData& data, TradingSuggestion
 
         // Parse response
         bool success = parseResponse(response, suggestion);
-        if (!success) {
+        if (success) {
+            toCached(suggestion, cached);
+            aiCache.store(AI_CACHE_TRADING_SUGGESTION, data, &cached, sizeof(cached));
+        } else {
             sdLogger.logAPIError("openai", "/v1/chat/completions", httpCode, "Response parse error");
         }
         return success;
@@ -255,7 +221,106 @@ bool OpenAIClient::fetchTradingSuggestion(const BTCData& data, TradingSuggestion
     }
 }
 
+bool OpenAIClient::fetchMarketSignals(const BTCData& data, MarketSignals& signals,
+                                      const volatile bool* cancelled) {
+    lastLatencyMs = 0;
+
+    if (apiKey.length() == 0) {
+        Serial.println("Error: OpenAI API key not set");
+        return false;
+    }
+
+    JsonBodyWriter body(requestBuffer, sizeof(requestBuffer));
+    if (!writeOpenAIMarketSignalsRequest(body, model.c_str(), data)) {
+        Serial.println("❌ OpenAI request body does not fit the request buffer");
+        return false;
+    }
+
+    // Lost the race before starting: do not spend a request (or a breaker probe)
+    if (isCancelled(cancelled) || !endpointHealth.allow(ENDPOINT_OPENAI)) {
+        return false;
+    }
+
+    HTTPClient http;
+    http.begin(API_URL);
+    http.setTimeout(30000);  // 30 second timeout
+    http.addHeader("Content-Type", "application/json");
+    http.addHeader("Authorization", "Bearer " + apiKey);
+
+    Serial.println("Fetching market signals from OpenAI...");
+    unsigned long startTime = millis();
+    int httpCode = http.POST((uint8_t*)body.c_str(), body.length());
+    lastLatencyMs = millis() - startTime;
+    if (lastLatencyMs == 0) lastLatencyMs = 1;
+    endpointHealth.record(ENDPOINT_OPENAI, httpCode, lastLatencyMs);
+
+    if (httpCode != HTTP_CODE_OK) {
+        sdLogger.logAPIError("openai", "/market-signals", httpCode,
+                           httpCode > 0 ? "HTTP error" : "Connection failed");
+        Serial.printf("OpenAI market signals request failed: %d\n", httpCode);
+        http.end();
+        return false;
+    }
+
+    String response = http.getString();
+    http.end();
+    sdLogger.logAPI("openai", "/market-signals", httpCode, lastLatencyMs, response.length());
+
+    // The reply is ~30 tokens; the envelope around it is most of the document
+    DynamicJsonDocument doc(2048);
+    if (deserializeJson(doc, response)) {
+        sdLogger.logAPIError("openai", "/market-signals", httpCode, "Response parse error");
+        return false;
+    }
+
+    const char* content = doc["choices"][0]["message"]["content"] | "";
+    if (!parseMarketSignals(content, signals)) {
+        sdLogger.logAPIError("openai", "/market-signals", httpCode, "Parse error");
+        Serial.printf("Unexpected market signals reply: %s\n", content);
+        return false;
+    }
+
+    Serial.printf("Market Signals (OpenAI): DCA=%s signal=%s (%s) confidence=%u%%\n",
+                 signals.dca, signals.signal, signals.timeframe, signals.confidence);
+    return true;
+}
+
+void OpenAIClient::toCached(const TradingSuggestion& suggestion, CachedSuggestion& cached) {
+    memset(&cached, 0, sizeof(cached));
+    cached.signal = (uint8_t)suggestion.signal;
+    cached.confidence = (uint8_t)suggestion.confidence;
+    cached.targetPrice = suggestion.targetPrice;
+    cached.stopLoss = suggestion.stopLoss;
+    strlcpy(cached.recommendation, suggestion.recommendation.c_str(), sizeof(cached.recommendation));
+
+    int count = suggestion.keyFactorCount < 5 ? suggestion.keyFactorCount : 5;
+    for (int i = 0; i < count; i++) {
+        strlcpy(cached.keyFactors[i], suggestion.keyFactors[i].c_str(), sizeof(cached.keyFactors[i]));
+    }
+    cached.keyFactorCount = (uint8_t)count;
+}
+
+void OpenAIClient::fromCached(const CachedSuggestion& cached, TradingSuggestion& suggestion) {
+    suggestion.signal = cached.signal <= SIGNAL_UNCERTAIN ? (TradingSignal)cached.signal : SIGNAL_UNCERTAIN;
+    suggestion.confidence = cached.confidence;
+    suggestion.targetPrice = cached.targetPrice;
+    suggestion.stopLoss = cached.stopLoss;
+    suggestion.recommendation = cached.recommendation;
+
+    suggestion.keyFactorCount = cached.keyFactorCount < 5 ? cached.keyFactorCount : 5;
+    for (int i = 0; i < suggestion.keyFactorCount; i++) {
+        suggestion.keyFactors[i] = cached.keyFactors[i];
+    }
+
+    suggestion.timestamp = millis();
+    suggestion.isValid = true;
+}
+
 bool OpenAIClient::testConnection() {
+    if (!endpointHealth.allow(ENDPOINT_OPENAI)) {
+        return false;
+    }
+
     HTTPClient http;
     http.begin(API_URL);
     http.setTimeout(10000);
@@ -264,11 +329,14 @@ bool OpenAIClient::testConnection() {
     http.addHeader("Authorization", "Bearer " + apiKey);
 
     // Minimal test request
-    String testBody = "{\"model\":\"" + model + "\",\"messages\":[{\"role\":\"user\",\"content\":\"test\"}],\"max_tokens\":5}";
+    JsonBodyWriter body(requestBuffer, sizeof(requestBuffer));
+    body.raw("{\"model\":\"").text(model.c_str());
+    body.raw("\",\"messages\":[{\"role\":\"user\",\"content\":\"test\"}],\"max_tokens\":5}");
 
     unsigned long startTime = millis();
-    int httpCode = http.POST(testBody);
+    int httpCode = http.POST((uint8_t*)body.c_str(), body.length());
     unsigned long duration = millis() - startTime;
+    endpointHealth.record(ENDPOINT_OPENAI, httpCode, duration);
 
     if (httpCode == HTTP_CODE_OK) {
         String response = http.getString();
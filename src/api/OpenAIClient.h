@@ -5,6 +5,8 @@
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
 #include "BTCData.h"
+#include "AIPrompts.h"
+#include "AIProvider.h"
 
 // Trading signal types
 enum TradingSignal {
@@ -29,23 +31,41 @@ struct TradingSuggestion {
     bool isValid = false;
 };
 
+// Fixed-size copy of a TradingSuggestion for AICache (text truncated to fit)
+struct CachedSuggestion {
+    uint8_t signal;           // TradingSignal
+    uint8_t confidence;
+    uint8_t keyFactorCount;
+    float targetPrice;
+    float stopLoss;
+    char recommendation[240];
+    char keyFactors[5][52];
+};
+
 /**
  * OpenAI API Client for trading suggestions
- * Uses GPT-3.5 Turbo or GPT-4 for Bitcoin trading analysis
+ * Uses GPT-3.5 Turbo or GPT-4 for Bitcoin trading analysis, and answers
+ * the market signals request as AIRouter's second provider
  */
-class OpenAIClient {
+class OpenAIClient : public AIProvider {
 private:
     String apiKey;
     String model;
 
+    // Request body, owned by this instance (see GeminiClient)
+    char requestBuffer[AI_REQUEST_BUFFER_SIZE];
+
     // API endpoint
     static constexpr const char* API_URL = "https://api.openai.com/v1/chat/completions";
 
     // Helper methods
-    String buildRequestBody(const BTCData& data);
     bool parseResponse(const String& response, TradingSuggestion& suggestion);
     TradingSignal parseSignal(const String& signalText);
 
+    // Conversion to and from the cached form
+    static void toCached(const TradingSuggestion& suggestion, CachedSuggestion& cached);
+    static void fromCached(const CachedSuggestion& cached, TradingSuggestion& suggestion);
+
 public:
     OpenAIClient();
     OpenAIClient(const String& key, const String& modelName = "gpt-3.5-turbo");
@@ -53,8 +73,10 @@ public:
     // Main method to fetch trading suggestion
     bool fetchTradingSuggestion(const BTCData& data, TradingSuggestion& suggestion);
 
-    // Generate trading analysis prompt
-    String generateTradingPrompt(const BTCData& data);
+    // DCA recommendation and trading signal in JSON mode (see MarketSignals.h).
+    // Not cached; go through AIRouter.
+    bool fetchMarketSignals(const BTCData& data, MarketSignals& signals,
+                            const volatile bool* cancelled) override;
 
     // Test API connectivity
     bool testConnection();
@@ -0,0 +1,114 @@
+#include "WarmStart.h"
+#include <Preferences.h>
+#include "../utils/WallClock.h"
+#include "../utils/SDLogger.h"
+
+// Global instance
+WarmStart warmStart;
+
+static const size_t BLOB_SIZE = sizeof(WarmStateHeader) + sizeof(BTCData);
+
+// Guards state and the save counters: the worker writes them, STATUS reads
+// them from the loop task. The worker's own reads need no lock.
+static portMUX_TYPE warmStartLock = portMUX_INITIALIZER_UNLOCKED;
+
+WarmStart::WarmStart() {
+    hasRestored = false;
+    loaded = false;
+    saves = 0;
+    lastSaveUs = 0;
+}
+
+void WarmStart::begin() {
+    if (loaded) return;
+    loaded = true;
+
+    Preferences prefs;
+    if (!prefs.begin(WARM_START_NAMESPACE, true)) {
+        // Namespace does not exist until the first save
+        Serial.println("Warm start: no saved state (first boot)");
+        return;
+    }
+
+    uint8_t blob[BLOB_SIZE];
+    size_t len = prefs.getBytesLength("state");
+    if (len == sizeof(blob)) {
+        uint32_t started = micros();
+        prefs.getBytes("state", blob, sizeof(blob));
+        hasRestored = restoredState.decode(blob, len, &restored, sizeof(restored));
+        if (hasRestored) {
+            state = restoredState;
+            Serial.printf("✓ Warm start: state restored from NVS in %luus (price $%.0f, block %lu)\n",
+                         micros() - started, restored.priceUSD, restored.blockHeight);
+            sdLogger.logf(LOG_INFO, "Warm start: restored state (%u bytes) in %lu us",
+                         (unsigned)len, micros() - started);
+        }
+    }
+    prefs.end();
+
+    if (!hasRestored && len > 0) {
+        // Another firmware's layout, or a torn write
+        Serial.println("⚠️  Warm start: saved state ignored (layout changed or corrupt)");
+        sdLogger.log(LOG_WARN, "Warm start: saved state ignored");
+    }
+}
+
+bool WarmStart::restore(BTCData& out) const {
+    if (!hasRestored) return false;
+    out = restored;
+    return true;
+}
+
+void WarmStart::record(FetchJob job, const BTCData& snapshot) {
+    uint32_t nowS = wallClockNow();
+    portENTER_CRITICAL(&warmStartLock);
+    state.update(job, nowS);
+    portEXIT_CRITICAL(&warmStartLock);
+
+    uint32_t now = millis();
+    if (!state.saveDue(now)) return;
+
+    uint8_t blob[BLOB_SIZE];
+    size_t len = state.encode(&snapshot, sizeof(snapshot), blob, sizeof(blob));
+    if (len == 0) return;
+
+    Preferences prefs;
+    if (!prefs.begin(WARM_START_NAMESPACE, false)) return;
+    uint32_t started = micros();
+    bool ok = prefs.putBytes("state", blob, len) == len;
+    uint32_t saveUs = micros() - started;
+    prefs.end();
+
+    portENTER_CRITICAL(&warmStartLock);
+    lastSaveUs = saveUs;
+    if (ok) {
+        saves++;
+        state.markSaved(now);
+    }
+    portEXIT_CRITICAL(&warmStartLock);
+}
+
+void WarmStart::printStatus() {
+    // Copy under the lock, print outside it
+    portENTER_CRITICAL(&warmStartLock);
+    WarmState current = state;
+    uint32_t saveCount = saves;
+    uint32_t saveUs = lastSaveUs;
+    portEXIT_CRITICAL(&warmStartLock);
+
+    Serial.printf("Warm Start: %s, %u saves (last %luus), blob %u bytes\n",
+                 hasRestored ? "restored at boot" : "nothing restored",
+                 saveCount, (unsigned long)saveUs,
+                 (unsigned)BLOB_SIZE);
+
+    uint32_t nowS = wallClockNow();
+    for (int i = 0; i < FETCH_JOB_COUNT; i++) {
+        FetchJob job = (FetchJob)i;
+        uint32_t age;
+        if (current.age(job, nowS, age)) {
+            Serial.printf("  %-8s updated %us ago\n", FetchScheduler::jobName(job), age);
+        } else {
+            Serial.printf("  %-8s %s\n", FetchScheduler::jobName(job), current.has(job) ? "age unknown" : "no data");
+        }
+    }
+}
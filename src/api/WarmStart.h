@@ -0,0 +1,58 @@
+#ifndef WARM_START_H
+#define WARM_START_H
+
+#include <Arduino.h>
+#include "WarmState.h"
+#include "BTCData.h"
+
+// NVS namespace holding the last-known dashboard snapshot ("state")
+#define WARM_START_NAMESPACE "warm_start"
+
+/**
+ * WarmStart - Last-known BTCData, persisted to NVS for an instant first frame
+ *
+ * begin() loads the snapshot saved before the last reboot. MainScreen draws
+ * it (marked stale) before WiFi has connected, and the fetch worker starts
+ * from it, so values not fetched yet are kept in the next save. The worker
+ * record()s every result; the snapshot is written to NVS when WarmState
+ * says a save is due.
+ *
+ * begin() runs in setup(); record() only on the fetch worker task.
+ * printStatus() copies the worker's state under a lock, so any task can call it.
+ */
+class WarmStart {
+public:
+    WarmStart();
+
+    // Load the saved snapshot (call once after boot)
+    void begin();
+
+    // Copy the restored snapshot; false if there was none
+    bool restore(BTCData& out) const;
+
+    // Jobs with restored data, and their ages (0 / false when unknown)
+    uint8_t restoredSources() const { return restoredState.sources(); }
+    bool restoredAge(uint8_t jobs, uint32_t nowS, uint32_t& seconds) const {
+        return restoredState.oldestAge(jobs, nowS, seconds);
+    }
+
+    // Fetch worker: the snapshot after a successful job; saves when due
+    void record(FetchJob job, const BTCData& snapshot);
+
+    // Print saves and the age of each job's data to serial (STATUS command)
+    void printStatus();
+
+private:
+    WarmState state;          // Worker task
+    WarmState restoredState;  // As loaded at boot, read by the UI
+    BTCData restored;
+    bool hasRestored;
+    bool loaded;
+    uint32_t saves;
+    uint32_t lastSaveUs;
+};
+
+// Global instance
+extern WarmStart warmStart;
+
+#endif // WARM_START_H
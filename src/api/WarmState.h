@@ -0,0 +1,157 @@
+#ifndef WARM_STATE_H
+#define WARM_STATE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "../network/FetchScheduler.h"
+
+// Warm start settings
+#define WARM_STATE_VERSION 1           // Bump when the blob layout changes
+#define WARM_STATE_MAGIC 0x4D524157UL  // "WARM"
+#define WARM_STATE_SAVE_MS 300000      // At most one NVS write per 5 minutes (flash wear)
+#define WARM_STATE_MAX_SNAPSHOT 1024   // Largest snapshot (BTCData) the blob carries
+
+// Stored in front of the snapshot bytes
+struct WarmStateHeader {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t sources;                       // Bit per FetchJob with data in the snapshot
+    uint16_t snapshotSize;                 // sizeof(BTCData) when saved: a new layout is ignored
+    uint32_t crc;                          // CRC-32 of the snapshot bytes
+    uint32_t updatedAt[FETCH_JOB_COUNT];   // Unix time of each job's last result, 0 if unknown
+};
+
+// CRC-32 (IEEE, reflected), bitwise: the blob is written every few minutes
+inline uint32_t warmCrc32(const uint8_t* data, size_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1)));
+        }
+    }
+    return ~crc;
+}
+
+// "45s", "12m", "3h", "2d"
+inline void warmFormatAge(uint32_t seconds, char* out, size_t size) {
+    if (seconds < 60) {
+        snprintf(out, size, "%us", (unsigned)seconds);
+    } else if (seconds < 3600) {
+        snprintf(out, size, "%um", (unsigned)(seconds / 60));
+    } else if (seconds < 86400) {
+        snprintf(out, size, "%uh", (unsigned)(seconds / 3600));
+    } else {
+        snprintf(out, size, "%ud", (unsigned)(seconds / 86400));
+    }
+}
+
+/**
+ * WarmState - Bookkeeping for the last-known dashboard snapshot
+ *
+ * The fetch worker reports every result with update(); the snapshot is
+ * encoded into a blob (header + snapshot bytes) when saveDue() says so, and
+ * the next boot decode()s it to draw the last known values before the first
+ * fetch finishes. Each job keeps the unix time of its last result, so the
+ * screen can tell how old a restored value is once the clock has synced.
+ *
+ * Saves are throttled to WARM_STATE_SAVE_MS: values restored a few minutes
+ * old are drawn as stale either way, and NVS pages wear with every write.
+ *
+ * The caller persists the blob (see WarmStart).
+ */
+class WarmState {
+public:
+    WarmState() { clear(); }
+
+    void clear() {
+        memset(&header, 0, sizeof(header));
+        dirty = false;
+        saved = false;
+        lastSaveMs = 0;
+    }
+
+    // A job delivered fresh data (nowS is 0 while the clock is not synced)
+    void update(FetchJob job, uint32_t nowS) {
+        if (job >= FETCH_JOB_COUNT) return;
+        header.sources |= (uint8_t)(1u << job);
+        header.updatedAt[job] = nowS;
+        dirty = true;
+    }
+
+    // The first result after boot is saved at once, then every WARM_STATE_SAVE_MS
+    bool saveDue(uint32_t nowMs) const {
+        return dirty && (!saved || nowMs - lastSaveMs >= WARM_STATE_SAVE_MS);
+    }
+
+    void markSaved(uint32_t nowMs) {
+        dirty = false;
+        saved = true;
+        lastSaveMs = nowMs;
+    }
+
+    // Header plus snapshot into out; returns the blob size, 0 if it does not fit
+    size_t encode(const void* snapshot, size_t size, uint8_t* out, size_t capacity) {
+        if (size > WARM_STATE_MAX_SNAPSHOT || sizeof(header) + size > capacity) return 0;
+        header.magic = WARM_STATE_MAGIC;
+        header.version = WARM_STATE_VERSION;
+        header.snapshotSize = (uint16_t)size;
+        header.crc = warmCrc32((const uint8_t*)snapshot, size);
+        memcpy(out, &header, sizeof(header));
+        memcpy(out + sizeof(header), snapshot, size);
+        return sizeof(header) + size;
+    }
+
+    // Restore a saved blob into snapshot; false (state unchanged) if it is
+    // corrupt, from another layout, or holds nothing
+    bool decode(const uint8_t* blob, size_t len, void* snapshot, size_t size) {
+        WarmStateHeader h;
+        if (len != sizeof(h) + size || size > WARM_STATE_MAX_SNAPSHOT) return false;
+        memcpy(&h, blob, sizeof(h));
+        if (h.magic != WARM_STATE_MAGIC || h.version != WARM_STATE_VERSION ||
+            h.snapshotSize != size || h.sources == 0 ||
+            h.crc != warmCrc32(blob + sizeof(h), size)) {
+            return false;
+        }
+
+        memcpy(snapshot, blob + sizeof(h), size);
+        header = h;
+        dirty = false;
+        return true;
+    }
+
+    bool has(FetchJob job) const { return job < FETCH_JOB_COUNT && (header.sources & (1u << job)); }
+    uint8_t sources() const { return header.sources; }
+    uint32_t updatedAt(FetchJob job) const { return job < FETCH_JOB_COUNT ? header.updatedAt[job] : 0; }
+
+    // Seconds since the job's last result; false if unknown (no data, or a clock not synced)
+    bool age(FetchJob job, uint32_t nowS, uint32_t& seconds) const {
+        uint32_t t = updatedAt(job);
+        if (!has(job) || t == 0 || nowS == 0) return false;
+        seconds = nowS >= t ? nowS - t : 0;
+        return true;
+    }
+
+    // Age of the oldest job with data (what the header shows for a restored screen)
+    bool oldestAge(uint8_t jobs, uint32_t nowS, uint32_t& seconds) const {
+        bool known = false;
+        seconds = 0;
+        for (int i = 0; i < FETCH_JOB_COUNT; i++) {
+            uint32_t s;
+            if (!(jobs & (1u << i)) || !age((FetchJob)i, nowS, s)) continue;
+            if (!known || s > seconds) seconds = s;
+            known = true;
+        }
+        return known;
+    }
+
+private:
+    WarmStateHeader header;
+    bool dirty;
+    bool saved;
+    uint32_t lastSaveMs;
+};
+
+#endif // WARM_STATE_H
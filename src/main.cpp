@@ -3,9 +3,19 @@
 #include <FT6X36.h>
 #include "DisplayConfig.h"
 #include "screens/ScreenManager.h"
+#include "screens/MainScreen.h"
+#include "screens/ValueFont.h"
 #include "Config.h"
 #include "utils/SDLogger.h"
 #include "utils/CrashHandler.h"
+#include "utils/HistoryStore.h"
+#include "utils/WallClock.h"
+#include "network/FetchWorker.h"
+#include "network/HttpConnectionPool.h"
+#include "network/EndpointHealth.h"
+#include "api/AICache.h"
+#include "api/AIRouter.h"
+#include "api/WarmStart.h"
 
 LGFX lcd;
 FT6X36 touch(&Wire, 7);  // INT pin = GPIO 7
@@ -14,6 +24,18 @@ ScreenManager* screenManager;
 // Screenshot buffer size (480x320 RGB565 = 307,200 bytes)
 #define SCREENSHOT_BUFFER_SIZE (480 * 320 * 2)
 
+// Parse a SET_*_INTERVAL value in milliseconds
+bool parseIntervalMs(String value, unsigned long& interval) {
+    value.trim();
+    long parsed = value.toInt();
+    if (parsed < FETCH_MIN_INTERVAL_MS) {
+        Serial.printf("✗ Invalid interval (minimum %d ms)\n", FETCH_MIN_INTERVAL_MS);
+        return false;
+    }
+    interval = (unsigned long)parsed;
+    return true;
+}
+
 // Screenshot function
 void sendScreenshot() {
     Serial.println("\nSCREENSHOT_START");
@@ -48,12 +70,45 @@ void processSerialCommand() {
             Serial.println("Capturing main screen...");
             sendScreenshot();
             Serial.println("✓ Debug screen capture complete!");
+        } else if (command == "RENDER_STATS") {
+            MainScreen::printRenderStats();
+            screenManager->printFramePacing();
+        } else if (command == "SCROLL_BENCH") {
+            Serial.println("Scroll benchmark runs on the main screen's next update...");
+            MainScreen::requestScrollBenchmark();
+        } else if (command == "TEXT_BENCH") {
+            Serial.println("Text benchmark runs on the main screen's next update...");
+            MainScreen::requestTextBenchmark();
 
         } else if (command == "STATUS") {
             Serial.printf("WiFi: %s\n", WiFi.status() == WL_CONNECTED ? "Connected" : "Disconnected");
             Serial.printf("Free Heap: %d bytes\n", ESP.getFreeHeap());
             Serial.printf("Uptime: %lu seconds\n", millis() / 1000);
+            fetchWorker.printStatus();
+            httpPool.printStatus();
+            aiCache.printStatus();
+            warmStart.printStatus();
             globalConfig.printConfig();
+        } else if (command == "NET_STATUS") {
+            endpointHealth.printStatus();
+            httpPool.printStatus();
+            aiRouter.printStatus();
+        } else if (command == "HISTORY") {
+            historyStore.printStatus();
+
+            // Hourly price range over the last 12 hours
+            TimeSeriesBucket buckets[13];
+            uint32_t nowS = wallClockNow();
+            uint32_t n = historyStore.queryTier(HISTORY_PRICE, TS_TIER_HOUR,
+                                                nowS - 12 * TS_HOUR_SECONDS, nowS, buckets, 13);
+            for (uint32_t i = 0; i < n; i++) {
+                Serial.printf("  %2uh ago  min=$%.0f max=$%.0f avg=$%.0f (%u samples)\n",
+                             (nowS - buckets[i].start) / TS_HOUR_SECONDS,
+                             buckets[i].min, buckets[i].max, buckets[i].avg, buckets[i].count);
+            }
+        } else if (command == "AI_CACHE_CLEAR") {
+            aiCache.clear();
+            Serial.println("✓ AI answer cache cleared");
         } else if (command == "CHECK_SD_CARD") {
             Serial.println("\n=== SD Card Status ===");
             Serial.printf("Logger Ready: %s\n", sdLogger.isReady() ? "Yes" : "No");
@@ -65,6 +120,7 @@ void processSerialCommand() {
                 Serial.printf("Free Space: %.2f GB\n", sdLogger.getFreeSpace() / (1024.0 * 1024.0 * 1024.0));
                 Serial.printf("Total Space: %.2f GB\n", sdLogger.getTotalSpace() / (1024.0 * 1024.0 * 1024.0));
                 Serial.printf("Log Files: %d\n", sdLogger.getLogFileCount());
+                sdLogger.printDataStatus();
             } else {
                 Serial.println("\n⚠️  SD Card Not Available");
                 Serial.println("\nSD Card Pin Configuration:");
@@ -100,7 +156,8 @@ void processSerialCommand() {
             Serial.println("✓ SD card logging disabled");
         } else if (command == "LOG_FLUSH") {
             sdLogger.flush();
-            Serial.println("✓ Log buffer flushed to SD card");
+            sdLogger.flushData();
+            Serial.println("✓ Log and data buffers flushed to SD card");
         } else if (command.startsWith("LOG_LEVEL=")) {
             String level = command.substring(10);
             level.trim();
@@ -135,8 +192,17 @@ void processSerialCommand() {
                 dataType.trim();
                 dataType.toUpperCase();
             }
-            Serial.printf("Exporting CSV data: %s\n", dataType.c_str());
-            sdLogger.exportData(dataType.c_str());
+            // Optional time range: EXPORT_DATA=PRICE,2025-11-29 10:00,2025-11-29 14:00
+            uint32_t from = 0;
+            uint32_t to = 0xFFFFFFFFu;
+            int comma = dataType.indexOf(',');
+            if (comma > 0 && !btsParseRange(dataType.c_str() + comma + 1, from, to)) {
+                Serial.println("✗ Invalid range. Use: EXPORT_DATA=TYPE,YYYY-MM-DD[ HH:MM[:SS]][,YYYY-MM-DD[ HH:MM[:SS]]] (UTC)");
+            } else {
+                if (comma > 0) dataType = dataType.substring(0, comma);
+                Serial.printf("Exporting CSV data: %s\n", dataType.c_str());
+                sdLogger.exportData(dataType.c_str(), from, to);
+            }
         } else if (command == "CLEANUP_CSV") {
             Serial.println("Running CSV cleanup (retention policy)...");
             sdLogger.cleanup();
@@ -159,13 +225,22 @@ void processSerialCommand() {
             Serial.println("\n[Display]");
             Serial.println("  SCREENSHOT         - Capture display buffer");
             Serial.println("  DEBUG_SCREENS      - Capture all screens for layout debugging");
+            Serial.println("  RENDER_STATS       - Show pixels per frame, frame times and pacing");
+            Serial.println("  SCROLL_BENCH       - Measure scroll fps, blit vs full redraw");
+            Serial.println("  TEXT_BENCH         - Measure card value draw time, glyph atlas vs print");
             Serial.println("\n[Device Status]");
             Serial.println("  STATUS             - Show device status");
+            Serial.println("  NET_STATUS         - Show endpoint health (circuit breakers, latency, AI providers)");
+            Serial.println("  AI_CACHE_CLEAR     - Forget cached AI answers (next fetch asks the API)");
+            Serial.println("  HISTORY            - Show in-memory price/fee/mempool history");
             Serial.println("  LAST_CRASH         - Show last crash information");
             Serial.println("\n[Configuration]");
             Serial.println("  SET_WIFI=SSID,Pass - Set WiFi credentials (requires restart)");
             Serial.println("  SET_GEMINI_KEY=xxx - Set Gemini API key");
             Serial.println("  SET_OPENAI_KEY=xxx - Set OpenAI API key");
+            Serial.println("  SET_PRICE_INTERVAL=ms   - Price poll interval");
+            Serial.println("  SET_BLOCK_INTERVAL=ms   - Block poll interval");
+            Serial.println("  SET_MEMPOOL_INTERVAL=ms - Mempool poll interval");
             Serial.println("  RESET_CONFIG       - Reset all configuration");
             Serial.println("\n[Telegram Bot Configuration]");
             Serial.println("  SET_TELEGRAM_TOKEN=xxx       - Set Telegram bot token from @BotFather");
@@ -185,7 +260,7 @@ void processSerialCommand() {
             Serial.println("  FORMAT_SD_CARD     - Format SD card (WARNING: Deletes all data!)");
             Serial.println("  LOG_ENABLE         - Enable SD card logging");
             Serial.println("  LOG_DISABLE        - Disable SD card logging");
-            Serial.println("  LOG_FLUSH          - Force flush log buffer");
+            Serial.println("  LOG_FLUSH          - Force flush log and data buffers");
             Serial.println("  LOG_LEVEL=LEVEL    - Set log level (DEBUG/INFO/WARN/ERROR/FATAL)");
             Serial.println("  LOG_MEMORY         - Log current memory usage");
             Serial.println("\n[CSV Data Export]");
@@ -193,6 +268,9 @@ void processSerialCommand() {
             Serial.println("  EXPORT_DATA=PRICE  - Export only price data");
             Serial.println("  EXPORT_DATA=BLOCKS - Export only block data");
             Serial.println("  EXPORT_DATA=MEMPOOL- Export only mempool data");
+            Serial.println("  EXPORT_DATA=FEES   - Export only fee data");
+            Serial.println("  EXPORT_DATA=PRICE,2025-11-29 10:00,2025-11-29 14:00");
+            Serial.println("                     - Export a time range (UTC; any type)");
             Serial.println("  CLEANUP_CSV        - Run CSV retention policy (delete old files)");
             Serial.println("\n[Help]");
             Serial.println("  HELP               - Show this help");
@@ -223,6 +301,39 @@ void processSerialCommand() {
             } else {
                 Serial.println("✗ Invalid API key (empty)");
             }
+        } else if (command.startsWith("SET_PRICE_INTERVAL=")) {
+            unsigned long interval;
+            if (parseIntervalMs(command.substring(19), interval)) {
+                globalConfig.setPriceInterval(interval);
+                if (globalConfig.save()) {
+                    fetchWorker.reloadIntervals();
+                    Serial.printf("✓ Price interval set to %lu seconds\n", interval / 1000);
+                } else {
+                    Serial.println("✗ Failed to save configuration");
+                }
+            }
+        } else if (command.startsWith("SET_BLOCK_INTERVAL=")) {
+            unsigned long interval;
+            if (parseIntervalMs(command.substring(19), interval)) {
+                globalConfig.setBlockInterval(interval);
+                if (globalConfig.save()) {
+                    fetchWorker.reloadIntervals();
+                    Serial.printf("✓ Block interval set to %lu seconds\n", interval / 1000);
+                } else {
+                    Serial.println("✗ Failed to save configuration");
+                }
+            }
+        } else if (command.startsWith("SET_MEMPOOL_INTERVAL=")) {
+            unsigned long interval;
+            if (parseIntervalMs(command.substring(21), interval)) {
+                globalConfig.setMempoolInterval(interval);
+                if (globalConfig.save()) {
+                    fetchWorker.reloadIntervals();
+                    Serial.printf("✓ Mempool interval set to %lu seconds\n", interval / 1000);
+                } else {
+                    Serial.println("✗ Failed to save configuration");
+                }
+            }
         } else if (command.startsWith("SET_WIFI=")) {
             String params = command.substring(9);
             params.trim();
@@ -474,6 +585,8 @@ void setup() {
     // Load configuration from NVRAM
     Serial.println("\n=== Initializing Configuration ===");
     globalConfig.load();
+    aiCache.begin();
+    historyStore.begin();
 
     // Check if this is first run
     if (globalConfig.isFirstRun()) {
@@ -495,6 +608,9 @@ void setup() {
         Serial.println("  Insert SD card and restart to enable logging");
     }
 
+    // Last known dashboard state (after the SD card so the restore is logged)
+    warmStart.begin();
+
     // Initialize display
     lcd.init();
     lcd.setRotation(1);  // Landscape
@@ -502,6 +618,9 @@ void setup() {
     Serial.println("Display initialized!");
     sdLogger.log(LOG_INFO, "Display initialized: 480x320 landscape mode");
 
+    // Card value glyphs (reads the optional VLW font from SD before any task uses the card)
+    valueFont.begin();
+
     // Initialize touch (SDA=6, SCL=5)
     Wire.begin(6, 5);
     if (touch.begin(40)) {
@@ -528,6 +647,11 @@ void setup() {
     bool hasStoredWiFi = globalConfig.hasWiFiCredentials();
 
     if (hasStoredWiFi) {
+        // Draw the restored state while WiFi connects instead of a blank screen
+        if (warmStart.restoredSources() != 0) {
+            screenManager->switchScreen(SCREEN_MAIN);
+        }
+
         Serial.println("Found stored WiFi credentials, connecting...");
         String ssid = globalConfig.getWiFiSSID();
         String pass = globalConfig.getWiFiPassword();
@@ -547,14 +671,21 @@ void setup() {
             Serial.printf("IP: %s\n", WiFi.localIP().toString().c_str());
             sdLogger.logf(LOG_INFO, "WiFi connected successfully: IP=%s, RSSI=%d dBm",
                          WiFi.localIP().toString().c_str(), WiFi.RSSI());
-            screenManager->switchScreen(SCREEN_MAIN);
+            if (screenManager->getCurrentScreenInstance() != nullptr) {
+                // Already showing the restored state: fetch now that the network is up
+                fetchWorker.requestRefresh();
+            } else {
+                screenManager->switchScreen(SCREEN_MAIN);
+            }
         } else {
 #ifdef SINGLE_SCREEN_MODE
             Serial.println("\n✗ WiFi connection failed!");
             Serial.println("SINGLE_SCREEN_MODE: Staying on Main screen (configure WiFi via serial)");
             sdLogger.logf(LOG_WARN, "WiFi connection failed after %d attempts (SSID: %s)",
                          attempts, ssid.c_str());
-            screenManager->switchScreen(SCREEN_MAIN);
+            if (screenManager->getCurrentScreenInstance() == nullptr) {
+                screenManager->switchScreen(SCREEN_MAIN);
+            }
 #else
             Serial.println("\n✗ WiFi connection failed, showing scan screen");
             sdLogger.logf(LOG_WARN, "WiFi connection failed after %d attempts, showing WiFi scan",
@@ -618,8 +749,11 @@ void loop() {
     // Check for SD card hot-swap
     sdLogger.checkHotSwap();
 
-    // Update current screen (includes touch processing)
+    // Update current screen (includes touch processing and the paced frame)
     screenManager->update();
 
-    delay(10);
+    // Sleep until the next render tick instead of a fixed 10ms, so touch is
+    // read and frames are drawn at a steady rate (always yield at least 1ms)
+    uint32_t idleUs = screenManager->untilNextFrameUs();
+    delay(idleUs >= 2000 ? idleUs / 1000 : 1);
 }
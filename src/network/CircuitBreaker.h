@@ -0,0 +1,159 @@
+#ifndef CIRCUIT_BREAKER_H
+#define CIRCUIT_BREAKER_H
+
+#include <stdint.h>
+#include "ReconnectBackoff.h"
+
+enum CircuitState {
+    CIRCUIT_CLOSED = 0,  // Requests flow normally
+    CIRCUIT_OPEN,        // Requests rejected until the backoff expires
+    CIRCUIT_HALF_OPEN    // One probe request allowed through
+};
+
+// Per-endpoint health counters
+struct CircuitStats {
+    uint32_t successes;
+    uint32_t failures;
+    uint32_t rejected;         // Requests skipped while open
+    uint32_t opens;            // Times the circuit tripped
+    uint32_t lastLatencyMs;
+    uint32_t maxLatencyMs;
+    uint32_t totalLatencyMs;   // Sum over successes and failures (for averages)
+};
+
+/**
+ * CircuitBreaker - Stops calling an endpoint that keeps failing
+ *
+ * Closed: every request is allowed; failureThreshold consecutive failures
+ * trip the circuit. Open: requests are rejected without touching the network
+ * until the backoff delay has passed (exponential with jitter, see
+ * ReconnectBackoff). Half-open: a single probe is let through; success closes
+ * the circuit and resets the backoff, failure reopens it with a longer delay.
+ *
+ * EndpointHealth passes the clock in (millis()) and holds the lock.
+ */
+class CircuitBreaker {
+public:
+    CircuitBreaker(uint8_t failureThreshold, uint32_t openMs, uint32_t maxOpenMs,
+                   uint32_t probeTimeoutMs, uint32_t seed = 1)
+        : threshold(failureThreshold > 0 ? failureThreshold : 1),
+          probeTimeout(probeTimeoutMs), backoff(openMs, maxOpenMs, seed) {
+        reset();
+    }
+
+    void reset() {
+        state = CIRCUIT_CLOSED;
+        consecutiveFailures = 0;
+        retryAtMs = 0;
+        probeStartedMs = 0;
+        probeInFlight = false;
+        backoff.reset();
+        stats = CircuitStats();
+    }
+
+    /**
+     * Ask before each request. Returns false while the circuit is open;
+     * the rejection is counted. When the backoff has expired the circuit goes
+     * half-open and exactly one caller gets true.
+     */
+    bool allowRequest(uint32_t nowMs) {
+        if (state == CIRCUIT_OPEN && (int32_t)(nowMs - retryAtMs) >= 0) {
+            state = CIRCUIT_HALF_OPEN;
+            probeInFlight = false;
+        }
+
+        if (state == CIRCUIT_HALF_OPEN) {
+            // A probe that never reported back must not wedge the circuit
+            if (probeInFlight && nowMs - probeStartedMs < probeTimeout) {
+                stats.rejected++;
+                return false;
+            }
+            probeInFlight = true;
+            probeStartedMs = nowMs;
+            return true;
+        }
+
+        if (state == CIRCUIT_OPEN) {
+            stats.rejected++;
+            return false;
+        }
+        return true;
+    }
+
+    void recordSuccess(uint32_t latencyMs) {
+        stats.successes++;
+        addLatency(latencyMs);
+        consecutiveFailures = 0;
+
+        if (state != CIRCUIT_CLOSED) {
+            state = CIRCUIT_CLOSED;
+            probeInFlight = false;
+            backoff.reset();
+        }
+    }
+
+    void recordFailure(uint32_t latencyMs, uint32_t nowMs) {
+        stats.failures++;
+        addLatency(latencyMs);
+        if (consecutiveFailures < UINT8_MAX) consecutiveFailures++;
+
+        // A request that started before the trip must not extend the backoff
+        if (state == CIRCUIT_OPEN) return;
+
+        if (state == CIRCUIT_HALF_OPEN || consecutiveFailures >= threshold) {
+            trip(nowMs);
+        }
+    }
+
+    CircuitState getState() const { return state; }
+    uint8_t getConsecutiveFailures() const { return consecutiveFailures; }
+    const CircuitStats& getStats() const { return stats; }
+
+    uint32_t getAverageLatency() const {
+        uint32_t calls = stats.successes + stats.failures;
+        return calls > 0 ? stats.totalLatencyMs / calls : 0;
+    }
+
+    // Milliseconds until an open circuit lets a probe through (0 otherwise)
+    uint32_t msUntilRetry(uint32_t nowMs) const {
+        if (state != CIRCUIT_OPEN) return 0;
+        int32_t remaining = (int32_t)(retryAtMs - nowMs);
+        return remaining > 0 ? (uint32_t)remaining : 0;
+    }
+
+    static const char* stateName(CircuitState s) {
+        switch (s) {
+            case CIRCUIT_CLOSED:    return "closed";
+            case CIRCUIT_OPEN:      return "open";
+            case CIRCUIT_HALF_OPEN: return "half-open";
+            default:                return "unknown";
+        }
+    }
+
+private:
+    uint8_t threshold;
+    uint32_t probeTimeout;
+    ReconnectBackoff backoff;
+
+    CircuitState state;
+    uint8_t consecutiveFailures;
+    uint32_t retryAtMs;
+    uint32_t probeStartedMs;
+    bool probeInFlight;
+    CircuitStats stats;
+
+    void trip(uint32_t nowMs) {
+        state = CIRCUIT_OPEN;
+        probeInFlight = false;
+        retryAtMs = nowMs + backoff.nextDelay();
+        stats.opens++;
+    }
+
+    void addLatency(uint32_t latencyMs) {
+        stats.lastLatencyMs = latencyMs;
+        stats.totalLatencyMs += latencyMs;
+        if (latencyMs > stats.maxLatencyMs) stats.maxLatencyMs = latencyMs;
+    }
+};
+
+#endif // CIRCUIT_BREAKER_H
@@ -0,0 +1,148 @@
+#ifndef CONNECTION_SLOTS_H
+#define CONNECTION_SLOTS_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define POOL_HOST_MAX_LEN 64
+
+// Per-host request statistics
+struct HostStats {
+    uint32_t requests;
+    uint32_t handshakes;      // New TCP+TLS connections (requests - handshakes = reused)
+    uint32_t failures;        // Connection errors or HTTP status >= 400
+    uint32_t lastLatencyMs;
+    uint32_t maxLatencyMs;
+    uint32_t totalLatencyMs;
+
+    uint32_t reused() const { return requests > handshakes ? requests - handshakes : 0; }
+    uint32_t averageLatencyMs() const { return requests > 0 ? totalLatencyMs / requests : 0; }
+};
+
+/**
+ * Extract "host[:port]" from an http(s) URL.
+ * Returns false if the URL has no scheme or the host does not fit.
+ */
+inline bool parseUrlHost(const char* url, char* host, size_t hostLen) {
+    if (url == nullptr || host == nullptr || hostLen == 0) return false;
+
+    const char* start = strstr(url, "://");
+    if (start == nullptr) return false;
+    start += 3;
+
+    const char* end = start;
+    while (*end != '\0' && *end != '/' && *end != '?' && *end != '#') {
+        end++;
+    }
+
+    size_t len = (size_t)(end - start);
+    if (len == 0 || len >= hostLen) return false;
+
+    memcpy(host, start, len);
+    host[len] = '\0';
+    return true;
+}
+
+/**
+ * ConnectionSlotTable - Host-to-slot bookkeeping for the HTTP connection pool
+ *
+ * Maps each host to a fixed slot so its keep-alive socket can be reused, and
+ * picks the least recently used slot when a new host needs one. Contains no
+ * network code so the policy can be checked in native tests; the firmware pool
+ * (HttpConnectionPool) owns the actual clients indexed by slot number.
+ */
+template <int N>
+class ConnectionSlotTable {
+public:
+    ConnectionSlotTable() {
+        memset(hosts, 0, sizeof(hosts));
+        memset(lastUsedMs, 0, sizeof(lastUsedMs));
+        memset(inUse, 0, sizeof(inUse));
+        memset(stats, 0, sizeof(stats));
+        evictions = 0;
+    }
+
+    // Slot currently assigned to host, or -1
+    int find(const char* host) const {
+        for (int i = 0; i < N; i++) {
+            if (inUse[i] && strcmp(hosts[i], host) == 0) return i;
+        }
+        return -1;
+    }
+
+    /**
+     * Slot for host, assigning one if needed.
+     * @param evicted set to true when another host's slot was taken over
+     *                (its connection must be closed by the caller)
+     */
+    int acquire(const char* host, uint32_t nowMs, bool& evicted) {
+        evicted = false;
+
+        int slot = find(host);
+        if (slot < 0) {
+            slot = freeSlot();
+            if (slot < 0) {
+                slot = leastRecentlyUsed();
+                evictions++;
+                evicted = true;
+            }
+
+            strncpy(hosts[slot], host, POOL_HOST_MAX_LEN - 1);
+            hosts[slot][POOL_HOST_MAX_LEN - 1] = '\0';
+            memset(&stats[slot], 0, sizeof(HostStats));
+            inUse[slot] = true;
+        }
+
+        lastUsedMs[slot] = nowMs;
+        return slot;
+    }
+
+    // Record a finished request on a slot
+    void record(int slot, bool newConnection, bool success, uint32_t latencyMs) {
+        if (slot < 0 || slot >= N) return;
+
+        HostStats& s = stats[slot];
+        s.requests++;
+        if (newConnection) s.handshakes++;
+        if (!success) s.failures++;
+        s.lastLatencyMs = latencyMs;
+        s.totalLatencyMs += latencyMs;
+        if (latencyMs > s.maxLatencyMs) s.maxLatencyMs = latencyMs;
+    }
+
+    // Slots idle for longer than maxIdleMs (server has likely closed them)
+    bool isIdle(int slot, uint32_t nowMs, uint32_t maxIdleMs) const {
+        if (slot < 0 || slot >= N || !inUse[slot]) return false;
+        return (uint32_t)(nowMs - lastUsedMs[slot]) > maxIdleMs;
+    }
+
+    bool isUsed(int slot) const { return slot >= 0 && slot < N && inUse[slot]; }
+    const char* host(int slot) const { return hosts[slot]; }
+    const HostStats& getStats(int slot) const { return stats[slot]; }
+    uint32_t getEvictions() const { return evictions; }
+    static int capacity() { return N; }
+
+private:
+    char hosts[N][POOL_HOST_MAX_LEN];
+    uint32_t lastUsedMs[N];
+    bool inUse[N];
+    HostStats stats[N];
+    uint32_t evictions;  // Connections closed to make room for another host
+
+    int freeSlot() const {
+        for (int i = 0; i < N; i++) {
+            if (!inUse[i]) return i;
+        }
+        return -1;
+    }
+
+    int leastRecentlyUsed() const {
+        int oldest = 0;
+        for (int i = 1; i < N; i++) {
+            if ((int32_t)(lastUsedMs[i] - lastUsedMs[oldest]) < 0) oldest = i;
+        }
+        return oldest;
+    }
+};
+
+#endif // CONNECTION_SLOTS_H
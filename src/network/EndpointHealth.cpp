@@ -0,0 +1,105 @@
+#include "EndpointHealth.h"
+#include "../utils/SDLogger.h"
+
+// Global instance
+EndpointHealth endpointHealth;
+
+// Guards the breakers; held only for a few counter updates
+static portMUX_TYPE healthLock = portMUX_INITIALIZER_UNLOCKED;
+
+#define ENDPOINT_BREAKER(seed) \
+    CircuitBreaker(BREAKER_FAILURE_THRESHOLD, BREAKER_OPEN_MS, BREAKER_MAX_OPEN_MS, \
+                   BREAKER_PROBE_TIMEOUT_MS, seed)
+
+EndpointHealth::EndpointHealth()
+    : breakers{ENDPOINT_BREAKER(esp_random()), ENDPOINT_BREAKER(esp_random()),
+               ENDPOINT_BREAKER(esp_random())} {
+}
+
+bool EndpointHealth::allow(Endpoint endpoint) {
+    if (endpoint >= ENDPOINT_COUNT) return true;
+
+    uint32_t now = millis();
+    portENTER_CRITICAL(&healthLock);
+    bool allowed = breakers[endpoint].allowRequest(now);
+    uint32_t retryMs = breakers[endpoint].msUntilRetry(now);
+    portEXIT_CRITICAL(&healthLock);
+
+    if (!allowed) {
+        Serial.printf("⏸️  %s circuit open, skipping request (retry in %us)\n",
+                     endpointName(endpoint), retryMs / 1000);
+    }
+    return allowed;
+}
+
+void EndpointHealth::record(Endpoint endpoint, int httpCode, uint32_t latencyMs) {
+    if (endpoint >= ENDPOINT_COUNT) return;
+
+    uint32_t now = millis();
+    portENTER_CRITICAL(&healthLock);
+    CircuitBreaker& breaker = breakers[endpoint];
+    CircuitState before = breaker.getState();
+    if (isFailure(httpCode)) {
+        breaker.recordFailure(latencyMs, now);
+    } else {
+        breaker.recordSuccess(latencyMs);
+    }
+    CircuitState after = breaker.getState();
+    uint32_t retryMs = breaker.msUntilRetry(now);
+    portEXIT_CRITICAL(&healthLock);
+
+    // Log only state changes; per-request results are already in the API log
+    if (after == CIRCUIT_OPEN && before != CIRCUIT_OPEN) {
+        Serial.printf("⚠️  %s circuit opened after HTTP %d, retry in %us\n",
+                     endpointName(endpoint), httpCode, retryMs / 1000);
+        sdLogger.logf(LOG_WARN, "Circuit %s opened (HTTP %d), retry in %u ms",
+                     endpointName(endpoint), httpCode, retryMs);
+    } else if (after == CIRCUIT_CLOSED && before != CIRCUIT_CLOSED) {
+        Serial.printf("✓ %s circuit closed\n", endpointName(endpoint));
+        sdLogger.logf(LOG_INFO, "Circuit %s closed", endpointName(endpoint));
+    }
+}
+
+CircuitState EndpointHealth::getState(Endpoint endpoint) {
+    if (endpoint >= ENDPOINT_COUNT) return CIRCUIT_CLOSED;
+
+    portENTER_CRITICAL(&healthLock);
+    CircuitState state = breakers[endpoint].getState();
+    portEXIT_CRITICAL(&healthLock);
+    return state;
+}
+
+void EndpointHealth::printStatus() {
+    Serial.println("\n=== Endpoint Health ===");
+    uint32_t now = millis();
+
+    for (int i = 0; i < ENDPOINT_COUNT; i++) {
+        // Copy under the lock, print outside it
+        portENTER_CRITICAL(&healthLock);
+        CircuitBreaker breaker = breakers[i];
+        portEXIT_CRITICAL(&healthLock);
+
+        const CircuitStats& s = breaker.getStats();
+        Serial.printf("  %-8s %-9s ok=%u fail=%u skipped=%u opened=%u avg=%ums max=%ums last=%ums",
+                     endpointName((Endpoint)i), CircuitBreaker::stateName(breaker.getState()),
+                     s.successes, s.failures, s.rejected, s.opens,
+                     breaker.getAverageLatency(), s.maxLatencyMs, s.lastLatencyMs);
+        if (breaker.getState() == CIRCUIT_OPEN) {
+            Serial.printf(" retry=%us", breaker.msUntilRetry(now) / 1000);
+        }
+        Serial.println();
+    }
+}
+
+const char* EndpointHealth::endpointName(Endpoint endpoint) {
+    switch (endpoint) {
+        case ENDPOINT_MEMPOOL: return "mempool";
+        case ENDPOINT_GEMINI:  return "gemini";
+        case ENDPOINT_OPENAI:  return "openai";
+        default:               return "unknown";
+    }
+}
+
+bool EndpointHealth::isFailure(int httpCode) {
+    return httpCode <= 0 || httpCode == 429 || httpCode >= 500;
+}
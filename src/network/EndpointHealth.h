@@ -0,0 +1,60 @@
+#ifndef ENDPOINT_HEALTH_H
+#define ENDPOINT_HEALTH_H
+
+#include <Arduino.h>
+#include "CircuitBreaker.h"
+
+// Circuit breaker settings
+#define BREAKER_FAILURE_THRESHOLD 3     // Consecutive failures before the circuit opens
+#define BREAKER_OPEN_MS 30000           // First open period, doubles per failed probe
+#define BREAKER_MAX_OPEN_MS 600000      // Longest open period: 10 minutes
+#define BREAKER_PROBE_TIMEOUT_MS 60000  // Longer than any request timeout
+
+// Returned instead of an HTTP status when the circuit rejects a request
+#define HTTPC_ERROR_CIRCUIT_OPEN (-100)
+
+// Remote services guarded by a circuit breaker
+enum Endpoint {
+    ENDPOINT_MEMPOOL = 0,  // mempool.space REST API
+    ENDPOINT_GEMINI,
+    ENDPOINT_OPENAI,
+    ENDPOINT_COUNT
+};
+
+/**
+ * EndpointHealth - One circuit breaker per remote service
+ *
+ * Clients call allow() before a request and record() with the HTTP status
+ * afterwards. While a service is down its requests fail immediately instead
+ * of each waiting for a 10-30s timeout. Connection errors, timeouts, 429 and
+ * 5xx count as failures; other statuses prove the service is reachable.
+ *
+ * Safe to call from the fetch worker and the loop task.
+ */
+class EndpointHealth {
+public:
+    EndpointHealth();
+
+    // False while the endpoint's circuit is open (prints when it rejects)
+    bool allow(Endpoint endpoint);
+
+    // Feed the outcome of a request that allow() let through
+    void record(Endpoint endpoint, int httpCode, uint32_t latencyMs);
+
+    CircuitState getState(Endpoint endpoint);
+
+    // Print per-endpoint state and counters to serial (NET_STATUS command)
+    void printStatus();
+
+    static const char* endpointName(Endpoint endpoint);
+
+private:
+    CircuitBreaker breakers[ENDPOINT_COUNT];
+
+    static bool isFailure(int httpCode);
+};
+
+// Global instance
+extern EndpointHealth endpointHealth;
+
+#endif // ENDPOINT_HEALTH_H
@@ -0,0 +1,251 @@
+#ifndef FETCH_SCHEDULER_H
+#define FETCH_SCHEDULER_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Data sources owned by the background fetch worker.
+// Order matters: when several jobs are equally overdue they run in this order,
+// which matches the original price -> block -> mempool -> AI sequence.
+enum FetchJob {
+    FETCH_PRICE = 0,
+    FETCH_BLOCK,
+    FETCH_MEMPOOL,
+    FETCH_AI_SIGNALS,
+    FETCH_JOB_COUNT
+};
+
+// Adaptive cadence never polls faster than this
+#define FETCH_MIN_INTERVAL_MS 5000
+#define FETCH_BACKOFF_STEP_PCT 150  // Each unchanged run stretches the interval by 50%
+
+// Per-job timing statistics
+struct FetchJobStats {
+    uint32_t runs;
+    uint32_t failures;
+    uint32_t lastLatencyMs;     // Duration of the last run
+    uint32_t maxLatencyMs;      // Worst run since boot
+    uint32_t totalLatencyMs;    // Sum of all run durations (for averages)
+    uint32_t lastStartDelayMs;  // How late the last run started vs. its due time
+};
+
+/**
+ * FetchScheduler - Timing logic for the background fetch worker
+ *
+ * Decides which data source is fetched next and records per-job latency.
+ * It has no Arduino or FreeRTOS dependencies: the caller passes the clock in,
+ * so native tests can drive it with a fake millisecond counter.
+ *
+ * Each job has its own base interval. Adaptive jobs repeat faster right after
+ * their value changed (fastPercent of the base) and back off by 50% per
+ * unchanged run, up to slowFactor x base. Optional jitter spreads every
+ * reschedule by +/- jitterPercent so jobs with similar intervals drift apart
+ * instead of firing back to back.
+ *
+ * All time comparisons are wrap-safe (millis() overflows after ~49 days).
+ */
+class FetchScheduler {
+public:
+    FetchScheduler() {
+        memset(intervalMs, 0, sizeof(intervalMs));
+        memset(currentMs, 0, sizeof(currentMs));
+        memset(fastPercent, 0, sizeof(fastPercent));
+        memset(slowFactor, 0, sizeof(slowFactor));
+        memset(nextDueMs, 0, sizeof(nextDueMs));
+        memset(startedMs, 0, sizeof(startedMs));
+        memset(running, 0, sizeof(running));
+        memset(stats, 0, sizeof(stats));
+        jitterPercent = 0;
+        rng = 1;
+    }
+
+    // Set how often a job repeats (0 = job disabled); resets any adaptation
+    void setInterval(FetchJob job, uint32_t interval) {
+        if (job >= FETCH_JOB_COUNT) return;
+        intervalMs[job] = interval;
+        currentMs[job] = interval;
+        fastPercent[job] = 100;
+        slowFactor[job] = 1;
+    }
+
+    /**
+     * Let a job's cadence follow its data (call after setInterval).
+     * fastPercent: interval after a change, as % of the base (never below
+     * FETCH_MIN_INTERVAL_MS). slowFactor: longest interval as a multiple of
+     * the base while nothing changes.
+     */
+    void setAdaptive(FetchJob job, uint8_t fast, uint8_t slow) {
+        if (job >= FETCH_JOB_COUNT) return;
+        fastPercent[job] = fast > 0 && fast <= 100 ? fast : 100;
+        slowFactor[job] = slow > 0 ? slow : 1;
+    }
+
+    // Spread each reschedule by +/- percent of the interval (0 = exact)
+    void setJitter(uint8_t percent, uint32_t seed) {
+        jitterPercent = percent < 50 ? percent : 50;
+        rng = seed ? seed : 1;
+    }
+
+    // Configured base interval
+    uint32_t getInterval(FetchJob job) const {
+        return job < FETCH_JOB_COUNT ? intervalMs[job] : 0;
+    }
+
+    // Interval currently in effect after adaptation
+    uint32_t getCurrentInterval(FetchJob job) const {
+        return job < FETCH_JOB_COUNT ? currentMs[job] : 0;
+    }
+
+    // Make a job due immediately
+    void requestNow(FetchJob job, uint32_t nowMs) {
+        if (job >= FETCH_JOB_COUNT) return;
+        nextDueMs[job] = nowMs;
+    }
+
+    // Make every job due immediately (initial fetch, manual refresh)
+    void requestAll(uint32_t nowMs) {
+        for (int i = 0; i < FETCH_JOB_COUNT; i++) {
+            nextDueMs[i] = nowMs;
+        }
+    }
+
+    // Most overdue job that is not already running, or FETCH_JOB_COUNT if none is due
+    FetchJob nextDue(uint32_t nowMs) const {
+        FetchJob best = FETCH_JOB_COUNT;
+        int32_t bestOverdue = -1;
+
+        for (int i = 0; i < FETCH_JOB_COUNT; i++) {
+            if (running[i] || !isScheduled((FetchJob)i)) continue;
+
+            int32_t overdue = (int32_t)(nowMs - nextDueMs[i]);
+            if (overdue >= 0 && overdue > bestOverdue) {
+                best = (FetchJob)i;
+                bestOverdue = overdue;
+            }
+        }
+
+        return best;
+    }
+
+    // Milliseconds until the next job becomes due (0 if one is due now)
+    uint32_t msUntilNext(uint32_t nowMs) const {
+        int32_t best = INT32_MAX;
+
+        for (int i = 0; i < FETCH_JOB_COUNT; i++) {
+            if (running[i] || !isScheduled((FetchJob)i)) continue;
+
+            int32_t remaining = (int32_t)(nextDueMs[i] - nowMs);
+            if (remaining < best) best = remaining;
+        }
+
+        return best < 0 ? 0 : (uint32_t)best;
+    }
+
+    void markStarted(FetchJob job, uint32_t nowMs) {
+        if (job >= FETCH_JOB_COUNT) return;
+
+        int32_t delay = (int32_t)(nowMs - nextDueMs[job]);
+        stats[job].lastStartDelayMs = delay > 0 ? (uint32_t)delay : 0;
+        startedMs[job] = nowMs;
+        running[job] = true;
+    }
+
+    // changed: whether the run produced a new value (drives adaptive jobs)
+    void markFinished(FetchJob job, bool success, uint32_t nowMs, bool changed = true) {
+        if (job >= FETCH_JOB_COUNT || !running[job]) return;
+
+        uint32_t latency = nowMs - startedMs[job];
+        FetchJobStats& s = stats[job];
+        s.runs++;
+        if (!success) s.failures++;
+        s.lastLatencyMs = latency;
+        s.totalLatencyMs += latency;
+        if (latency > s.maxLatencyMs) s.maxLatencyMs = latency;
+
+        // Failures keep the current cadence; retry policy is up to the caller
+        if (success) adapt(job, changed);
+
+        // Anchor the next run to the start time so slow requests don't add drift,
+        // but never schedule into the past (a run longer than its interval).
+        uint32_t next = startedMs[job] + jittered(currentMs[job]);
+        if ((int32_t)(next - nowMs) < 0) next = nowMs;
+        nextDueMs[job] = next;
+        running[job] = false;
+    }
+
+    bool isRunning(FetchJob job) const {
+        return job < FETCH_JOB_COUNT && running[job];
+    }
+
+    uint32_t getNextDue(FetchJob job) const {
+        return job < FETCH_JOB_COUNT ? nextDueMs[job] : 0;
+    }
+
+    const FetchJobStats& getStats(FetchJob job) const {
+        return stats[job < FETCH_JOB_COUNT ? job : 0];
+    }
+
+    uint32_t getAverageLatency(FetchJob job) const {
+        const FetchJobStats& s = getStats(job);
+        return s.runs > 0 ? s.totalLatencyMs / s.runs : 0;
+    }
+
+    static const char* jobName(FetchJob job) {
+        switch (job) {
+            case FETCH_PRICE:      return "price";
+            case FETCH_BLOCK:      return "block";
+            case FETCH_MEMPOOL:    return "mempool";
+            case FETCH_AI_SIGNALS: return "ai";
+            default:               return "unknown";
+        }
+    }
+
+private:
+    uint32_t intervalMs[FETCH_JOB_COUNT];
+    uint32_t currentMs[FETCH_JOB_COUNT];
+    uint8_t fastPercent[FETCH_JOB_COUNT];
+    uint8_t slowFactor[FETCH_JOB_COUNT];
+    uint8_t jitterPercent;
+    uint32_t rng;
+    uint32_t nextDueMs[FETCH_JOB_COUNT];
+    uint32_t startedMs[FETCH_JOB_COUNT];
+    bool running[FETCH_JOB_COUNT];
+    FetchJobStats stats[FETCH_JOB_COUNT];
+
+    bool isScheduled(FetchJob job) const {
+        return intervalMs[job] > 0;
+    }
+
+    void adapt(FetchJob job, bool changed) {
+        uint32_t base = intervalMs[job];
+        if (base == 0 || (fastPercent[job] == 100 && slowFactor[job] == 1)) return;
+
+        uint32_t fastest = (uint32_t)((uint64_t)base * fastPercent[job] / 100);
+        if (fastest < FETCH_MIN_INTERVAL_MS) fastest = FETCH_MIN_INTERVAL_MS;
+        if (fastest > base) fastest = base;
+        uint64_t slowest = (uint64_t)base * slowFactor[job];
+
+        if (changed) {
+            currentMs[job] = fastest;
+        } else {
+            uint64_t next = (uint64_t)currentMs[job] * FETCH_BACKOFF_STEP_PCT / 100;
+            currentMs[job] = (uint32_t)(next < slowest ? next : slowest);
+        }
+    }
+
+    uint32_t jittered(uint32_t interval) {
+        uint32_t range = (uint32_t)((uint64_t)interval * jitterPercent / 100);
+        if (range == 0) return interval;
+        return interval - range + nextRandom() % (2 * range + 1);
+    }
+
+    // xorshift32, same generator as ReconnectBackoff
+    uint32_t nextRandom() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    }
+};
+
+#endif // FETCH_SCHEDULER_H
@@ -0,0 +1,617 @@
+#include "FetchWorker.h"
+#include <WiFi.h>
+#include "../api/AIRouter.h"
+#include "../utils/WallClock.h"
+#include "../api/WarmStart.h"
+#include "../utils/SDLogger.h"
+#include "../utils/HistoryStore.h"
+#include "../Config.h"
+
+// Global instance
+FetchWorker fetchWorker;
+
+// Guards the published status copy (worker writes, STATUS on the loop task reads)
+static portMUX_TYPE statusLock = portMUX_INITIALIZER_UNLOCKED;
+
+FetchWorker::FetchWorker() {
+    taskHandle = nullptr;
+    resultQueue = nullptr;
+    refreshRequested = false;
+    intervalsChanged = false;
+    lastLoggedBlock = 0;
+    lastPriceLogMs = 0;
+    priceLogged = false;
+    lastMempoolLogMs = 0;
+    mempoolLogged = false;
+    lastFeeLogMs = 0;
+    feeLogged = false;
+    aiForced = false;
+    aiSkipped = false;
+    hasAIAnswer = false;
+    lastAIAnswerMs = 0;
+    aiCalls = 0;
+    aiCached = 0;
+    aiSkips = 0;
+
+    pollIntervalMs[FETCH_PRICE] = DEFAULT_PRICE_INTERVAL;
+    pollIntervalMs[FETCH_BLOCK] = DEFAULT_BLOCK_INTERVAL;
+    pollIntervalMs[FETCH_MEMPOOL] = DEFAULT_MEMPOOL_INTERVAL;
+    pollIntervalMs[FETCH_AI_SIGNALS] = FETCH_AI_INTERVAL;
+    for (int i = 0; i < FETCH_JOB_COUNT; i++) {
+        applyPollCadence((FetchJob)i);
+    }
+
+    for (int i = 0; i < PUSH_TOPIC_COUNT; i++) {
+        pushCovered[i] = false;
+    }
+    memset(&published, 0, sizeof(published));
+}
+
+bool FetchWorker::begin() {
+    if (taskHandle != nullptr) {
+        return true;
+    }
+
+    if (resultQueue == nullptr) {
+        resultQueue = xQueueCreate(FETCH_RESULT_QUEUE_DEPTH, sizeof(FetchResult));
+        if (resultQueue == nullptr) {
+            Serial.println("✗ Fetch worker: failed to create result queue");
+            sdLogger.log(LOG_ERROR, "Fetch worker: result queue allocation failed");
+            return false;
+        }
+    }
+
+    // Wall clock (UTC) for log timestamps and AI cache expiry across reboots
+    configTime(0, 0, FETCH_NTP_SERVER_1, FETCH_NTP_SERVER_2);
+
+    // Start from the state saved before the reboot: jobs not fetched yet keep
+    // their restored values in the next warm-start save
+    if (warmStart.restore(snapshot)) {
+        lastLoggedBlock = snapshot.blockHeight;
+    }
+
+    // The task is not running yet, so the scheduler can be configured directly
+    loadIntervals();
+    scheduler.setJitter(FETCH_JITTER_PCT, esp_random());
+
+    // Everything is due on the first pass (replaces the blocking fetch in MainScreen::init)
+    scheduler.requestAll(millis());
+
+    BaseType_t created = xTaskCreatePinnedToCore(
+        taskEntry, "fetch_worker", FETCH_WORKER_STACK_SIZE, this,
+        FETCH_WORKER_PRIORITY, &taskHandle, FETCH_WORKER_CORE);
+
+    if (created != pdPASS) {
+        taskHandle = nullptr;
+        Serial.println("✗ Fetch worker: failed to start task");
+        sdLogger.log(LOG_ERROR, "Fetch worker: task creation failed");
+        return false;
+    }
+
+    Serial.printf("✓ Fetch worker started on core %d\n", FETCH_WORKER_CORE);
+    sdLogger.logf(LOG_INFO, "Fetch worker started (core %d, stack %d bytes)",
+                 FETCH_WORKER_CORE, FETCH_WORKER_STACK_SIZE);
+    return true;
+}
+
+void FetchWorker::requestRefresh() {
+    refreshRequested = true;
+    if (taskHandle != nullptr) {
+        xTaskNotifyGive(taskHandle);
+    }
+}
+
+void FetchWorker::reloadIntervals() {
+    intervalsChanged = true;
+    if (taskHandle != nullptr) {
+        xTaskNotifyGive(taskHandle);
+    }
+}
+
+void FetchWorker::loadIntervals() {
+    uint32_t configured[] = {
+        (uint32_t)globalConfig.getPriceInterval(),
+        (uint32_t)globalConfig.getBlockInterval(),
+        (uint32_t)globalConfig.getMempoolInterval(),
+    };
+
+    for (int i = 0; i < FETCH_AI_SIGNALS; i++) {
+        uint32_t interval = configured[i];
+        if (interval < FETCH_MIN_INTERVAL_MS) interval = FETCH_MIN_INTERVAL_MS;
+        pollIntervalMs[i] = interval;
+    }
+
+    // Topics pushed over the WebSocket keep their safety interval until they go quiet
+    for (int i = 0; i < PUSH_TOPIC_COUNT; i++) {
+        if (!pushCovered[i]) {
+            applyPollCadence(jobForTopic((PushTopic)i));
+        }
+    }
+
+    Serial.printf("Poll intervals: price=%us block=%us mempool=%us\n",
+                 pollIntervalMs[FETCH_PRICE] / 1000, pollIntervalMs[FETCH_BLOCK] / 1000,
+                 pollIntervalMs[FETCH_MEMPOOL] / 1000);
+    sdLogger.logf(LOG_INFO, "Fetch intervals: price=%u block=%u mempool=%u ms",
+                 pollIntervalMs[FETCH_PRICE], pollIntervalMs[FETCH_BLOCK],
+                 pollIntervalMs[FETCH_MEMPOOL]);
+}
+
+void FetchWorker::applyPollCadence(FetchJob job) {
+    scheduler.setInterval(job, pollIntervalMs[job]);
+
+    switch (job) {
+        case FETCH_PRICE:
+        case FETCH_MEMPOOL:
+            scheduler.setAdaptive(job, 100, FETCH_SLOW_FACTOR);
+            break;
+        case FETCH_BLOCK:
+            scheduler.setAdaptive(job, FETCH_BLOCK_FAST_PCT, FETCH_SLOW_FACTOR);
+            break;
+        default:
+            break;  // AI signals keep a fixed interval
+    }
+}
+
+bool FetchWorker::hasChanged(FetchJob job) const {
+    switch (job) {
+        case FETCH_PRICE: {
+            float delta = fabsf(snapshot.priceUSD - previous.priceUSD);
+            return delta > previous.priceUSD * (FETCH_PRICE_STABLE_PCT / 100.0f);
+        }
+        case FETCH_BLOCK:
+            return snapshot.blockHeight != previous.blockHeight;
+        case FETCH_MEMPOOL:
+            return snapshot.feeFast != previous.feeFast ||
+                   snapshot.feeMedium != previous.feeMedium ||
+                   snapshot.feeSlow != previous.feeSlow;
+        default:
+            return true;
+    }
+}
+
+bool FetchWorker::poll(FetchResult& result) {
+    if (resultQueue == nullptr) {
+        return false;
+    }
+    return xQueueReceive(resultQueue, &result, 0) == pdTRUE;
+}
+
+void FetchWorker::applyResult(const FetchResult& result, BTCData& target) {
+    const BTCData& src = result.data;
+
+    switch (result.job) {
+        case FETCH_PRICE:
+            target.priceUSD = src.priceUSD;
+            target.priceEUR = src.priceEUR;
+            memcpy(target.priceChange, src.priceChange, sizeof(target.priceChange));
+            memcpy(target.localSignal, src.localSignal, sizeof(target.localSignal));
+            target.localConfidence = src.localConfidence;
+            target.rsi = src.rsi;
+            target.bandWidthPct = src.bandWidthPct;
+            target.volatilityPct = src.volatilityPct;
+            break;
+
+        case FETCH_BLOCK:
+            target.blockHeight = src.blockHeight;
+            memcpy(target.blockHash, src.blockHash, sizeof(target.blockHash));
+            target.blockTime = src.blockTime;
+            target.blockTxCount = src.blockTxCount;
+            target.blockSize = src.blockSize;
+            break;
+
+        case FETCH_MEMPOOL:
+            target.mempoolCount = src.mempoolCount;
+            target.mempoolSize = src.mempoolSize;
+            target.mempoolTotalFee = src.mempoolTotalFee;
+            memcpy(target.feeHistogram, src.feeHistogram, sizeof(target.feeHistogram));
+            target.feeFast = src.feeFast;
+            target.feeMedium = src.feeMedium;
+            target.feeSlow = src.feeSlow;
+            break;
+
+        case FETCH_AI_SIGNALS:
+            memcpy(target.dcaRecommendation, src.dcaRecommendation, sizeof(target.dcaRecommendation));
+            memcpy(target.tradingSignal, src.tradingSignal, sizeof(target.tradingSignal));
+            memcpy(target.signalTimeframe, src.signalTimeframe, sizeof(target.signalTimeframe));
+            target.signalConfidence = src.signalConfidence;
+            break;
+
+        default:
+            break;
+    }
+}
+
+void FetchWorker::printStatus() {
+    Serial.printf("Fetch Worker: %s\n", isRunning() ? "Running" : "Stopped");
+    if (!isRunning()) return;
+
+    // Copy under the lock, print outside it
+    FetchWorkerStatus st;
+    portENTER_CRITICAL(&statusLock);
+    st = published;
+    portEXIT_CRITICAL(&statusLock);
+
+    Serial.printf("Worker Stack Free: %u bytes\n", uxTaskGetStackHighWaterMark(taskHandle));
+    for (int i = 0; i < FETCH_JOB_COUNT; i++) {
+        const FetchJobStats& s = st.jobs[i];
+        Serial.printf("  %-8s runs=%u fail=%u last=%ums avg=%ums max=%ums late=%ums every=%us (base %us)\n",
+                     FetchScheduler::jobName((FetchJob)i), s.runs, s.failures,
+                     s.lastLatencyMs, st.averageLatencyMs[i],
+                     s.maxLatencyMs, s.lastStartDelayMs,
+                     st.currentIntervalMs[i] / 1000, st.baseIntervalMs[i] / 1000);
+    }
+
+    Serial.printf("  Indicators: %u samples, local %s %u%%, RSI %.1f, BW %.2f%%, vol %.2f%%/h, events 0x%02X\n",
+                 st.indicatorSamples,
+                 st.indicatorsReady ? IndicatorEngine::signalName(st.localSignal) : "warming up",
+                 st.localConfidence, st.rsiX100 / 100.0f,
+                 st.bandWidthPpm / 10000.0f, st.hourlyVolatilityPpm / 10000.0f,
+                 st.indicatorEvents);
+    Serial.printf("  AI gate: called=%u cached=%u skipped=%u\n", st.aiCalls, st.aiCached, st.aiSkips);
+    Serial.print("  Price change:");
+    for (int i = 0; i < CHANGE_WINDOW_COUNT; i++) {
+        const PriceChange& c = st.priceChange[i];
+        if (c.valid) {
+            Serial.printf(" %s %+.0f USD (%+.2f%%)", PriceChanges::windowName((ChangeWindow)i), c.delta, c.pct);
+        } else {
+            Serial.printf(" %s n/a", PriceChanges::windowName((ChangeWindow)i));
+        }
+    }
+    Serial.println();
+
+    MempoolClient::printCacheStatus(st.cache);
+
+#if MEMPOOL_WS_ENABLED
+    MempoolSocket::printStatus(st.socket);
+#endif
+}
+
+void FetchWorker::publishStatus(uint32_t now) {
+    // Built on the worker stack, then copied in one go
+    FetchWorkerStatus st;
+    for (int i = 0; i < FETCH_JOB_COUNT; i++) {
+        FetchJob job = (FetchJob)i;
+        st.jobs[i] = scheduler.getStats(job);
+        st.averageLatencyMs[i] = scheduler.getAverageLatency(job);
+        st.currentIntervalMs[i] = scheduler.getCurrentInterval(job);
+        st.baseIntervalMs[i] = scheduler.getInterval(job);
+    }
+
+    st.indicatorSamples = indicators.getSamples();
+    st.indicatorsReady = indicators.ready();
+    st.localSignal = indicators.signal();
+    st.localConfidence = indicators.confidence();
+    st.rsiX100 = indicators.rsiX100();
+    st.bandWidthPpm = indicators.bandWidthPpm();
+    st.hourlyVolatilityPpm = indicators.hourlyVolatilityPpm();
+    st.indicatorEvents = indicators.peekEvents();
+
+    st.aiCalls = aiCalls;
+    st.aiCached = aiCached;
+    st.aiSkips = aiSkips;
+    memcpy(st.priceChange, snapshot.priceChange, sizeof(st.priceChange));
+
+    mempool.getCacheStatus(st.cache);
+#if MEMPOOL_WS_ENABLED
+    pushSocket.getStatus(st.socket, now);
+#else
+    memset(&st.socket, 0, sizeof(st.socket));
+    (void)now;
+#endif
+
+    portENTER_CRITICAL(&statusLock);
+    published = st;
+    portEXIT_CRITICAL(&statusLock);
+}
+
+void FetchWorker::taskEntry(void* arg) {
+    static_cast<FetchWorker*>(arg)->run();
+}
+
+void FetchWorker::run() {
+    bootstrapHistory();
+
+    for (;;) {
+        if (refreshRequested) {
+            refreshRequested = false;
+            aiForced = true;
+            scheduler.requestAll(millis());
+        }
+        if (intervalsChanged) {
+            intervalsChanged = false;
+            loadIntervals();
+        }
+
+        uint32_t now = millis();
+#if MEMPOOL_WS_ENABLED
+        pumpSocket(now);
+#endif
+        publishStatus(now);
+        FetchJob job = scheduler.nextDue(now);
+
+        if (job == FETCH_JOB_COUNT) {
+            // Sleep until the next job is due or the UI asks for a refresh
+            uint32_t waitMs = scheduler.msUntilNext(now);
+#if MEMPOOL_WS_ENABLED
+            if (waitMs > MEMPOOL_WS_LOOP_MS) waitMs = MEMPOOL_WS_LOOP_MS;
+#else
+            if (waitMs > FETCH_IDLE_WAIT_MS) waitMs = FETCH_IDLE_WAIT_MS;
+#endif
+            ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(waitMs > 0 ? waitMs : 1));
+            continue;
+        }
+
+        scheduler.markStarted(job, now);
+        previous = snapshot;
+        bool success = runJob(job);
+        uint32_t finished = millis();
+
+        // A 304 or a gated AI run changes nothing on screen; skip the result and the redraw
+        bool notModified = success && (job == FETCH_AI_SIGNALS ? aiSkipped : mempool.wasUnchanged());
+        scheduler.markFinished(job, success, finished, !notModified && hasChanged(job));
+        if (notModified) {
+            continue;
+        }
+
+        if (success && job == FETCH_BLOCK) {
+            logNewBlock();
+        }
+
+        postResult(job, success, finished - now);
+    }
+}
+
+void FetchWorker::pumpDuringRace(void* ctx) {
+    FetchWorker* worker = static_cast<FetchWorker*>(ctx);
+    worker->pumpSocket(millis());
+}
+
+void FetchWorker::pumpSocket(uint32_t now) {
+    uint8_t pushed = pushSocket.loop(snapshot);
+
+    // Hand pushed data to the UI like a completed fetch
+    if (pushed & PUSH_HAS_PRICE) {
+        recordHistory(FETCH_PRICE);
+        sampleIndicators(now);
+        postResult(FETCH_PRICE, true, 0);
+    }
+    if (pushed & PUSH_HAS_BLOCK) {
+        postResult(FETCH_BLOCK, true, 0);
+        logNewBlock();
+    }
+    if (pushed & PUSH_HAS_MEMPOOL) {
+        recordHistory(FETCH_MEMPOOL);
+        postResult(FETCH_MEMPOOL, true, 0);
+    }
+
+    // Slow down polling for pushed topics, resume it when they go quiet
+    for (int i = 0; i < PUSH_TOPIC_COUNT; i++) {
+        PushTopic topic = (PushTopic)i;
+        bool covered = pushSocket.covers(topic, now);
+        if (covered == pushCovered[i]) continue;
+
+        pushCovered[i] = covered;
+        FetchJob job = jobForTopic(topic);
+        if (covered) {
+            scheduler.setInterval(job, FETCH_PUSH_FALLBACK_INTERVAL);
+        } else {
+            applyPollCadence(job);
+            scheduler.requestNow(job, now);
+        }
+
+        Serial.printf("%s updates: %s\n", MempoolSocketSession::topicName(topic),
+                     covered ? "WebSocket push" : "REST polling");
+        sdLogger.logf(LOG_INFO, "Fetch %s via %s", FetchScheduler::jobName(job),
+                     covered ? "WebSocket" : "polling");
+    }
+}
+
+void FetchWorker::recordHistory(FetchJob job) {
+    // A 304 still counts: the value held for another interval
+    if (job == FETCH_PRICE) {
+        historyStore.append(HISTORY_PRICE, snapshot.priceUSD);
+
+        uint32_t nowS = wallClockNow();
+        if (nowS != 0 && priceChanges.add(nowS, snapshot.priceUSD)) {
+            for (int i = 0; i < CHANGE_WINDOW_COUNT; i++) {
+                snapshot.priceChange[i] = priceChanges.get((ChangeWindow)i);
+            }
+        }
+
+        // The price file is what the next boot replays
+        uint32_t now = millis();
+        if (!priceLogged || now - lastPriceLogMs >= FETCH_PRICE_LOG_MS) {
+            sdLogger.logPrice(snapshot.priceUSD, snapshot.priceEUR);
+            lastPriceLogMs = now;
+            priceLogged = true;
+        }
+    } else if (job == FETCH_MEMPOOL) {
+        historyStore.append(HISTORY_FEE_FAST, snapshot.feeFast);
+        historyStore.append(HISTORY_MEMPOOL_COUNT, snapshot.mempoolCount);
+
+        uint32_t now = millis();
+        if (!mempoolLogged || now - lastMempoolLogMs >= FETCH_MEMPOOL_LOG_MS) {
+            sdLogger.logMempool(snapshot.mempoolCount, snapshot.mempoolSize);
+            lastMempoolLogMs = now;
+            mempoolLogged = true;
+        }
+        if (!feeLogged || now - lastFeeLogMs >= FETCH_FEE_LOG_MS) {
+            sdLogger.logFees(snapshot.feeFast, snapshot.feeMedium, snapshot.feeSlow);
+            lastFeeLogMs = now;
+            feeLogged = true;
+        }
+    }
+}
+
+void FetchWorker::bootstrapHistory() {
+    uint32_t started = millis();
+    int samples = sdLogger.readPriceHistory(FETCH_HISTORY_DAYS, replaySample, this);
+    if (samples == 0) return;
+
+    // The change windows are filled in with the first live price
+    Serial.printf("✓ Price history: %d samples replayed from SD in %lums\n", samples, millis() - started);
+    sdLogger.logf(LOG_INFO, "Price history: replayed %d samples in %lu ms",
+                 samples, millis() - started);
+}
+
+void FetchWorker::replaySample(uint32_t time, float usd, void* ctx) {
+    FetchWorker* self = static_cast<FetchWorker*>(ctx);
+    self->priceChanges.add(time, usd);
+    historyStore.appendAt(HISTORY_PRICE, time, usd);
+}
+
+void FetchWorker::logNewBlock() {
+    // One logged row per block, whether it arrived by push or poll; a tip
+    // without details yet is logged once they have been fetched
+    if (snapshot.blockHeight == lastLoggedBlock || snapshot.blockHash[0] == '\0') {
+        return;
+    }
+
+    sdLogger.logBlock(snapshot.blockHeight, snapshot.blockTxCount,
+                      snapshot.blockTime, snapshot.blockSize);
+    lastLoggedBlock = snapshot.blockHeight;
+}
+
+FetchJob FetchWorker::jobForTopic(PushTopic topic) {
+    switch (topic) {
+        case PUSH_TOPIC_PRICE: return FETCH_PRICE;
+        case PUSH_TOPIC_BLOCK: return FETCH_BLOCK;
+        case PUSH_TOPIC_MEMPOOL: return FETCH_MEMPOOL;
+        default: return FETCH_JOB_COUNT;
+    }
+}
+
+bool FetchWorker::runJob(FetchJob job) {
+    switch (job) {
+        case FETCH_PRICE:
+            if (mempool.fetchPrice(snapshot)) {
+                Serial.printf("Price: $%.0f\n", snapshot.priceUSD);
+                recordHistory(FETCH_PRICE);
+                sampleIndicators(millis());
+                return true;
+            }
+            return false;
+
+        case FETCH_BLOCK:
+            if (mempool.fetchBlockHeight(snapshot)) {
+                Serial.printf("Block: %lu\n", snapshot.blockHeight);
+                return true;
+            }
+            return false;
+
+        case FETCH_MEMPOOL:
+            if (mempool.fetchMempool(snapshot)) {
+                Serial.printf("Mempool: %lu TX, Fee: %d sat/vB\n",
+                             snapshot.mempoolCount, snapshot.feeFast);
+                recordHistory(FETCH_MEMPOOL);
+                return true;
+            }
+            return false;
+
+        case FETCH_AI_SIGNALS:
+            return fetchAISignals();
+
+        default:
+            return false;
+    }
+}
+
+bool FetchWorker::aiCallNeeded(uint32_t now) const {
+    if (aiForced || !hasAIAnswer) return true;
+    if (indicators.peekEvents() != 0) return true;
+    return now - lastAIAnswerMs >= FETCH_AI_MAX_AGE_MS;
+}
+
+void FetchWorker::sampleIndicators(uint32_t now) {
+    uint8_t before = indicators.peekEvents();
+    if (!indicators.update(snapshot.priceUSD, now)) return;
+
+    strcpy(snapshot.localSignal, IndicatorEngine::signalName(indicators.signal()));
+    snapshot.localConfidence = indicators.confidence();
+    int32_t rsi = indicators.rsiX100();
+    snapshot.rsi = rsi < 0 ? -1.0f : rsi / 100.0f;
+    snapshot.bandWidthPct = indicators.bandWidthPpm() / 10000.0f;
+    snapshot.volatilityPct = indicators.hourlyVolatilityPpm() / 10000.0f;
+
+    uint8_t raised = indicators.peekEvents() & ~before;
+    if (raised) {
+        Serial.printf("Indicators: local %s %u%%, RSI %.1f (events 0x%02X)\n",
+                     snapshot.localSignal, snapshot.localConfidence, snapshot.rsi, raised);
+        sdLogger.logf(LOG_INFO, "Indicator events 0x%02X: local %s, RSI %.1f, vol %.2f%%/h",
+                     raised, snapshot.localSignal, snapshot.rsi, snapshot.volatilityPct);
+    }
+}
+
+bool FetchWorker::fetchAISignals() {
+    // Nothing crossed a threshold since the last answer: keep it
+    aiSkipped = !aiCallNeeded(millis());
+    if (aiSkipped) {
+        aiSkips++;
+        return true;
+    }
+
+    if (WiFi.status() != WL_CONNECTED) {
+        Serial.println("❌ AI signal fetch: WiFi not connected");
+        return false;
+    }
+
+    // Cached answers are only usable once SNTP has set the clock (first pass after boot)
+    for (int waited = 0; wallClockNow() == 0 && waited < FETCH_NTP_WAIT_MS; waited += 100) {
+        vTaskDelay(pdMS_TO_TICKS(100));
+    }
+
+    Serial.println("Fetching AI signals...");
+    MarketSignals signals;
+
+    // The race can take up to AI_RACE_TIMEOUT_MS: keep applying WebSocket pushes
+    // meanwhile. They change the snapshot, so the request (and cache key) is a copy.
+    BTCData request = snapshot;
+#if MEMPOOL_WS_ENABLED
+    bool answered = aiRouter.fetchMarketSignals(request, signals, pumpDuringRace, this);
+#else
+    bool answered = aiRouter.fetchMarketSignals(request, signals);
+#endif
+    if (!answered) {
+        Serial.println("❌ Failed to fetch AI signals");
+        return false;
+    }
+
+    if (aiRouter.wasCached()) {
+        aiCached++;
+    } else {
+        aiCalls++;
+    }
+    aiForced = false;
+    hasAIAnswer = true;
+    lastAIAnswerMs = millis();
+    indicators.clearEvents();
+
+    strcpy(snapshot.dcaRecommendation, signals.dca);
+    strcpy(snapshot.tradingSignal, signals.signal);
+    strcpy(snapshot.signalTimeframe, signals.timeframe);
+    snapshot.signalConfidence = signals.confidence;
+    Serial.printf("✓ DCA: %s, Trading Signal (%s): %s, confidence %u%%\n",
+                 snapshot.dcaRecommendation, snapshot.signalTimeframe,
+                 snapshot.tradingSignal, snapshot.signalConfidence);
+    return true;
+}
+
+void FetchWorker::postResult(FetchJob job, bool success, uint32_t latencyMs) {
+    if (resultQueue == nullptr) return;
+
+    FetchResult result;
+    result.job = job;
+    result.success = success;
+    result.latencyMs = latencyMs;
+    result.data = snapshot;
+
+    if (success) {
+        warmStart.record(job, snapshot);
+    }
+
+    // Never block the worker on a slow UI: drop the result if the queue is full
+    if (xQueueSend(resultQueue, &result, 0) != pdTRUE) {
+        Serial.printf("⚠️  Fetch worker: result queue full, dropped %s update\n",
+                     FetchScheduler::jobName(job));
+    }
+}
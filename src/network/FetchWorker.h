@@ -0,0 +1,191 @@
+#ifndef FETCH_WORKER_H
+#define FETCH_WORKER_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+#include "FetchScheduler.h"
+#include "../api/BTCData.h"
+#include "../api/MempoolClient.h"
+#include "../api/Indicators.h"
+#include "MempoolSocket.h"
+
+// Worker task settings
+#define FETCH_WORKER_CORE 0            // Arduino loop() runs on core 1
+#define FETCH_WORKER_STACK_SIZE 12288  // TLS handshakes need ~8KB of stack
+#define FETCH_WORKER_PRIORITY 1
+#define FETCH_RESULT_QUEUE_DEPTH 8
+
+// Fetch intervals (price, block and mempool come from ConfigManager)
+#define FETCH_AI_INTERVAL 300000       // AI signals: 5 minutes
+#define FETCH_AI_MAX_AGE_MS 3600000    // Ask the AI at least hourly without indicator events
+#define FETCH_PUSH_FALLBACK_INTERVAL 300000  // Safety poll while the WebSocket pushes a topic
+#define FETCH_IDLE_WAIT_MS 1000        // Longest sleep when nothing is due
+
+// SNTP servers for the wall clock (AI cache TTLs, log timestamps)
+#define FETCH_NTP_SERVER_1 "pool.ntp.org"
+#define FETCH_NTP_SERVER_2 "time.google.com"
+#define FETCH_NTP_WAIT_MS 3000         // Longest wait for the first sync before an AI fetch
+
+// Adaptive cadence (see FetchScheduler::setAdaptive)
+#define FETCH_JITTER_PCT 10            // +/- 10% on every reschedule
+#define FETCH_SLOW_FACTOR 4            // Stable values back off to 4x the configured interval
+#define FETCH_BLOCK_FAST_PCT 25        // Tip polled at 1/4 interval right after a new block
+#define FETCH_PRICE_STABLE_PCT 0.05f   // Price moves below 0.05% count as unchanged
+
+// Price history
+#define FETCH_PRICE_LOG_MS 30000       // At most one logged price per 30s (pushes arrive faster)
+#define FETCH_MEMPOOL_LOG_MS 300000    // One logged mempool snapshot per 5 minutes
+#define FETCH_FEE_LOG_MS 60000         // One logged fee sample per minute
+#define FETCH_HISTORY_DAYS 8           // Daily price files replayed at start (7d change plus today)
+
+// Completed fetch handed from the worker to the UI task
+struct FetchResult {
+    FetchJob job;
+    bool success;
+    uint32_t latencyMs;
+    BTCData data;  // Worker snapshot after the job ran
+};
+
+// Worker state printed by STATUS; the worker publishes a copy every loop
+struct FetchWorkerStatus {
+    FetchJobStats jobs[FETCH_JOB_COUNT];
+    uint32_t averageLatencyMs[FETCH_JOB_COUNT];
+    uint32_t currentIntervalMs[FETCH_JOB_COUNT];
+    uint32_t baseIntervalMs[FETCH_JOB_COUNT];
+
+    uint32_t indicatorSamples;
+    bool indicatorsReady;
+    LocalSignal localSignal;
+    uint8_t localConfidence;
+    int32_t rsiX100;
+    uint32_t bandWidthPpm;
+    uint32_t hourlyVolatilityPpm;
+    uint8_t indicatorEvents;
+
+    uint32_t aiCalls;
+    uint32_t aiCached;
+    uint32_t aiSkips;
+    PriceChange priceChange[CHANGE_WINDOW_COUNT];
+
+    MempoolCacheStatus cache;
+    MempoolSocketStatus socket;
+};
+
+/**
+ * FetchWorker - Background task that owns all HTTP traffic
+ *
+ * Runs on core 0 so blocking HTTPS requests (10s mempool timeouts, 30s Gemini
+ * timeouts) never stall touch handling or rendering on the loop task.
+ * Results are posted to a FreeRTOS queue; the UI drains it with poll() and
+ * merges each result into its own BTCData with applyResult().
+ *
+ * Price, block and mempool are polled at the intervals stored in ConfigManager,
+ * each on its own cadence: a source whose value is stable backs off, and the
+ * block tip is polled faster right after a new block.
+ *
+ * Price, block and mempool data normally arrive as pushes on the mempool.space
+ * WebSocket (MempoolSocket). Their REST polls drop to a slow safety interval
+ * while a topic is being pushed and return to the configured interval as soon
+ * as it goes quiet or the socket disconnects.
+ *
+ * At start the worker replays the last week of price files from SD into the
+ * history store and the 1h/24h/7d change windows, then keeps both current
+ * with every price it sees.
+ *
+ * Every price also feeds the on-device IndicatorEngine, which fills the local
+ * signal fields of the snapshot. The AI job only calls out when the indicators
+ * raised an event since the last answer, the answer is FETCH_AI_MAX_AGE_MS
+ * old, or the user asked for a refresh; otherwise the run is skipped.
+ *
+ * The worker keeps its own BTCData snapshot, which is only touched from the
+ * worker task. The UI copy is only touched from the loop task. STATUS runs on
+ * the loop task too, so it prints a FetchWorkerStatus the worker copies out
+ * under a lock instead of reading the worker's fields.
+ */
+class FetchWorker {
+public:
+    FetchWorker();
+
+    // Create the result queue and start the task (safe to call repeatedly)
+    bool begin();
+    bool isRunning() const { return taskHandle != nullptr; }
+
+    // Ask the worker to run every job as soon as possible
+    void requestRefresh();
+
+    // Re-read the poll intervals from ConfigManager (applied on the worker task)
+    void reloadIntervals();
+
+    // Non-blocking: fetch the next completed result for the UI task
+    bool poll(FetchResult& result);
+
+    // Copy the fields owned by result.job into target
+    static void applyResult(const FetchResult& result, BTCData& target);
+
+    // Print per-job timing statistics to serial (from the last published copy)
+    void printStatus();
+
+private:
+    TaskHandle_t taskHandle;
+    QueueHandle_t resultQueue;
+    volatile bool refreshRequested;
+    volatile bool intervalsChanged;
+
+    // Worker-task state
+    FetchScheduler scheduler;
+    MempoolClient mempool;
+    MempoolSocket pushSocket;
+    bool pushCovered[PUSH_TOPIC_COUNT];
+    uint32_t pollIntervalMs[FETCH_JOB_COUNT];
+    BTCData snapshot;
+    BTCData previous;  // Snapshot before the running job, for change detection
+    unsigned long lastLoggedBlock;
+
+    // Rolling 1h/24h/7d price change
+    PriceChanges priceChanges;
+    uint32_t lastPriceLogMs;
+    bool priceLogged;
+    uint32_t lastMempoolLogMs;
+    bool mempoolLogged;
+    uint32_t lastFeeLogMs;
+    bool feeLogged;
+
+    // Local indicators and AI gating
+    IndicatorEngine indicators;
+    bool aiForced;            // User refresh: call the AI whatever the indicators say
+    bool aiSkipped;           // Last AI run was skipped by the gate
+    bool hasAIAnswer;
+    uint32_t lastAIAnswerMs;
+    uint32_t aiCalls;         // Answers from a provider request
+    uint32_t aiCached;        // Answers from AICache, nothing sent
+    uint32_t aiSkips;
+
+    // Copy for STATUS, guarded by the status lock
+    FetchWorkerStatus published;
+
+    static void taskEntry(void* arg);
+    void run();
+    bool runJob(FetchJob job);
+    bool fetchAISignals();
+    bool aiCallNeeded(uint32_t now) const;
+    void sampleIndicators(uint32_t now);
+    void postResult(FetchJob job, bool success, uint32_t latencyMs);
+    void publishStatus(uint32_t now);
+    void pumpSocket(uint32_t now);
+    static void pumpDuringRace(void* ctx);  // AIRouter idle callback
+    void recordHistory(FetchJob job);
+    void bootstrapHistory();
+    static void replaySample(uint32_t time, float usd, void* ctx);
+    void logNewBlock();
+    void loadIntervals();
+    void applyPollCadence(FetchJob job);
+    bool hasChanged(FetchJob job) const;
+    static FetchJob jobForTopic(PushTopic topic);
+};
+
+// Global instance
+extern FetchWorker fetchWorker;
+
+#endif // FETCH_WORKER_H
@@ -0,0 +1,325 @@
+#ifndef HEDGED_RACE_H
+#define HEDGED_RACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Hedging settings
+#define HEDGE_MAX_PROVIDERS 2
+#define HEDGE_PERCENTILE 95            // Hedge once the primary is slower than this percentile
+#define HEDGE_DEFAULT_MS 8000          // Budget while the primary has too few samples
+#define HEDGE_MIN_MS 1500              // Never hedge sooner (every blip would cost a second request)
+#define HEDGE_MAX_MS 20000
+#define HEDGE_MIN_SAMPLES 5            // Samples before a provider's percentiles are trusted
+#define HEDGE_RANK_PERCENTILE 50       // Primary = lowest median; the tail is what hedging covers
+#define HEDGE_SWITCH_PCT 75            // Swap primary when the other median is below 75% of it
+
+// Latency histogram
+#define LATENCY_BUCKETS 14
+#define LATENCY_WINDOW 64              // Counts are halved at this many samples so old data fades
+#define LATENCY_OVERFLOW_MS 30000      // Reported for the last bucket (failures, timeouts)
+
+/**
+ * LatencyHistogram - Fixed buckets from 250ms to 24s plus an overflow bucket
+ *
+ * Percentiles are the upper edge of the bucket holding the requested sample,
+ * which is precise enough to pick a hedge delay. Failed requests are kept
+ * apart: percentile() ranks them above every answer, so a provider that
+ * errors looks as slow as one that times out, while answerPercentile() only
+ * looks at answers (a failure fails over at once, it needs no hedge). Once
+ * LATENCY_WINDOW samples are held every count is halved, letting recent
+ * behaviour dominate.
+ */
+class LatencyHistogram {
+public:
+    LatencyHistogram() { clear(); }
+
+    void clear() {
+        memset(counts, 0, sizeof(counts));
+        failures = 0;
+        answers = 0;
+    }
+
+    void record(uint32_t ms) {
+        int i = 0;
+        while (i < LATENCY_BUCKETS - 1 && ms > bucketLimit(i)) i++;
+        decay();
+        counts[i]++;
+        answers++;
+    }
+
+    void recordFailure() {
+        decay();
+        failures++;
+    }
+
+    // Upper edge of the bucket holding the pct-th percentile, failures
+    // counted as LATENCY_OVERFLOW_MS; 0 when empty
+    uint32_t percentile(uint8_t pct) const {
+        return find(pct, samples());
+    }
+
+    // Same over answers only
+    uint32_t answerPercentile(uint8_t pct) const {
+        return find(pct, answers);
+    }
+
+    uint32_t samples() const { return answers + failures; }
+    uint32_t getAnswers() const { return answers; }
+    uint16_t getFailures() const { return failures; }
+    uint16_t count(int bucket) const { return counts[bucket]; }
+
+    static uint32_t bucketLimit(int bucket) {
+        static const uint32_t LIMITS[LATENCY_BUCKETS] = {
+            250, 500, 750, 1000, 1500, 2000, 3000, 4000, 6000, 8000, 12000, 16000, 24000,
+            LATENCY_OVERFLOW_MS
+        };
+        return LIMITS[bucket];
+    }
+
+private:
+    uint16_t counts[LATENCY_BUCKETS];
+    uint16_t failures;
+    uint32_t answers;
+
+    // Answers fill the buckets in order; failures sit above the last one
+    uint32_t find(uint8_t pct, uint32_t total) const {
+        if (total == 0) return 0;
+        uint32_t rank = (total * pct + 99) / 100;
+        if (rank == 0) rank = 1;
+
+        uint32_t seen = 0;
+        for (int i = 0; i < LATENCY_BUCKETS; i++) {
+            seen += counts[i];
+            if (seen >= rank) return bucketLimit(i);
+        }
+        return LATENCY_OVERFLOW_MS;
+    }
+
+    void decay() {
+        if (samples() < LATENCY_WINDOW) return;
+        answers = 0;
+        for (int i = 0; i < LATENCY_BUCKETS; i++) {
+            counts[i] /= 2;  // A single old stall must be able to drop out
+            answers += counts[i];
+        }
+        failures /= 2;
+    }
+};
+
+// Lifetime counters per provider
+struct HedgeProviderStats {
+    uint32_t attempts;   // Requests that reached the network
+    uint32_t failures;
+    uint32_t wins;       // Races this provider answered
+};
+
+/**
+ * HedgePolicy - Picks the primary provider and the hedge delay
+ *
+ * Every completed request feeds its provider's histogram. The primary is the
+ * provider with the lower median (a provider failing most requests has its
+ * median in the overflow bucket); the other takes over only when its median
+ * is clearly better (HEDGE_SWITCH_PCT) and both have HEDGE_MIN_SAMPLES, so the
+ * choice does not flap on noise. Ranking on the median rather than the tail
+ * keeps a fast provider with occasional stalls as primary: its stalls are
+ * what the hedge is for. The hedge delay is the primary's HEDGE_PERCENTILE
+ * answer latency clamped to [HEDGE_MIN_MS, HEDGE_MAX_MS], so about one
+ * request in twenty gets a second, parallel attempt.
+ *
+ * Pure bookkeeping with no Arduino code; the caller serializes access.
+ */
+class HedgePolicy {
+public:
+    explicit HedgePolicy(uint8_t defaultPrimary = 0)
+        : primary(defaultPrimary < HEDGE_MAX_PROVIDERS ? defaultPrimary : 0) {
+        memset(stats, 0, sizeof(stats));
+    }
+
+    // A request that reached the network finished
+    void record(uint8_t provider, uint32_t ms, bool ok) {
+        if (provider >= HEDGE_MAX_PROVIDERS) return;
+        stats[provider].attempts++;
+        if (ok) {
+            latency[provider].record(ms);
+        } else {
+            stats[provider].failures++;
+            latency[provider].recordFailure();
+        }
+        updatePrimary();
+    }
+
+    void recordWin(uint8_t provider) {
+        if (provider < HEDGE_MAX_PROVIDERS) stats[provider].wins++;
+    }
+
+    /**
+     * Providers to try, primary first, skipping those marked unavailable
+     * (no API key, circuit open, previous attempt still running).
+     * Returns how many were written to out.
+     */
+    uint8_t order(const bool* available, uint8_t count, uint8_t* out) const {
+        uint8_t n = 0;
+        if (primary < count && available[primary]) out[n++] = primary;
+        for (uint8_t i = 0; i < count && i < HEDGE_MAX_PROVIDERS; i++) {
+            if (i != primary && available[i]) out[n++] = i;
+        }
+        return n;
+    }
+
+    // How long provider may take before a second provider is started
+    uint32_t hedgeDelayMs(uint8_t provider) const {
+        if (provider >= HEDGE_MAX_PROVIDERS || latency[provider].getAnswers() < HEDGE_MIN_SAMPLES) {
+            return HEDGE_DEFAULT_MS;
+        }
+        uint32_t ms = latency[provider].answerPercentile(HEDGE_PERCENTILE);
+        if (ms < HEDGE_MIN_MS) return HEDGE_MIN_MS;
+        if (ms > HEDGE_MAX_MS) return HEDGE_MAX_MS;
+        return ms;
+    }
+
+    uint8_t getPrimary() const { return primary; }
+    const LatencyHistogram& getLatency(uint8_t provider) const { return latency[provider]; }
+    const HedgeProviderStats& getStats(uint8_t provider) const { return stats[provider]; }
+
+private:
+    LatencyHistogram latency[HEDGE_MAX_PROVIDERS];
+    HedgeProviderStats stats[HEDGE_MAX_PROVIDERS];
+    uint8_t primary;
+
+    void updatePrimary() {
+        if (latency[primary].samples() < HEDGE_MIN_SAMPLES) return;
+        uint32_t current = latency[primary].percentile(HEDGE_RANK_PERCENTILE);
+
+        for (uint8_t i = 0; i < HEDGE_MAX_PROVIDERS; i++) {
+            if (i == primary || latency[i].samples() < HEDGE_MIN_SAMPLES) continue;
+            uint32_t other = latency[i].percentile(HEDGE_RANK_PERCENTILE);
+            if (other * 100 < current * HEDGE_SWITCH_PCT) {
+                primary = i;
+                current = other;
+            }
+        }
+    }
+};
+
+// Progress of one provider within a race
+enum HedgeAttemptState {
+    ATTEMPT_PENDING = 0,  // Not started
+    ATTEMPT_RUNNING,
+    ATTEMPT_OK,
+    ATTEMPT_FAILED
+};
+
+/**
+ * HedgedRace - One request raced across providers
+ *
+ * The first provider in the order starts at once. The next one starts when
+ * the running attempts have taken longer than the hedge delay, or right away
+ * when every running attempt has failed (failover). The first valid answer
+ * wins; attempts still running at that point are to be cancelled.
+ *
+ * The caller owns the I/O and the clock: it starts whatever launch() returns,
+ * reports each outcome with finish(), and sleeps at most msUntilLaunch() in
+ * between.
+ */
+class HedgedRace {
+public:
+    HedgedRace() { begin(nullptr, 0, 0, 0); }
+
+    void begin(const uint8_t* providerOrder, uint8_t count, uint32_t hedgeAfterMs, uint32_t nowMs) {
+        if (count > HEDGE_MAX_PROVIDERS) count = HEDGE_MAX_PROVIDERS;
+        for (uint8_t i = 0; i < count; i++) order[i] = providerOrder[i];
+        orderCount = count;
+        launched = 0;
+        hedgeAfter = hedgeAfterMs;
+        lastLaunchMs = nowMs;
+        startMs = nowMs;
+        finishMs = nowMs;
+        winner = -1;
+        hedged = false;
+        memset(states, 0, sizeof(states));
+    }
+
+    /**
+     * Provider to start now, or -1. Call in a loop until it returns -1;
+     * the returned provider is marked running.
+     */
+    int launch(uint32_t nowMs) {
+        if (done() || launched >= orderCount) return -1;
+
+        bool first = launched == 0;
+        bool late = nowMs - lastLaunchMs >= hedgeAfter;
+        if (!first && !late && runningCount() > 0) return -1;
+
+        uint8_t provider = order[launched++];
+        if (runningCount() > 0) hedged = true;
+        states[provider] = ATTEMPT_RUNNING;
+        lastLaunchMs = nowMs;
+        return provider;
+    }
+
+    // Longest the caller may wait for a result before calling launch() again
+    uint32_t msUntilLaunch(uint32_t nowMs) const {
+        if (done() || launched >= orderCount) return UINT32_MAX;
+        if (launched == 0 || runningCount() == 0) return 0;
+        uint32_t elapsed = nowMs - lastLaunchMs;
+        return elapsed >= hedgeAfter ? 0 : hedgeAfter - elapsed;
+    }
+
+    /**
+     * An attempt finished. Returns true when this answer wins the race;
+     * results after the race is decided are ignored.
+     */
+    bool finish(uint8_t provider, bool ok, uint32_t nowMs) {
+        if (provider >= HEDGE_MAX_PROVIDERS || states[provider] != ATTEMPT_RUNNING) return false;
+
+        states[provider] = ok ? ATTEMPT_OK : ATTEMPT_FAILED;
+        if (winner >= 0) return false;
+
+        if (ok) {
+            winner = provider;
+            finishMs = nowMs;
+            return true;
+        }
+        if (done()) finishMs = nowMs;
+        return false;
+    }
+
+    // Won, or every provider has been tried and failed
+    bool done() const {
+        return winner >= 0 || (launched >= orderCount && runningCount() == 0);
+    }
+
+    // Attempts to cancel once the race is done
+    bool isRunning(uint8_t provider) const {
+        return provider < HEDGE_MAX_PROVIDERS && states[provider] == ATTEMPT_RUNNING;
+    }
+
+    int getWinner() const { return winner; }
+    bool wasHedged() const { return hedged; }                   // Two attempts ran at once
+    uint8_t getLaunched() const { return launched; }
+    uint32_t getElapsedMs() const { return finishMs - startMs; }  // Start to decision
+    HedgeAttemptState getState(uint8_t provider) const { return (HedgeAttemptState)states[provider]; }
+
+private:
+    uint8_t order[HEDGE_MAX_PROVIDERS];
+    uint8_t orderCount;
+    uint8_t launched;
+    uint8_t states[HEDGE_MAX_PROVIDERS];
+    uint32_t hedgeAfter;
+    uint32_t lastLaunchMs;
+    uint32_t startMs;
+    uint32_t finishMs;
+    int winner;
+    bool hedged;
+
+    uint8_t runningCount() const {
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < HEDGE_MAX_PROVIDERS; i++) {
+            if (states[i] == ATTEMPT_RUNNING) n++;
+        }
+        return n;
+    }
+};
+
+#endif // HEDGED_RACE_H
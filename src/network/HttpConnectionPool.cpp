@@ -0,0 +1,148 @@
+#include "HttpConnectionPool.h"
+
+// Global instance
+HttpConnectionPool httpPool;
+
+// Guards table and the open flags: the worker writes them, status commands read
+// them from the loop task. The worker's own reads need no lock.
+static portMUX_TYPE poolLock = portMUX_INITIALIZER_UNLOCKED;
+
+HttpConnectionPool::HttpConnectionPool() {
+    for (int i = 0; i < HTTP_POOL_MAX_HOSTS; i++) {
+        // Same trust model as HTTPClient::begin(url) without a CA bundle,
+        // which the per-request clients used before pooling
+        slots[i].client.setInsecure();
+        slots[i].http.setReuse(true);
+        slots[i].newConnection = false;
+        slots[i].startMs = 0;
+        slots[i].open = false;
+    }
+}
+
+HTTPClient* HttpConnectionPool::begin(const char* url, uint16_t timeoutMs) {
+    char host[POOL_HOST_MAX_LEN];
+    if (!parseUrlHost(url, host, sizeof(host))) {
+        Serial.printf("❌ HTTP pool: invalid URL %s\n", url);
+        return nullptr;
+    }
+
+    unsigned long now = millis();
+
+    // Server-side keep-alive has probably expired; start clean instead of
+    // writing into a half-closed socket
+    int existing = table.find(host);
+    if (existing >= 0 && table.isIdle(existing, now, HTTP_POOL_MAX_IDLE_MS)) {
+        closeSlot(existing);
+    }
+
+    bool evicted = false;
+    portENTER_CRITICAL(&poolLock);
+    int slot = table.acquire(host, now, evicted);
+    portEXIT_CRITICAL(&poolLock);
+    if (evicted) {
+        Serial.printf("HTTP pool: evicting connection for new host %s\n", host);
+        closeSlot(slot);
+    }
+
+    Slot& s = slots[slot];
+    s.newConnection = !s.client.connected();
+    s.startMs = now;
+
+    s.http.setReuse(true);
+    s.http.setTimeout(timeoutMs);
+    s.http.setConnectTimeout(timeoutMs);
+    if (!s.http.begin(s.client, url)) {
+        portENTER_CRITICAL(&poolLock);
+        table.record(slot, s.newConnection, false, 0);
+        portEXIT_CRITICAL(&poolLock);
+        return nullptr;
+    }
+
+    return &s.http;
+}
+
+void HttpConnectionPool::end(HTTPClient* http, int httpCode) {
+    int slot = slotFor(http);
+    if (slot < 0) return;
+
+    Slot& s = slots[slot];
+    uint32_t latency = millis() - s.startMs;
+    bool success = httpCode > 0 && httpCode < 400;
+
+    // end() keeps the TLS session open if the server allowed keep-alive
+    s.http.end();
+
+    // Connection-level errors leave the socket in an unknown state
+    if (httpCode <= 0) {
+        s.client.stop();
+    }
+    bool open = s.client.connected();
+
+    portENTER_CRITICAL(&poolLock);
+    table.record(slot, s.newConnection, success, latency);
+    s.open = open;
+    portEXIT_CRITICAL(&poolLock);
+}
+
+void HttpConnectionPool::closeAll() {
+    for (int i = 0; i < HTTP_POOL_MAX_HOSTS; i++) {
+        closeSlot(i);
+    }
+}
+
+void HttpConnectionPool::printStatus() {
+    // Copy under the lock, print outside it
+    ConnectionSlotTable<HTTP_POOL_MAX_HOSTS> copy;
+    bool open[HTTP_POOL_MAX_HOSTS];
+    portENTER_CRITICAL(&poolLock);
+    copy = table;
+    for (int i = 0; i < HTTP_POOL_MAX_HOSTS; i++) open[i] = slots[i].open;
+    portEXIT_CRITICAL(&poolLock);
+
+    Serial.println("HTTP Connection Pool:");
+
+    bool any = false;
+    for (int i = 0; i < HTTP_POOL_MAX_HOSTS; i++) {
+        if (!copy.isUsed(i)) continue;
+        any = true;
+
+        const HostStats& st = copy.getStats(i);
+        Serial.printf("  %s [%s] req=%u handshakes=%u reused=%u fail=%u last=%ums avg=%ums max=%ums\n",
+                     copy.host(i), open[i] ? "open" : "closed",
+                     st.requests, st.handshakes, st.reused(), st.failures,
+                     st.lastLatencyMs, st.averageLatencyMs(), st.maxLatencyMs);
+    }
+
+    if (!any) {
+        Serial.println("  (no connections yet)");
+    }
+    if (copy.getEvictions() > 0) {
+        Serial.printf("  Evictions: %u\n", copy.getEvictions());
+    }
+}
+
+bool HttpConnectionPool::getStats(const char* host, HostStats& stats) const {
+    portENTER_CRITICAL(&poolLock);
+    int slot = table.find(host);
+    if (slot >= 0) stats = table.getStats(slot);
+    portEXIT_CRITICAL(&poolLock);
+    return slot >= 0;
+}
+
+int HttpConnectionPool::slotFor(const HTTPClient* http) const {
+    for (int i = 0; i < HTTP_POOL_MAX_HOSTS; i++) {
+        if (&slots[i].http == http) return i;
+    }
+    return -1;
+}
+
+void HttpConnectionPool::closeSlot(int slot) {
+    if (slot < 0 || slot >= HTTP_POOL_MAX_HOSTS) return;
+
+    slots[slot].http.end();
+    slots[slot].client.stop();
+
+    portENTER_CRITICAL(&poolLock);
+    slots[slot].open = false;
+    portEXIT_CRITICAL(&poolLock);
+}
@@ -0,0 +1,71 @@
+#ifndef HTTP_CONNECTION_POOL_H
+#define HTTP_CONNECTION_POOL_H
+
+#include <Arduino.h>
+#include <WiFiClientSecure.h>
+#include <HTTPClient.h>
+#include "ConnectionSlots.h"
+
+// Pool settings
+#define HTTP_POOL_MAX_HOSTS 2           // Each open TLS session holds ~40KB of heap
+#define HTTP_POOL_MAX_IDLE_MS 50000     // Close before typical 60s server keep-alive timeouts
+
+/**
+ * HttpConnectionPool - Keep-alive HTTPS clients, one per host
+ *
+ * Every request to the same host goes through the same WiFiClientSecure, so
+ * the TCP connection and TLS session stay open between requests and the
+ * 30s fetch cycle pays one handshake instead of four. Tracks per-host
+ * request latency and how many requests needed a new handshake.
+ *
+ * Requests are only made from the fetch worker task. The host table and the
+ * open flags are updated under a spinlock so printStatus() can copy them from
+ * the loop task (STATUS, NET_STATUS) while the worker evicts or reopens slots.
+ *
+ * Usage:
+ *   HTTPClient* http = httpPool.begin(url, timeoutMs);
+ *   if (http) {
+ *       int code = http->GET();
+ *       ... read the full body ...
+ *       httpPool.end(http, code);
+ *   }
+ */
+class HttpConnectionPool {
+public:
+    HttpConnectionPool();
+
+    // Prepare the pooled client for url's host (nullptr if the URL is invalid)
+    HTTPClient* begin(const char* url, uint16_t timeoutMs);
+
+    // Finish a request started with begin(); keeps the socket open when possible
+    void end(HTTPClient* http, int httpCode);
+
+    // Close every pooled connection (e.g. after WiFi reconnects)
+    void closeAll();
+
+    // Print per-host statistics to serial (safe from any task)
+    void printStatus();
+
+    // Copy of host's statistics; false if it has no slot (safe from any task)
+    bool getStats(const char* host, HostStats& stats) const;
+
+private:
+    struct Slot {
+        WiFiClientSecure client;
+        HTTPClient http;
+        bool newConnection;       // Current request had to open a connection
+        unsigned long startMs;    // Current request start time
+        bool open;                // Socket kept open after the last request (guarded)
+    };
+
+    Slot slots[HTTP_POOL_MAX_HOSTS];
+    ConnectionSlotTable<HTTP_POOL_MAX_HOSTS> table;
+
+    int slotFor(const HTTPClient* http) const;
+    void closeSlot(int slot);
+};
+
+// Global instance
+extern HttpConnectionPool httpPool;
+
+#endif // HTTP_CONNECTION_POOL_H
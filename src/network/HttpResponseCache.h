@@ -0,0 +1,153 @@
+#ifndef HTTP_RESPONSE_CACHE_H
+#define HTTP_RESPONSE_CACHE_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Cache settings
+#define HTTP_CACHE_ENTRIES 6           // One per polled endpoint, plus spare
+#define HTTP_CACHE_URL_LEN 96
+#define HTTP_CACHE_VALIDATOR_LEN 64    // ETag / Last-Modified header value
+#define HTTP_CACHE_VALUE_SIZE 64       // Largest parsed value (MempoolStats)
+#define HTTP_CACHE_LOG_EVERY 20        // Log the hit rate every N responses
+
+// One cached endpoint
+struct HttpCacheEntry {
+    bool used;
+    char url[HTTP_CACHE_URL_LEN];
+    char etag[HTTP_CACHE_VALIDATOR_LEN];
+    char lastModified[HTTP_CACHE_VALIDATOR_LEN];
+    uint8_t value[HTTP_CACHE_VALUE_SIZE];
+    uint8_t valueSize;
+    uint32_t lastUsedMs;
+    uint32_t hits;       // 304 answered from cache
+    uint32_t misses;     // Full 200 responses
+
+    bool hasValidators() const { return etag[0] != '\0' || lastModified[0] != '\0'; }
+};
+
+/**
+ * HttpResponseCache - Conditional GET bookkeeping keyed by URL
+ *
+ * Remembers each endpoint's ETag / Last-Modified together with the value
+ * parsed from its last full response. The next request sends If-None-Match /
+ * If-Modified-Since; a 304 then costs no body transfer and no parsing, and the
+ * cached value is handed back instead. Servers that send no validators simply
+ * never produce hits.
+ */
+class HttpResponseCache {
+public:
+    HttpResponseCache() { clear(); }
+
+    void clear() {
+        memset(entries, 0, sizeof(entries));
+        totalHits = 0;
+        totalMisses = 0;
+    }
+
+    // Cached entry for url (validators to send), or nullptr
+    const HttpCacheEntry* lookup(const char* url) const {
+        int i = find(url);
+        return i >= 0 ? &entries[i] : nullptr;
+    }
+
+    /**
+     * Record a full 200 response and its parsed value.
+     * Empty validators are allowed; the entry then only counts misses.
+     */
+    bool store(const char* url, const char* etag, const char* lastModified,
+               const void* value, size_t size, uint32_t nowMs) {
+        if (url == nullptr || size > HTTP_CACHE_VALUE_SIZE || strlen(url) >= HTTP_CACHE_URL_LEN) {
+            return false;
+        }
+
+        int i = find(url);
+        if (i < 0) {
+            i = victim();
+            memset(&entries[i], 0, sizeof(HttpCacheEntry));
+            entries[i].used = true;
+            strcpy(entries[i].url, url);
+        }
+
+        HttpCacheEntry& e = entries[i];
+        copyValidator(e.etag, etag);
+        copyValidator(e.lastModified, lastModified);
+        memcpy(e.value, value, size);
+        e.valueSize = (uint8_t)size;
+        e.lastUsedMs = nowMs;
+        e.misses++;
+        totalMisses++;
+        return true;
+    }
+
+    /**
+     * Handle a 304 for url: copy the cached value into value.
+     * Returns false if nothing suitable is cached (caller must refetch).
+     */
+    bool notModified(const char* url, void* value, size_t size, uint32_t nowMs) {
+        int i = find(url);
+        if (i < 0 || entries[i].valueSize != size) {
+            return false;
+        }
+
+        HttpCacheEntry& e = entries[i];
+        memcpy(value, e.value, size);
+        e.lastUsedMs = nowMs;
+        e.hits++;
+        totalHits++;
+        return true;
+    }
+
+    // Forget url (e.g. after a response that could not be parsed)
+    void invalidate(const char* url) {
+        int i = find(url);
+        if (i >= 0) entries[i].used = false;
+    }
+
+    uint32_t getHits() const { return totalHits; }
+    uint32_t getMisses() const { return totalMisses; }
+    uint32_t getResponses() const { return totalHits + totalMisses; }
+
+    // Percentage of responses answered by a 304
+    uint8_t hitRate() const {
+        uint32_t total = getResponses();
+        return total > 0 ? (uint8_t)((totalHits * 100 + total / 2) / total) : 0;
+    }
+
+    const HttpCacheEntry& entry(int i) const { return entries[i]; }
+    static int capacity() { return HTTP_CACHE_ENTRIES; }
+
+private:
+    HttpCacheEntry entries[HTTP_CACHE_ENTRIES];
+    uint32_t totalHits;
+    uint32_t totalMisses;
+
+    int find(const char* url) const {
+        if (url == nullptr) return -1;
+        for (int i = 0; i < HTTP_CACHE_ENTRIES; i++) {
+            if (entries[i].used && strcmp(entries[i].url, url) == 0) return i;
+        }
+        return -1;
+    }
+
+    // Free slot, else least recently used
+    int victim() const {
+        int oldest = 0;
+        for (int i = 0; i < HTTP_CACHE_ENTRIES; i++) {
+            if (!entries[i].used) return i;
+            if ((int32_t)(entries[i].lastUsedMs - entries[oldest].lastUsedMs) < 0) oldest = i;
+        }
+        return oldest;
+    }
+
+    // Over-long validators are dropped rather than truncated (a cut ETag never matches)
+    static void copyValidator(char* dst, const char* src) {
+        if (src != nullptr && strlen(src) < HTTP_CACHE_VALIDATOR_LEN) {
+            strcpy(dst, src);
+        } else {
+            dst[0] = '\0';
+        }
+    }
+};
+
+#endif // HTTP_RESPONSE_CACHE_H
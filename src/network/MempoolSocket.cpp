@@ -0,0 +1,163 @@
+#include "MempoolSocket.h"
+#include <WiFi.h>
+#include "../utils/SDLogger.h"
+
+MempoolSocket::MempoolSocket()
+    : session(esp_random()) {
+    started = false;
+    retryCheckMs = 0;
+    target = nullptr;
+    pending = 0;
+}
+
+void MempoolSocket::begin() {
+    if (started) return;
+
+#if MEMPOOL_WS_SSL
+    ws.beginSSL(MEMPOOL_WS_HOST, MEMPOOL_WS_PORT, MEMPOOL_WS_PATH);
+#else
+    ws.begin(MEMPOOL_WS_HOST, MEMPOOL_WS_PORT, MEMPOOL_WS_PATH);
+#endif
+
+    ws.onEvent([this](WStype_t type, uint8_t* payload, size_t length) {
+        onEvent(type, payload, length);
+    });
+
+    // Ping every 15s, drop the link after two missed pongs
+    ws.enableHeartbeat(15000, 3000, 2);
+    ws.setReconnectInterval(MEMPOOL_WS_BACKOFF_BASE);
+
+    started = true;
+    retryCheckMs = millis() + MEMPOOL_WS_CONNECT_GRACE_MS;
+
+    Serial.printf("📡 WebSocket: connecting to %s:%d%s\n",
+                 MEMPOOL_WS_HOST, MEMPOOL_WS_PORT, MEMPOOL_WS_PATH);
+}
+
+uint8_t MempoolSocket::loop(BTCData& data) {
+    if (WiFi.status() != WL_CONNECTED) {
+        return 0;
+    }
+    if (!started) {
+        begin();
+    }
+
+    target = &data;
+    pending = 0;
+    ws.loop();
+    target = nullptr;
+
+    // The library retries silently; count attempts that never connected
+    uint32_t now = millis();
+    if (!session.isConnected() && (int32_t)(now - retryCheckMs) >= 0) {
+        scheduleRetry(now);
+    }
+
+    return pending;
+}
+
+void MempoolSocket::onEvent(WStype_t type, uint8_t* payload, size_t length) {
+    uint32_t now = millis();
+
+    switch (type) {
+        case WStype_CONNECTED: {
+            const char* subscribe = session.onConnected(now);
+            ws.sendTXT(subscribe);
+            Serial.println("✓ WebSocket connected, subscribed to blocks/stats");
+            sdLogger.logf(LOG_INFO, "WebSocket connected (%s), connect #%u",
+                         MEMPOOL_WS_HOST, session.getConnects());
+            break;
+        }
+
+        case WStype_DISCONNECTED:
+            if (session.isConnected()) {
+                Serial.println("⚠️  WebSocket disconnected, polling fallback active");
+                sdLogger.log(LOG_WARN, "WebSocket disconnected");
+            }
+            scheduleRetry(now);
+            break;
+
+        case WStype_TEXT: {
+            MempoolPush push;
+            uint8_t flags = parseMempoolSocketMessage((const char*)payload, length, push);
+            session.onMessage(flags, now);
+
+            if (flags != 0 && target != nullptr) {
+                applyPush(push, *target);
+                pending |= flags;
+            }
+            break;
+        }
+
+        case WStype_ERROR:
+            Serial.println("❌ WebSocket error");
+            break;
+
+        default:
+            break;
+    }
+}
+
+void MempoolSocket::scheduleRetry(uint32_t now) {
+    uint32_t delay = session.onDisconnected(now);
+    ws.setReconnectInterval(delay);
+    retryCheckMs = now + delay + MEMPOOL_WS_CONNECT_GRACE_MS;
+    Serial.printf("WebSocket: reconnect in %u ms (attempt %u)\n", delay, session.getFailedAttempts());
+}
+
+void MempoolSocket::applyPush(const MempoolPush& push, BTCData& data) {
+    if (push.flags & PUSH_HAS_PRICE) {
+        data.priceUSD = push.priceUSD;
+        if (push.priceEUR > 0) data.priceEUR = push.priceEUR;
+    }
+
+    if (push.flags & PUSH_HAS_BLOCK) {
+        data.blockHeight = push.blockHeight;
+        memcpy(data.blockHash, push.blockHash, sizeof(data.blockHash));
+        data.blockTime = push.blockTime;
+        data.blockTxCount = push.blockTxCount;
+        data.blockSize = push.blockSize;
+    }
+
+    if (push.flags & PUSH_HAS_MEMPOOL) {
+        if (push.mempoolCount > 0) {
+            data.mempoolCount = push.mempoolCount;
+            data.mempoolSize = push.mempoolVsize / 1000000.0f;
+            data.mempoolTotalFee = push.mempoolTotalFee;
+        }
+        if (push.hasFees) {
+            data.feeFast = push.feeFast;
+            data.feeMedium = push.feeMedium;
+            data.feeSlow = push.feeSlow;
+        }
+    }
+}
+
+void MempoolSocket::getStatus(MempoolSocketStatus& status, uint32_t now) const {
+    status.connected = session.isConnected();
+    status.live = session.isLive(now);
+    status.connects = session.getConnects();
+    status.disconnects = session.getDisconnects();
+    status.messages = session.getMessages();
+    status.failedAttempts = session.getFailedAttempts();
+    status.lastMessageMs = session.getLastMessageMs();
+    for (int i = 0; i < PUSH_TOPIC_COUNT; i++) {
+        status.pushed[i] = session.covers((PushTopic)i, now);
+    }
+}
+
+void MempoolSocket::printStatus(const MempoolSocketStatus& status) {
+    uint32_t now = millis();
+
+    Serial.printf("WebSocket: %s (%s:%d)\n",
+                 status.connected ? (status.live ? "Live" : "Silent") : "Disconnected",
+                 MEMPOOL_WS_HOST, MEMPOOL_WS_PORT);
+    Serial.printf("  connects=%u disconnects=%u messages=%u failed_attempts=%u last_msg=%us ago\n",
+                 status.connects, status.disconnects, status.messages,
+                 status.failedAttempts, (now - status.lastMessageMs) / 1000);
+
+    for (int i = 0; i < PUSH_TOPIC_COUNT; i++) {
+        Serial.printf("  %-8s %s\n", MempoolSocketSession::topicName((PushTopic)i),
+                     status.pushed[i] ? "push" : "polling");
+    }
+}
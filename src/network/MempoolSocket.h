@@ -0,0 +1,84 @@
+#ifndef MEMPOOL_SOCKET_H
+#define MEMPOOL_SOCKET_H
+
+#include <Arduino.h>
+#include <WebSocketsClient.h>
+#include "MempoolSocketSession.h"
+#include "../api/BTCData.h"
+
+// mempool.space WebSocket endpoint (override with -D to target scripts/ws_stub_server.py)
+#ifndef MEMPOOL_WS_ENABLED
+#define MEMPOOL_WS_ENABLED 1
+#endif
+#ifndef MEMPOOL_WS_HOST
+#define MEMPOOL_WS_HOST "mempool.space"
+#endif
+#ifndef MEMPOOL_WS_PORT
+#define MEMPOOL_WS_PORT 443
+#endif
+#ifndef MEMPOOL_WS_PATH
+#define MEMPOOL_WS_PATH "/api/v1/ws"
+#endif
+#ifndef MEMPOOL_WS_SSL
+#define MEMPOOL_WS_SSL 1
+#endif
+
+// Worker pumps the socket at least this often while idle or waiting on an AI
+// race (AI_RACE_IDLE_MS); a REST fetch in progress delays it up to its timeout
+#define MEMPOOL_WS_LOOP_MS 50
+#define MEMPOOL_WS_CONNECT_GRACE_MS 15000 // Attempt not connected by then = failed
+
+// Connection statistics, copied out of the worker task for STATUS
+struct MempoolSocketStatus {
+    bool connected;
+    bool live;
+    uint32_t connects;
+    uint32_t disconnects;
+    uint32_t messages;
+    uint32_t failedAttempts;
+    uint32_t lastMessageMs;
+    bool pushed[PUSH_TOPIC_COUNT];  // Topic covered by pushes (REST poll slowed down)
+};
+
+/**
+ * MempoolSocket - Push updates from the mempool.space WebSocket API
+ *
+ * Subscribes to "blocks" and "stats" and applies every pushed block, fee,
+ * mempool and price update straight to the worker's BTCData snapshot.
+ * Reconnects with exponential backoff; while the link is down (or a topic goes
+ * quiet) the fetch worker falls back to REST polling for that topic.
+ *
+ * Only used from the fetch worker task; STATUS prints a copy of its counters.
+ */
+class MempoolSocket {
+public:
+    MempoolSocket();
+
+    // Configure the client (first call connects once WiFi is up)
+    void begin();
+
+    // Pump the socket; returns PUSH_HAS_* flags for the data applied to target
+    uint8_t loop(BTCData& target);
+
+    bool covers(PushTopic topic, uint32_t now) const { return session.covers(topic, now); }
+
+    // Copy the connection statistics (worker task) / print a copy (any task)
+    void getStatus(MempoolSocketStatus& status, uint32_t now) const;
+    static void printStatus(const MempoolSocketStatus& status);
+
+    // Copy pushed fields into a BTCData
+    static void applyPush(const MempoolPush& push, BTCData& data);
+
+private:
+    WebSocketsClient ws;
+    MempoolSocketSession session;
+    bool started;
+    uint32_t retryCheckMs;   // When a still-pending reconnect counts as failed
+    BTCData* target;         // Valid only inside loop()
+    uint8_t pending;         // Flags collected during loop()
+
+    void onEvent(WStype_t type, uint8_t* payload, size_t length);
+    void scheduleRetry(uint32_t now);
+};
+
+#endif // MEMPOOL_SOCKET_H
@@ -0,0 +1,132 @@
+#ifndef MEMPOOL_SOCKET_SESSION_H
+#define MEMPOOL_SOCKET_SESSION_H
+
+#include <stdint.h>
+#include "ReconnectBackoff.h"
+#include "../api/MempoolSocketMessage.h"
+
+// WebSocket session settings
+#define MEMPOOL_WS_BACKOFF_BASE 1000      // First reconnect after ~1s
+#define MEMPOOL_WS_BACKOFF_MAX 60000      // Never wait more than 60s
+#define MEMPOOL_WS_SILENCE_MS 60000       // Stats arrive every few seconds; 60s quiet = dead link
+#define MEMPOOL_WS_PRICE_STALE_MS 600000  // Conversions are pushed far less often than stats
+
+// Data pushed over the socket, mapped onto the polled fetch jobs
+enum PushTopic {
+    PUSH_TOPIC_PRICE = 0,
+    PUSH_TOPIC_BLOCK,
+    PUSH_TOPIC_MEMPOOL,
+    PUSH_TOPIC_COUNT
+};
+
+/**
+ * MempoolSocketSession - Connection state for the mempool.space WebSocket
+ *
+ * Tracks connect/disconnect events, picks reconnect delays and decides per
+ * topic whether pushed data is fresh enough that polling can back off.
+ * Contains no network code; MempoolSocket feeds it events from the WebSocket
+ * library, native tests feed it a scripted stand-in server.
+ */
+class MempoolSocketSession {
+public:
+    explicit MempoolSocketSession(uint32_t seed = 1)
+        : backoff(MEMPOOL_WS_BACKOFF_BASE, MEMPOOL_WS_BACKOFF_MAX, seed) {
+        connected = false;
+        connectedAt = 0;
+        lastMessageMs = 0;
+        connects = 0;
+        disconnects = 0;
+        messages = 0;
+        for (int i = 0; i < PUSH_TOPIC_COUNT; i++) {
+            topicSeen[i] = false;
+            topicMs[i] = 0;
+        }
+    }
+
+    // Returns the subscription message to send
+    const char* onConnected(uint32_t now) {
+        connected = true;
+        connectedAt = now;
+        lastMessageMs = now;
+        connects++;
+        backoff.reset();
+        for (int i = 0; i < PUSH_TOPIC_COUNT; i++) {
+            topicSeen[i] = false;
+        }
+        return MEMPOOL_WS_SUBSCRIBE;
+    }
+
+    // Connection lost or attempt failed; returns the delay before retrying
+    uint32_t onDisconnected(uint32_t now) {
+        (void)now;
+        if (connected) disconnects++;
+        connected = false;
+        return backoff.nextDelay();
+    }
+
+    // Record a parsed message (PUSH_HAS_* flags)
+    void onMessage(uint8_t flags, uint32_t now) {
+        lastMessageMs = now;
+        messages++;
+        if (flags & PUSH_HAS_PRICE) markTopic(PUSH_TOPIC_PRICE, now);
+        if (flags & PUSH_HAS_BLOCK) markTopic(PUSH_TOPIC_BLOCK, now);
+        if (flags & PUSH_HAS_MEMPOOL) markTopic(PUSH_TOPIC_MEMPOOL, now);
+    }
+
+    // Connected and the server has spoken recently
+    bool isLive(uint32_t now) const {
+        return connected && (uint32_t)(now - lastMessageMs) <= MEMPOOL_WS_SILENCE_MS;
+    }
+
+    /**
+     * True while the socket is delivering this topic, so its REST poll can
+     * fall back to a slow safety interval. Blocks are only pushed when mined,
+     * so the block topic counts as covered for as long as the link is live.
+     */
+    bool covers(PushTopic topic, uint32_t now) const {
+        if (!isLive(now) || !topicSeen[topic]) return false;
+
+        switch (topic) {
+            case PUSH_TOPIC_BLOCK:
+                return true;
+            case PUSH_TOPIC_PRICE:
+                return (uint32_t)(now - topicMs[topic]) <= MEMPOOL_WS_PRICE_STALE_MS;
+            default:
+                return (uint32_t)(now - topicMs[topic]) <= MEMPOOL_WS_SILENCE_MS;
+        }
+    }
+
+    bool isConnected() const { return connected; }
+    uint32_t getConnects() const { return connects; }
+    uint32_t getDisconnects() const { return disconnects; }
+    uint32_t getMessages() const { return messages; }
+    uint32_t getLastMessageMs() const { return lastMessageMs; }
+    uint32_t getFailedAttempts() const { return backoff.getAttempts(); }
+
+    static const char* topicName(PushTopic topic) {
+        switch (topic) {
+            case PUSH_TOPIC_PRICE: return "price";
+            case PUSH_TOPIC_BLOCK: return "block";
+            case PUSH_TOPIC_MEMPOOL: return "mempool";
+            default: return "unknown";
+        }
+    }
+
+private:
+    ReconnectBackoff backoff;
+    bool connected;
+    uint32_t connectedAt;
+    uint32_t lastMessageMs;
+    uint32_t connects;
+    uint32_t disconnects;
+    uint32_t messages;
+    bool topicSeen[PUSH_TOPIC_COUNT];
+    uint32_t topicMs[PUSH_TOPIC_COUNT];
+
+    void markTopic(PushTopic topic, uint32_t now) {
+        topicSeen[topic] = true;
+        topicMs[topic] = now;
+    }
+};
+
+#endif // MEMPOOL_SOCKET_SESSION_H
@@ -0,0 +1,56 @@
+#ifndef RECONNECT_BACKOFF_H
+#define RECONNECT_BACKOFF_H
+
+#include <stdint.h>
+
+/**
+ * ReconnectBackoff - Exponential backoff with jitter
+ *
+ * Delay doubles with every consecutive failure up to maxMs. Each delay is
+ * pulled down by up to 25% of random jitter so a fleet of dashboards that lost
+ * the same server does not reconnect in lockstep. The PRNG is seeded by the
+ * caller (esp_random() on the device, a constant in tests).
+ */
+class ReconnectBackoff {
+public:
+    ReconnectBackoff(uint32_t initialMs, uint32_t limitMs, uint32_t seed = 1)
+        : baseMs(initialMs), maxMs(limitMs), attempts(0), rng(seed ? seed : 1) {}
+
+    // Delay before the next attempt; counts as one more failure
+    uint32_t nextDelay() {
+        uint32_t delay = maxMs;
+        if (attempts < 31 && (baseMs << attempts) >> attempts == baseMs) {
+            uint32_t scaled = baseMs << attempts;
+            if (scaled < maxMs) delay = scaled;
+        }
+        attempts++;
+
+        uint32_t jitterRange = delay / 4;
+        if (jitterRange > 0) {
+            delay -= nextRandom() % (jitterRange + 1);
+        }
+        return delay;
+    }
+
+    // Call after a successful connection
+    void reset() { attempts = 0; }
+
+    uint32_t getAttempts() const { return attempts; }
+    void setSeed(uint32_t seed) { rng = seed ? seed : 1; }
+
+private:
+    uint32_t baseMs;
+    uint32_t maxMs;
+    uint32_t attempts;
+    uint32_t rng;
+
+    // xorshift32
+    uint32_t nextRandom() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return rng;
+    }
+};
+
+#endif // RECONNECT_BACKOFF_H
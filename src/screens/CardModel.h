@@ -0,0 +1,135 @@
+#ifndef CARD_MODEL_H
+#define CARD_MODEL_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Retained card settings
+#define CARD_MODEL_MAX_CARDS 10   // MainScreen: 5 rows x 2 columns
+#define CARD_TITLE_LEN 48
+#define CARD_VALUE_LEN 32
+
+// What a card last put on the panel
+struct CardView {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+    char title[CARD_TITLE_LEN];
+    char value[CARD_VALUE_LEN];
+    uint32_t color;
+    bool stale;
+};
+
+inline void cardViewSet(CardView& view, int x, int y, int w, int h,
+                        const char* title, const char* value, uint32_t color, bool stale) {
+    memset(&view, 0, sizeof(view));
+    view.x = (int16_t)x;
+    view.y = (int16_t)y;
+    view.w = (int16_t)w;
+    view.h = (int16_t)h;
+    strncpy(view.title, title, CARD_TITLE_LEN - 1);
+    strncpy(view.value, value, CARD_VALUE_LEN - 1);
+    view.color = color;
+    view.stale = stale;
+}
+
+// Pixels of the rectangle inside the clip rectangle (what a fill actually pushes)
+inline uint32_t clippedArea(int x, int y, int w, int h, int clipX, int clipY, int clipW, int clipH) {
+    int left = x > clipX ? x : clipX;
+    int top = y > clipY ? y : clipY;
+    int right = x + w < clipX + clipW ? x + w : clipX + clipW;
+    int bottom = y + h < clipY + clipH ? y + h : clipY + clipH;
+    if (right <= left || bottom <= top) return 0;
+    return (uint32_t)(right - left) * (uint32_t)(bottom - top);
+}
+
+// Pixels pushed by the dashboard, against what redrawing everything would push
+struct RenderStats {
+    uint32_t frames;
+    uint32_t fullFrames;        // Background cleared (scroll, rotation, first frame)
+    uint32_t cardsDrawn;
+    uint32_t cardsSkipped;      // Unchanged since the last frame
+    uint32_t blitFrames;        // Scroll frames shifted from the previous frame
+    uint64_t stripRows;         // Rows rendered for those (the newly exposed strips)
+    uint64_t pixels;
+    uint64_t fullRedrawPixels;  // Same frames drawn the old way (clear + every visible card + header)
+    uint32_t lastFramePixels;
+};
+
+/**
+ * CardModel - Retained state of the cards on the panel, for dirty-region redraws
+ *
+ * MainScreen describes every visible card each frame; update() compares it
+ * with the card last rendered in that slot and says whether it has to be
+ * painted again. A scroll moves every card and uncovers background, so a
+ * frame at a new scroll offset (or after invalidate()) is a full frame: the
+ * caller clears the content area and every visible card is repainted,
+ * unless it blits the previous frame (scrollFrom()).
+ */
+class CardModel {
+public:
+    CardModel() { invalidate(); }
+
+    // Forget what is on the panel (screen cleared, rotated)
+    void invalidate() {
+        for (int i = 0; i < CARD_MODEL_MAX_CARDS; i++) valid[i] = false;
+        hasScroll = false;
+        lastScrollY = 0;
+    }
+
+    // Start a frame at this scroll offset; true if it has to be a full frame
+    bool beginFrame(int scrollY) {
+        bool full = !hasScroll || scrollY != lastScrollY;
+        if (full) {
+            for (int i = 0; i < CARD_MODEL_MAX_CARDS; i++) valid[i] = false;
+        }
+        hasScroll = true;
+        lastScrollY = scrollY;
+        return full;
+    }
+
+    // True (and remembered as rendered) if the card differs from the last one drawn in its slot
+    bool update(uint8_t index, const CardView& view) {
+        if (index >= CARD_MODEL_MAX_CARDS) return true;
+        if (valid[index] && same(cards[index], view)) return false;
+        cards[index] = view;
+        valid[index] = true;
+        return true;
+    }
+
+    bool isValid(uint8_t index) const { return index < CARD_MODEL_MAX_CARDS && valid[index]; }
+
+    // Scroll offset of the last frame; false before the first one
+    bool lastScroll(int& scrollY) const {
+        scrollY = lastScrollY;
+        return hasScroll;
+    }
+
+    // The canvas now holds other's frame blitted to scrollY (ScrollBlit.h):
+    // take its cards, moved by the scroll. The caller renders the exposed strip.
+    void scrollFrom(const CardModel& other, int scrollY) {
+        int dy = scrollY - other.lastScrollY;
+        for (int i = 0; i < CARD_MODEL_MAX_CARDS; i++) {
+            valid[i] = other.valid[i];
+            cards[i] = other.cards[i];
+            cards[i].y = (int16_t)(cards[i].y - dy);
+        }
+        hasScroll = other.hasScroll;
+        lastScrollY = scrollY;
+    }
+
+private:
+    static bool same(const CardView& a, const CardView& b) {
+        return a.x == b.x && a.y == b.y && a.w == b.w && a.h == b.h &&
+               a.color == b.color && a.stale == b.stale &&
+               strcmp(a.value, b.value) == 0 && strcmp(a.title, b.title) == 0;
+    }
+
+    CardView cards[CARD_MODEL_MAX_CARDS];
+    bool valid[CARD_MODEL_MAX_CARDS];
+    bool hasScroll;
+    int lastScrollY;
+};
+
+#endif // CARD_MODEL_H
@@ -0,0 +1,38 @@
+#ifndef DRAG_SCROLL_H
+#define DRAG_SCROLL_H
+
+#include <stdint.h>
+
+/**
+ * DragScroll - Vertical drag tracking for a scrolling screen
+ *
+ * The first touch point of a gesture only anchors it; every later point
+ * scrolls by its distance from the previous one. The gesture lasts until
+ * release() on touch up. Frames rendered in between do not end it, so
+ * every move of a drag scrolls however the frames are paced.
+ */
+class DragScroll {
+public:
+    DragScroll() : active(false), lastY(0) {}
+
+    // Touch down or move at y; returns the scroll offset after it, within [0, maxOffset]
+    int move(int16_t y, int offset, int maxOffset) {
+        if (active) {
+            offset -= y - lastY;
+            if (offset < 0) offset = 0;
+            if (offset > maxOffset) offset = maxOffset;
+        }
+        active = true;
+        lastY = y;
+        return offset;
+    }
+
+    void release() { active = false; }
+    bool dragging() const { return active; }
+
+private:
+    bool active;
+    int16_t lastY;
+};
+
+#endif // DRAG_SCROLL_H
@@ -0,0 +1,79 @@
+#include "FrameBuffer.h"
+#include "../utils/SDLogger.h"
+
+FrameBuffer::FrameBuffer() {
+    lcd = nullptr;
+    backIndex = 0;
+    originX = 0;
+    originY = 0;
+    width = 0;
+    height = 0;
+}
+
+FrameBuffer::~FrameBuffer() {
+    end();
+}
+
+bool FrameBuffer::begin(LGFX* display, int x, int y, int w, int h) {
+    if (lcd != nullptr) return true;
+
+    for (int i = 0; i < 2; i++) {
+        sprites[i].setPsram(true);
+        sprites[i].setColorDepth(16);
+        if (sprites[i].createSprite(w, h) == nullptr) {
+            sprites[0].deleteSprite();
+            sprites[1].deleteSprite();
+            Serial.printf("⚠️  Frame buffer: %u bytes of PSRAM not available, drawing directly\n",
+                         (unsigned)(2 * w * h * 2));
+            sdLogger.logf(LOG_WARN, "Frame buffer: PSRAM allocation of 2x%dx%d failed", w, h);
+            return false;
+        }
+        sprites[i].fillScreen(0x000000);
+    }
+
+    lcd = display;
+    backIndex = 0;
+    originX = x;
+    originY = y;
+    width = w;
+    height = h;
+
+    // Held until end(): pushImageDMA only returns early inside a transaction
+    lcd->initDMA();
+    lcd->startWrite();
+
+    Serial.printf("✓ Frame buffer: 2x %dx%d sprites in PSRAM (%u KB)\n",
+                 w, h, (unsigned)(2 * w * h * 2 / 1024));
+    sdLogger.logf(LOG_INFO, "Frame buffer: 2x%dx%d RGB565 sprites in PSRAM", w, h);
+    return true;
+}
+
+void FrameBuffer::end() {
+    if (lcd == nullptr) return;
+
+    lcd->waitDMA();
+    lcd->endWrite();
+    lcd = nullptr;
+    sprites[0].deleteSprite();
+    sprites[1].deleteSprite();
+}
+
+uint32_t FrameBuffer::present(const FrameRect* rects, uint8_t count) {
+    if (lcd == nullptr) return 0;
+
+    // The previous push reads the other sprite; it must be done before this one starts
+    uint32_t started = micros();
+    lcd->waitDMA();
+    uint32_t waited = micros() - started;
+
+    // Clipping the full-area push leaves only the rectangle's rows on the bus
+    const lgfx::swap565_t* pixels = (const lgfx::swap565_t*)sprites[backIndex].getBuffer();
+    for (uint8_t i = 0; i < count; i++) {
+        lcd->setClipRect(rects[i].x, rects[i].y, rects[i].w, rects[i].h);
+        lcd->pushImageDMA(originX, originY, width, height, pixels);
+    }
+    lcd->clearClipRect();
+
+    backIndex ^= 1;
+    return waited;
+}
@@ -0,0 +1,62 @@
+#ifndef FRAME_BUFFER_H
+#define FRAME_BUFFER_H
+
+#include <Arduino.h>
+#include "../DisplayConfig.h"
+
+// Most rectangles one present() pushes (cards plus the full content area)
+#define FRAME_MAX_RECTS 12
+
+// Panel area to push, in screen coordinates
+struct FrameRect {
+    int16_t x;
+    int16_t y;
+    int16_t w;
+    int16_t h;
+};
+
+/**
+ * FrameBuffer - Two off-screen sprites in PSRAM, pushed to the panel with DMA
+ *
+ * The screen composes a frame into back(), then present() starts the DMA
+ * push of its dirty rectangles and swaps: the next frame is composed into
+ * the other sprite while the bus is still busy with this one. present()
+ * only waits when the previous push has not finished yet.
+ *
+ * Each sprite holds the frame from two presents ago, so the caller tracks
+ * what is in each one (see MainScreen's per-buffer CardModel).
+ *
+ * begin() keeps a write transaction open on the panel so the pushes run
+ * asynchronously; end() (or the destructor) waits for the last push and
+ * closes it.
+ */
+class FrameBuffer {
+public:
+    FrameBuffer();
+    ~FrameBuffer();
+
+    // Allocate two w x h sprites for the panel area at (x, y); false if PSRAM is short
+    bool begin(LGFX* display, int x, int y, int w, int h);
+    void end();
+    bool ready() const { return lcd != nullptr; }
+
+    // Sprite to compose the next frame into (coordinates relative to the area)
+    LGFX_Sprite* back() { return &sprites[backIndex]; }
+    LGFX_Sprite* front() { return &sprites[backIndex ^ 1]; }  // Last presented frame
+    uint8_t backBuffer() const { return backIndex; }
+
+    // Push rects of the back sprite and make it the front; returns the
+    // microseconds spent waiting for the previous push
+    uint32_t present(const FrameRect* rects, uint8_t count);
+
+private:
+    LGFX* lcd;
+    LGFX_Sprite sprites[2];
+    uint8_t backIndex;
+    int originX;
+    int originY;
+    int width;
+    int height;
+};
+
+#endif // FRAME_BUFFER_H
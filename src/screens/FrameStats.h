@@ -0,0 +1,85 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <stdint.h>
+
+// Frame statistics settings
+#define FRAME_BUS_BYTES_PER_SEC 20000000UL  // 8-bit parallel bus, freq_write 20 MHz (DisplayConfig.h)
+#define FRAME_BURST_GAP_US 100000UL         // Frames closer than this are one animation (a drag)
+
+/**
+ * FrameStats - Frame time and display bus load of the main screen
+ *
+ * record() takes, per frame: the time spent composing it, the time spent
+ * waiting for the previous frame's DMA push, and the bytes pushed to the
+ * panel. The push itself runs asynchronously, so its duration is estimated
+ * from the bus rate. Frames less than FRAME_BURST_GAP_US apart form a burst
+ * (scrolling); fps and bus utilization are measured over bursts only, since
+ * a data tick every few seconds says nothing about either.
+ */
+class FrameStats {
+public:
+    FrameStats() { clear(); }
+
+    void clear() {
+        frames = 0;
+        composeTotalUs = 0;
+        composeMaxUs = 0;
+        waitTotalUs = 0;
+        waitMaxUs = 0;
+        bytes = 0;
+        burstFrames = 0;
+        burstUs = 0;
+        burstPushUs = 0;
+        lastUs = 0;
+    }
+
+    void record(uint32_t nowUs, uint32_t composeUs, uint32_t waitUs, uint32_t pushBytes) {
+        uint32_t pushUs = transferUs(pushBytes);
+        if (frames > 0 && nowUs - lastUs < FRAME_BURST_GAP_US) {
+            burstFrames++;
+            burstUs += nowUs - lastUs;
+            burstPushUs += pushUs;
+        }
+        lastUs = nowUs;
+
+        frames++;
+        composeTotalUs += composeUs;
+        if (composeUs > composeMaxUs) composeMaxUs = composeUs;
+        waitTotalUs += waitUs;
+        if (waitUs > waitMaxUs) waitMaxUs = waitUs;
+        bytes += pushBytes;
+    }
+
+    // Time the bus needs for a push of this size
+    static uint32_t transferUs(uint32_t pushBytes) {
+        return (uint32_t)((uint64_t)pushBytes * 1000000ULL / FRAME_BUS_BYTES_PER_SEC);
+    }
+
+    uint32_t frameCount() const { return frames; }
+    uint32_t avgComposeUs() const { return frames ? (uint32_t)(composeTotalUs / frames) : 0; }
+    uint32_t maxComposeUs() const { return composeMaxUs; }
+    uint32_t avgWaitUs() const { return frames ? (uint32_t)(waitTotalUs / frames) : 0; }
+    uint32_t maxWaitUs() const { return waitMaxUs; }
+    uint32_t avgBytes() const { return frames ? (uint32_t)(bytes / frames) : 0; }
+
+    // Frames per second while animating; 0 before the first burst
+    float burstFps() const { return burstUs ? burstFrames * 1000000.0f / burstUs : 0; }
+
+    // Share of the burst time the bus spent pushing pixels, 0-100
+    float busUtilization() const { return burstUs ? 100.0f * burstPushUs / burstUs : 0; }
+
+private:
+    uint32_t frames;
+    uint64_t composeTotalUs;
+    uint32_t composeMaxUs;
+    uint64_t waitTotalUs;
+    uint32_t waitMaxUs;
+    uint64_t bytes;
+    uint32_t burstFrames;
+    uint64_t burstUs;
+    uint64_t burstPushUs;
+    uint32_t lastUs;
+};
+
+#endif // FRAME_STATS_H
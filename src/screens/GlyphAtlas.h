@@ -0,0 +1,102 @@
+#ifndef GLYPH_ATLAS_H
+#define GLYPH_ATLAS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// Printable ASCII only
+#define GLYPH_FIRST 32
+#define GLYPH_COUNT 95
+
+/**
+ * GlyphAtlas - Pre-rendered RGB565 glyphs for one font, size and color pair
+ *
+ * Each glyph is a cell of width x cellHeight pixels, stored row-major and
+ * back to back in caller-provided storage (PSRAM on the device). Drawing a
+ * string is then a copy of each cell instead of rasterizing the font again.
+ * Pixels are kept in whatever byte order they were added in.
+ *
+ * The atlas only stores and looks up cells; ValueFont rasterizes them.
+ */
+class GlyphAtlas {
+public:
+    GlyphAtlas() { begin(nullptr, 0, 0); }
+
+    void begin(uint16_t* storage, size_t capacityPixels, uint8_t cellHeight) {
+        pixels = storage;
+        capacity = capacityPixels;
+        used = 0;
+        height = cellHeight;
+        for (int i = 0; i < GLYPH_COUNT; i++) {
+            widths[i] = 0;
+            offsets[i] = 0;
+        }
+    }
+
+    // Copy a width x cellHeight cell; false if the character is not printable,
+    // already present, or the storage is full
+    bool add(char c, uint8_t width, const uint16_t* cell) {
+        int i = index(c);
+        size_t size = (size_t)width * height;
+        if (i < 0 || widths[i] != 0 || width == 0 || used + size > capacity) return false;
+        memcpy(pixels + used, cell, size * sizeof(uint16_t));
+        offsets[i] = (uint32_t)used;
+        widths[i] = width;
+        used += size;
+        return true;
+    }
+
+    // Cell of c (width x cellHeight), nullptr if not in the atlas
+    const uint16_t* glyph(char c, uint8_t& width) const {
+        int i = index(c);
+        if (i < 0 || widths[i] == 0) return nullptr;
+        width = widths[i];
+        return pixels + offsets[i];
+    }
+
+    // Every character of text has a glyph (empty text too)
+    bool covers(const char* text) const {
+        for (; *text; text++) {
+            int i = index(*text);
+            if (i < 0 || widths[i] == 0) return false;
+        }
+        return true;
+    }
+
+    // Width of text in pixels, counting only characters in the atlas
+    int textWidth(const char* text) const {
+        int w = 0;
+        for (; *text; text++) {
+            int i = index(*text);
+            if (i >= 0) w += widths[i];
+        }
+        return w;
+    }
+
+    uint8_t cellHeight() const { return height; }
+    size_t bytesUsed() const { return used * sizeof(uint16_t); }
+
+    // Sum of the cell widths for an alphabet, to size the storage before adding
+    template <typename WidthOf>
+    static size_t pixelsFor(const char* alphabet, uint8_t cellHeight, WidthOf widthOf) {
+        size_t total = 0;
+        for (; *alphabet; alphabet++) total += (size_t)widthOf(*alphabet) * cellHeight;
+        return total;
+    }
+
+private:
+    static int index(char c) {
+        int i = (unsigned char)c - GLYPH_FIRST;
+        return i >= 0 && i < GLYPH_COUNT ? i : -1;
+    }
+
+    uint16_t* pixels;
+    size_t capacity;
+    size_t used;
+    uint8_t height;
+    uint8_t widths[GLYPH_COUNT];
+    uint32_t offsets[GLYPH_COUNT];
+};
+
+#endif // GLYPH_ATLAS_H
@@ -1,18 +1,48 @@
 #include "MainScreen.h"
 #include <WiFi.h>
-#include <HTTPClient.h>
-#include <ArduinoJson.h>
-#include "../api/GeminiClient.h"
+#include "../network/FetchWorker.h"
+#include "../utils/WallClock.h"
+#include "../api/WarmStart.h"
+#include "../utils/SDLogger.h"
+#include "ScrollBlit.h"
+#include "ValueFont.h"
 
 // Global BTC data instance
 BTCData btcData;
 
+// Jobs whose values on screen are still the warm-start copy (bit per FetchJob)
+static uint8_t staleSources = 0;
+
+// Time to first meaningful frame, logged once per boot
+static bool firstFrameLogged = false;
+static bool firstLiveLogged = false;
+
+// Content area below the header
+static const int CONTENT_Y = 29;
+static const int CONTENT_H = 291;
+static const int HEADER_H = 29;  // Bar plus separator line
+
+RenderStats MainScreen::renderStats = {};
+FrameStats MainScreen::frameStats;
+bool MainScreen::scrollBenchmarkRequested = false;
+bool MainScreen::textBenchmarkRequested = false;
+
+// Scroll benchmark: frames per pass and pixels per frame (a steady drag)
+static const int SCROLL_BENCH_FRAMES = 200;
+static const int SCROLL_BENCH_STEP = 6;
+
+// Text benchmark: times every placed card value is drawn per pass
+static const int TEXT_BENCH_ROUNDS = 100;
+
 void MainScreen::init(ScreenManager* mgr) {
     manager = mgr;
     LGFX* lcd = manager->getLCD();
 
     lcd->fillScreen(0x000000);
 
+    // Frames are composed off-screen and pushed with DMA; without PSRAM, straight to the panel
+    frameBuffer.begin(lcd, 0, CONTENT_Y, 480, CONTENT_H);
+
     // Calculate max vertical scroll (total content height - visible area)
     // 8 cards × 88px (80 + 8 spacing) = 704px
     // Visible area = 320 - 28 (header) = 292px
@@ -25,114 +55,191 @@ void MainScreen::init(ScreenManager* mgr) {
     maxScrollX = 944 - 480;
     if (maxScrollX < 0) maxScrollX = 0;
 
+    // Last known values from before the reboot, drawn stale until each job reports
+    if (btcData.priceUSD == 0 && warmStart.restore(btcData)) {
+        staleSources = warmStart.restoredSources();
+    }
+
     drawHeader();
 
-    // Fetch initial data if WiFi connected
-    if (WiFi.status() == WL_CONNECTED) {
-        Serial.println("Fetching initial BTC data...");
-        fetchBTCPrice();
-        fetchBlockData();
-        fetchMempoolData();
-        fetchDCASignal();
-        fetchTradingSignal();
+    // Network requests run on the background fetch worker (core 0);
+    // results arrive through the queue drained in update()
+    if (fetchWorker.begin()) {
+        Serial.println("Requesting initial BTC data...");
+        fetchWorker.requestRefresh();
     }
 
+    // First frame now, not on the first tick: setup() may block on WiFi before loop() runs
     drawContent();
+    lastClockMinute = millis() / 60000;
 
     Serial.println("Main Screen initialized with scroll support");
 }
 
 void MainScreen::update() {
-    unsigned long now = millis();
+    // Merge completed fetches from the worker - never blocks on the network
+    bool dataChanged = false;
+    FetchResult result;
+
+    while (fetchWorker.poll(result)) {
+        if (result.success) {
+            FetchWorker::applyResult(result, btcData);
+            staleSources &= (uint8_t)~(1u << result.job);
+            dataChanged = true;
+
+            if (result.job == FETCH_PRICE && !firstLiveLogged) {
+                firstLiveLogged = true;
+                Serial.printf("✓ First live price at %lu ms after boot\n", millis());
+                sdLogger.logf(LOG_INFO, "First live frame: %lu ms after boot", millis());
+            }
+        }
+    }
 
-    // Update price data every 30s
-    if (now - lastPriceUpdate >= PRICE_UPDATE) {
-        lastPriceUpdate = now;
+    // Drawn on the next render tick, merged with touch and clock updates
+    if (dataChanged) {
+        manager->invalidate(RENDER_DATA);
+    }
 
-        // Fetch fresh data from APIs
-        Serial.println("Fetching BTC data...");
-        if (fetchBTCPrice()) {
-            Serial.printf("Price: $%.0f\n", btcData.priceUSD);
-        }
-        if (fetchBlockData()) {
-            Serial.printf("Block: %lu\n", btcData.blockHeight);
-        }
-        if (fetchMempoolData()) {
-            Serial.printf("Mempool: %lu TX, Fee: %d sat/vB\n",
-                         btcData.mempoolCount, btcData.feeFast);
-        }
+    unsigned long minute = millis() / 60000;
+    if (minute != lastClockMinute) {
+        lastClockMinute = minute;
+        manager->invalidate(RENDER_CLOCK);
+    }
 
-        drawContent();
+    if (scrollBenchmarkRequested) {
+        scrollBenchmarkRequested = false;
+        runScrollBenchmark();
     }
 
-    // Update AI signals every 5 minutes
-    if (now - lastAIUpdate >= AI_UPDATE) {
-        lastAIUpdate = now;
+    if (textBenchmarkRequested) {
+        textBenchmarkRequested = false;
+        runTextBenchmark();
+    }
+}
 
-        Serial.println("Fetching AI signals...");
-        if (fetchDCASignal()) {
-            Serial.printf("DCA: %s\n", btcData.dcaRecommendation);
-        }
-        if (fetchTradingSignal()) {
-            Serial.printf("Trading Signal: %s\n", btcData.tradingSignal);
+void MainScreen::runScrollBenchmark() {
+    LGFX* lcd = manager->getLCD();
+    int savedScroll = scrollOffsetY;
+
+    Serial.printf("Scroll benchmark: %d frames per pass, %dpx per frame\n",
+                 SCROLL_BENCH_FRAMES, SCROLL_BENCH_STEP);
+
+    // Blits need the frame buffer; without it only the full redraw runs
+    for (int pass = frameBuffer.ready() ? 0 : 1; pass < 2; pass++) {
+        blitScrolling = pass == 0;
+        int step = SCROLL_BENCH_STEP;
+        uint32_t started = micros();
+
+        for (int i = 0; i < SCROLL_BENCH_FRAMES; i++) {
+            if (scrollOffsetY + step > maxScrollY || scrollOffsetY + step < 0) step = -step;
+            scrollOffsetY += step;
+            drawContent();
         }
+        lcd->waitDMA();
+
+        uint32_t elapsed = micros() - started;
+        float fps = SCROLL_BENCH_FRAMES * 1000000.0f / elapsed;
+        const char* mode = pass == 0 ? "blit" : "full redraw";
+        Serial.printf("  %-11s %.1f fps (%.2f ms/frame)\n", mode, fps, elapsed / 1000.0f / SCROLL_BENCH_FRAMES);
+        sdLogger.logf(LOG_INFO, "Scroll benchmark (%s): %.1f fps over %d frames", mode, fps, SCROLL_BENCH_FRAMES);
+    }
+
+    blitScrolling = true;
+    scrollOffsetY = savedScroll;
+    drawContent();
+}
 
-        drawContent();
+void MainScreen::runTextBenchmark() {
+    LGFX* lcd = manager->getLCD();
+    int count = 0;
+    for (uint8_t i = 0; i < CARD_MODEL_MAX_CARDS; i++) {
+        if (placedCards & (1u << i)) count++;
+    }
+    if (count == 0) return;
+
+    // Same canvas as a frame: the back sprite (the front may still be on the bus), or the panel
+    bool composing = frameBuffer.ready();
+    canvas = composing ? static_cast<lgfx::LovyanGFX*>(frameBuffer.back()) : static_cast<lgfx::LovyanGFX*>(lcd);
+    canvasY = composing ? CONTENT_Y : 0;
+
+    Serial.printf("Text benchmark: %d card values x %d rounds on the %s (%s)\n",
+                 count, TEXT_BENCH_ROUNDS, composing ? "frame buffer" : "panel", valueFont.source());
+
+    float perCardUs[2];
+    lcd->startWrite();
+    if (!composing) lcd->setClipRect(0, CONTENT_Y, 480, CONTENT_H);
+    for (int pass = 0; pass < 2; pass++) {
+        glyphAtlas = pass == 0;
+        uint32_t started = micros();
+        for (int r = 0; r < TEXT_BENCH_ROUNDS; r++) {
+            for (uint8_t i = 0; i < CARD_MODEL_MAX_CARDS; i++) {
+                if (placedCards & (1u << i)) drawValue(cards[i], cards[i].x, cards[i].y - canvasY);
+            }
+        }
+        perCardUs[pass] = (float)(micros() - started) / (TEXT_BENCH_ROUNDS * count);
     }
+    if (!composing) lcd->clearClipRect();
+    lcd->endWrite();
+    glyphAtlas = true;
+
+    Serial.printf("  glyph atlas     %.1f us/card\n", perCardUs[0]);
+    Serial.printf("  setTextSize(3)  %.1f us/card (%.1fx)\n", perCardUs[1], perCardUs[1] / perCardUs[0]);
+    sdLogger.logf(LOG_INFO, "Text benchmark: atlas %.1f us/card, setTextSize(3) %.1f us/card over %d cards",
+                 perCardUs[0], perCardUs[1], count);
+
+    // Same values in the same place, but the back sprite is no longer what its model says
+    if (composing) bufferModel[frameBuffer.backBuffer()].invalidate();
+    drawContent();
 }
 
 void MainScreen::handleTouch(int16_t x, int16_t y) {
-    // Rotation button in top-right corner (header area)
+    // Rotation button in top-right corner (header area); drags go through handleDrag()
     if (y < 28 && x > 440) {
         rotateScreen();
-        return;
     }
+}
 
-    // Start of new touch
-    if (!isDragging) {
-        isDragging = true;
-        initialTouchX = x;
-        initialTouchY = y;
-        lastTouchX = x;
-        lastTouchY = y;
-        isHorizontalScroll = false;
-    } else {
-        // Calculate deltas
-        int16_t deltaY = y - lastTouchY;
-
-        // Lock to vertical scrolling only (horizontal scroll disabled)
-        isHorizontalScroll = false;
-
-        // Vertical scrolling only - update position instantly
-        scrollOffsetY -= deltaY;
+void MainScreen::handleDrag(int16_t x, int16_t y) {
+    // Vertical scrolling only; the first point of a gesture anchors it
+    int scrolled = drag.move(y, scrollOffsetY, maxScrollY);
+    if (scrolled == scrollOffsetY) return;
+    scrollOffsetY = scrolled;
 
-        // Clamp vertical scroll offset
-        if (scrollOffsetY < 0) scrollOffsetY = 0;
-        if (scrollOffsetY > maxScrollY) scrollOffsetY = maxScrollY;
+    // Every move lands in the next frame; moves within one tick are one frame
+    manager->invalidate(RENDER_TOUCH);
+}
 
-        lastTouchY = y;
+void MainScreen::handleRelease() {
+    drag.release();
+}
 
-        // IMMEDIATE redraw with every touch movement for smooth scrolling
-        unsigned long now = millis();
-        if (now - lastDrawTime >= MIN_DRAW_INTERVAL) {
-            drawContent();
-            lastDrawnScrollY = scrollOffsetY;
-            lastDrawTime = now;
-        }
+void MainScreen::render(uint8_t reasons) {
+    // The minute tick only changes the header text; cards wait for data, touch or layout
+    if (reasons == RENDER_CLOCK) {
+        LGFX* lcd = manager->getLCD();
+        uint32_t started = micros();
+        framePixels = 0;
+        renderStats.fullRedrawPixels += 480 * CONTENT_H + 480 * HEADER_H;
+
+        lcd->startWrite();
+        drawHeader(false);
+        lcd->endWrite();
+
+        renderStats.frames++;
+        renderStats.pixels += framePixels;
+        renderStats.lastFramePixels = framePixels;
+        frameStats.record(micros(), micros() - started, 0, framePixels * 2);
+        return;
     }
+    drawContent();
 }
 
 void MainScreen::drawContent() {
     LGFX* lcd = manager->getLCD();
+    uint32_t started = micros();
 
-    // Use startWrite/endWrite for batch operations (much faster)
-    lcd->startWrite();
-
-    // Set clipping region to content area only (prevents cards from drawing over header)
-    lcd->setClipRect(0, 29, 480, 291);
-
-    // Clear content area (preserve header) - do AFTER setting clip region for faster clear
-    lcd->fillRect(0, 29, 480, 291, 0x000000);
+    // Card contents at this scroll offset; rendered below
+    placedCards = 0;
 
     // Consistent color palette: Bitcoin Orange
     uint32_t cardColor = 0xF7931A;
@@ -147,14 +254,33 @@ void MainScreen::drawContent() {
     int x1 = baseX;
     int x2 = baseX + 236;
     if (baseY > -80 && baseY < 320 && x1 < 480 && (x1 + 228) > 0) {
-        drawCard(x1, baseY, 228, 80, "BTC Price", priceStr, cardColor);
+        placeCard(0, x1, baseY, "BTC Price", priceStr, cardColor, isStale(FETCH_PRICE));
     }
 
+    // Rolling change (FetchWorker / RollingChange.h); "--" until the history covers the window
     char changeStr[32];
-    float change = btcData.priceUSD * 0.02; // Placeholder
-    snprintf(changeStr, sizeof(changeStr), "+$%.0f", change);
+    const PriceChange& day = btcData.priceChange[CHANGE_24H];
+    if (day.valid) {
+        snprintf(changeStr, sizeof(changeStr), "%s$%.0f", day.delta < 0 ? "-" : "+", fabsf(day.delta));
+    } else {
+        snprintf(changeStr, sizeof(changeStr), "--");
+    }
     if (baseY > -80 && baseY < 320 && x2 < 480 && (x2 + 228) > 0) {
-        drawCard(x2, baseY, 228, 80, "24h Change", changeStr, cardColor);
+        // Percent change for 24h, 1h and 7d in the title
+        char changeTitle[48];
+        int len = 0;
+        static const ChangeWindow WINDOWS[] = { CHANGE_24H, CHANGE_1H, CHANGE_7D };
+        for (int i = 0; i < 3; i++) {
+            const PriceChange& c = btcData.priceChange[WINDOWS[i]];
+            const char* name = PriceChanges::windowName(WINDOWS[i]);
+            const char* sep = i > 0 ? " | " : "";
+            if (c.valid) {
+                len += snprintf(changeTitle + len, sizeof(changeTitle) - len, "%s%s %+.1f%%", sep, name, c.pct);
+            } else {
+                len += snprintf(changeTitle + len, sizeof(changeTitle) - len, "%s%s --", sep, name);
+            }
+        }
+        placeCard(1, x2, baseY, changeTitle, changeStr, cardColor, isStale(FETCH_PRICE));
     }
 
     // Row 2: Block and Mempool
@@ -162,13 +288,13 @@ void MainScreen::drawContent() {
     char blockStr[32];
     snprintf(blockStr, sizeof(blockStr), "%lu", btcData.blockHeight);
     if (baseY > -80 && baseY < 320 && x1 < 480 && (x1 + 228) > 0) {
-        drawCard(x1, baseY, 228, 80, "Block Height", blockStr, cardColor);
+        placeCard(2, x1, baseY, "Block Height", blockStr, cardColor, isStale(FETCH_BLOCK));
     }
 
     char mempoolStr[32];
     snprintf(mempoolStr, sizeof(mempoolStr), "%lu TX", btcData.mempoolCount);
     if (baseY > -80 && baseY < 320 && x2 < 480 && (x2 + 228) > 0) {
-        drawCard(x2, baseY, 228, 80, "Mempool", mempoolStr, cardColor);
+        placeCard(3, x2, baseY, "Mempool", mempoolStr, cardColor, isStale(FETCH_MEMPOOL));
     }
 
     // Row 3: Fees and Network
@@ -176,7 +302,7 @@ void MainScreen::drawContent() {
     char feeStr[32];
     snprintf(feeStr, sizeof(feeStr), "%d sat/vB", btcData.feeFast);
     if (baseY > -80 && baseY < 320 && x1 < 480 && (x1 + 228) > 0) {
-        drawCard(x1, baseY, 228, 80, "Fast Fee", feeStr, cardColor);
+        placeCard(4, x1, baseY, "Fast Fee", feeStr, cardColor, isStale(FETCH_MEMPOOL));
     }
 
     char networkStr[32];
@@ -187,7 +313,7 @@ void MainScreen::drawContent() {
         snprintf(networkStr, sizeof(networkStr), "No WiFi");
     }
     if (baseY > -80 && baseY < 320 && x2 < 480 && (x2 + 228) > 0) {
-        drawCard(x2, baseY, 228, 80, "Signal", networkStr, cardColor);
+        placeCard(5, x2, baseY, "Signal", networkStr, cardColor, false);
     }
 
     // Row 4: DCA and Trading Signal (AI-powered)
@@ -204,11 +330,15 @@ void MainScreen::drawContent() {
         } else {
             dcaColor = 0xFFFF00; // Yellow (WAIT)
         }
-        drawCard(x1, baseY, 228, 80, "DCA Signal", dcaStr, dcaColor);
+        placeCard(6, x1, baseY, "DCA Signal", dcaStr, dcaColor, isStale(FETCH_AI_SIGNALS));
     }
 
     char signalStr[32];
-    snprintf(signalStr, sizeof(signalStr), "%s", btcData.tradingSignal);
+    if (btcData.signalConfidence > 0) {
+        snprintf(signalStr, sizeof(signalStr), "%s %u%%", btcData.tradingSignal, btcData.signalConfidence);
+    } else {
+        snprintf(signalStr, sizeof(signalStr), "%s", btcData.tradingSignal);
+    }
     if (baseY > -80 && baseY < 320 && x2 < 480 && (x2 + 228) > 0) {
         // Color based on signal: BUY=green, SELL=red, HOLD=gray
         uint32_t signalColor = cardColor;
@@ -219,19 +349,123 @@ void MainScreen::drawContent() {
         } else {
             signalColor = 0x808080; // Gray (HOLD)
         }
-        drawCard(x2, baseY, 228, 80, "Trading (15m-1h)", signalStr, signalColor);
+        char signalTitle[32];
+        snprintf(signalTitle, sizeof(signalTitle), "Trading (%s)", btcData.signalTimeframe);
+        placeCard(7, x2, baseY, signalTitle, signalStr, signalColor, isStale(FETCH_AI_SIGNALS));
+    }
+
+    // Row 5: Local Signal and Indicators (computed on device)
+    baseY += 88;
+    char localStr[32];
+    if (btcData.localSignal[0] != '\0') {
+        snprintf(localStr, sizeof(localStr), "%s %u%%", btcData.localSignal, btcData.localConfidence);
+    } else {
+        snprintf(localStr, sizeof(localStr), "Warming up");
+    }
+    if (baseY > -80 && baseY < 320 && x1 < 480 && (x1 + 228) > 0) {
+        // Color based on signal: BUY=green, SELL=red, HOLD=gray
+        uint32_t localColor = cardColor;
+        if (strcmp(btcData.localSignal, "BUY") == 0) {
+            localColor = 0x00FF00; // Green
+        } else if (strcmp(btcData.localSignal, "SELL") == 0) {
+            localColor = 0xFF0000; // Red
+        } else if (btcData.localSignal[0] != '\0') {
+            localColor = 0x808080; // Gray (HOLD)
+        }
+        placeCard(8, x1, baseY, "Local Signal", localStr, localColor, isStale(FETCH_PRICE));
+    }
+
+    // RSI as the value; band width and hourly volatility fit in the title
+    char rsiStr[32];
+    if (btcData.rsi >= 0) {
+        snprintf(rsiStr, sizeof(rsiStr), "RSI %.0f", btcData.rsi);
+    } else {
+        snprintf(rsiStr, sizeof(rsiStr), "RSI --");
+    }
+    if (baseY > -80 && baseY < 320 && x2 < 480 && (x2 + 228) > 0) {
+        char indicatorTitle[48];
+        snprintf(indicatorTitle, sizeof(indicatorTitle), "Bands %.1f%%  Volatility %.2f%%/h",
+                 btcData.bandWidthPct, btcData.volatilityPct);
+        placeCard(9, x2, baseY, indicatorTitle, rsiStr, cardColor, isStale(FETCH_PRICE));
     }
 
-    // Clear clipping region
-    lcd->clearClipRect();
+    // Compose into the back sprite when there is one, otherwise draw on the panel
+    bool composing = frameBuffer.ready();
+    canvas = composing ? static_cast<lgfx::LovyanGFX*>(frameBuffer.back()) : static_cast<lgfx::LovyanGFX*>(lcd);
+    canvasY = composing ? CONTENT_Y : 0;
 
-    // Redraw header on top to ensure it's always visible (z-index fix)
-    drawHeader();
+    // Only cards whose content changed are repainted, unless the scroll moved everything.
+    // cardModel is the panel; the back sprite has its own (it missed the last frame).
+    bool full = cardModel.beginFrame(scrollOffsetY);
+    framePixels = 0;
+    dirtyCount = 0;
+    renderStats.fullRedrawPixels += 480 * CONTENT_H + 480 * HEADER_H;
+
+    // Use startWrite/endWrite for batch operations (much faster)
+    lcd->startWrite();
+
+    // Set clipping region to content area only (prevents cards from drawing over header)
+    if (!composing) {
+        lcd->setClipRect(0, CONTENT_Y, 480, CONTENT_H);
+    }
+
+    // A scroll reuses the last frame: shift it and render only the strip it lacks.
+    // After a blit the back sprite is at this offset, so it is not cleared.
+    bool clear = full;
+    if (composing) {
+        CardModel& back = bufferModel[frameBuffer.backBuffer()];
+        int backScroll;
+        if (blitScrolling && (!back.lastScroll(backScroll) || backScroll != scrollOffsetY)) {
+            blitFromFront();
+        }
+        clear = back.beginFrame(scrollOffsetY);
+    }
+
+    // Clear content area (preserve header) - do AFTER setting clip region for faster clear
+    if (clear) {
+        canvas->fillRect(0, CONTENT_Y - canvasY, 480, CONTENT_H, 0x000000);
+    }
+    if (full) {
+        addDirty(0, CONTENT_Y, 480, CONTENT_H);
+        framePixels += 480 * CONTENT_H;
+        renderStats.fullFrames++;
+    }
+
+    for (uint8_t i = 0; i < CARD_MODEL_MAX_CARDS; i++) {
+        if (placedCards & (1u << i)) renderCard(i);
+    }
+
+    // Push what changed on the panel; the next frame is composed while the DMA runs
+    uint32_t composeUs = micros() - started;
+    uint32_t waitUs = 0;
+    if (composing) {
+        waitUs = frameBuffer.present(dirty, dirtyCount);
+    } else {
+        lcd->clearClipRect();
+    }
+
+    // Cards are clipped below the header; repaint it only when its text changed
+    drawHeader(false);
 
     // End batch write operation
     lcd->endWrite();
 
-    isDragging = false;
+    renderStats.frames++;
+    renderStats.pixels += framePixels;
+    renderStats.lastFramePixels = framePixels;
+    frameStats.record(micros(), composeUs, waitUs, framePixels * 2);
+
+    // Boot-to-first-price, whether the price came from the warm start or the network
+    if (!firstFrameLogged && btcData.priceUSD > 0) {
+        firstFrameLogged = true;
+        const char* source = isStale(FETCH_PRICE) ? "restored" : "live";
+        Serial.printf("✓ First meaningful frame at %lu ms after boot (%s)\n", millis(), source);
+        sdLogger.logf(LOG_INFO, "First meaningful frame: %lu ms after boot (%s)", millis(), source);
+    }
+}
+
+bool MainScreen::isStale(FetchJob job) const {
+    return (staleSources & (1u << job)) != 0;
 }
 
 void MainScreen::rotateScreen() {
@@ -246,13 +480,38 @@ void MainScreen::rotateScreen() {
     lcd->fillScreen(0x000000);
     scrollOffsetX = 0;
     scrollOffsetY = 0;
+    cardModel.invalidate();
     drawHeader();
-    drawContent();
+    manager->invalidate(RENDER_LAYOUT);
 }
 
-void MainScreen::drawHeader() {
+void MainScreen::drawHeader(bool force) {
     LGFX* lcd = manager->getLCD();
 
+    // Uptime, or the age of the restored values until a live price lands
+    // (AI signals may never refresh without an API key, so they do not hold it)
+    char timeStr[16];
+    uint32_t age;
+    bool cached = isStale(FETCH_PRICE);
+    if (cached && warmStart.restoredAge(staleSources, wallClockNow(), age)) {
+        char ageStr[8];
+        warmFormatAge(age, ageStr, sizeof(ageStr));
+        snprintf(timeStr, sizeof(timeStr), "cached %s", ageStr);
+    } else if (cached) {
+        snprintf(timeStr, sizeof(timeStr), "cached");
+    } else {
+        unsigned long uptime = millis() / 1000;
+        unsigned long hours = uptime / 3600;
+        unsigned long mins = (uptime % 3600) / 60;
+        snprintf(timeStr, sizeof(timeStr), "%02luh %02lum", hours, mins);
+    }
+
+    if (!force && strcmp(timeStr, headerText) == 0) {
+        return;
+    }
+    strcpy(headerText, timeStr);
+    framePixels += 480 * HEADER_H;
+
     // Header bar - Bitcoin orange background
     lcd->fillRect(0, 0, 480, 28, 0xF7931A);
     lcd->fillRect(0, 28, 480, 1, 0xFFFFFF);  // White separator line
@@ -264,224 +523,144 @@ void MainScreen::drawHeader() {
     lcd->print("Bitcoin Dashboard");
 
     // Time - white text
-    char timeStr[16];
-    unsigned long uptime = millis() / 1000;
-    unsigned long hours = uptime / 3600;
-    unsigned long mins = (uptime % 3600) / 60;
-    snprintf(timeStr, sizeof(timeStr), "%02luh %02lum", hours, mins);
-
     lcd->setTextColor(0xFFFFFF, 0xF7931A);
     lcd->setTextSize(1);
     lcd->setCursor(380, 12);
     lcd->print(timeStr);
 }
 
-void MainScreen::drawCard(int x, int y, int w, int h, const char* title, const char* value, uint32_t color) {
-    LGFX* lcd = manager->getLCD();
-
-    // Simplified card - no rounded corners or shadows for faster rendering
-    lcd->fillRect(x, y, w, h, 0x252525);              // Card background
-    lcd->drawRect(x, y, w, h, 0x404040);              // Border
-
-    // Title
-    lcd->setTextColor(0xAAAAAA, 0x252525);
-    lcd->setTextSize(1);
-    lcd->setCursor(x + 8, y + 10);
-    lcd->print(title);
-
-    // Value
-    lcd->setTextColor(0xFFFFFF, 0x252525);
-    lcd->setTextSize(3);
-    lcd->setCursor(x + 8, y + 35);
-    lcd->print(value);
+void MainScreen::placeCard(uint8_t index, int x, int y, const char* title, const char* value,
+                           uint32_t color, bool stale) {
+    cardViewSet(cards[index], x, y, 228, 80, title, value, color, stale);
+    placedCards |= (uint16_t)(1u << index);
 }
 
-// API Fetch Functions
-bool MainScreen::fetchBTCPrice() {
-    if (WiFi.status() != WL_CONNECTED) {
-        Serial.println("❌ Price fetch: WiFi not connected");
-        return false;
-    }
-
-    HTTPClient http;
-    http.begin("https://mempool.space/api/v1/prices");
-    http.setTimeout(10000);
-
-    Serial.println("📡 Fetching BTC price...");
-    int httpCode = http.GET();
-    Serial.printf("HTTP code: %d\n", httpCode);
+void MainScreen::renderCard(uint8_t index) {
+    const CardView& view = cards[index];
+    uint32_t area = clippedArea(view.x, view.y, view.w, view.h, 0, CONTENT_Y, 480, CONTENT_H);
+    renderStats.fullRedrawPixels += area;
 
-    if (httpCode == 200) {
-        String payload = http.getString();
-        Serial.printf("Price payload: %s\n", payload.c_str());
+    // Drawn if the canvas has something else there, pushed if the panel does
+    bool toPanel = cardModel.update(index, view);
+    bool toCanvas = frameBuffer.ready() ? bufferModel[frameBuffer.backBuffer()].update(index, view) : toPanel;
 
-        StaticJsonDocument<256> doc;
-        DeserializationError error = deserializeJson(doc, payload);
-
-        if (!error) {
-            btcData.priceUSD = doc["USD"];
-            btcData.priceEUR = doc["EUR"];
-            Serial.printf("✓ Price: USD $%.2f, EUR €%.2f\n", btcData.priceUSD, btcData.priceEUR);
-            http.end();
-            return true;
-        } else {
-            Serial.printf("❌ JSON parse error: %s\n", error.c_str());
-        }
-    }
-
-    http.end();
-    return false;
-}
-
-bool MainScreen::fetchBlockData() {
-    if (WiFi.status() != WL_CONNECTED) {
-        Serial.println("❌ Block fetch: WiFi not connected");
-        return false;
+    if (toCanvas) {
+        drawCard(view);
+        renderStats.cardsDrawn++;
+    } else {
+        renderStats.cardsSkipped++;
     }
-
-    HTTPClient http;
-    // Use tip/height endpoint instead - much smaller response
-    http.begin("https://mempool.space/api/blocks/tip/height");
-    http.setTimeout(10000);
-
-    Serial.println("📡 Fetching block height...");
-    int httpCode = http.GET();
-    Serial.printf("HTTP code: %d\n", httpCode);
-
-    if (httpCode == 200) {
-        String payload = http.getString();
-        Serial.printf("Block height payload: %s\n", payload.c_str());
-
-        // Response is just a number
-        btcData.blockHeight = payload.toInt();
-        Serial.printf("✓ Block height: %lu\n", btcData.blockHeight);
-        http.end();
-        return true;
+    if (toPanel) {
+        addDirty(view.x, view.y, view.w, view.h);
+        framePixels += area;
     }
-
-    http.end();
-    return false;
 }
 
-bool MainScreen::fetchMempoolData() {
-    if (WiFi.status() != WL_CONNECTED) {
-        Serial.println("❌ Mempool fetch: WiFi not connected");
-        return false;
-    }
-
-    HTTPClient http;
-
-    // Fetch fee rates (small payload)
-    Serial.println("📡 Fetching fee rates...");
-    http.begin("https://mempool.space/api/v1/fees/recommended");
-    http.setTimeout(10000);
-
-    int httpCode = http.GET();
-    Serial.printf("Fees HTTP code: %d\n", httpCode);
-
-    if (httpCode == 200) {
-        String payload = http.getString();
-        Serial.printf("Fees payload: %s\n", payload.c_str());
-
-        StaticJsonDocument<256> doc;
-        DeserializationError error = deserializeJson(doc, payload);
-
-        if (!error) {
-            btcData.feeFast = doc["fastestFee"];
-            btcData.feeMedium = doc["halfHourFee"];
-            btcData.feeSlow = doc["hourFee"];
-            Serial.printf("✓ Fees: fast=%d, medium=%d, slow=%d sat/vB\n",
-                         btcData.feeFast, btcData.feeMedium, btcData.feeSlow);
-        } else {
-            Serial.printf("❌ Fees JSON parse error: %s\n", error.c_str());
-        }
+bool MainScreen::blitFromFront() {
+    CardModel& front = bufferModel[frameBuffer.backBuffer() ^ 1];
+    CardModel& back = bufferModel[frameBuffer.backBuffer()];
+    int frontScroll;
+    if (!front.lastScroll(frontScroll)) return false;
+
+    int dy = scrollOffsetY - frontScroll;
+    if (dy >= CONTENT_H || -dy >= CONTENT_H) return false;
+
+    // Pixels the front frame already has, moved to the new offset
+    LGFX_Sprite* sprite = frameBuffer.back();
+    ScrollStrip strip = scrollBlit((uint16_t*)sprite->getBuffer(),
+                                   (const uint16_t*)frameBuffer.front()->getBuffer(), 480, CONTENT_H, dy);
+    back.scrollFrom(front, scrollOffsetY);
+
+    // Newly exposed rows: every card crossing them, clipped to the strip
+    sprite->setClipRect(0, strip.y, 480, strip.h);
+    sprite->fillRect(0, strip.y, 480, strip.h, 0x000000);
+    for (uint8_t i = 0; i < CARD_MODEL_MAX_CARDS; i++) {
+        if (!(placedCards & (1u << i))) continue;
+        const CardView& view = cards[i];
+        int top = view.y - CONTENT_Y;
+        if (top >= strip.y + strip.h || top + view.h <= strip.y) continue;
+        drawCard(view);
+
+        // A card the front frame did not show lies entirely in the strip
+        if (!back.isValid(i)) back.update(i, view);
     }
-    http.end();
+    sprite->clearClipRect();
 
-    // Fetch mempool count using streaming parser to avoid huge fee_histogram
-    Serial.println("📡 Fetching mempool count...");
-    http.begin("https://mempool.space/api/mempool");
-    http.setTimeout(10000);
-
-    httpCode = http.GET();
-    Serial.printf("Mempool HTTP code: %d\n", httpCode);
-
-    if (httpCode == 200) {
-        String payload = http.getString();
-
-        // Extract only the "count" field using string parsing to save memory
-        int countStart = payload.indexOf("\"count\":");
-        if (countStart != -1) {
-            countStart += 8; // Skip "count":
-            int countEnd = payload.indexOf(',', countStart);
-            if (countEnd == -1) countEnd = payload.indexOf('}', countStart);
-
-            String countStr = payload.substring(countStart, countEnd);
-            btcData.mempoolCount = countStr.toInt();
-            Serial.printf("✓ Mempool count: %lu TX\n", btcData.mempoolCount);
-            http.end();
-            return true;
-        } else {
-            Serial.println("❌ Could not find count in mempool response");
-        }
-    }
+    renderStats.blitFrames++;
+    renderStats.stripRows += strip.h;
+    return true;
+}
 
-    http.end();
-    return false;
+void MainScreen::addDirty(int x, int y, int w, int h) {
+    // Inside the full-area push already queued this frame
+    if (dirtyCount > 0 && dirty[0].h == CONTENT_H) return;
+    if (dirtyCount >= FRAME_MAX_RECTS) return;
+    dirty[dirtyCount].x = (int16_t)x;
+    dirty[dirtyCount].y = (int16_t)y;
+    dirty[dirtyCount].w = (int16_t)w;
+    dirty[dirtyCount].h = (int16_t)h;
+    dirtyCount++;
 }
 
-bool MainScreen::fetchDCASignal() {
-    if (WiFi.status() != WL_CONNECTED) {
-        Serial.println("❌ DCA fetch: WiFi not connected");
-        return false;
+void MainScreen::printRenderStats() {
+    const RenderStats& s = renderStats;
+    Serial.printf("Main screen: %u frames (%u full), %u cards drawn, %u unchanged\n",
+                 s.frames, s.fullFrames, s.cardsDrawn, s.cardsSkipped);
+    if (s.frames == 0) return;
+    Serial.printf("  Pixels/frame: %llu (last %u), full redraw would push %llu (%.0f%% saved)\n",
+                 s.pixels / s.frames, s.lastFramePixels, s.fullRedrawPixels / s.frames,
+                 s.fullRedrawPixels > 0 ? 100.0 * (1.0 - (double)s.pixels / s.fullRedrawPixels) : 0.0);
+    if (s.blitFrames > 0) {
+        Serial.printf("  Scroll blits: %u frames, %llu rows rendered per blit (of %d)\n",
+                     s.blitFrames, s.stripRows / s.blitFrames, CONTENT_H);
     }
 
-    Serial.println("📡 Fetching DCA recommendation from Gemini AI...");
-
-    // Create Gemini client
-    GeminiClient gemini;
-
-    // Fetch DCA recommendation
-    String recommendation;
-    bool success = gemini.fetchDCARecommendation(btcData, recommendation);
-
-    if (success) {
-        // Copy recommendation to btcData
-        strncpy(btcData.dcaRecommendation, recommendation.c_str(), sizeof(btcData.dcaRecommendation) - 1);
-        btcData.dcaRecommendation[sizeof(btcData.dcaRecommendation) - 1] = '\0';
-
-        Serial.printf("✓ DCA Recommendation: %s\n", btcData.dcaRecommendation);
-        return true;
+    const FrameStats& f = frameStats;
+    Serial.printf("  Frame time: compose avg %luus max %luus, DMA wait avg %luus max %luus, %lu bytes/frame\n",
+                 (unsigned long)f.avgComposeUs(), (unsigned long)f.maxComposeUs(),
+                 (unsigned long)f.avgWaitUs(), (unsigned long)f.maxWaitUs(), (unsigned long)f.avgBytes());
+    Serial.printf("  While scrolling: %.0f fps, bus %.0f%% busy (%lu MB/s bus)\n",
+                 f.burstFps(), f.busUtilization(), FRAME_BUS_BYTES_PER_SEC / 1000000UL);
+    if (valueFont.ready()) {
+        Serial.printf("  Card values: glyph atlas, %s (%u KB PSRAM)\n",
+                     valueFont.source(), (unsigned)(valueFont.bytesUsed() / 1024));
     } else {
-        Serial.println("❌ Failed to fetch DCA recommendation");
-        return false;
+        Serial.println("  Card values: setTextSize(3) print (no glyph atlas)");
     }
 }
 
-bool MainScreen::fetchTradingSignal() {
-    if (WiFi.status() != WL_CONNECTED) {
-        Serial.println("❌ Trading signal fetch: WiFi not connected");
-        return false;
-    }
+void MainScreen::drawCard(const CardView& card) {
+    // Sprite or panel, whichever drawContent() composes on
+    lgfx::LovyanGFX* gfx = canvas;
+    int x = card.x;
+    int y = card.y - canvasY;
+    int w = card.w;
+    int h = card.h;
 
-    Serial.println("📡 Fetching trading signal from Gemini AI (15m-1h)...");
+    // Simplified card - no rounded corners or shadows for faster rendering
+    gfx->fillRect(x, y, w, h, 0x252525);              // Card background
+    gfx->drawRect(x, y, w, h, 0x404040);              // Border
 
-    // Create Gemini client
-    GeminiClient gemini;
+    // Title
+    gfx->setTextColor(0xAAAAAA, 0x252525);
+    gfx->setTextSize(1);
+    gfx->setCursor(x + 8, y + 10);
+    gfx->print(card.title);
+
+    // Stale (warm-start) values are grayed with an amber marker until refreshed
+    if (card.stale) {
+        gfx->fillCircle(x + w - 12, y + 12, 4, 0xFFA500);
+    }
 
-    // Fetch trading signal
-    String signal;
-    bool success = gemini.fetchTradingSignal(btcData, signal);
+    drawValue(card, x, y);
+}
 
-    if (success) {
-        // Copy signal to btcData
-        strncpy(btcData.tradingSignal, signal.c_str(), sizeof(btcData.tradingSignal) - 1);
-        btcData.tradingSignal[sizeof(btcData.tradingSignal) - 1] = '\0';
+void MainScreen::drawValue(const CardView& card, int x, int y) {
+    // Pre-rendered glyphs when the atlas has every character
+    if (glyphAtlas && valueFont.draw(canvas, x + 8, y + 35, card.value, card.stale)) return;
 
-        Serial.printf("✓ Trading Signal (15m-1h): %s\n", btcData.tradingSignal);
-        return true;
-    } else {
-        Serial.println("❌ Failed to fetch trading signal");
-        return false;
-    }
+    canvas->setTextColor(card.stale ? VALUE_FONT_STALE : VALUE_FONT_LIVE, VALUE_FONT_BG);
+    canvas->setTextSize(3);
+    canvas->setCursor(x + 8, y + 35);
+    canvas->print(card.value);
 }
@@ -4,20 +4,16 @@
 #include "ScreenManager.h"
 #include "../Config.h"
 #include "../api/BTCData.h"
+#include "../network/FetchScheduler.h"
+#include "CardModel.h"
+#include "DragScroll.h"
+#include "FrameBuffer.h"
+#include "FrameStats.h"
 
 class MainScreen : public BaseScreen {
 private:
     ScreenManager* manager;
 
-    // Data update intervals
-    static const unsigned long PRICE_UPDATE = 30000;
-    static const unsigned long STATS_UPDATE = 60000;
-    static const unsigned long AI_UPDATE = 300000;  // 5 minutes for AI signals
-
-    unsigned long lastPriceUpdate = 0;
-    unsigned long lastStatsUpdate = 0;
-    unsigned long lastAIUpdate = 0;
-
     // Vertical scrolling
     int scrollOffsetY = 0;
     int maxScrollY = 0;
@@ -26,40 +22,71 @@ private:
     int scrollOffsetX = 0;
     int maxScrollX = 0;
 
-    // Touch tracking
-    int16_t lastTouchX = 0;
-    int16_t lastTouchY = 0;
-    int16_t initialTouchX = 0;
-    int16_t initialTouchY = 0;
-    bool isDragging = false;
-    bool isHorizontalScroll = false;
+    // Touch tracking (ends on touch up, not on a frame)
+    DragScroll drag;
 
     // Performance optimization
     int lastDrawnScrollX = 0;
-    int lastDrawnScrollY = 0;
     static const int SCROLL_REDRAW_THRESHOLD = 1;  // Pixels moved before redraw (immediate response)
-    unsigned long lastDrawTime = 0;
-    static const unsigned long MIN_DRAW_INTERVAL = 8;  // Min 8ms between redraws (120 FPS)
+    unsigned long lastClockMinute = 0;  // Header clock shown; a new minute invalidates it
 
     // Screen rotation
     uint8_t rotation = 1;  // 0=0°, 1=90°, 2=180°, 3=270°
 
-    void drawCard(int x, int y, int w, int h, const char* title, const char* value, uint32_t color);
-    void drawHeader();
+    // Dirty-region rendering: what each card and the header last put on the panel
+    CardModel cardModel;
+    char headerText[16] = "";
+    uint32_t framePixels = 0;
+    static RenderStats renderStats;  // Kept across screen switches
+
+    // Off-screen composition: cards are drawn into the back sprite, then the
+    // dirty rectangles are pushed with DMA
+    FrameBuffer frameBuffer;
+    CardModel bufferModel[2];        // What each sprite holds
+    lgfx::LovyanGFX* canvas = nullptr;
+    int canvasY = 0;                 // Screen y of the canvas's row 0
+    FrameRect dirty[FRAME_MAX_RECTS];
+    uint8_t dirtyCount = 0;
+    static FrameStats frameStats;
+
+    // This frame's cards (placeCard), rendered once the canvas is ready
+    CardView cards[CARD_MODEL_MAX_CARDS];
+    uint16_t placedCards = 0;
+    bool blitScrolling = true;       // Off for the full-redraw pass of the scroll benchmark
+    static bool scrollBenchmarkRequested;
+    bool glyphAtlas = true;          // Off for the print pass of the text benchmark
+    static bool textBenchmarkRequested;
+
+    void drawCard(const CardView& card);
+    void drawValue(const CardView& card, int x, int y);
+    void placeCard(uint8_t index, int x, int y, const char* title, const char* value,
+                   uint32_t color, bool stale);
+    void renderCard(uint8_t index);
+    bool blitFromFront();
+    void runScrollBenchmark();
+    void runTextBenchmark();
+    void addDirty(int x, int y, int w, int h);
+    void drawHeader(bool force = true);
     void drawContent();
     void rotateScreen();
-
-    // API fetch functions
-    bool fetchBTCPrice();
-    bool fetchBlockData();
-    bool fetchMempoolData();
-    bool fetchDCASignal();
-    bool fetchTradingSignal();
+    bool isStale(FetchJob job) const;  // Value on screen is the warm-start copy
 
 public:
     void init(ScreenManager* mgr);
     void update();
     void handleTouch(int16_t x, int16_t y);
+    void handleDrag(int16_t x, int16_t y);
+    void handleRelease();
+    void render(uint8_t reasons);
+
+    // Pixels pushed per frame vs a full redraw, frame time and bus load (RENDER_STATS command)
+    static void printRenderStats();
+
+    // Sweep the content up and down with and without blits, print fps (SCROLL_BENCH command)
+    static void requestScrollBenchmark() { scrollBenchmarkRequested = true; }
+
+    // Draw time per card value, glyph atlas vs setTextSize(3) print (TEXT_BENCH command)
+    static void requestTextBenchmark() { textBenchmarkRequested = true; }
 };
 
 #endif
@@ -0,0 +1,166 @@
+#ifndef RENDER_SCHEDULER_H
+#define RENDER_SCHEDULER_H
+
+#include <stdint.h>
+
+// Render loop settings
+#define RENDER_FRAME_BUDGET_US 16667UL  // 60 Hz tick, one frame at most per tick
+#define RENDER_HIST_BUCKETS 11
+
+// Why a frame is needed; invalidations between two ticks are merged
+enum RenderReason {
+    RENDER_DATA = 1 << 0,    // Fetch results arrived
+    RENDER_TOUCH = 1 << 1,   // Drag moved the content
+    RENDER_CLOCK = 1 << 2,   // Header clock or cache age rolled over
+    RENDER_LAYOUT = 1 << 3,  // Rotation, screen cleared
+    RENDER_REASON_COUNT = 4
+};
+
+// Upper edges of the frame time buckets (the last bucket is everything slower)
+static const uint32_t RENDER_HIST_EDGES_US[RENDER_HIST_BUCKETS - 1] = {
+    1000, 2000, 4000, 8000, 12000, RENDER_FRAME_BUDGET_US, 25000, 33333, 50000, 100000
+};
+
+/**
+ * FrameTimeHistogram - Distribution of frame render times
+ *
+ * Fixed buckets from 1 ms to 100 ms, with one edge at the frame budget so
+ * frames that missed their tick are counted exactly. Percentiles are
+ * reported as the upper edge of the bucket they fall in.
+ */
+class FrameTimeHistogram {
+public:
+    FrameTimeHistogram() { clear(); }
+
+    void clear() {
+        for (int i = 0; i < RENDER_HIST_BUCKETS; i++) counts[i] = 0;
+        frames = 0;
+        totalUs = 0;
+        maxFrameUs = 0;
+    }
+
+    void record(uint32_t frameUs) {
+        counts[bucketOf(frameUs)]++;
+        frames++;
+        totalUs += frameUs;
+        if (frameUs > maxFrameUs) maxFrameUs = frameUs;
+    }
+
+    static int bucketOf(uint32_t frameUs) {
+        int i = 0;
+        while (i < RENDER_HIST_BUCKETS - 1 && frameUs >= RENDER_HIST_EDGES_US[i]) i++;
+        return i;
+    }
+
+    // Upper edge of the bucket holding the pct-th percentile frame (max for the last bucket)
+    uint32_t percentileUs(uint8_t pct) const {
+        if (frames == 0) return 0;
+        uint32_t rank = (uint32_t)(((uint64_t)frames * pct + 99) / 100);
+        if (rank == 0) rank = 1;
+        uint32_t seen = 0;
+        for (int i = 0; i < RENDER_HIST_BUCKETS - 1; i++) {
+            seen += counts[i];
+            if (seen >= rank) return RENDER_HIST_EDGES_US[i];
+        }
+        return maxFrameUs;
+    }
+
+    // Frames slower than the budget
+    uint32_t overBudget() const {
+        uint32_t n = 0;
+        for (int i = bucketOf(RENDER_FRAME_BUDGET_US); i < RENDER_HIST_BUCKETS; i++) n += counts[i];
+        return n;
+    }
+
+    uint32_t count(int bucket) const { return counts[bucket]; }
+    uint32_t frameCount() const { return frames; }
+    uint32_t avgUs() const { return frames ? (uint32_t)(totalUs / frames) : 0; }
+    uint32_t maxUs() const { return maxFrameUs; }
+
+private:
+    uint32_t counts[RENDER_HIST_BUCKETS];
+    uint32_t frames;
+    uint64_t totalUs;
+    uint32_t maxFrameUs;
+};
+
+/**
+ * RenderScheduler - Fixed-rate frame pacing for the screens
+ *
+ * Screens no longer draw when something changes; they invalidate() with a
+ * reason and ScreenManager renders at most one frame per tick of the frame
+ * budget, however many data results, touch moves and clock updates came in
+ * since the last one. Ticks keep a steady phase while frames keep coming
+ * (a drag renders every 16.7 ms, not whenever the loop comes around); after
+ * an idle gap or a frame longer than a tick, the next frame renders at
+ * once and the phase restarts from it.
+ *
+ * untilNextTickUs() tells the main loop how long it can sleep.
+ */
+class RenderScheduler {
+public:
+    RenderScheduler() { clear(); }
+
+    void clear() {
+        pendingReasons = 0;
+        nextTickUs = 0;
+        started = false;
+        invalidations = 0;
+        for (int i = 0; i < RENDER_REASON_COUNT; i++) reasonFrames[i] = 0;
+        histogram.clear();
+    }
+
+    void invalidate(uint8_t reasons) {
+        pendingReasons |= reasons;
+        invalidations++;
+    }
+
+    // Drop pending invalidations (the new screen draws itself)
+    void cancel() { pendingReasons = 0; }
+
+    bool pending() const { return pendingReasons != 0; }
+
+    // True if a frame should render now; hands over the merged reasons
+    bool due(uint32_t nowUs, uint8_t& reasons) {
+        if (pendingReasons == 0) return false;
+        if (started && (int32_t)(nowUs - nextTickUs) < 0) return false;
+
+        reasons = pendingReasons;
+        pendingReasons = 0;
+        for (int i = 0; i < RENDER_REASON_COUNT; i++) {
+            if (reasons & (1 << i)) reasonFrames[i]++;
+        }
+
+        // Next tick one budget after this one; a whole tick late restarts the phase
+        nextTickUs += RENDER_FRAME_BUDGET_US;
+        if (!started || (int32_t)(nowUs - nextTickUs) >= 0) {
+            nextTickUs = nowUs + RENDER_FRAME_BUDGET_US;
+        }
+        started = true;
+        return true;
+    }
+
+    // Time the frame took to render (after due() returned true)
+    void frameDone(uint32_t frameUs) { histogram.record(frameUs); }
+
+    // Microseconds until a frame could render; idle loops sleep a whole tick
+    uint32_t untilNextTickUs(uint32_t nowUs) const {
+        int32_t remaining = (int32_t)(nextTickUs - nowUs);
+        if (started && remaining > 0) return (uint32_t)remaining;
+        return pendingReasons != 0 ? 0 : RENDER_FRAME_BUDGET_US;
+    }
+
+    const FrameTimeHistogram& frameTimes() const { return histogram; }
+    uint32_t invalidationCount() const { return invalidations; }
+    uint32_t framesFor(int reasonBit) const { return reasonFrames[reasonBit]; }
+
+private:
+    uint8_t pendingReasons;
+    uint32_t nextTickUs;
+    bool started;
+    uint32_t invalidations;
+    uint32_t reasonFrames[RENDER_REASON_COUNT];
+    FrameTimeHistogram histogram;
+};
+
+#endif // RENDER_SCHEDULER_H
@@ -54,6 +54,7 @@ void ScreenManager::switchScreen(Screen screen) {
     if (currentScreen != nullptr) {
         delete currentScreen;
     }
+    scheduler.cancel();
 
     currentScreenType = screen;
 
@@ -89,6 +90,43 @@ void ScreenManager::update() {
     if (currentScreen != nullptr) {
         currentScreen->update();
     }
+
+    // At most one frame per tick for whatever touch, data and timers invalidated
+    uint8_t reasons;
+    if (currentScreen != nullptr && scheduler.due(micros(), reasons)) {
+        uint32_t started = micros();
+        currentScreen->render(reasons);
+        scheduler.frameDone(micros() - started);
+    }
+}
+
+void ScreenManager::printFramePacing() {
+    const FrameTimeHistogram& h = scheduler.frameTimes();
+    Serial.printf("Frame pacing: %lu us budget, %lu frames for %lu invalidations\n",
+                 RENDER_FRAME_BUDGET_US, (unsigned long)h.frameCount(),
+                 (unsigned long)scheduler.invalidationCount());
+    if (h.frameCount() == 0) return;
+
+    Serial.printf("  Frames by reason: data %lu, touch %lu, clock %lu, layout %lu\n",
+                 (unsigned long)scheduler.framesFor(0), (unsigned long)scheduler.framesFor(1),
+                 (unsigned long)scheduler.framesFor(2), (unsigned long)scheduler.framesFor(3));
+    Serial.printf("  Frame time: avg %luus, p50 <%luus, p95 <%luus, p99 <%luus, max %luus, %lu over budget\n",
+                 (unsigned long)h.avgUs(), (unsigned long)h.percentileUs(50),
+                 (unsigned long)h.percentileUs(95), (unsigned long)h.percentileUs(99),
+                 (unsigned long)h.maxUs(), (unsigned long)h.overBudget());
+
+    for (int i = 0; i < RENDER_HIST_BUCKETS; i++) {
+        char bar[41];
+        int len = (int)((uint64_t)h.count(i) * 40 / h.frameCount());
+        if (len == 0 && h.count(i) > 0) len = 1;
+        memset(bar, '#', len);
+        bar[len] = '\0';
+        if (i < RENDER_HIST_BUCKETS - 1) {
+            Serial.printf("  < %6.1f ms %7lu %s\n", RENDER_HIST_EDGES_US[i] / 1000.0f, (unsigned long)h.count(i), bar);
+        } else {
+            Serial.printf("  >=%6.1f ms %7lu %s\n", RENDER_HIST_EDGES_US[i - 1] / 1000.0f, (unsigned long)h.count(i), bar);
+        }
+    }
 }
 
 void ScreenManager::handleTouch() {
@@ -102,6 +140,15 @@ void ScreenManager::touchCallback(TPoint point, TEvent e) {
     int16_t transformedX = point.y;
     int16_t transformedY = 320 - point.x;
 
+    // Drags follow every touch point until release; frames in between do not end them
+    if (_instance->currentScreen != nullptr) {
+        if (e == TEvent::TouchStart || e == TEvent::TouchMove) {
+            _instance->currentScreen->handleDrag(transformedX, transformedY);
+        } else if (e == TEvent::TouchEnd) {
+            _instance->currentScreen->handleRelease();
+        }
+    }
+
 #ifdef SINGLE_SCREEN_MODE
     // In single screen mode, only handle taps (no swipe navigation)
     if (e == TEvent::TouchEnd || e == TEvent::Tap) {
@@ -4,6 +4,7 @@
 #include <Arduino.h>
 #include "../DisplayConfig.h"
 #include <FT6X36.h>
+#include "RenderScheduler.h"
 
 // Screen types
 enum Screen {
@@ -23,6 +24,11 @@ public:
     virtual void init(ScreenManager* manager) = 0;
     virtual void update() = 0;
     virtual void handleTouch(int16_t x, int16_t y) = 0;
+    // Touch down or move, and touch up, for screens that scroll
+    virtual void handleDrag(int16_t x, int16_t y) {}
+    virtual void handleRelease() {}
+    // Paced frame for invalidations since the last one (ScreenManager::invalidate)
+    virtual void render(uint8_t reasons) {}
     virtual ~BaseScreen() {}
 };
 
@@ -48,6 +54,7 @@ private:
     FT6X36* touch;
     BaseScreen* currentScreen;
     Screen currentScreenType;
+    RenderScheduler scheduler;
 
 #ifndef SINGLE_SCREEN_MODE
     // Swipe gesture tracking
@@ -76,6 +83,13 @@ public:
     FT6X36* getTouch() { return touch; }
     Screen getCurrentScreen() { return currentScreenType; }
     BaseScreen* getCurrentScreenInstance() { return currentScreen; }
+
+    // Ask for a frame; renders on the next tick together with anything else pending
+    void invalidate(uint8_t reasons) { scheduler.invalidate(reasons); }
+    // How long the main loop can sleep before the next tick
+    uint32_t untilNextFrameUs() { return scheduler.untilNextTickUs(micros()); }
+    // Frame time histogram and coalescing (RENDER_STATS command)
+    void printFramePacing();
 };
 
 #endif
@@ -0,0 +1,42 @@
+#ifndef SCROLL_BLIT_H
+#define SCROLL_BLIT_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Rows of a frame that a scroll blit could not fill
+struct ScrollStrip {
+    int y;
+    int h;
+};
+
+/**
+ * Copy a rendered frame into dst moved up by dy rows (down for dy < 0), as
+ * a scroll by dy pixels shows it. Rows are contiguous, so this is a single
+ * memmove; the caller renders only the returned strip, which the old frame
+ * did not cover. |dy| >= height copies nothing and exposes the whole frame.
+ *
+ * src and dst may be the same buffer.
+ */
+inline ScrollStrip scrollBlit(uint16_t* dst, const uint16_t* src, int width, int height, int dy) {
+    ScrollStrip strip;
+    if (dy >= height || -dy >= height) {
+        strip.y = 0;
+        strip.h = height;
+        return strip;
+    }
+
+    size_t rowBytes = (size_t)width * sizeof(uint16_t);
+    if (dy >= 0) {
+        memmove(dst, src + (size_t)dy * width, (size_t)(height - dy) * rowBytes);
+        strip.y = height - dy;
+        strip.h = dy;
+    } else {
+        memmove(dst + (size_t)(-dy) * width, src, (size_t)(height + dy) * rowBytes);
+        strip.y = 0;
+        strip.h = -dy;
+    }
+    return strip;
+}
+
+#endif // SCROLL_BLIT_H
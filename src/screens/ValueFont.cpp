@@ -0,0 +1,106 @@
+#include <SD.h>
+#include <esp_heap_caps.h>
+#include "ValueFont.h"
+#include "../utils/SDLogger.h"
+
+ValueFont valueFont;
+
+ValueFont::ValueFont() {
+    storage = nullptr;
+    vlwLoaded = false;
+}
+
+bool ValueFont::begin() {
+    if (storage != nullptr) return true;
+
+    // Glyphs are drawn into a sprite exactly as MainScreen used to print them
+    LGFX_Sprite cell;
+    cell.setColorDepth(16);
+    uint8_t* vlw = loadVlw();
+    if (vlw != nullptr && cell.loadFont(vlw)) {
+        vlwLoaded = true;
+    } else {
+        cell.setTextSize(3);
+    }
+
+    uint8_t height = (uint8_t)cell.fontHeight();
+    size_t perAtlas = GlyphAtlas::pixelsFor(VALUE_FONT_ALPHABET, height, [&cell](char c) {
+        char text[2] = { c, '\0' };
+        return cell.textWidth(text);
+    });
+
+    storage = (uint16_t*)heap_caps_malloc(2 * perAtlas * sizeof(uint16_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (storage == nullptr) {
+        Serial.printf("⚠️  Value font: %u bytes of PSRAM not available, printing values\n",
+                     (unsigned)(2 * perAtlas * sizeof(uint16_t)));
+        sdLogger.logf(LOG_WARN, "Value font: PSRAM allocation of %u bytes failed",
+                     (unsigned)(2 * perAtlas * sizeof(uint16_t)));
+    } else {
+        static const uint32_t COLORS[2] = { VALUE_FONT_LIVE, VALUE_FONT_STALE };
+        for (int a = 0; a < 2; a++) {
+            atlases[a].begin(storage + a * perAtlas, perAtlas, height);
+            cell.setTextColor(COLORS[a], VALUE_FONT_BG);
+
+            for (const char* c = VALUE_FONT_ALPHABET; *c; c++) {
+                char text[2] = { *c, '\0' };
+                int width = cell.textWidth(text);
+                if (width <= 0 || width > 255 || cell.createSprite(width, height) == nullptr) continue;
+                cell.fillScreen(VALUE_FONT_BG);
+                cell.setCursor(0, 0);
+                cell.print(text);
+                atlases[a].add(*c, (uint8_t)width, (const uint16_t*)cell.getBuffer());
+                cell.deleteSprite();
+            }
+        }
+
+        Serial.printf("✓ Value font: %s, %u glyphs x2 colors, %ux%u cells (%u KB PSRAM)\n",
+                     source(), (unsigned)strlen(VALUE_FONT_ALPHABET), (unsigned)cell.textWidth("0"),
+                     height, (unsigned)(bytesUsed() / 1024));
+        sdLogger.logf(LOG_INFO, "Value font: %s, %u px high, %u bytes PSRAM",
+                     source(), height, (unsigned)bytesUsed());
+    }
+
+    if (vlwLoaded) cell.unloadFont();
+    free(vlw);
+    return storage != nullptr;
+}
+
+bool ValueFont::draw(lgfx::LovyanGFX* gfx, int x, int y, const char* text, bool stale) {
+    const GlyphAtlas& atlas = atlases[stale ? 1 : 0];
+    if (storage == nullptr || !atlas.covers(text)) return false;
+
+    // Cells hold the sprite's byte order, which is the panel's: no conversion on push
+    uint8_t height = atlas.cellHeight();
+    for (; *text; text++) {
+        uint8_t width;
+        const uint16_t* cell = atlas.glyph(*text, width);
+        gfx->pushImage(x, y, width, height, (const lgfx::swap565_t*)cell);
+        x += width;
+    }
+    return true;
+}
+
+uint8_t* ValueFont::loadVlw() {
+    if (!sdLogger.isReady() || !SD.exists(VALUE_FONT_VLW_PATH)) return nullptr;
+
+    File file = SD.open(VALUE_FONT_VLW_PATH, FILE_READ);
+    if (!file) return nullptr;
+
+    size_t size = file.size();
+    uint8_t* data = nullptr;
+    if (size > 0 && size <= VALUE_FONT_VLW_MAX_BYTES) {
+        data = (uint8_t*)heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+    if (data != nullptr && file.read(data, size) != size) {
+        free(data);
+        data = nullptr;
+    }
+    file.close();
+
+    if (data == nullptr) {
+        Serial.printf("⚠️  Value font: could not load %s (%u bytes), using the built-in font\n",
+                     VALUE_FONT_VLW_PATH, (unsigned)size);
+        sdLogger.logf(LOG_WARN, "Value font: %s not loaded (%u bytes)", VALUE_FONT_VLW_PATH, (unsigned)size);
+    }
+    return data;
+}
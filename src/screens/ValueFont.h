@@ -0,0 +1,58 @@
+#ifndef VALUE_FONT_H
+#define VALUE_FONT_H
+
+#include <Arduino.h>
+#include "../DisplayConfig.h"
+#include "GlyphAtlas.h"
+
+// Characters pre-rendered for card values: prices, heights, fees, signals
+#define VALUE_FONT_ALPHABET " 0123456789$,.+-%/()ABCDEFGHIJKLMNOPQRSTUVWXYZabdefgimnoprstuv"
+
+// Optional anti-aliased font on the SD card (LovyanGFX/Processing VLW format)
+#define VALUE_FONT_VLW_PATH "/fonts/value.vlw"
+#define VALUE_FONT_VLW_MAX_BYTES (256 * 1024)
+
+// Card colors the glyphs are rendered in
+#define VALUE_FONT_BG 0x252525     // Card background
+#define VALUE_FONT_LIVE 0xFFFFFF
+#define VALUE_FONT_STALE 0x808080  // Warm-start values
+
+/**
+ * ValueFont - Card value glyphs rasterized once into a PSRAM atlas
+ *
+ * Card values used to be printed with setTextSize(3), which scales the
+ * built-in 6x8 font pixel by pixel on every redraw. begin() renders each
+ * character of VALUE_FONT_ALPHABET once per value color, with the same
+ * font (or the VLW font on the SD card, anti-aliased against the card
+ * background), and draw() copies the cells with pushImage: a row copy
+ * into the frame buffer sprite, or a plain push to the panel.
+ *
+ * Text with a character outside the alphabet is left to the caller's
+ * print() path.
+ */
+class ValueFont {
+public:
+    ValueFont();
+
+    // Rasterize the atlases (call once after the SD card and display); false if PSRAM is short
+    bool begin();
+    bool ready() const { return storage != nullptr; }
+
+    // Draw text with its top-left corner at (x, y); false (nothing drawn) if
+    // the atlas does not cover it
+    bool draw(lgfx::LovyanGFX* gfx, int x, int y, const char* text, bool stale);
+
+    const char* source() const { return vlwLoaded ? "SD VLW font" : "built-in font x3"; }
+    size_t bytesUsed() const { return atlases[0].bytesUsed() + atlases[1].bytesUsed(); }
+
+private:
+    uint8_t* loadVlw();
+
+    uint16_t* storage;
+    GlyphAtlas atlases[2];  // Live, stale
+    bool vlwLoaded;
+};
+
+extern ValueFont valueFont;
+
+#endif // VALUE_FONT_H
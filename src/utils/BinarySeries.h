@@ -0,0 +1,587 @@
+#ifndef BINARY_SERIES_H
+#define BINARY_SERIES_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "PriceCsv.h"
+#include "Gorilla.h"
+
+// Binary time-series files (.bts): /logs/data/<prefix>YYYY-MM-DD.bts
+#define BTS_SCHEMA_VERSION 2  // 1: fixed-size records, 2: Gorilla blocks
+#define BTS_HEADER_SIZE 16
+#define BTS_MAX_FIELDS 4
+#define BTS_BLOCK_SIZE 512    // Write buffer, and the largest v2 block
+#define BTS_MAX_DELTA 0xFFFE  // Longer gaps are written as a time mark
+#define BTS_TIME_MARK 0xFFFF  // Record holds an absolute offset instead of a sample
+
+static const uint8_t BTS_MAGIC[4] = {'B', 'T', 'S', 'D'};
+
+enum BtsKind {
+    BTS_PRICE = 1,
+    BTS_BLOCKS = 2,
+    BTS_MEMPOOL = 3,
+    BTS_FEES = 4
+};
+
+#define BTS_KIND_COUNT 4
+
+// Fields of each kind; values are stored as unsigned fixed-point integers
+struct BtsSchema {
+    uint8_t kind;
+    const char* prefix;   // File name prefix
+    const char* columns;  // CSV columns after "timestamp"
+    uint8_t fieldCount;
+    uint8_t decimals[BTS_MAX_FIELDS];
+};
+
+inline const BtsSchema* btsSchema(uint8_t kind) {
+    static const BtsSchema schemas[BTS_KIND_COUNT] = {
+        {BTS_PRICE, "btc_price_", "price_usd,price_eur", 2, {2, 2, 0, 0}},
+        {BTS_BLOCKS, "btc_blocks_", "block_height,tx_count,block_timestamp,size_bytes", 4, {0, 0, 0, 0}},
+        {BTS_MEMPOOL, "btc_mempool_", "tx_count,size_mb", 2, {0, 2, 0, 0}},
+        {BTS_FEES, "btc_fees_", "fee_fast,fee_medium,fee_slow", 3, {0, 0, 0, 0}},
+    };
+    if (kind < 1 || kind > BTS_KIND_COUNT) return nullptr;
+    return &schemas[kind - 1];
+}
+
+// Float to fixed-point with `decimals` digits, rounded; negatives clamp to 0
+// (scaled in double: a float has only ~7 digits, 97123.45 needs 7 plus 2)
+inline uint32_t btsFixed(float value, uint8_t decimals) {
+    double scaled = value;
+    for (uint8_t i = 0; i < decimals; i++) scaled *= 10.0;
+    if (!(scaled > 0)) return 0;
+    if (scaled >= 4294967295.0) return 0xFFFFFFFFu;
+    return (uint32_t)(scaled + 0.5);
+}
+
+inline void btsPut16(uint8_t* p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+inline void btsPut32(uint8_t* p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+inline uint16_t btsGet16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+inline uint32_t btsGet32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * Header (16 bytes, little-endian):
+ *   0  magic "BTSD"        8  base time (unix seconds, first sample)
+ *   4  schema version     12  decimals of each field (4 bytes)
+ *   5  kind (BtsKind)
+ *   6  field count
+ *   7  record size (v1), 0 (v2)
+ */
+struct BtsHeader {
+    uint8_t version = 0;
+    uint8_t kind = 0;
+    uint8_t fieldCount = 0;
+    uint8_t recordSize = 0;
+    uint32_t baseTime = 0;
+    uint8_t decimals[BTS_MAX_FIELDS] = {};
+};
+
+inline size_t btsRecordSize(uint8_t fieldCount) {
+    return 2 + 4 * (size_t)fieldCount;
+}
+
+// Field as a float, decimals applied
+inline float btsValue(const BtsHeader& h, const uint32_t* fields, uint8_t i) {
+    float v = (float)fields[i];
+    for (uint8_t d = 0; d < h.decimals[i]; d++) v /= 10.0f;
+    return v;
+}
+
+// "timestamp,<columns>" as in the CSV files
+inline int btsFormatHeader(const BtsHeader& h, char* out, size_t size) {
+    const BtsSchema* schema = btsSchema(h.kind);
+    return snprintf(out, size, "timestamp,%s", schema ? schema->columns : "");
+}
+
+// One CSV row; fixed-point fields are printed exactly
+inline int btsFormatRow(const BtsHeader& h, uint32_t time, const uint32_t* fields, char* out, size_t size) {
+    formatCsvTimestamp(time, out, size);
+    size_t len = strlen(out);
+    for (uint8_t i = 0; i < h.fieldCount && len < size; i++) {
+        uint32_t scale = 1;
+        for (uint8_t d = 0; d < h.decimals[i]; d++) scale *= 10;
+        int n;
+        if (scale == 1) {
+            n = snprintf(out + len, size - len, ",%lu", (unsigned long)fields[i]);
+        } else {
+            n = snprintf(out + len, size - len, ",%lu.%0*lu", (unsigned long)(fields[i] / scale),
+                         (int)h.decimals[i], (unsigned long)(fields[i] % scale));
+        }
+        if (n < 0) break;
+        len += (size_t)n;
+    }
+    return (int)len;
+}
+
+inline void btsWriteHeader(const BtsHeader& h, uint8_t* out) {
+    memcpy(out, BTS_MAGIC, 4);
+    out[4] = h.version;
+    out[5] = h.kind;
+    out[6] = h.fieldCount;
+    out[7] = h.recordSize;
+    btsPut32(out + 8, h.baseTime);
+    memcpy(out + 12, h.decimals, BTS_MAX_FIELDS);
+}
+
+// False for foreign files, other schema versions and inconsistent sizes
+inline bool btsReadHeader(const uint8_t* in, BtsHeader& h) {
+    if (memcmp(in, BTS_MAGIC, 4) != 0) return false;
+    h.version = in[4];
+    h.kind = in[5];
+    h.fieldCount = in[6];
+    h.recordSize = in[7];
+    h.baseTime = btsGet32(in + 8);
+    memcpy(h.decimals, in + 12, BTS_MAX_FIELDS);
+
+    if (h.fieldCount < 1 || h.fieldCount > BTS_MAX_FIELDS) return false;
+    if (h.version == 1) return h.recordSize == btsRecordSize(h.fieldCount);
+    return h.version == 2 && h.recordSize == 0;
+}
+
+/**
+ * BtsEncoder - Fixed-size records for one version 1 .bts file
+ *
+ * Each record is the seconds since the previous record (uint16) followed
+ * by the fixed-point fields (uint32 each): 10 bytes for a price sample
+ * against ~40 for its CSV row. A gap longer than BTS_MAX_DELTA, a clock
+ * step backwards, or the first record after resume() is preceded by a
+ * time-mark record holding the offset from the header's base time, so a
+ * reader only has to sum deltas from the start of the file.
+ */
+class BtsEncoder {
+public:
+    BtsEncoder() : lastTime(0), needsMark(true) {}
+
+    // New file: the first sample's time becomes the base. Fills `header`
+    // (BTS_HEADER_SIZE bytes); false for an unknown kind.
+    bool begin(uint8_t kind, uint32_t baseTime, uint8_t* header) {
+        const BtsSchema* schema = btsSchema(kind);
+        if (!schema) return false;
+
+        info = BtsHeader();
+        info.version = 1;
+        info.kind = kind;
+        info.fieldCount = schema->fieldCount;
+        info.recordSize = (uint8_t)btsRecordSize(schema->fieldCount);
+        info.baseTime = baseTime;
+        memcpy(info.decimals, schema->decimals, BTS_MAX_FIELDS);
+        btsWriteHeader(info, header);
+
+        lastTime = baseTime;
+        needsMark = false;
+        return true;
+    }
+
+    // Append to an existing file whose header was read back
+    bool resume(const uint8_t* header) {
+        if (!btsReadHeader(header, info) || info.version != 1) return false;
+        lastTime = info.baseTime;
+        needsMark = true;
+        return true;
+    }
+
+    // Encode a sample into `out` (maxEncodedSize() bytes). Returns the bytes
+    // written: one record, two with a time mark, 0 if before the base time.
+    size_t encode(uint32_t time, const uint32_t* fields, uint8_t* out) {
+        if (info.recordSize == 0 || time < info.baseTime) return 0;
+
+        size_t size = info.recordSize;
+        size_t written = 0;
+
+        if (needsMark || time < lastTime || time - lastTime > BTS_MAX_DELTA) {
+            memset(out, 0, size);
+            btsPut16(out, BTS_TIME_MARK);
+            btsPut32(out + 2, time - info.baseTime);
+            written = size;
+            lastTime = time;
+            needsMark = false;
+        }
+
+        uint8_t* rec = out + written;
+        btsPut16(rec, (uint16_t)(time - lastTime));
+        for (uint8_t i = 0; i < info.fieldCount; i++) {
+            btsPut32(rec + 2 + 4 * i, fields[i]);
+        }
+        lastTime = time;
+        return written + size;
+    }
+
+    size_t recordSize() const { return info.recordSize; }
+    size_t maxEncodedSize() const { return 2 * (size_t)info.recordSize; }
+    const BtsHeader& header() const { return info; }
+
+private:
+    BtsHeader info;
+    uint32_t lastTime;
+    bool needsMark;
+};
+
+/**
+ * BtsDecoder - Reads back the records of one version 1 .bts file
+ *
+ * Feed it the header, then each record in file order.
+ */
+class BtsDecoder {
+public:
+    BtsDecoder() : time(0) {}
+
+    bool begin(const uint8_t* headerBytes) {
+        if (!btsReadHeader(headerBytes, info) || info.version != 1) return false;
+        time = info.baseTime;
+        return true;
+    }
+
+    // True if the record is a sample (time marks only move the clock)
+    bool decode(const uint8_t* record, uint32_t& sampleTime, uint32_t* fields) {
+        uint16_t delta = btsGet16(record);
+        if (delta == BTS_TIME_MARK) {
+            time = info.baseTime + btsGet32(record + 2);
+            return false;
+        }
+
+        time += delta;
+        sampleTime = time;
+        for (uint8_t i = 0; i < info.fieldCount; i++) {
+            fields[i] = btsGet32(record + 2 + 4 * i);
+        }
+        return true;
+    }
+
+    float value(const uint32_t* fields, uint8_t i) const { return btsValue(info, fields, i); }
+
+    int formatHeader(char* out, size_t size) const { return btsFormatHeader(info, out, size); }
+
+    int formatRow(uint32_t sampleTime, const uint32_t* fields, char* out, size_t size) const {
+        return btsFormatRow(info, sampleTime, fields, out, size);
+    }
+
+    size_t recordSize() const { return info.recordSize; }
+    const BtsHeader& header() const { return info; }
+
+private:
+    BtsHeader info;
+    uint32_t time;
+};
+
+/**
+ * BtsWriter - Buffers the samples of one .bts file
+ *
+ * New files are version 2: the buffer is a Gorilla block (Gorilla.h,
+ * GORILLA_DELTA as the fields are fixed-point). A version 1 file from older
+ * firmware is continued with fixed-size records until the day ends.
+ *
+ * append() returns false when the buffer is full: take() the bytes, write
+ * them, and append again.
+ */
+class BtsWriter {
+public:
+    BtsWriter() : used(0), samples(0), taken(false) {}
+
+    // New file: fills `header` (BTS_HEADER_SIZE bytes)
+    bool create(uint8_t kind, uint32_t baseTime, uint8_t* header) {
+        const BtsSchema* schema = btsSchema(kind);
+        if (!schema) return false;
+
+        info = BtsHeader();
+        info.version = BTS_SCHEMA_VERSION;
+        info.kind = kind;
+        info.fieldCount = schema->fieldCount;
+        info.baseTime = baseTime;
+        memcpy(info.decimals, schema->decimals, BTS_MAX_FIELDS);
+        btsWriteHeader(info, header);
+        reset();
+        return true;
+    }
+
+    // Existing file of either version
+    bool resume(const uint8_t* header) {
+        if (!btsReadHeader(header, info)) return false;
+        if (info.version == 1) records.resume(header);
+        reset();
+        return true;
+    }
+
+    bool append(uint32_t time, const uint32_t* fields) {
+        if (taken) reset();
+        if (info.version == 1) {
+            if (used + records.maxEncodedSize() > sizeof(buffer)) return false;
+            size_t n = records.encode(time, fields, buffer + used);
+            if (n == 0) return false;
+            used += n;
+        } else if (!blocks.append(time, fields)) {
+            return false;
+        }
+        samples++;
+        return true;
+    }
+
+    // Buffered bytes ready to write (a finished block for version 2),
+    // valid until the next append(); the buffer is empty again afterwards
+    size_t take(const uint8_t*& data) {
+        if (taken) return 0;
+        size_t len = info.version == 1 ? used : blocks.finish();
+        data = buffer;
+        taken = true;
+        return len;
+    }
+
+    uint16_t pendingSamples() const { return taken ? 0 : samples; }
+    const BtsHeader& header() const { return info; }
+
+private:
+    void reset() {
+        used = 0;
+        samples = 0;
+        taken = false;
+        if (info.version != 1) blocks.begin(buffer, sizeof(buffer), info.fieldCount, GORILLA_DELTA);
+    }
+
+    BtsHeader info;
+    BtsEncoder records;
+    GorillaEncoder blocks;
+    uint8_t buffer[BTS_BLOCK_SIZE];
+    size_t used;
+    uint16_t samples;
+    bool taken;
+};
+
+/**
+ * BtsReader - Streams the samples out of a .bts file of either version
+ *
+ * Give it the header, then feed() the rest of the file in chunks of any
+ * size; records and blocks split across chunks are reassembled. A torn
+ * record or block at the end of the file is never emitted.
+ */
+class BtsReader {
+public:
+    BtsReader() : pendingLen(0), broken(false) {}
+
+    bool begin(const uint8_t* headerBytes) {
+        pendingLen = 0;
+        broken = false;
+        if (!btsReadHeader(headerBytes, info)) return false;
+        if (info.version == 1) records.begin(headerBytes);
+        return true;
+    }
+
+    // Calls onSample(time, fields) for each sample; returns how many
+    template <typename F>
+    size_t feed(const uint8_t* data, size_t len, F onSample) {
+        size_t emitted = 0;
+        while (len > 0 && !broken) {
+            size_t need = unitSize();
+            if (need == 0) break;
+
+            size_t n = need - pendingLen;
+            if (n > len) n = len;
+            memcpy(pending + pendingLen, data, n);
+            pendingLen += n;
+            data += n;
+            len -= n;
+
+            if (pendingLen == unitSize()) {
+                emitted += emitUnit(onSample);
+                pendingLen = 0;
+            }
+        }
+        return emitted;
+    }
+
+    // Stopped at a block header that cannot be valid
+    bool corrupt() const { return broken; }
+    const BtsHeader& header() const { return info; }
+
+private:
+    // Bytes of the record or block being assembled (block size known once
+    // its header is in)
+    size_t unitSize() {
+        if (info.version == 1) return info.recordSize;
+        if (pendingLen < GORILLA_BLOCK_HEADER) return GORILLA_BLOCK_HEADER;
+
+        size_t size = GorillaDecoder::blockSize(pending, pendingLen);
+        if (size > BTS_BLOCK_SIZE) {
+            broken = true;
+            return 0;
+        }
+        return size;
+    }
+
+    template <typename F>
+    size_t emitUnit(F& onSample) {
+        uint32_t time;
+        uint32_t fields[BTS_MAX_FIELDS];
+        if (info.version == 1) {
+            if (!records.decode(pending, time, fields)) return 0;
+            onSample(time, fields);
+            return 1;
+        }
+
+        // An empty block is just its header
+        GorillaDecoder block;
+        if (!block.begin(pending, pendingLen, info.fieldCount, GORILLA_DELTA)) return 0;
+        size_t emitted = 0;
+        while (block.next(time, fields)) {
+            onSample(time, fields);
+            emitted++;
+        }
+        return emitted;
+    }
+
+    BtsHeader info;
+    BtsDecoder records;
+    uint8_t pending[BTS_BLOCK_SIZE];
+    size_t pendingLen;
+    bool broken;
+};
+
+/**
+ * Sidecar index (.idx next to each version 2 .bts file)
+ *
+ * An 8-byte header (magic "BTSI", the data file's base time) followed by
+ * one 8-byte entry per block: the block's first time as an offset from the
+ * base time, and the block's byte offset in the .bts file. A range query
+ * binary-searches the entries and reads only the blocks that can hold it.
+ * The index is a hint: a missing tail entry only widens the range read.
+ */
+#define BTS_INDEX_HEADER_SIZE 8
+#define BTS_INDEX_ENTRY_SIZE 8
+
+static const uint8_t BTS_INDEX_MAGIC[4] = {'B', 'T', 'S', 'I'};
+
+inline void btsWriteIndexHeader(uint32_t baseTime, uint8_t* out) {
+    memcpy(out, BTS_INDEX_MAGIC, 4);
+    btsPut32(out + 4, baseTime);
+}
+
+inline bool btsReadIndexHeader(const uint8_t* in, uint32_t& baseTime) {
+    if (memcmp(in, BTS_INDEX_MAGIC, 4) != 0) return false;
+    baseTime = btsGet32(in + 4);
+    return true;
+}
+
+/**
+ * BtsIndexWriter - Index entries for the blocks of one file
+ *
+ * Entry times never decrease: a block starting before the previous entry
+ * is indexed at the previous entry's time. NTP corrections are far smaller
+ * than the sampling interval, so blocks do not overlap in practice; after a
+ * step back of more than that, a range export can miss the samples logged
+ * just after the step (a full export still has them).
+ */
+class BtsIndexWriter {
+public:
+    BtsIndexWriter() : base(0), last(0) {}
+
+    void begin(uint32_t baseTime) {
+        base = baseTime;
+        last = 0;
+    }
+
+    // Entry for the block at `offset` whose first sample is at `time`
+    void entry(uint32_t time, uint32_t offset, uint8_t* out) {
+        uint32_t t = time > base ? time - base : 0;
+        if (t < last) t = last;
+        last = t;
+        btsPut32(out, t);
+        btsPut32(out + 4, offset);
+    }
+
+private:
+    uint32_t base;
+    uint32_t last;
+};
+
+/**
+ * Byte range [start, end) of the blocks that can hold samples from `from`
+ * to `to` (inclusive unix times). readEntry(i, timeOffset, byteOffset)
+ * reads entry i; it is called O(log count) times. Returns false if the
+ * index does not fit the file (the caller then reads the whole file).
+ */
+template <typename F>
+bool btsIndexRange(uint32_t baseTime, size_t count, size_t fileSize,
+                   uint32_t from, uint32_t to, F readEntry, size_t& start, size_t& end) {
+    start = BTS_HEADER_SIZE;
+    end = fileSize;
+    if (to < baseTime || to < from) {
+        end = start;
+        return true;
+    }
+    uint32_t fromOffset = from > baseTime ? from - baseTime : 0;
+    uint32_t toOffset = to - baseTime;
+
+    // First entry whose block starts after `t`
+    bool valid = true;
+    auto upperBound = [&](uint32_t t) {
+        size_t lo = 0, hi = count;
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            uint32_t time, offset;
+            if (!readEntry(mid, time, offset)) {
+                valid = false;
+                return (size_t)0;
+            }
+            if (time <= t) lo = mid + 1; else hi = mid;
+        }
+        return lo;
+    };
+
+    size_t first = upperBound(fromOffset);
+    size_t last = upperBound(toOffset);
+    uint32_t time, offset;
+    // The block holding `from` starts at or before it
+    if (valid && first > 0) {
+        valid = readEntry(first - 1, time, offset);
+        start = offset;
+    }
+    if (valid && last < count) {
+        valid = readEntry(last, time, offset);
+        end = offset;
+    }
+
+    if (!valid || start < BTS_HEADER_SIZE || start > end || end > fileSize) {
+        start = BTS_HEADER_SIZE;
+        end = fileSize;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Parse the range of EXPORT_DATA=<TYPE>,from[,to]: "YYYY-MM-DD",
+ * "YYYY-MM-DD HH:MM" or "YYYY-MM-DD HH:MM:SS" (UTC, 'T' also separates).
+ * A date alone runs to the end of that day for `to`; without `to` the range
+ * is open-ended.
+ */
+inline bool btsParseRange(const char* args, uint32_t& from, uint32_t& to) {
+    bool hasTime;
+    const char* p = parseCsvTimestamp(args, from, hasTime);
+    if (!p) return false;
+
+    to = 0xFFFFFFFFu;
+    if (*p == ',') {
+        p = parseCsvTimestamp(p + 1, to, hasTime);
+        if (!p) return false;
+        if (!hasTime) to += 86399;
+    }
+    return *p == '\0' && to >= from;
+}
+
+#endif // BINARY_SERIES_H
@@ -0,0 +1,331 @@
+#ifndef GORILLA_H
+#define GORILLA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// Gorilla-style block codec (Pelkonen et al., VLDB 2015) for 32-bit values
+#define GORILLA_BLOCK_HEADER 8   // Payload bytes (u16), sample count (u16), first time (u32)
+#define GORILLA_MAX_FIELDS 4
+
+// How a value is compared with the previous one
+enum GorillaMode {
+    GORILLA_XOR = 0,    // Float bits: sign, exponent and top of the mantissa repeat
+    GORILLA_DELTA = 1   // Fixed-point integers: zigzag difference
+};
+
+// MSB-first bit writer over a caller buffer
+class BitWriter {
+public:
+    BitWriter() : buf(nullptr), capacity(0), bits(0) {}
+
+    void begin(uint8_t* buffer, size_t bytes) {
+        buf = buffer;
+        capacity = bytes * 8;
+        bits = 0;
+        memset(buf, 0, bytes);
+    }
+
+    // Low `count` bits of value (count <= 32)
+    void write(uint32_t value, uint8_t count) {
+        while (count > 0 && bits < capacity) {
+            count--;
+            if ((value >> count) & 1) buf[bits >> 3] |= (uint8_t)(0x80 >> (bits & 7));
+            bits++;
+        }
+    }
+
+    size_t bitCount() const { return bits; }
+    size_t byteCount() const { return (bits + 7) / 8; }
+    size_t bitsFree() const { return capacity - bits; }
+
+private:
+    uint8_t* buf;
+    size_t capacity;
+    size_t bits;
+};
+
+class BitReader {
+public:
+    BitReader() : buf(nullptr), capacity(0), bits(0) {}
+
+    void begin(const uint8_t* buffer, size_t bytes) {
+        buf = buffer;
+        capacity = bytes * 8;
+        bits = 0;
+    }
+
+    // Reads past the end return zero bits and set overrun()
+    uint32_t read(uint8_t count) {
+        uint32_t value = 0;
+        while (count-- > 0) {
+            value <<= 1;
+            if (bits < capacity) value |= (buf[bits >> 3] >> (7 - (bits & 7))) & 1;
+            bits++;
+        }
+        return value;
+    }
+
+    bool overrun() const { return bits > capacity; }
+
+private:
+    const uint8_t* buf;
+    size_t capacity;
+    size_t bits;
+};
+
+inline int32_t gorillaSignExtend(uint32_t value, uint8_t bits) {
+    uint32_t sign = 1u << (bits - 1);
+    return (int32_t)((value ^ sign) - sign);
+}
+
+inline uint8_t gorillaLeadingZeros(uint32_t v) {
+    uint8_t n = 0;
+    while (n < 32 && !(v & (0x80000000u >> n))) n++;
+    return n;
+}
+
+inline uint8_t gorillaTrailingZeros(uint32_t v) {
+    uint8_t n = 0;
+    while (n < 32 && !(v & (1u << n))) n++;
+    return n;
+}
+
+/**
+ * GorillaEncoder - Streaming compressor for one block of samples
+ *
+ * Each sample is a unix time plus up to GORILLA_MAX_FIELDS 32-bit words
+ * (fixed-point values, or the bits of a float). Timestamps are stored as
+ * the delta of the delta:
+ *   '0' same interval, '10' + 7 bits, '110' + 9 bits, '1110' + 12 bits,
+ *   '1111' + 32 bits
+ * and each field as the XOR with its previous value (GORILLA_XOR), or the
+ * zigzag difference for integers (GORILLA_DELTA, which takes ~15 bits for a
+ * price in cents where the XOR of two integers takes ~23):
+ *   '0' unchanged, '10' + bits inside the previous leading/trailing zero
+ *   window, '11' + 5 bits leading zeros + 5 bits length - 1 + the bits
+ * A regular interval costs 1 bit of time.
+ *
+ * A block is self-contained: an 8-byte header (payload size, sample count,
+ * first time) and the first sample's fields raw, so a reader can start at
+ * any block. append() refuses a sample that might not fit; the caller then
+ * finish()es the block and begins the next.
+ */
+class GorillaEncoder {
+public:
+    GorillaEncoder() : block(nullptr), fieldCount(0), mode(GORILLA_XOR), samples(0) {}
+
+    void begin(uint8_t* buffer, size_t capacity, uint8_t fields, GorillaMode valueMode) {
+        block = buffer;
+        fieldCount = fields > GORILLA_MAX_FIELDS ? GORILLA_MAX_FIELDS : fields;
+        mode = valueMode;
+        samples = 0;
+        writer.begin(buffer + GORILLA_BLOCK_HEADER, capacity - GORILLA_BLOCK_HEADER);
+    }
+
+    bool append(uint32_t time, const uint32_t* fields) {
+        if (samples == 0xFFFF || writer.bitsFree() < maxSampleBits()) return false;
+
+        if (samples == 0) {
+            firstTime = time;
+            lastDelta = 0;
+            for (uint8_t i = 0; i < fieldCount; i++) {
+                writer.write(fields[i], 32);
+                last[i] = fields[i];
+                leading[i] = 0xFF;  // No window yet
+            }
+        } else {
+            int32_t delta = (int32_t)(time - lastTime);
+            writeDeltaOfDelta((int32_t)((uint32_t)delta - (uint32_t)lastDelta));
+            lastDelta = delta;
+            for (uint8_t i = 0; i < fieldCount; i++) writeXor(i, fields[i]);
+        }
+
+        lastTime = time;
+        samples++;
+        return true;
+    }
+
+    // Writes the block header; returns the block size in bytes (0 if empty)
+    size_t finish() {
+        if (samples == 0) return 0;
+        size_t payload = writer.byteCount();
+        block[0] = (uint8_t)payload;
+        block[1] = (uint8_t)(payload >> 8);
+        block[2] = (uint8_t)samples;
+        block[3] = (uint8_t)(samples >> 8);
+        for (int i = 0; i < 4; i++) block[4 + i] = (uint8_t)(firstTime >> (8 * i));
+        return GORILLA_BLOCK_HEADER + payload;
+    }
+
+    uint16_t count() const { return samples; }
+    size_t bitCount() const { return writer.bitCount(); }
+
+    // Worst case: 36 bits of time, 44 per field
+    size_t maxSampleBits() const { return 36 + 44 * (size_t)fieldCount; }
+
+private:
+    void writeDeltaOfDelta(int32_t dod) {
+        if (dod == 0) {
+            writer.write(0, 1);
+        } else if (dod >= -64 && dod <= 63) {
+            writer.write(0x2, 2);
+            writer.write((uint32_t)dod, 7);
+        } else if (dod >= -256 && dod <= 255) {
+            writer.write(0x6, 3);
+            writer.write((uint32_t)dod, 9);
+        } else if (dod >= -2048 && dod <= 2047) {
+            writer.write(0xE, 4);
+            writer.write((uint32_t)dod, 12);
+        } else {
+            writer.write(0xF, 4);
+            writer.write((uint32_t)dod, 32);
+        }
+    }
+
+    void writeXor(uint8_t i, uint32_t value) {
+        uint32_t x;
+        if (mode == GORILLA_XOR) {
+            x = value ^ last[i];
+        } else {
+            uint32_t d = value - last[i];
+            x = (d << 1) ^ (uint32_t)((int32_t)d >> 31);
+        }
+        last[i] = value;
+        if (x == 0) {
+            writer.write(0, 1);
+            return;
+        }
+
+        // Low bits of a difference are noise: only XOR keeps a trailing window
+        uint8_t lead = gorillaLeadingZeros(x);
+        uint8_t trail = mode == GORILLA_XOR ? gorillaTrailingZeros(x) : 0;
+        if (lead > 31) lead = 31;
+
+        if (leading[i] != 0xFF && lead >= leading[i] && trail >= trailing[i]) {
+            uint8_t meaningful = 32 - leading[i] - trailing[i];
+            writer.write(0x2, 2);
+            writer.write(x >> trailing[i], meaningful);
+        } else {
+            uint8_t meaningful = 32 - lead - trail;
+            writer.write(0x3, 2);
+            writer.write(lead, 5);
+            writer.write(meaningful - 1, 5);
+            writer.write(x >> trail, meaningful);
+            leading[i] = lead;
+            trailing[i] = trail;
+        }
+    }
+
+    BitWriter writer;
+    uint8_t* block;
+    uint8_t fieldCount;
+    GorillaMode mode;
+    uint16_t samples;
+    uint32_t firstTime;
+    uint32_t lastTime;
+    int32_t lastDelta;
+    uint32_t last[GORILLA_MAX_FIELDS];
+    uint8_t leading[GORILLA_MAX_FIELDS];
+    uint8_t trailing[GORILLA_MAX_FIELDS];
+};
+
+/**
+ * GorillaDecoder - Streams the samples back out of one block
+ */
+class GorillaDecoder {
+public:
+    GorillaDecoder() : fieldCount(0), mode(GORILLA_XOR), samples(0), decoded(0) {}
+
+    // Size of the block starting at `data` from its header, 0 if fewer than
+    // GORILLA_BLOCK_HEADER bytes are given
+    static size_t blockSize(const uint8_t* data, size_t available) {
+        if (available < GORILLA_BLOCK_HEADER) return 0;
+        return GORILLA_BLOCK_HEADER + (data[0] | (data[1] << 8));
+    }
+
+    // False if the block is truncated or empty
+    bool begin(const uint8_t* data, size_t available, uint8_t fields, GorillaMode valueMode) {
+        size_t size = blockSize(data, available);
+        if (size == 0 || size > available) return false;
+
+        fieldCount = fields > GORILLA_MAX_FIELDS ? GORILLA_MAX_FIELDS : fields;
+        mode = valueMode;
+        samples = (uint16_t)(data[2] | (data[3] << 8));
+        firstTime = (uint32_t)data[4] | ((uint32_t)data[5] << 8) |
+                    ((uint32_t)data[6] << 16) | ((uint32_t)data[7] << 24);
+        decoded = 0;
+        reader.begin(data + GORILLA_BLOCK_HEADER, size - GORILLA_BLOCK_HEADER);
+        return samples > 0;
+    }
+
+    bool next(uint32_t& time, uint32_t* fields) {
+        if (decoded >= samples) return false;
+
+        if (decoded == 0) {
+            lastTime = firstTime;
+            lastDelta = 0;
+            for (uint8_t i = 0; i < fieldCount; i++) {
+                last[i] = reader.read(32);
+                leading[i] = 0;
+                trailing[i] = 0;
+            }
+        } else {
+            lastDelta = (int32_t)((uint32_t)lastDelta + (uint32_t)readDeltaOfDelta());
+            lastTime += (uint32_t)lastDelta;
+            for (uint8_t i = 0; i < fieldCount; i++) readXor(i);
+        }
+        if (reader.overrun()) {
+            decoded = samples;  // Corrupt block: stop here
+            return false;
+        }
+
+        time = lastTime;
+        memcpy(fields, last, fieldCount * sizeof(uint32_t));
+        decoded++;
+        return true;
+    }
+
+    uint16_t count() const { return samples; }
+    uint32_t startTime() const { return firstTime; }
+
+private:
+    int32_t readDeltaOfDelta() {
+        if (reader.read(1) == 0) return 0;
+        if (reader.read(1) == 0) return gorillaSignExtend(reader.read(7), 7);
+        if (reader.read(1) == 0) return gorillaSignExtend(reader.read(9), 9);
+        if (reader.read(1) == 0) return gorillaSignExtend(reader.read(12), 12);
+        return (int32_t)reader.read(32);
+    }
+
+    void readXor(uint8_t i) {
+        if (reader.read(1) == 0) return;
+        if (reader.read(1) == 1) {
+            leading[i] = (uint8_t)reader.read(5);
+            uint8_t meaningful = (uint8_t)reader.read(5) + 1;
+            trailing[i] = (uint8_t)(32 - leading[i] - meaningful);
+        }
+        uint8_t meaningful = 32 - leading[i] - trailing[i];
+        uint32_t x = reader.read(meaningful) << trailing[i];
+        if (mode == GORILLA_XOR) {
+            last[i] ^= x;
+        } else {
+            last[i] += (x >> 1) ^ (0u - (x & 1));
+        }
+    }
+
+    BitReader reader;
+    uint8_t fieldCount;
+    GorillaMode mode;
+    uint16_t samples;
+    uint16_t decoded;
+    uint32_t firstTime;
+    uint32_t lastTime;
+    int32_t lastDelta;
+    uint32_t last[GORILLA_MAX_FIELDS];
+    uint8_t leading[GORILLA_MAX_FIELDS];
+    uint8_t trailing[GORILLA_MAX_FIELDS];
+};
+
+#endif // GORILLA_H
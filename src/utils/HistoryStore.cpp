@@ -0,0 +1,144 @@
+#include "HistoryStore.h"
+#include <esp_heap_caps.h>
+#include <time.h>
+#include "SDLogger.h"
+#include "WallClock.h"
+
+// Global instance
+HistoryStore historyStore;
+
+// Scoped lock for the store mutex
+class HistoryLock {
+public:
+    explicit HistoryLock(SemaphoreHandle_t m) : mutex(m) {
+        if (mutex) xSemaphoreTake(mutex, portMAX_DELAY);
+    }
+    ~HistoryLock() {
+        if (mutex) xSemaphoreGive(mutex);
+    }
+private:
+    SemaphoreHandle_t mutex;
+};
+
+static const TimeSeriesCapacity HISTORY_CAPACITY = {
+    HISTORY_RAW_SAMPLES,
+    { HISTORY_MINUTE_BUCKETS, HISTORY_HOUR_BUCKETS, HISTORY_DAY_BUCKETS }
+};
+
+HistoryStore::HistoryStore() {
+    storage = nullptr;
+    dropped = 0;
+    mutex = xSemaphoreCreateMutex();
+}
+
+bool HistoryStore::begin() {
+    if (storage != nullptr) return true;
+
+    size_t perSeries = TieredSeries::bytesFor(HISTORY_CAPACITY);
+    size_t total = perSeries * HISTORY_SERIES_COUNT;
+
+    void* block = heap_caps_malloc(total, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (block == nullptr) {
+        Serial.printf("❌ History store: %u bytes of PSRAM not available\n", (unsigned)total);
+        sdLogger.logf(LOG_ERROR, "History store: PSRAM allocation of %u bytes failed", (unsigned)total);
+        return false;
+    }
+
+    HistoryLock lock(mutex);
+    for (int i = 0; i < HISTORY_SERIES_COUNT; i++) {
+        series[i].attach((uint8_t*)block + i * perSeries, HISTORY_CAPACITY);
+    }
+    storage = block;
+
+    Serial.printf("✓ History store: %u KB in PSRAM (%d series)\n",
+                 (unsigned)(total / 1024), HISTORY_SERIES_COUNT);
+    sdLogger.logf(LOG_INFO, "History store: %u bytes PSRAM, raw=%u minute=%u hour=%u day=%u per series",
+                 (unsigned)total, HISTORY_RAW_SAMPLES, HISTORY_MINUTE_BUCKETS,
+                 HISTORY_HOUR_BUCKETS, HISTORY_DAY_BUCKETS);
+    return true;
+}
+
+void HistoryStore::append(HistorySeries s, float value) {
+    uint32_t t = wallClockNow();
+    if (t == 0) return;
+    appendAt(s, t, value);
+}
+
+void HistoryStore::appendAt(HistorySeries s, uint32_t time, float value) {
+    if (!isReady() || s >= HISTORY_SERIES_COUNT) return;
+
+    HistoryLock lock(mutex);
+    if (!series[s].append(time, value)) dropped++;
+}
+
+uint32_t HistoryStore::query(HistorySeries s, uint32_t from, uint32_t to,
+                             TimeSeriesSample* out, uint32_t max) {
+    if (!isReady() || s >= HISTORY_SERIES_COUNT) return 0;
+
+    HistoryLock lock(mutex);
+    return series[s].query(from, to, out, max);
+}
+
+uint32_t HistoryStore::queryTier(HistorySeries s, TimeSeriesTier tier, uint32_t from, uint32_t to,
+                                 TimeSeriesBucket* out, uint32_t max) {
+    if (!isReady() || s >= HISTORY_SERIES_COUNT || tier >= TS_TIER_COUNT) return 0;
+
+    HistoryLock lock(mutex);
+    return series[s].queryTier(tier, from, to, out, max);
+}
+
+bool HistoryStore::latest(HistorySeries s, TimeSeriesSample& out) {
+    if (!isReady() || s >= HISTORY_SERIES_COUNT) return false;
+
+    HistoryLock lock(mutex);
+    return series[s].latest(out);
+}
+
+void HistoryStore::printStatus() {
+    if (!isReady()) {
+        Serial.println("History Store: not allocated");
+        return;
+    }
+
+    uint32_t nowS = wallClockNow();
+    uint32_t droppedCount;
+    {
+        HistoryLock lock(mutex);
+        droppedCount = dropped;
+    }
+    Serial.printf("History Store: %u out-of-order samples dropped\n", droppedCount);
+
+    for (int i = 0; i < HISTORY_SERIES_COUNT; i++) {
+        // Copy under the lock, print outside it
+        uint32_t rawCount, rawOldest, tierCount[TS_TIER_COUNT];
+        TimeSeriesSample last = {0, 0};
+        {
+            HistoryLock lock(mutex);
+            const TieredSeries& ts = series[i];
+            rawCount = ts.getRaw().size();
+            rawOldest = ts.oldestRaw();
+            for (int t = 0; t < TS_TIER_COUNT; t++) tierCount[t] = ts.getTier((TimeSeriesTier)t).size();
+            ts.latest(last);
+        }
+
+        Serial.printf("  %-8s raw=%u/%u (%uh) minute=%u hour=%u day=%u last=%.2f",
+                     seriesName((HistorySeries)i), rawCount, HISTORY_RAW_SAMPLES,
+                     rawCount > 0 && nowS > rawOldest ? (nowS - rawOldest) / 3600 : 0,
+                     tierCount[TS_TIER_MINUTE], tierCount[TS_TIER_HOUR], tierCount[TS_TIER_DAY],
+                     last.value);
+        if (rawCount > 0 && nowS >= last.time) {
+            Serial.printf(" (%us ago)\n", nowS - last.time);
+        } else {
+            Serial.println();
+        }
+    }
+}
+
+const char* HistoryStore::seriesName(HistorySeries s) {
+    switch (s) {
+        case HISTORY_PRICE:         return "price";
+        case HISTORY_FEE_FAST:      return "fee";
+        case HISTORY_MEMPOOL_COUNT: return "mempool";
+        default:                    return "unknown";
+    }
+}
@@ -0,0 +1,74 @@
+#ifndef HISTORY_STORE_H
+#define HISTORY_STORE_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "TimeSeries.h"
+
+// Ring sizes per series (PSRAM, ~152KB each)
+#define HISTORY_RAW_SAMPLES 4096       // 34h at the 30s price poll, less with WebSocket pushes
+#define HISTORY_MINUTE_BUCKETS 2880    // 2 days
+#define HISTORY_HOUR_BUCKETS 2160      // 90 days (price data retention)
+#define HISTORY_DAY_BUCKETS 1100       // 3 years
+
+enum HistorySeries {
+    HISTORY_PRICE = 0,      // USD
+    HISTORY_FEE_FAST,       // sat/vB
+    HISTORY_MEMPOOL_COUNT,  // Unconfirmed transactions
+    HISTORY_SERIES_COUNT
+};
+
+/**
+ * HistoryStore - In-memory price, fee and mempool history in PSRAM
+ *
+ * One TieredSeries per metric: raw samples plus minute, hour and day
+ * min/max/avg buckets. The fetch worker appends every price and mempool
+ * update; the UI, alerts and AI prompts read ranges without touching SD.
+ * Samples are stamped with SNTP wall-clock time and dropped until the clock
+ * has synced.
+ *
+ * Safe to call from the fetch worker and the loop task. Queries copy out
+ * under a mutex, so ask for what you will draw, not the whole ring.
+ */
+class HistoryStore {
+public:
+    HistoryStore();
+
+    // Allocate the rings in PSRAM (call once after boot)
+    bool begin();
+    bool isReady() const { return storage != nullptr; }
+
+    // Add a sample stamped now (ignored before the clock syncs)
+    void append(HistorySeries series, float value);
+
+    // Add a sample with its own timestamp (unix seconds)
+    void appendAt(HistorySeries series, uint32_t time, float value);
+
+    // Raw samples with from <= time <= to, oldest first; returns the count copied
+    uint32_t query(HistorySeries series, uint32_t from, uint32_t to,
+                   TimeSeriesSample* out, uint32_t max);
+
+    // min/max/avg buckets starting in [from, to], oldest first
+    uint32_t queryTier(HistorySeries series, TimeSeriesTier tier, uint32_t from, uint32_t to,
+                       TimeSeriesBucket* out, uint32_t max);
+
+    // Most recent sample; false when the series is empty
+    bool latest(HistorySeries series, TimeSeriesSample& out);
+
+    // Print ring fill and time spans to serial (HISTORY command)
+    void printStatus();
+
+    static const char* seriesName(HistorySeries series);
+
+private:
+    TieredSeries series[HISTORY_SERIES_COUNT];
+    void* storage;
+    SemaphoreHandle_t mutex;
+    uint32_t dropped;  // Out-of-order samples
+};
+
+// Global instance
+extern HistoryStore historyStore;
+
+#endif // HISTORY_STORE_H
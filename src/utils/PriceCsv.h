@@ -0,0 +1,85 @@
+#ifndef PRICE_CSV_H
+#define PRICE_CSV_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Unix time of a UTC calendar time (days-from-civil, no timezone tables)
+inline uint32_t unixFromCivil(int year, int month, int day, int hour, int minute, int second) {
+    year -= month <= 2;
+    int era = (year >= 0 ? year : year - 399) / 400;
+    int yoe = year - era * 400;
+    int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    int64_t days = (int64_t)era * 146097 + doe - 719468;
+    return (uint32_t)(days * 86400 + hour * 3600 + minute * 60 + second);
+}
+
+// "YYYY-MM-DD HH:MM:SS" of a unix time (UTC, civil-from-days)
+inline void formatCsvTimestamp(uint32_t time, char* out, size_t size) {
+    int32_t days = (int32_t)(time / 86400) + 719468;
+    uint32_t secs = time % 86400;
+    int32_t era = days / 146097;
+    int32_t doe = days - era * 146097;
+    int32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int32_t mp = (5 * doy + 2) / 153;
+    int day = doy - (153 * mp + 2) / 5 + 1;
+    int month = mp < 10 ? mp + 3 : mp - 9;
+    int year = yoe + era * 400 + (month <= 2);
+    snprintf(out, size, "%04d-%02d-%02d %02d:%02d:%02d", year, month, day,
+             (int)(secs / 3600), (int)(secs / 60 % 60), (int)(secs % 60));
+}
+
+// Parses "YYYY-MM-DD", "YYYY-MM-DD HH:MM" or "YYYY-MM-DD HH:MM:SS" (a 'T'
+// may separate date and time) at the start of `s`. Returns the end of the
+// parsed text, or nullptr; `hasTime` tells whether a time of day was given.
+inline const char* parseCsvTimestamp(const char* s, uint32_t& time, bool& hasTime) {
+    int year, month, day, hour = 0, minute = 0, second = 0, n = 0;
+    if (sscanf(s, "%4d-%2d-%2d%n", &year, &month, &day, &n) != 3 || n != 10) return nullptr;
+    const char* p = s + n;
+
+    hasTime = false;
+    if (*p == ' ' || *p == 'T' || *p == 't') {
+        if (sscanf(p + 1, "%2d:%2d%n", &hour, &minute, &n) == 2 && n == 5) {
+            hasTime = true;
+            p += 1 + n;
+            if (*p == ':' && sscanf(p + 1, "%2d%n", &second, &n) == 1 && n == 2) p += 1 + n;
+        }
+    }
+    if (year < 2009 || month < 1 || month > 12 || day < 1 || day > 31 ||
+        hour < 0 || hour > 23 || minute < 0 || minute > 59 || second < 0 || second > 59) {
+        return nullptr;
+    }
+
+    time = unixFromCivil(year, month, day, hour, minute, second);
+    return p;
+}
+
+/**
+ * Parse one row of a btc_price_YYYY-MM-DD.csv file written by
+ * SDLogger::logPrice ("2025-01-01 12:00:30.123,97000.00,93000.00").
+ * The logger's clock is UTC (configTime(0, 0, ...)). Returns false for the
+ * header and for malformed rows.
+ */
+inline bool parsePriceCsvLine(const char* line, uint32_t& time, float& usd) {
+    int year, month, day, hour, minute, second;
+    float price;
+    if (sscanf(line, "%4d-%2d-%2d %2d:%2d:%2d%*[^,],%f",
+               &year, &month, &day, &hour, &minute, &second, &price) != 7) {
+        // Timestamps without milliseconds
+        if (sscanf(line, "%4d-%2d-%2d %2d:%2d:%2d,%f",
+                   &year, &month, &day, &hour, &minute, &second, &price) != 7) {
+            return false;
+        }
+    }
+    if (year < 2009 || month < 1 || month > 12 || day < 1 || day > 31 || !(price > 0)) {
+        return false;
+    }
+
+    time = unixFromCivil(year, month, day, hour, minute, second);
+    usd = price;
+    return true;
+}
+
+#endif // PRICE_CSV_H
@@ -0,0 +1,161 @@
+#ifndef ROLLING_CHANGE_H
+#define ROLLING_CHANGE_H
+
+#include <stdint.h>
+#include <string.h>
+
+// A reference found later than this share of the window (data gap) is not used
+#define ROLLING_MAX_GAP_PCT 10
+
+enum ChangeWindow {
+    CHANGE_1H = 0,
+    CHANGE_24H,
+    CHANGE_7D,
+    CHANGE_WINDOW_COUNT
+};
+
+// Price now vs the price one window ago
+struct PriceChange {
+    float delta = 0;     // USD
+    float pct = 0;
+    bool valid = false;  // Enough history to cover the window
+};
+
+/**
+ * RollingChange - Change of a value over a sliding time window
+ *
+ * The window is cut into Slots slots; each slot remembers the first sample
+ * that fell into it, in a ring of Slots + 1 entries. The value one window
+ * ago is the first sample of the slot holding (newest - window), so the
+ * window is exact to one slot (5 minutes for 24h in 288 slots) and both
+ * add() and change() are O(1) with no per-sample history.
+ *
+ * Ring entries from earlier laps are recognised by their timestamp, which
+ * is how missing slots (polling gaps, power off) show up. change() then
+ * takes the next slot that has data, unless that is more than
+ * ROLLING_MAX_GAP_PCT of the window later, and reports no change before
+ * the history covers the window.
+ */
+template <uint16_t Slots>
+class RollingChange {
+public:
+    explicit RollingChange(uint32_t windowSeconds)
+        : window(windowSeconds), slotSeconds(windowSeconds / Slots) {
+        reset();
+    }
+
+    void reset() {
+        memset(slots, 0, sizeof(slots));
+        samples = 0;
+        firstTime = 0;
+        latestTime = 0;
+        latestValue = 0;
+    }
+
+    // Add a sample (unix seconds); false if it is older than the newest one
+    bool add(uint32_t time, float value) {
+        if (samples > 0 && time < latestTime) return false;
+
+        uint32_t slot = time / slotSeconds;
+        Entry& e = slots[slot % (Slots + 1)];
+        if (e.time == 0 || e.time / slotSeconds != slot) {
+            e.time = time;
+            e.value = value;
+        }
+
+        if (samples == 0) firstTime = time;
+        latestTime = time;
+        latestValue = value;
+        samples++;
+        return true;
+    }
+
+    PriceChange change() const {
+        PriceChange result;
+        if (samples == 0 || latestTime - firstTime < window) return result;
+
+        uint32_t target = latestTime - window;
+        uint32_t slot = target / slotSeconds;
+        uint32_t last = latestTime / slotSeconds;
+        uint32_t maxSkip = Slots * ROLLING_MAX_GAP_PCT / 100;
+
+        for (uint32_t s = slot; s <= last && s - slot <= maxSkip; s++) {
+            const Entry& e = slots[s % (Slots + 1)];
+            if (e.time == 0 || e.time / slotSeconds != s || e.value == 0) continue;
+
+            result.delta = latestValue - e.value;
+            result.pct = result.delta / e.value * 100.0f;
+            result.valid = true;
+            break;
+        }
+        return result;
+    }
+
+    uint32_t getWindow() const { return window; }
+    uint32_t getSamples() const { return samples; }
+
+private:
+    struct Entry {
+        uint32_t time;
+        float value;
+    };
+
+    Entry slots[Slots + 1];
+    uint32_t window;
+    uint32_t slotSeconds;
+    uint32_t samples;
+    uint32_t firstTime;
+    uint32_t latestTime;
+    float latestValue;
+};
+
+/**
+ * PriceChanges - 1h, 24h and 7d price change, fed with every price sample
+ *
+ * Slot widths of 1 minute, 5 minutes and 1 hour; about 4KB in total.
+ */
+class PriceChanges {
+public:
+    PriceChanges() : hour(3600), day(86400), week(7 * 86400) {}
+
+    void reset() {
+        hour.reset();
+        day.reset();
+        week.reset();
+    }
+
+    bool add(uint32_t time, float price) {
+        if (!(price > 0)) return false;
+        bool ok = hour.add(time, price);
+        day.add(time, price);
+        week.add(time, price);
+        return ok;
+    }
+
+    PriceChange get(ChangeWindow w) const {
+        switch (w) {
+            case CHANGE_1H:  return hour.change();
+            case CHANGE_24H: return day.change();
+            case CHANGE_7D:  return week.change();
+            default:         return PriceChange();
+        }
+    }
+
+    uint32_t getSamples() const { return hour.getSamples(); }
+
+    static const char* windowName(ChangeWindow w) {
+        switch (w) {
+            case CHANGE_1H:  return "1h";
+            case CHANGE_24H: return "24h";
+            case CHANGE_7D:  return "7d";
+            default:         return "";
+        }
+    }
+
+private:
+    RollingChange<60> hour;
+    RollingChange<288> day;
+    RollingChange<168> week;
+};
+
+#endif // ROLLING_CHANGE_H
@@ -1,10 +1,25 @@
 #include "SDLogger.h"
+#include "PriceCsv.h"
+#include "WallClock.h"
 #include <time.h>
 #include <sys/time.h>
 
 // Global instance
 SDLogger sdLogger;
 
+// Scoped lock for the logger mutex (recursive: log() may call flush())
+class SDLock {
+public:
+    explicit SDLock(SemaphoreHandle_t m) : mutex(m) {
+        if (mutex) xSemaphoreTakeRecursive(mutex, portMAX_DELAY);
+    }
+    ~SDLock() {
+        if (mutex) xSemaphoreGiveRecursive(mutex);
+    }
+private:
+    SemaphoreHandle_t mutex;
+};
+
 SDLogger::SDLogger() {
     bufferPos = 0;
     currentLevel = LOG_INFO;
@@ -17,11 +32,23 @@ SDLogger::SDLogger() {
     cardPresent = false;
     lastHotSwapCheck = 0;
     writeRetryCount = 0;
+    mutex = xSemaphoreCreateRecursiveMutex();
+
+    for (int i = 0; i < BTS_KIND_COUNT; i++) {
+        streams[i].kind = i + 1;
+        streams[i].date[0] = '\0';
+        streams[i].fileSize = 0;
+        streams[i].firstBufferedMs = 0;
+        streams[i].bytes = 0;
+        streams[i].samples = 0;
+        streams[i].writes = 0;
+    }
 }
 
 SDLogger::~SDLogger() {
     if (ready) {
         flush();
+        closeStreams(true);
         closeLogFile();
     }
 }
@@ -33,7 +60,7 @@ bool SDLogger::begin() {
     SPI.begin(SD_CLK_PIN, SD_MISO_PIN, SD_MOSI_PIN, SD_CS_PIN);
 
     // Initialize SD card
-    if (!SD.begin(SD_CS_PIN)) {
+    if (!SD.begin(SD_CS_PIN, SPI, 4000000, "/sd", SD_MAX_OPEN_FILES)) {
         Serial.println("✗ SD card initialization failed");
         Serial.println("  Possible causes:");
         Serial.println("  - No SD card inserted");
@@ -162,6 +189,7 @@ bool SDLogger::shouldRotate() {
 }
 
 void SDLogger::log(LogLevel level, const char* message) {
+    SDLock lock(mutex);
     if (!isReady() || level < currentLevel) {
         return;
     }
@@ -233,6 +261,7 @@ void SDLogger::logBoot(const char* message) {
 }
 
 void SDLogger::logAPI(const char* service, const char* endpoint, int status, long duration_ms, size_t response_size) {
+    SDLock lock(mutex);
     if (!isReady()) return;
 
     // JSON Lines format for API logs
@@ -262,6 +291,7 @@ void SDLogger::logAPI(const char* service, const char* endpoint, int status, lon
 }
 
 void SDLogger::logAPIError(const char* service, const char* endpoint, int status, const char* error) {
+    SDLock lock(mutex);
     if (!isReady()) return;
 
     char errorMsg[512];
@@ -285,6 +315,7 @@ void SDLogger::logAPIError(const char* service, const char* endpoint, int status
 }
 
 void SDLogger::logData(const char* filename, const char* csvLine) {
+    SDLock lock(mutex);
     if (!isReady()) return;
 
     String dataPath = String(filename);
@@ -296,6 +327,7 @@ void SDLogger::logData(const char* filename, const char* csvLine) {
 }
 
 void SDLogger::logCrash(const char* stackTrace) {
+    SDLock lock(mutex);
     if (!ready) return; // Don't check enabled - always log crashes
 
     String crashLogPath = "/logs/errors/crash_" + getTimestamp() + ".log";
@@ -318,6 +350,7 @@ void SDLogger::logCrash(const char* stackTrace) {
 }
 
 void SDLogger::flush() {
+    SDLock lock(mutex);
     if (!isReady() || bufferPos == 0) {
         return;
     }
@@ -367,12 +400,14 @@ void SDLogger::flush() {
 }
 
 void SDLogger::rotate() {
+    SDLock lock(mutex);
     flush(); // Flush current buffer
     currentDate = getCurrentDate();
     Serial.printf("Log rotated to date: %s\n", currentDate.c_str());
 }
 
 void SDLogger::cleanup() {
+    SDLock lock(mutex);
     if (!isReady()) return;
 
     Serial.println("\n=== SD Card Cleanup Starting ===");
@@ -380,6 +415,7 @@ void SDLogger::cleanup() {
     // Clean up CSV data files with specific retention policies
     cleanupOldCSVFiles("btc_price_", 90);    // Price data: 90 days
     cleanupOldCSVFiles("btc_mempool_", 30);  // Mempool data: 30 days
+    cleanupOldCSVFiles("btc_fees_", 90);     // Fee data: 90 days
     // Block data is kept indefinitely (low volume)
 
     // Clean up system logs based on general retention policy
@@ -407,8 +443,12 @@ void SDLogger::enable() {
 }
 
 void SDLogger::disable() {
+    // Under the lock, and disabled first, so the fetch worker cannot write
+    // to a stream being closed or reopen one afterwards
+    SDLock lock(mutex);
     flush(); // Flush before disabling
     enabled = false;
+    closeStreams(true);
     Serial.println("SD logging disabled");
 }
 
@@ -461,6 +501,7 @@ void SDLogger::checkHotSwap() {
     }
 
     lastHotSwapCheck = now;
+    SDLock lock(mutex);
 
     // Try to detect card presence
     uint8_t cardType = SD.cardType();
@@ -470,6 +511,7 @@ void SDLogger::checkHotSwap() {
         if (cardPresent) {
             cardPresent = false;
             ready = false;
+            closeStreams(false);
             Serial.println("\n=== SD CARD REMOVED ===");
             Serial.println("Logging disabled until card is re-inserted");
         }
@@ -581,6 +623,8 @@ void SDLogger::logWatchdogCrash() {
 }
 
 bool SDLogger::formatCard() {
+    // Held through the unmount and wipe: the fetch worker appends from core 0
+    SDLock lock(mutex);
     if (!cardPresent) {
         Serial.println("✗ No SD card present");
         return false;
@@ -596,7 +640,8 @@ bool SDLogger::formatCard() {
     // Flush any pending writes
     flush();
 
-    // Close any open files
+    // Close any open files (buffered samples go with the deleted data)
+    closeStreams(false);
     closeLogFile();
 
     // End SD card
@@ -609,7 +654,7 @@ bool SDLogger::formatCard() {
     // Note: ESP32 SD library doesn't have a direct format() method
     // We need to delete all files and directories recursively
 
-    if (!SD.begin(SD_CS_PIN)) {
+    if (!SD.begin(SD_CS_PIN, SPI, 4000000, "/sd", SD_MAX_OPEN_FILES)) {
         Serial.println("✗ Failed to reinitialize SD card");
         ready = false;
         cardPresent = false;
@@ -695,108 +740,413 @@ bool SDLogger::deleteRecursive(File dir, const char* path) {
     return success;
 }
 
-// ==================== CSV Data Logging ====================
+// ==================== Data Logging ====================
 
 void SDLogger::logPrice(float usd, float eur) {
-    if (!isReady()) return;
+    uint32_t fields[2] = {btsFixed(usd, 2), btsFixed(eur, 2)};
+    appendSample(BTS_PRICE, fields);
 
-    // Create filename: /logs/data/btc_price_YYYY-MM-DD.csv
-    String filename = "/logs/data/btc_price_" + getCurrentDate() + ".csv";
+    // Log success (DEBUG level to avoid spam)
+    if (currentLevel <= LOG_DEBUG) {
+        Serial.printf("[DATA] Price logged: $%.2f / €%.2f\n", usd, eur);
+    }
+}
 
-    // Check if file exists to determine if we need to write header
-    bool fileExists = SD.exists(filename.c_str());
+void SDLogger::logBlock(int height, int txCount, uint32_t timestamp, uint32_t sizeBytes) {
+    uint32_t fields[4] = {(uint32_t)height, (uint32_t)txCount, timestamp, sizeBytes};
+    appendSample(BTS_BLOCKS, fields);
 
-    File csvFile = SD.open(filename.c_str(), FILE_APPEND);
-    if (!csvFile) {
-        Serial.printf("ERROR: Failed to open %s\n", filename.c_str());
-        return;
+    // Log success
+    Serial.printf("[DATA] Block logged: Height %d (%d TXs)\n", height, txCount);
+}
+
+void SDLogger::logMempool(int count, float sizeMB) {
+    uint32_t fields[2] = {(uint32_t)count, btsFixed(sizeMB, 2)};
+    appendSample(BTS_MEMPOOL, fields);
+
+    // Log success (DEBUG level to avoid spam)
+    if (currentLevel <= LOG_DEBUG) {
+        Serial.printf("[DATA] Mempool logged: %d TXs (%.2f MB)\n", count, sizeMB);
+    }
+}
+
+void SDLogger::logFees(int fast, int medium, int slow) {
+    uint32_t fields[3] = {(uint32_t)fast, (uint32_t)medium, (uint32_t)slow};
+    appendSample(BTS_FEES, fields);
+}
+
+// ==================== Binary Data Files ====================
+
+void SDLogger::appendSample(uint8_t kind, const uint32_t* fields) {
+    SDLock lock(mutex);
+    if (!isReady() || kind < 1 || kind > BTS_KIND_COUNT) return;
+
+    // Samples before SNTP sync are not logged
+    time_t t = wallClockNow();
+    if (t == 0) return;
+
+    DataStream& stream = streams[kind - 1];
+    struct tm timeinfo;
+    localtime_r(&t, &timeinfo);
+    char date[11];
+    snprintf(date, sizeof(date), "%04d-%02d-%02d",
+             timeinfo.tm_year + 1900, timeinfo.tm_mon + 1, timeinfo.tm_mday);
+
+    // Daily files: the first sample of a new day closes yesterday's
+    if (!stream.file || strcmp(stream.date, date) != 0) {
+        flushStream(stream);
+        if (stream.file) stream.file.close();
+        if (!openStream(stream, kind, date, (uint32_t)t)) return;
     }
 
-    // Write CSV header if new file
-    if (!fileExists) {
-        csvFile.println("timestamp,price_usd,price_eur");
+    // A full buffer (one finished block) is written and a new one started
+    if (!stream.writer.append((uint32_t)t, fields)) {
+        flushStream(stream);
+        if (!stream.writer.append((uint32_t)t, fields)) return;
     }
 
-    // Write data row
-    char csvLine[128];
-    snprintf(csvLine, sizeof(csvLine), "%s,%.2f,%.2f",
-             getTimestamp().c_str(), usd, eur);
-    csvFile.println(csvLine);
-    csvFile.close();
+    if (stream.writer.pendingSamples() == 1) stream.firstBufferedMs = millis();
+    stream.samples++;
 
-    // Log success (DEBUG level to avoid spam)
-    if (currentLevel <= LOG_DEBUG) {
-        Serial.printf("[CSV] Price logged: $%.2f / €%.2f\n", usd, eur);
+    if (millis() - stream.firstBufferedMs >= DATA_FLUSH_INTERVAL) {
+        flushStream(stream);
     }
 }
 
-void SDLogger::logBlock(int height, int txCount, uint32_t timestamp) {
-    if (!isReady()) return;
+// /logs/data/<prefix>YYYY-MM-DD<ext>
+static void dataPath(char* out, size_t size, uint8_t kind, const char* date, const char* ext) {
+    snprintf(out, size, "/logs/data/%s%s%s", btsSchema(kind)->prefix, date, ext);
+}
 
-    // Create filename: /logs/data/btc_blocks_YYYY-MM-DD.csv
-    String filename = "/logs/data/btc_blocks_" + getCurrentDate() + ".csv";
+bool SDLogger::openStream(DataStream& stream, uint8_t kind, const char* date, uint32_t time) {
+    char path[48];
+    char indexPath[48];
+    dataPath(path, sizeof(path), kind, date, ".bts");
+    dataPath(indexPath, sizeof(indexPath), kind, date, ".idx");
+
+    // After a reboot the day's file continues under its original header
+    size_t existing = 0;
+    size_t valid = 0;
+    uint8_t header[BTS_HEADER_SIZE];
+    bool resumed = false;
+    File current = SD.exists(path) ? SD.open(path, FILE_READ) : File();
+    if (current) {
+        existing = current.size();
+        if (existing >= BTS_HEADER_SIZE && current.read(header, sizeof(header)) == sizeof(header) &&
+            stream.writer.resume(header) && stream.writer.header().kind == kind) {
+            resumed = true;
+            // The index is rebuilt from the blocks, so it always matches the file
+            File index = stream.writer.header().version >= 2 ? SD.open(indexPath, FILE_WRITE) : File();
+            valid = validDataLength(current, stream.writer.header(), existing, index ? &index : nullptr);
+            if (index) index.close();
+        }
+        current.close();
+    }
 
-    // Check if file exists to determine if we need to write header
-    bool fileExists = SD.exists(filename.c_str());
+    bool created = existing == 0;
+    if (created) {
+        stream.writer.create(kind, time, header);
+    } else if (!resumed) {
+        Serial.printf("ERROR: %s is not a data file, not appending\n", path);
+        return false;
+    } else if (valid < existing && !truncateFile(path, valid)) {
+        // A record or block torn by a failed write is cut off the end
+        Serial.printf("ERROR: Failed to repair %s\n", path);
+        return false;
+    }
 
-    File csvFile = SD.open(filename.c_str(), FILE_APPEND);
-    if (!csvFile) {
-        Serial.printf("ERROR: Failed to open %s\n", filename.c_str());
-        return;
+    stream.file = SD.open(path, FILE_APPEND);
+    if (!stream.file) {
+        Serial.printf("ERROR: Failed to open %s\n", path);
+        return false;
+    }
+    if (created) {
+        if (stream.file.write(header, sizeof(header)) != sizeof(header)) {
+            Serial.printf("ERROR: Failed to write %s\n", path);
+            stream.file.close();
+            return false;
+        }
+        uint8_t indexHeader[BTS_INDEX_HEADER_SIZE];
+        btsWriteIndexHeader(time, indexHeader);
+        stream.index.begin(time);
+        File index = SD.open(indexPath, FILE_WRITE);
+        if (index) {
+            index.write(indexHeader, sizeof(indexHeader));
+            index.close();
+        }
     }
+    stream.fileSize = created ? BTS_HEADER_SIZE : valid;
 
-    // Write CSV header if new file
-    if (!fileExists) {
-        csvFile.println("timestamp,block_height,tx_count,block_timestamp");
+    strncpy(stream.date, date, sizeof(stream.date) - 1);
+    stream.date[sizeof(stream.date) - 1] = '\0';
+    stream.firstBufferedMs = millis();
+    return true;
+}
+
+size_t SDLogger::validDataLength(File& file, const BtsHeader& header, size_t size, File* index) {
+    if (header.version == 1) {
+        return size - (size - BTS_HEADER_SIZE) % header.recordSize;
     }
 
-    // Write data row
-    char csvLine[128];
-    snprintf(csvLine, sizeof(csvLine), "%s,%d,%d,%u",
-             getTimestamp().c_str(), height, txCount, timestamp);
-    csvFile.println(csvLine);
-    csvFile.close();
+    DataStream& stream = streams[header.kind - 1];
+    stream.index.begin(header.baseTime);
+    uint8_t entry[BTS_INDEX_ENTRY_SIZE];
+    if (index) {
+        btsWriteIndexHeader(header.baseTime, entry);
+        index->write(entry, BTS_INDEX_HEADER_SIZE);
+    }
 
-    // Log success
-    Serial.printf("[CSV] Block logged: Height %d (%d TXs)\n", height, txCount);
+    // Walk the block headers; a block running past the end is torn
+    size_t pos = BTS_HEADER_SIZE;
+    uint8_t blockHeader[GORILLA_BLOCK_HEADER];
+    while (pos < size) {
+        if (!file.seek(pos) || file.read(blockHeader, sizeof(blockHeader)) != sizeof(blockHeader)) break;
+        size_t block = GorillaDecoder::blockSize(blockHeader, sizeof(blockHeader));
+        if (block > BTS_BLOCK_SIZE || pos + block > size) break;
+        stream.index.entry(btsGet32(blockHeader + 4), pos, entry);
+        if (index) index->write(entry, sizeof(entry));
+        pos += block;
+    }
+    return pos < size ? pos : size;
 }
 
-void SDLogger::logMempool(int count, float sizeMB) {
-    if (!isReady()) return;
+bool SDLogger::truncateFile(const char* path, size_t length) {
+    // FAT has no truncate here: copy the kept part and swap the files
+    char tmpPath[52];
+    snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
 
-    // Create filename: /logs/data/btc_mempool_YYYY-MM-DD.csv
-    String filename = "/logs/data/btc_mempool_" + getCurrentDate() + ".csv";
+    File src = SD.open(path, FILE_READ);
+    File dst = SD.open(tmpPath, FILE_WRITE);
+    if (!src || !dst) {
+        if (src) src.close();
+        if (dst) dst.close();
+        return false;
+    }
 
-    // Check if file exists to determine if we need to write header
-    bool fileExists = SD.exists(filename.c_str());
+    uint8_t chunk[512];
+    size_t copied = 0;
+    while (copied < length) {
+        size_t want = length - copied < sizeof(chunk) ? length - copied : sizeof(chunk);
+        int n = src.read(chunk, want);
+        if (n <= 0 || dst.write(chunk, n) != (size_t)n) break;
+        copied += n;
+    }
+    src.close();
+    dst.close();
 
-    File csvFile = SD.open(filename.c_str(), FILE_APPEND);
-    if (!csvFile) {
-        Serial.printf("ERROR: Failed to open %s\n", filename.c_str());
+    if (copied != length) {
+        SD.remove(tmpPath);
+        return false;
+    }
+    if (!SD.remove(path) || !SD.rename(tmpPath, path)) {
+        return false;
+    }
+    Serial.printf("⚠️  %s: dropped a torn record\n", path);
+    return true;
+}
+
+void SDLogger::flushStream(DataStream& stream) {
+    if (!stream.file || stream.writer.pendingSamples() == 0) return;
+
+    // One write per block instead of an open/write/close per sample
+    const uint8_t* data;
+    size_t len = stream.writer.take(data);
+    uint32_t offset = stream.fileSize;
+    size_t written = stream.file.write(data, len);
+    stream.file.flush();
+    stream.writes++;
+    stream.bytes += written;
+    stream.fileSize += written;
+
+    if (written != len) {
+        Serial.printf("ERROR: Data write incomplete (%zu/%zu bytes)\n", written, len);
+        writeRetryCount++;
+        // Reopening cuts the torn block off and resumes the file
+        stream.file.close();
+        stream.date[0] = '\0';
         return;
     }
 
-    // Write CSV header if new file
-    if (!fileExists) {
-        csvFile.println("timestamp,tx_count,size_mb");
+    if (stream.writer.header().version >= 2) {
+        appendIndexEntry(stream, btsGet32(data + 4), offset);
     }
+}
 
-    // Write data row
-    char csvLine[128];
-    snprintf(csvLine, sizeof(csvLine), "%s,%d,%.2f",
-             getTimestamp().c_str(), count, sizeMB);
-    csvFile.println(csvLine);
-    csvFile.close();
+void SDLogger::appendIndexEntry(DataStream& stream, uint32_t time, uint32_t offset) {
+    // Written after its block, so an entry never points past the data
+    char path[48];
+    dataPath(path, sizeof(path), stream.kind, stream.date, ".idx");
+    uint8_t entry[BTS_INDEX_ENTRY_SIZE];
+    stream.index.entry(time, offset, entry);
+
+    File index = SD.open(path, FILE_APPEND);
+    if (!index) return;
+    size_t written = index.write(entry, sizeof(entry));
+    index.close();
+    if (written != sizeof(entry)) {
+        // A misaligned index is worse than none; reopening the stream rebuilds it
+        SD.remove(path);
+    }
+}
 
-    // Log success (DEBUG level to avoid spam)
-    if (currentLevel <= LOG_DEBUG) {
-        Serial.printf("[CSV] Mempool logged: %d TXs (%.2f MB)\n", count, sizeMB);
+void SDLogger::closeStreams(bool flushBuffers) {
+    for (int i = 0; i < BTS_KIND_COUNT; i++) {
+        DataStream& stream = streams[i];
+        if (flushBuffers) flushStream(stream);
+        if (stream.file) stream.file.close();
+        stream.date[0] = '\0';
+    }
+}
+
+void SDLogger::flushData() {
+    SDLock lock(mutex);
+    if (!isReady()) return;
+    for (int i = 0; i < BTS_KIND_COUNT; i++) {
+        flushStream(streams[i]);
     }
 }
 
+void SDLogger::printDataStatus() {
+    SDLock lock(mutex);
+    Serial.println("Data Files (compressed binary):");
+    for (int i = 0; i < BTS_KIND_COUNT; i++) {
+        const DataStream& stream = streams[i];
+        Serial.printf("  %-13s %s, %lu samples in %lu SD writes (%.1f bytes/sample), %u buffered\n",
+                     btsSchema(i + 1)->prefix, stream.file ? stream.date : "closed",
+                     (unsigned long)stream.samples, (unsigned long)stream.writes,
+                     stream.samples > 0 ? (float)stream.bytes / stream.samples : 0.0f,
+                     (unsigned)stream.writer.pendingSamples());
+    }
+}
+
+// ==================== Price Data Replay ====================
+
+static bool isPriceFile(const char* name) {
+    size_t len = strlen(name);
+    return strncmp(name, "btc_price_", 10) == 0 && len == 24 &&
+           (strcmp(name + 20, ".bts") == 0 || strcmp(name + 20, ".csv") == 0);
+}
+
+// By date; on the day of a firmware update the .csv comes before the .bts
+static int priceFileOrder(const char* a, const char* b) {
+    int byDate = strncmp(a + 10, b + 10, 10);
+    if (byDate != 0) return byDate;
+    return strcmp(b, a);
+}
+
+int SDLogger::readPriceHistory(int days, void (*onSample)(uint32_t time, float usd, void* ctx), void* ctx) {
+    if (days <= 0) return 0;
+    if (days > MAX_REPLAY_DAYS) days = MAX_REPLAY_DAYS;
+
+    // Newest `days` file names, ascending (YYYY-MM-DD sorts by date)
+    char names[MAX_REPLAY_DAYS][32];
+    int count = 0;
+
+    // The lock is held for the listing and each read only: the replay takes
+    // seconds and the UI task logs (first frame, hot-swap) in the meantime
+    {
+        SDLock lock(mutex);
+        if (!isReady()) return 0;
+
+        File dataDir = SD.open("/logs/data");
+        if (!dataDir) return 0;
+
+        File file = dataDir.openNextFile();
+        while (file) {
+            const char* name = file.name();
+            if (isPriceFile(name)) {
+                if (count < days) {
+                    // Insert in order
+                    int i = count++;
+                    while (i > 0 && priceFileOrder(names[i - 1], name) > 0) {
+                        strcpy(names[i], names[i - 1]);
+                        i--;
+                    }
+                    strcpy(names[i], name);
+                } else if (priceFileOrder(name, names[0]) > 0) {
+                    // Drop the oldest, insert in order
+                    int i = 0;
+                    while (i + 1 < count && priceFileOrder(names[i + 1], name) < 0) {
+                        strcpy(names[i], names[i + 1]);
+                        i++;
+                    }
+                    strcpy(names[i], name);
+                }
+            }
+            file.close();
+            file = dataDir.openNextFile();
+        }
+        dataDir.close();
+    }
+
+    int samples = 0;
+    char chunk[512];
+    char line[96];
+    int n;
+
+    for (int f = 0; f < count; f++) {
+        char path[48];
+        snprintf(path, sizeof(path), "/logs/data/%s", names[f]);
+        File csv;
+        {
+            SDLock lock(mutex);
+            if (!isReady()) break;  // Card removed or logging disabled mid-replay
+            csv = SD.open(path, FILE_READ);
+        }
+        if (!csv) continue;
+
+        // Next block of the file under the lock; 0 at the end or once the card is gone
+        auto readChunk = [&](uint8_t* buf, size_t len) -> int {
+            SDLock lock(mutex);
+            return isReady() ? csv.read(buf, len) : 0;
+        };
+
+        if (strcmp(names[f] + 20, ".bts") == 0) {
+            uint8_t header[BTS_HEADER_SIZE];
+            BtsReader reader;
+            if (readChunk(header, sizeof(header)) == (int)sizeof(header) && reader.begin(header) &&
+                reader.header().kind == BTS_PRICE) {
+                const BtsHeader& info = reader.header();
+                while ((n = readChunk((uint8_t*)chunk, sizeof(chunk))) > 0) {
+                    samples += reader.feed((const uint8_t*)chunk, n, [&](uint32_t time, const uint32_t* fields) {
+                        if (fields[0] > 0) onSample(time, btsValue(info, fields, 0), ctx);
+                    });
+                }
+            }
+        } else {
+            // Block reads and a fixed line buffer (readStringUntil allocates per line)
+            size_t lineLen = 0;
+            while ((n = readChunk((uint8_t*)chunk, sizeof(chunk))) > 0) {
+                for (int i = 0; i < n; i++) {
+                    char c = chunk[i];
+                    if (c != '\n') {
+                        if (lineLen < sizeof(line) - 1) line[lineLen++] = c;
+                        continue;
+                    }
+                    line[lineLen] = '\0';
+                    lineLen = 0;
+
+                    uint32_t time;
+                    float usd;
+                    if (parsePriceCsvLine(line, time, usd)) {
+                        onSample(time, usd, ctx);
+                        samples++;
+                    }
+                }
+            }
+        }
+
+        SDLock lock(mutex);
+        csv.close();
+    }
+
+    return samples;
+}
+
 // ==================== CSV Data Export ====================
 
-void SDLogger::exportData(const char* dataType) {
+void SDLogger::exportData(const char* dataType, uint32_t from, uint32_t to) {
+    SDLock lock(mutex);
     if (!isReady()) {
         Serial.println("ERROR: SD card not ready");
         return;
@@ -809,61 +1159,206 @@ void SDLogger::exportData(const char* dataType) {
         pattern = "btc_blocks_";
     } else if (strcmp(dataType, "MEMPOOL") == 0) {
         pattern = "btc_mempool_";
+    } else if (strcmp(dataType, "FEES") == 0) {
+        pattern = "btc_fees_";
     } else if (strcmp(dataType, "ALL") == 0) {
         // Export all data types
         Serial.println("\n=== EXPORTING ALL DATA ===\n");
-        exportData("PRICE");
-        exportData("BLOCKS");
-        exportData("MEMPOOL");
+        exportData("PRICE", from, to);
+        exportData("BLOCKS", from, to);
+        exportData("MEMPOOL", from, to);
+        exportData("FEES", from, to);
         return;
     } else {
         Serial.printf("ERROR: Unknown data type '%s'\n", dataType);
-        Serial.println("Valid types: PRICE, BLOCKS, MEMPOOL, ALL");
+        Serial.println("Valid types: PRICE, BLOCKS, MEMPOOL, FEES, ALL");
         return;
     }
 
-    Serial.printf("\n=== EXPORT START: %s ===\n", dataType);
-
-    // Open data directory
-    File dataDir = SD.open("/logs/data");
-    if (!dataDir) {
-        Serial.println("ERROR: Failed to open /logs/data directory");
-        return;
-    }
+    // Samples still buffered belong in the export
+    flushData();
 
     int filesExported = 0;
     int totalLines = 0;
 
-    // Iterate through files
-    File file = dataDir.openNextFile();
-    while (file) {
-        String filename = String(file.name());
+    if (from != 0 || to != 0xFFFFFFFFu) {
+        char fromText[20];
+        char toText[20];
+        formatCsvTimestamp(from, fromText, sizeof(fromText));
+        if (to == 0xFFFFFFFFu) {
+            strcpy(toText, "now");
+        } else {
+            formatCsvTimestamp(to, toText, sizeof(toText));
+        }
+        Serial.printf("\n=== EXPORT START: %s %s to %s ===\n", dataType, fromText, toText);
+        exportRange(pattern.c_str(), from, to, filesExported, totalLines);
+    } else {
+        Serial.printf("\n=== EXPORT START: %s ===\n", dataType);
 
-        // Check if filename matches pattern
-        if (filename.startsWith(pattern)) {
-            Serial.printf("\n--- FILE: %s ---\n", filename.c_str());
+        // Open data directory
+        File dataDir = SD.open("/logs/data");
+        if (!dataDir) {
+            Serial.println("ERROR: Failed to open /logs/data directory");
+            return;
+        }
+
+        // Iterate through files
+        File file = dataDir.openNextFile();
+        while (file) {
+            String filename = String(file.name());
 
-            // Read and output entire file
-            while (file.available()) {
-                String line = file.readStringUntil('\n');
-                Serial.println(line);
-                totalLines++;
+            // Check if filename matches pattern
+            if (filename.startsWith(pattern) && !filename.endsWith(".tmp") && !filename.endsWith(".idx")) {
+                Serial.printf("\n--- FILE: %s ---\n", filename.c_str());
+
+                if (filename.endsWith(".bts")) {
+                    // Binary data file: decode to the same CSV rows
+                    exportBinary(file, totalLines, 0, 0xFFFFFFFFu, nullptr);
+                } else {
+                    // Read and output entire file
+                    while (file.available()) {
+                        String line = file.readStringUntil('\n');
+                        Serial.println(line);
+                        totalLines++;
+                    }
+                }
+
+                filesExported++;
             }
 
-            filesExported++;
+            file.close();
+            file = dataDir.openNextFile();
         }
 
-        file.close();
-        file = dataDir.openNextFile();
+        dataDir.close();
     }
 
-    dataDir.close();
-
     Serial.printf("\n=== EXPORT END: %s ===\n", dataType);
     Serial.printf("Files exported: %d\n", filesExported);
     Serial.printf("Total lines: %d\n", totalLines);
 }
 
+void SDLogger::exportRange(const char* prefix, uint32_t from, uint32_t to, int& filesExported, int& totalLines) {
+    // Daily files are named by date: open only the days in the range
+    uint32_t now = (uint32_t)time(nullptr);
+    uint32_t last = to < now ? to : now;
+    if (last < from) last = from;
+
+    for (uint32_t day = from - from % 86400; day <= last; day += 86400) {
+        char date[20];
+        formatCsvTimestamp(day, date, sizeof(date));
+        date[10] = '\0';
+
+        // On the day of a firmware update the .csv comes before the .bts
+        static const char* const extensions[] = {".csv", ".bts"};
+        for (const char* ext : extensions) {
+            char path[48];
+            snprintf(path, sizeof(path), "/logs/data/%s%s%s", prefix, date, ext);
+            if (!SD.exists(path)) continue;
+            File file = SD.open(path, FILE_READ);
+            if (!file) continue;
+
+            Serial.printf("\n--- FILE: %s%s%s ---\n", prefix, date, ext);
+            if (strcmp(ext, ".bts") == 0) {
+                char indexPath[48];
+                snprintf(indexPath, sizeof(indexPath), "/logs/data/%s%s.idx", prefix, date);
+                exportBinary(file, totalLines, from, to, indexPath);
+            } else {
+                exportCsv(file, totalLines, from, to);
+            }
+            file.close();
+            filesExported++;
+        }
+
+        if (day > 0xFFFFFFFFu - 86400) break;
+    }
+}
+
+void SDLogger::exportBinary(File& file, int& totalLines, uint32_t from, uint32_t to, const char* indexPath) {
+    uint8_t header[BTS_HEADER_SIZE];
+    BtsReader reader;
+    if (file.read(header, sizeof(header)) != sizeof(header) || !reader.begin(header)) {
+        Serial.println("ERROR: Unknown data file format");
+        return;
+    }
+
+    const BtsHeader& info = reader.header();
+    char row[128];
+    btsFormatHeader(info, row, sizeof(row));
+    Serial.println(row);
+    totalLines++;
+
+    // With an index only the blocks that can hold the range are read
+    size_t start = BTS_HEADER_SIZE;
+    size_t end = file.size();
+    if (indexPath && info.version >= 2 &&
+        readIndexRange(indexPath, info, from, to, file.size(), start, end) && !file.seek(start)) {
+        return;
+    }
+
+    uint8_t chunk[512];
+    size_t pos = start;
+    while (pos < end) {
+        size_t want = end - pos < sizeof(chunk) ? end - pos : sizeof(chunk);
+        int n = file.read(chunk, want);
+        if (n <= 0) break;
+        pos += n;
+        reader.feed(chunk, n, [&](uint32_t time, const uint32_t* fields) {
+            if (time < from || time > to) return;
+            btsFormatRow(info, time, fields, row, sizeof(row));
+            Serial.println(row);
+            totalLines++;
+        });
+    }
+    if (reader.corrupt()) {
+        Serial.println("ERROR: Corrupt block, rest of file skipped");
+    }
+}
+
+void SDLogger::exportCsv(File& file, int& totalLines, uint32_t from, uint32_t to) {
+    // CSV files from older firmware: the header, then rows inside the range
+    bool first = true;
+    while (file.available()) {
+        String line = file.readStringUntil('\n');
+        uint32_t time;
+        bool hasTime;
+        if (!first && (!parseCsvTimestamp(line.c_str(), time, hasTime) || time < from || time > to)) {
+            continue;
+        }
+        first = false;
+        Serial.println(line);
+        totalLines++;
+    }
+}
+
+bool SDLogger::readIndexRange(const char* path, const BtsHeader& header, uint32_t from, uint32_t to,
+                              size_t fileSize, size_t& start, size_t& end) {
+    File index = SD.exists(path) ? SD.open(path, FILE_READ) : File();
+    if (!index) return false;
+
+    uint8_t indexHeader[BTS_INDEX_HEADER_SIZE];
+    uint32_t baseTime;
+    bool found = false;
+    if (index.read(indexHeader, sizeof(indexHeader)) == sizeof(indexHeader) &&
+        btsReadIndexHeader(indexHeader, baseTime) && baseTime == header.baseTime) {
+        size_t count = (index.size() - BTS_INDEX_HEADER_SIZE) / BTS_INDEX_ENTRY_SIZE;
+        // Binary search with one seek per probe
+        found = btsIndexRange(baseTime, count, fileSize, from, to,
+            [&](size_t i, uint32_t& time, uint32_t& offset) {
+                uint8_t entry[BTS_INDEX_ENTRY_SIZE];
+                if (!index.seek(BTS_INDEX_HEADER_SIZE + i * BTS_INDEX_ENTRY_SIZE) ||
+                    index.read(entry, sizeof(entry)) != sizeof(entry)) {
+                    return false;
+                }
+                time = btsGet32(entry);
+                offset = btsGet32(entry + 4);
+                return true;
+            }, start, end);
+    }
+    index.close();
+    return found;
+}
+
 // ==================== CSV Data Retention ====================
 
 int SDLogger::getFileDaysOld(const char* filename) {
@@ -904,6 +1399,7 @@ int SDLogger::getFileDaysOld(const char* filename) {
 }
 
 void SDLogger::cleanupOldCSVFiles(const char* pattern, int retentionDays) {
+    SDLock lock(mutex);
     if (!isReady()) return;
 
     File dataDir = SD.open("/logs/data");
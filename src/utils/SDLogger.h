@@ -4,12 +4,19 @@
 #include <SD.h>
 #include <Arduino.h>
 #include <FS.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include "BinarySeries.h"
 
 // SD Card Pin Definitions for SC01 Plus
 #define SD_CS_PIN   41
 #define SD_MOSI_PIN 40
 #define SD_CLK_PIN  39
 #define SD_MISO_PIN 38
+#define SD_MAX_OPEN_FILES 8  // Four held-open data files plus logs, exports and screenshots
+
+// Binary data files (BinarySeries.h)
+#define DATA_FLUSH_INTERVAL 300000   // Buffered samples reach the card within 5 minutes
 
 enum LogLevel {
     LOG_DEBUG = 0,
@@ -40,10 +47,16 @@ public:
     void logMemoryUsage();              // v1.2.0: Log memory statistics
     void logWatchdogCrash();            // v1.2.0: Log watchdog timeout crashes
 
-    // CSV data logging for historical export
+    // Historical data, appended to daily binary files (exported as CSV)
     void logPrice(float usd, float eur);
-    void logBlock(int height, int txCount, uint32_t timestamp);
+    void logBlock(int height, int txCount, uint32_t timestamp, uint32_t sizeBytes);
     void logMempool(int count, float sizeMB);
+    void logFees(int fast, int medium, int slow);  // sat/vB
+
+    // Replay the price samples of the newest `days` daily files (.bts, or
+    // .csv from older firmware), oldest first.
+    // Returns the number of samples passed to onSample.
+    int readPriceHistory(int days, void (*onSample)(uint32_t time, float usd, void* ctx), void* ctx);
 
     // Boot logging
     void logBoot(const char* message);
@@ -58,11 +71,14 @@ public:
 
     // Maintenance
     void flush();  // Force write buffer to SD
+    void flushData(); // Write buffered data samples to SD
     void rotate(); // Create new log file (called daily)
     void cleanup(); // Delete old logs per retention policy
     void checkHotSwap(); // Check if SD card was removed/inserted
     bool formatCard(); // Format SD card (WARNING: Deletes all data)
-    void exportData(const char* dataType); // Export CSV data to serial console
+    // Export data files to serial console as CSV; a time range (unix
+    // seconds, inclusive) reads only the days and indexed blocks it covers
+    void exportData(const char* dataType, uint32_t from = 0, uint32_t to = 0xFFFFFFFFu);
 
     // Status
     uint64_t getFreeSpace();
@@ -71,6 +87,7 @@ public:
     int getLogFileCount();
     const char* getStatusString();
     bool isCardPresent();
+    void printDataStatus();
 
     // Public helper for external logging
     String getTimestamp();
@@ -90,8 +107,25 @@ private:
     bool cardPresent;
     unsigned long lastHotSwapCheck;
     int writeRetryCount;
+    SemaphoreHandle_t mutex;  // Serializes SD access between loop and fetch worker tasks
+
+    // One held-open, buffered file per data kind
+    struct DataStream {
+        File file;
+        BtsWriter writer;          // Buffers one block (BTS_BLOCK_SIZE)
+        BtsIndexWriter index;      // Entries for the .idx sidecar
+        uint8_t kind;
+        char date[11];
+        uint32_t fileSize;
+        unsigned long firstBufferedMs;
+        uint32_t samples;
+        uint32_t writes;
+        uint32_t bytes;
+    };
+    DataStream streams[BTS_KIND_COUNT];
 
     static const int MAX_WRITE_RETRIES = 3;
+    static const int MAX_REPLAY_DAYS = 8;  // readPriceHistory(): 7 days plus today
     static const unsigned long HOT_SWAP_CHECK_INTERVAL = 5000; // Check every 5 seconds
 
     void writeBuffer();
@@ -105,6 +139,18 @@ private:
     bool deleteRecursive(File dir, const char* path); // Helper for formatCard()
     void cleanupOldCSVFiles(const char* pattern, int retentionDays); // Helper for CSV retention
     int getFileDaysOld(const char* filename); // Parse date from filename
+    void appendSample(uint8_t kind, const uint32_t* fields);
+    bool openStream(DataStream& stream, uint8_t kind, const char* date, uint32_t time);
+    void flushStream(DataStream& stream);
+    bool truncateFile(const char* path, size_t length);
+    size_t validDataLength(File& file, const BtsHeader& header, size_t size, File* index);
+    void appendIndexEntry(DataStream& stream, uint32_t time, uint32_t offset);
+    void closeStreams(bool flushBuffers);
+    void exportRange(const char* prefix, uint32_t from, uint32_t to, int& filesExported, int& totalLines);
+    void exportBinary(File& file, int& totalLines, uint32_t from, uint32_t to, const char* indexPath);
+    void exportCsv(File& file, int& totalLines, uint32_t from, uint32_t to);
+    bool readIndexRange(const char* path, const BtsHeader& header, uint32_t from, uint32_t to,
+                        size_t fileSize, size_t& start, size_t& end);
 };
 
 extern SDLogger sdLogger;
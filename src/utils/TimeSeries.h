@@ -0,0 +1,234 @@
+#ifndef TIME_SERIES_H
+#define TIME_SERIES_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+// Downsampling tiers: bucket width in seconds
+#define TS_MINUTE_SECONDS 60
+#define TS_HOUR_SECONDS 3600
+#define TS_DAY_SECONDS 86400
+
+enum TimeSeriesTier {
+    TS_TIER_MINUTE = 0,
+    TS_TIER_HOUR,
+    TS_TIER_DAY,
+    TS_TIER_COUNT
+};
+
+// One raw sample (unix seconds)
+struct TimeSeriesSample {
+    uint32_t time;
+    float value;
+};
+
+// Aggregate of the samples in [start, start + tier width)
+struct TimeSeriesBucket {
+    uint32_t start;
+    float min;
+    float max;
+    float avg;
+    uint32_t count;
+};
+
+inline uint32_t timeOf(const TimeSeriesSample& s) { return s.time; }
+inline uint32_t timeOf(const TimeSeriesBucket& b) { return b.start; }
+
+/**
+ * TimeSeriesRing - Fixed-capacity ring of time-ordered items
+ *
+ * The storage is supplied by the caller (PSRAM on the device, a static array
+ * in tests). push() overwrites the oldest item once full. Items must arrive
+ * in non-decreasing time order, which keeps the ring sorted, so the first
+ * item at or after a time is found by binary search.
+ */
+template <typename T>
+class TimeSeriesRing {
+public:
+    TimeSeriesRing() : items(nullptr), cap(0), head(0), count(0) {}
+
+    void attach(T* storage, uint32_t capacity) {
+        items = storage;
+        cap = storage ? capacity : 0;
+        clear();
+    }
+
+    void clear() {
+        head = 0;
+        count = 0;
+    }
+
+    void push(const T& item) {
+        if (cap == 0) return;
+        items[(head + count) % cap] = item;
+        if (count < cap) {
+            count++;
+        } else {
+            head = (head + 1) % cap;
+        }
+    }
+
+    uint32_t size() const { return count; }
+    uint32_t capacity() const { return cap; }
+    bool empty() const { return count == 0; }
+
+    // 0 is the oldest item
+    const T& at(uint32_t i) const { return items[(head + i) % cap]; }
+    const T& newest() const { return at(count - 1); }
+
+    // Index of the first item with time >= t, size() if there is none
+    uint32_t lowerBound(uint32_t t) const {
+        uint32_t lo = 0, hi = count;
+        while (lo < hi) {
+            uint32_t mid = lo + (hi - lo) / 2;
+            if (timeOf(at(mid)) < t) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    /**
+     * Copy the items with from <= time <= to, oldest first, at most max.
+     * Returns how many were copied.
+     */
+    uint32_t copyRange(uint32_t from, uint32_t to, T* out, uint32_t max) const {
+        uint32_t n = 0;
+        for (uint32_t i = lowerBound(from); i < count && n < max; i++) {
+            const T& item = at(i);
+            if (timeOf(item) > to) break;
+            out[n++] = item;
+        }
+        return n;
+    }
+
+private:
+    T* items;
+    uint32_t cap;
+    uint32_t head;
+    uint32_t count;
+};
+
+// Ring sizes of one series
+struct TimeSeriesCapacity {
+    uint32_t raw;
+    uint32_t tiers[TS_TIER_COUNT];  // Minute, hour, day buckets
+};
+
+/**
+ * TieredSeries - Raw samples plus minute, hour and day aggregates
+ *
+ * append() is O(1): the sample goes into the raw ring and is folded into the
+ * open bucket of every tier; a bucket is pushed to its tier's ring when a
+ * sample for a later bucket arrives. Range queries binary-search the ring
+ * (O(log n) plus the items copied). The open buckets are part of tier
+ * queries, so the current minute, hour and day are always visible.
+ *
+ * Raw samples cover the last hours, the tiers days to years at fixed memory.
+ * Samples older than the newest one are dropped. The caller provides storage
+ * (PSRAM in HistoryStore) and serializes access.
+ */
+class TieredSeries {
+public:
+    TieredSeries() { memset(open, 0, sizeof(open)); }
+
+    // Bytes of storage attach() needs for these capacities
+    static size_t bytesFor(const TimeSeriesCapacity& c) {
+        size_t bytes = c.raw * sizeof(TimeSeriesSample);
+        for (int i = 0; i < TS_TIER_COUNT; i++) bytes += c.tiers[i] * sizeof(TimeSeriesBucket);
+        return bytes;
+    }
+
+    static uint32_t tierSeconds(TimeSeriesTier tier) {
+        static const uint32_t SECONDS[TS_TIER_COUNT] = {
+            TS_MINUTE_SECONDS, TS_HOUR_SECONDS, TS_DAY_SECONDS
+        };
+        return SECONDS[tier];
+    }
+
+    // storage must hold bytesFor(c) bytes, aligned for float
+    void attach(void* storage, const TimeSeriesCapacity& c) {
+        uint8_t* p = (uint8_t*)storage;
+        raw.attach((TimeSeriesSample*)p, c.raw);
+        p += c.raw * sizeof(TimeSeriesSample);
+        for (int i = 0; i < TS_TIER_COUNT; i++) {
+            tiers[i].attach((TimeSeriesBucket*)p, c.tiers[i]);
+            p += c.tiers[i] * sizeof(TimeSeriesBucket);
+        }
+        memset(open, 0, sizeof(open));
+    }
+
+    void clear() {
+        raw.clear();
+        for (int i = 0; i < TS_TIER_COUNT; i++) tiers[i].clear();
+        memset(open, 0, sizeof(open));
+    }
+
+    // Add a sample; false if it is older than the newest one
+    bool append(uint32_t time, float value) {
+        if (!raw.empty() && time < raw.newest().time) return false;
+
+        TimeSeriesSample s = {time, value};
+        raw.push(s);
+
+        for (int i = 0; i < TS_TIER_COUNT; i++) {
+            TimeSeriesBucket& b = open[i];
+            uint32_t start = time - time % tierSeconds((TimeSeriesTier)i);
+            if (b.count > 0 && b.start != start) {
+                tiers[i].push(b);
+                b.count = 0;
+            }
+            if (b.count == 0) {
+                b.start = start;
+                b.min = value;
+                b.max = value;
+                b.avg = 0;
+            }
+            b.count++;
+            if (value < b.min) b.min = value;
+            if (value > b.max) b.max = value;
+            b.avg += (value - b.avg) / b.count;
+        }
+        return true;
+    }
+
+    // Raw samples with from <= time <= to, oldest first; returns the count copied
+    uint32_t query(uint32_t from, uint32_t to, TimeSeriesSample* out, uint32_t max) const {
+        return raw.copyRange(from, to, out, max);
+    }
+
+    // Buckets starting in [from, to], oldest first, the open bucket last
+    uint32_t queryTier(TimeSeriesTier tier, uint32_t from, uint32_t to,
+                       TimeSeriesBucket* out, uint32_t max) const {
+        uint32_t n = tiers[tier].copyRange(from, to, out, max);
+        const TimeSeriesBucket& b = open[tier];
+        if (n < max && b.count > 0 && b.start >= from && b.start <= to) out[n++] = b;
+        return n;
+    }
+
+    bool latest(TimeSeriesSample& out) const {
+        if (raw.empty()) return false;
+        out = raw.newest();
+        return true;
+    }
+
+    // Oldest time still held as a raw sample, or in the given tier (0 when empty)
+    uint32_t oldestRaw() const { return raw.empty() ? 0 : raw.at(0).time; }
+    uint32_t oldest(TimeSeriesTier tier) const {
+        if (!tiers[tier].empty()) return tiers[tier].at(0).start;
+        return open[tier].count > 0 ? open[tier].start : 0;
+    }
+
+    const TimeSeriesRing<TimeSeriesSample>& getRaw() const { return raw; }
+    const TimeSeriesRing<TimeSeriesBucket>& getTier(TimeSeriesTier tier) const { return tiers[tier]; }
+
+private:
+    TimeSeriesRing<TimeSeriesSample> raw;
+    TimeSeriesRing<TimeSeriesBucket> tiers[TS_TIER_COUNT];
+    TimeSeriesBucket open[TS_TIER_COUNT];
+};
+
+#endif // TIME_SERIES_H
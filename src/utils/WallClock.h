@@ -0,0 +1,17 @@
+#ifndef WALL_CLOCK_H
+#define WALL_CLOCK_H
+
+#include <stdint.h>
+#include <time.h>
+
+// time() values below this mean SNTP has not synced yet
+#define WALL_CLOCK_MIN_EPOCH 1700000000UL
+
+// Unix time in seconds, or 0 while the clock is not synced. Used for AI cache
+// TTLs, history buckets, warm-start ages and data file timestamps.
+inline uint32_t wallClockNow() {
+    time_t t = time(nullptr);
+    return t >= (time_t)WALL_CLOCK_MIN_EPOCH ? (uint32_t)t : 0;
+}
+
+#endif // WALL_CLOCK_H
@@ -0,0 +1,136 @@
+#include <unity.h>
+#include <string.h>
+#include "api/AISignalCache.h"
+
+#define T0 1760000000UL  // Some synced Unix time
+
+struct Answer {
+    char signal[8];
+    uint8_t confidence;
+};
+
+static const Answer BUY = {"BUY", 70};
+static const Answer SELL = {"SELL", 55};
+
+// Test: Small price moves stay in the same bucket, larger ones do not
+void test_price_bucket() {
+    TEST_ASSERT_EQUAL_UINT32(priceBucket(97000.0f), priceBucket(97100.0f));
+    TEST_ASSERT_NOT_EQUAL(priceBucket(97000.0f), priceBucket(98000.0f));
+    TEST_ASSERT_EQUAL_UINT32(0, priceBucket(0.0f));
+}
+
+// Test: Fee and mempool tiers follow their thresholds
+void test_fee_and_mempool_tiers() {
+    TEST_ASSERT_EQUAL_UINT8(0, feeTier(1));
+    TEST_ASSERT_EQUAL_UINT8(1, feeTier(4));
+    TEST_ASSERT_EQUAL_UINT8(2, feeTier(8));
+    TEST_ASSERT_EQUAL_UINT8(6, feeTier(500));
+
+    TEST_ASSERT_EQUAL_UINT8(0, mempoolTier(0.5f));
+    TEST_ASSERT_EQUAL_UINT8(3, mempoolTier(35.0f));
+    TEST_ASSERT_EQUAL_UINT8(6, mempoolTier(400.0f));
+}
+
+// Test: Fingerprint changes when any component changes tier
+void test_fingerprint() {
+    uint32_t base = marketFingerprint(97000.0f, 8, 35.0f);
+    TEST_ASSERT_EQUAL_UINT32(base, marketFingerprint(97050.0f, 9, 36.0f));
+    TEST_ASSERT_NOT_EQUAL(base, marketFingerprint(97000.0f, 25, 35.0f));
+    TEST_ASSERT_NOT_EQUAL(base, marketFingerprint(97000.0f, 8, 120.0f));
+}
+
+// Test: A stored answer is returned for the same fingerprint and kind only
+void test_hit_and_miss() {
+    AISignalCache cache;
+    Answer a;
+    uint32_t fp = marketFingerprint(97000.0f, 8, 35.0f);
+
+    TEST_ASSERT_FALSE(cache.lookup(AI_CACHE_MARKET_SIGNALS, fp, &a, sizeof(a), T0));
+    TEST_ASSERT_EQUAL_INT(0, cache.store(AI_CACHE_MARKET_SIGNALS, fp, &BUY, sizeof(BUY), T0));
+
+    TEST_ASSERT_TRUE(cache.lookup(AI_CACHE_MARKET_SIGNALS, fp, &a, sizeof(a), T0 + 60));
+    TEST_ASSERT_EQUAL_STRING("BUY", a.signal);
+    TEST_ASSERT_FALSE(cache.lookup(AI_CACHE_TRADING_SUGGESTION, fp, &a, sizeof(a), T0 + 60));
+    TEST_ASSERT_FALSE(cache.lookup(AI_CACHE_MARKET_SIGNALS, fp + 1, &a, sizeof(a), T0 + 60));
+
+    TEST_ASSERT_EQUAL_UINT32(1, cache.getHits());
+    TEST_ASSERT_EQUAL_UINT32(3, cache.getMisses());
+    TEST_ASSERT_EQUAL_UINT8(25, cache.hitRate());
+}
+
+// Test: Entries expire after the TTL even if the market is unchanged
+void test_ttl_expiry() {
+    AISignalCache cache;
+    Answer a;
+    cache.store(AI_CACHE_MARKET_SIGNALS, 42, &BUY, sizeof(BUY), T0);
+
+    TEST_ASSERT_TRUE(cache.lookup(AI_CACHE_MARKET_SIGNALS, 42, &a, sizeof(a), T0 + AI_CACHE_TTL_S - 1));
+    TEST_ASSERT_FALSE(cache.lookup(AI_CACHE_MARKET_SIGNALS, 42, &a, sizeof(a), T0 + AI_CACHE_TTL_S));
+    TEST_ASSERT_EQUAL_UINT32(1, cache.getExpired());
+
+    // A fresh answer for the same state replaces the expired one in place
+    TEST_ASSERT_EQUAL_INT(0, cache.store(AI_CACHE_MARKET_SIGNALS, 42, &SELL, sizeof(SELL), T0 + AI_CACHE_TTL_S));
+    TEST_ASSERT_TRUE(cache.lookup(AI_CACHE_MARKET_SIGNALS, 42, &a, sizeof(a), T0 + AI_CACHE_TTL_S + 1));
+    TEST_ASSERT_EQUAL_STRING("SELL", a.signal);
+}
+
+// Test: Nothing is stored or returned before the clock is synced
+void test_unsynced_clock() {
+    AISignalCache cache;
+    Answer a;
+
+    TEST_ASSERT_EQUAL_INT(-1, cache.store(AI_CACHE_MARKET_SIGNALS, 42, &BUY, sizeof(BUY), 0));
+    cache.store(AI_CACHE_MARKET_SIGNALS, 42, &BUY, sizeof(BUY), T0);
+    TEST_ASSERT_FALSE(cache.lookup(AI_CACHE_MARKET_SIGNALS, 42, &a, sizeof(a), 0));
+}
+
+// Test: When full, the oldest answer is replaced
+void test_evicts_oldest() {
+    AISignalCache cache;
+    Answer a;
+
+    for (uint32_t i = 0; i < AI_CACHE_ENTRIES; i++) {
+        cache.store(AI_CACHE_MARKET_SIGNALS, 100 + i, &BUY, sizeof(BUY), T0 + i);
+    }
+    cache.store(AI_CACHE_MARKET_SIGNALS, 999, &SELL, sizeof(SELL), T0 + 10);
+
+    TEST_ASSERT_FALSE(cache.lookup(AI_CACHE_MARKET_SIGNALS, 100, &a, sizeof(a), T0 + 11));
+    TEST_ASSERT_TRUE(cache.lookup(AI_CACHE_MARKET_SIGNALS, 101, &a, sizeof(a), T0 + 11));
+    TEST_ASSERT_TRUE(cache.lookup(AI_CACHE_MARKET_SIGNALS, 999, &a, sizeof(a), T0 + 11));
+}
+
+// Test: Persisted entries survive a "reboot"; other layouts are ignored
+void test_restore_entries() {
+    AISignalCache before;
+    int slot = before.store(AI_CACHE_MARKET_SIGNALS, 42, &BUY, sizeof(BUY), T0);
+
+    AISignalCache after;
+    TEST_ASSERT_TRUE(after.restore(slot, before.entry(slot)));
+
+    Answer a;
+    TEST_ASSERT_TRUE(after.lookup(AI_CACHE_MARKET_SIGNALS, 42, &a, sizeof(a), T0 + 300));
+    TEST_ASSERT_EQUAL_UINT8(70, a.confidence);
+
+    AICacheEntry stale = before.entry(slot);
+    stale.version = AI_CACHE_VERSION + 1;
+    TEST_ASSERT_FALSE(after.restore(1, stale));
+    TEST_ASSERT_FALSE(after.restore(AI_CACHE_ENTRIES, before.entry(slot)));
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_price_bucket);
+    RUN_TEST(test_fee_and_mempool_tiers);
+    RUN_TEST(test_fingerprint);
+    RUN_TEST(test_hit_and_miss);
+    RUN_TEST(test_ttl_expiry);
+    RUN_TEST(test_unsynced_clock);
+    RUN_TEST(test_evicts_oldest);
+    RUN_TEST(test_restore_entries);
+
+    return UNITY_END();
+}
@@ -0,0 +1,461 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <chrono>
+#include "utils/BinarySeries.h"
+
+static const uint32_t T0 = 1735689600;  // 2025-01-01 00:00:00 UTC
+
+struct Decoded {
+    uint32_t time;
+    uint32_t fields[BTS_MAX_FIELDS];
+};
+
+// Decode a whole file image (header + records)
+static void decodeAll(const std::vector<uint8_t>& file, std::vector<Decoded>& out) {
+    BtsDecoder decoder;
+    TEST_ASSERT_TRUE(decoder.begin(file.data()));
+    size_t size = decoder.recordSize();
+    TEST_ASSERT_EQUAL(0, (file.size() - BTS_HEADER_SIZE) % size);
+
+    for (size_t i = BTS_HEADER_SIZE; i + size <= file.size(); i += size) {
+        Decoded d;
+        if (decoder.decode(file.data() + i, d.time, d.fields)) out.push_back(d);
+    }
+}
+
+static void append(std::vector<uint8_t>& file, BtsEncoder& encoder, uint32_t time, const uint32_t* fields) {
+    uint8_t buf[64];
+    size_t n = encoder.encode(time, fields, buf);
+    file.insert(file.end(), buf, buf + n);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// ---------------------------------------------------------------------------
+// Header and fixed point
+// ---------------------------------------------------------------------------
+
+// Test: Header carries the schema and is rejected when it does not match
+void test_header() {
+    uint8_t header[BTS_HEADER_SIZE];
+    BtsEncoder encoder;
+    TEST_ASSERT_FALSE(encoder.begin(9, T0, header));
+    TEST_ASSERT_TRUE(encoder.begin(BTS_BLOCKS, T0, header));
+
+    BtsHeader h;
+    TEST_ASSERT_TRUE(btsReadHeader(header, h));
+    TEST_ASSERT_EQUAL_UINT8(1, h.version);  // Fixed-size records
+    TEST_ASSERT_EQUAL_UINT8(BTS_BLOCKS, h.kind);
+    TEST_ASSERT_EQUAL_UINT8(4, h.fieldCount);
+    TEST_ASSERT_EQUAL_UINT8(18, h.recordSize);
+    TEST_ASSERT_EQUAL_UINT32(T0, h.baseTime);
+    TEST_ASSERT_EQUAL_MEMORY("BTSD", header, 4);
+
+    uint8_t bad[BTS_HEADER_SIZE];
+    memcpy(bad, header, sizeof(bad));
+    bad[4] = BTS_SCHEMA_VERSION + 1;
+    TEST_ASSERT_FALSE(btsReadHeader(bad, h));
+
+    memcpy(bad, header, sizeof(bad));
+    bad[7] = 10;  // Record size does not match the field count
+    TEST_ASSERT_FALSE(btsReadHeader(bad, h));
+
+    TEST_ASSERT_FALSE(btsReadHeader((const uint8_t*)"timestamp,price_", h));
+}
+
+// Test: Fixed-point conversion rounds and clamps
+void test_fixed_point() {
+    TEST_ASSERT_EQUAL_UINT32(9712345, btsFixed(97123.45f, 2));
+    TEST_ASSERT_EQUAL_UINT32(8745, btsFixed(87.449f, 2));
+    TEST_ASSERT_EQUAL_UINT32(15234, btsFixed(15234.0f, 0));
+    TEST_ASSERT_EQUAL_UINT32(0, btsFixed(-5.0f, 2));
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFFu, btsFixed(1e12f, 2));
+}
+
+// ---------------------------------------------------------------------------
+// Records
+// ---------------------------------------------------------------------------
+
+// Test: Samples come back with exact times and values
+void test_round_trip() {
+    uint8_t header[BTS_HEADER_SIZE];
+    BtsEncoder encoder;
+    encoder.begin(BTS_PRICE, T0 + 7, header);
+    std::vector<uint8_t> file(header, header + BTS_HEADER_SIZE);
+
+    uint32_t rng = 3;
+    std::vector<Decoded> written;
+    uint32_t t = T0 + 7;
+    for (int i = 0; i < 3000; i++) {
+        rng = rng * 1664525u + 1013904223u;
+        Decoded d;
+        d.time = t;
+        d.fields[0] = 9500000 + (rng >> 12) % 100000;
+        d.fields[1] = d.fields[0] * 95 / 100;
+        append(file, encoder, d.time, d.fields);
+        written.push_back(d);
+        t += 30 + (rng >> 28);  // 30-45s apart
+    }
+
+    TEST_ASSERT_EQUAL(BTS_HEADER_SIZE + 3000 * 10, file.size());
+
+    std::vector<Decoded> read;
+    decodeAll(file, read);
+    TEST_ASSERT_EQUAL(written.size(), read.size());
+    for (size_t i = 0; i < read.size(); i++) {
+        TEST_ASSERT_EQUAL_UINT32(written[i].time, read[i].time);
+        TEST_ASSERT_EQUAL_UINT32(written[i].fields[0], read[i].fields[0]);
+        TEST_ASSERT_EQUAL_UINT32(written[i].fields[1], read[i].fields[1]);
+    }
+}
+
+// Test: Long gaps, clock steps back and resumed files use time marks
+void test_time_marks() {
+    uint8_t header[BTS_HEADER_SIZE];
+    BtsEncoder encoder;
+    encoder.begin(BTS_MEMPOOL, T0, header);
+    std::vector<uint8_t> file(header, header + BTS_HEADER_SIZE);
+
+    uint32_t f[2] = {15000, 8745};
+    append(file, encoder, T0, f);
+    append(file, encoder, T0 + 300, f);
+    TEST_ASSERT_EQUAL(BTS_HEADER_SIZE + 20, file.size());
+
+    append(file, encoder, T0 + 300 + 70000, f);  // Longer than a delta
+    TEST_ASSERT_EQUAL(BTS_HEADER_SIZE + 40, file.size());
+
+    append(file, encoder, T0 + 300 + 69990, f);  // NTP stepped the clock back
+    TEST_ASSERT_EQUAL(BTS_HEADER_SIZE + 60, file.size());
+
+    uint8_t out[64];
+    TEST_ASSERT_EQUAL(0, encoder.encode(T0 - 1, f, out));  // Before the file's base
+
+    // Reboot: continue the file from its header
+    BtsEncoder resumed;
+    TEST_ASSERT_TRUE(resumed.resume(file.data()));
+    f[0] = 16000;
+    append(file, resumed, T0 + 80000, f);
+    append(file, resumed, T0 + 80030, f);
+    TEST_ASSERT_EQUAL(BTS_HEADER_SIZE + 90, file.size());
+
+    std::vector<Decoded> read;
+    decodeAll(file, read);
+    uint32_t expected[] = {T0, T0 + 300, T0 + 70300, T0 + 70290, T0 + 80000, T0 + 80030};
+    TEST_ASSERT_EQUAL(6, read.size());
+    for (int i = 0; i < 6; i++) TEST_ASSERT_EQUAL_UINT32(expected[i], read[i].time);
+    TEST_ASSERT_EQUAL_UINT32(16000, read[5].fields[0]);
+}
+
+// Test: Export rows match the CSV the logger used to write
+void test_csv_rows() {
+    uint8_t header[BTS_HEADER_SIZE];
+    BtsEncoder encoder;
+    encoder.begin(BTS_PRICE, T0, header);
+    BtsDecoder decoder;
+    TEST_ASSERT_TRUE(decoder.begin(header));
+
+    char row[128];
+    decoder.formatHeader(row, sizeof(row));
+    TEST_ASSERT_EQUAL_STRING("timestamp,price_usd,price_eur", row);
+
+    uint32_t price[2] = {btsFixed(97123.45f, 2), btsFixed(93000.1f, 2)};
+    decoder.formatRow(T0 + 12 * 3600 + 30, price, row, sizeof(row));
+    TEST_ASSERT_EQUAL_STRING("2025-01-01 12:00:30,97123.45,93000.10", row);
+
+    // Decoded rows replay like CSV rows
+    uint32_t t;
+    float usd;
+    TEST_ASSERT_TRUE(parsePriceCsvLine(row, t, usd));
+    TEST_ASSERT_EQUAL_UINT32(T0 + 12 * 3600 + 30, t);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 97123.45, usd);
+
+    uint8_t mempoolHeader[BTS_HEADER_SIZE];
+    encoder.begin(BTS_MEMPOOL, T0, mempoolHeader);
+    decoder.begin(mempoolHeader);
+    uint32_t mempool[2] = {15234, 8705};
+    decoder.formatRow(1709208000, mempool, row, sizeof(row));
+    TEST_ASSERT_EQUAL_STRING("2024-02-29 12:00:00,15234,87.05", row);
+
+    formatCsvTimestamp(1767225599, row, sizeof(row));
+    TEST_ASSERT_EQUAL_STRING("2025-12-31 23:59:59", row);
+}
+
+// ---------------------------------------------------------------------------
+// Sidecar index and range export
+// ---------------------------------------------------------------------------
+
+struct IndexedDay {
+    std::vector<uint8_t> file;
+    std::vector<uint8_t> index;
+    std::vector<Decoded> samples;
+};
+
+// A day of 30s prices written as SDLogger does: one block and one index
+// entry per 5-minute flush, with an NTP correction (10s back) in the afternoon
+static void writeIndexedDay(IndexedDay& day) {
+    uint8_t header[BTS_HEADER_SIZE];
+    BtsWriter writer;
+    writer.create(BTS_PRICE, T0, header);
+    day.file.assign(header, header + BTS_HEADER_SIZE);
+
+    BtsIndexWriter index;
+    index.begin(T0);
+    day.index.resize(BTS_INDEX_HEADER_SIZE);
+    btsWriteIndexHeader(T0, day.index.data());
+
+    uint32_t t = T0;
+    for (int i = 0; i < 2880; i++) {
+        Decoded d;
+        d.time = t;
+        d.fields[0] = 9700000 + (i * 37) % 5000;
+        d.fields[1] = d.fields[0] * 95 / 100;
+        writer.append(d.time, d.fields);
+        day.samples.push_back(d);
+        t += i == 1800 ? 20 : 30;
+
+        if (i % 10 == 9 || i == 2879) {
+            const uint8_t* data;
+            size_t len = writer.take(data);
+            uint8_t entry[BTS_INDEX_ENTRY_SIZE];
+            index.entry(btsGet32(data + 4), day.file.size(), entry);
+            day.file.insert(day.file.end(), data, data + len);
+            day.index.insert(day.index.end(), entry, entry + sizeof(entry));
+        }
+    }
+}
+
+// Rows of [from, to] from the index range; `read` gets the bytes used
+static void queryRange(const IndexedDay& day, uint32_t from, uint32_t to,
+                       std::vector<Decoded>& out, size_t& read, int& probes) {
+    uint32_t base;
+    TEST_ASSERT_TRUE(btsReadIndexHeader(day.index.data(), base));
+    size_t count = (day.index.size() - BTS_INDEX_HEADER_SIZE) / BTS_INDEX_ENTRY_SIZE;
+    size_t start, end;
+    probes = 0;
+    TEST_ASSERT_TRUE(btsIndexRange(base, count, day.file.size(), from, to,
+        [&](size_t i, uint32_t& time, uint32_t& offset) {
+            const uint8_t* e = day.index.data() + BTS_INDEX_HEADER_SIZE + i * BTS_INDEX_ENTRY_SIZE;
+            time = btsGet32(e);
+            offset = btsGet32(e + 4);
+            probes++;
+            return true;
+        }, start, end));
+
+    BtsReader reader;
+    reader.begin(day.file.data());
+    reader.feed(day.file.data() + start, end - start, [&](uint32_t time, const uint32_t* fields) {
+        if (time < from || time > to) return;
+        Decoded d;
+        d.time = time;
+        memcpy(d.fields, fields, sizeof(d.fields));
+        out.push_back(d);
+    });
+    read = end - start;
+}
+
+// Test: Export ranges parse like the CSV timestamps
+void test_parse_range() {
+    uint32_t from, to;
+    TEST_ASSERT_TRUE(btsParseRange("2025-01-01 10:00,2025-01-01 14:00:30", from, to));
+    TEST_ASSERT_EQUAL_UINT32(T0 + 10 * 3600, from);
+    TEST_ASSERT_EQUAL_UINT32(T0 + 14 * 3600 + 30, to);
+
+    TEST_ASSERT_TRUE(btsParseRange("2025-01-01,2025-01-02", from, to));  // Whole days
+    TEST_ASSERT_EQUAL_UINT32(T0, from);
+    TEST_ASSERT_EQUAL_UINT32(T0 + 2 * 86400 - 1, to);
+
+    TEST_ASSERT_TRUE(btsParseRange("2025-01-01T12:00", from, to));  // Open-ended
+    TEST_ASSERT_EQUAL_UINT32(T0 + 12 * 3600, from);
+    TEST_ASSERT_EQUAL_UINT32(0xFFFFFFFFu, to);
+
+    TEST_ASSERT_FALSE(btsParseRange("2025-01-02,2025-01-01 10:00", from, to));  // Backwards
+    TEST_ASSERT_FALSE(btsParseRange("2025-01-01 25:00", from, to));
+    TEST_ASSERT_FALSE(btsParseRange("2025-1-1", from, to));
+    TEST_ASSERT_FALSE(btsParseRange("2025-01-01,", from, to));
+    TEST_ASSERT_FALSE(btsParseRange("yesterday", from, to));
+}
+
+// Test: Index ranges return exactly the rows a full scan does
+void test_index_range() {
+    IndexedDay day;
+    writeIndexedDay(day);
+    TEST_ASSERT_EQUAL(BTS_INDEX_HEADER_SIZE + 288 * BTS_INDEX_ENTRY_SIZE, day.index.size());
+
+    uint32_t rng = 11;
+    for (int q = 0; q < 200; q++) {
+        rng = rng * 1664525u + 1013904223u;
+        uint32_t from = T0 - 600 + (rng >> 8) % 88000;
+        uint32_t to = from + (q % 4 == 0 ? 0 : (rng >> 4) % 20000);
+        if (q == 0) { from = T0 + 54000; to = T0 + 54000 + 40; }  // Around the clock step
+
+        std::vector<Decoded> got;
+        size_t read;
+        int probes;
+        queryRange(day, from, to, got, read, probes);
+
+        std::vector<Decoded> want;
+        for (size_t i = 0; i < day.samples.size(); i++) {
+            if (day.samples[i].time >= from && day.samples[i].time <= to) want.push_back(day.samples[i]);
+        }
+        TEST_ASSERT_EQUAL(want.size(), got.size());
+        for (size_t i = 0; i < got.size(); i++) {
+            TEST_ASSERT_EQUAL_UINT32(want[i].time, got[i].time);
+            TEST_ASSERT_EQUAL_UINT32(want[i].fields[0], got[i].fields[0]);
+        }
+        TEST_ASSERT_TRUE(probes <= 2 * 9 + 2);  // Two binary searches over 288 entries
+    }
+
+    // Ranges outside the day read nothing
+    std::vector<Decoded> none;
+    size_t read;
+    int probes;
+    queryRange(day, T0 - 7200, T0 - 3600, none, read, probes);
+    TEST_ASSERT_EQUAL(0, read);
+    queryRange(day, T0 + 2 * 86400, T0 + 3 * 86400, none, read, probes);
+    TEST_ASSERT_TRUE(read < 128);  // At most the last block
+    TEST_ASSERT_EQUAL(0, none.size());
+
+    // An index that points past its file is not trusted
+    size_t start, end;
+    TEST_ASSERT_FALSE(btsIndexRange(T0, 1, 100, T0, T0 + 60,
+        [](size_t, uint32_t& time, uint32_t& offset) { time = 0; offset = 5000; return true; }, start, end));
+    TEST_ASSERT_EQUAL(BTS_HEADER_SIZE, start);
+    TEST_ASSERT_EQUAL(100, end);
+
+    uint8_t header[BTS_INDEX_HEADER_SIZE] = {'B', 'T', 'S', 'D'};
+    uint32_t base;
+    TEST_ASSERT_FALSE(btsReadIndexHeader(header, base));
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------
+
+// Test: A day of price samples: file size and SD operations vs per-sample CSV
+void test_benchmark() {
+    const uint32_t samples = 2880;   // One per 30s
+    const size_t bufferSize = 512;   // BTS_BLOCK_SIZE
+    const uint32_t flushSeconds = 300;  // DATA_FLUSH_INTERVAL
+
+    uint8_t header[BTS_HEADER_SIZE];
+    BtsEncoder encoder;
+    encoder.begin(BTS_PRICE, T0, header);
+
+    std::vector<uint8_t> file(header, header + BTS_HEADER_SIZE);
+    uint8_t buffer[bufferSize];
+    size_t bufferLen = 0;
+    uint32_t firstBuffered = 0;
+    int binaryWrites = 0;
+    size_t csvBytes = strlen("timestamp,price_usd,price_eur\r\n");
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < samples; i++) {
+        uint32_t t = T0 + i * 30;
+        float usd = 97000.0f + (float)(i % 500);
+        uint32_t fields[2] = {btsFixed(usd, 2), btsFixed(usd * 0.95f, 2)};
+
+        // SDLogger::appendSample: buffer, write when full or 5 minutes old
+        if (bufferLen + encoder.maxEncodedSize() > bufferSize) {
+            file.insert(file.end(), buffer, buffer + bufferLen);
+            bufferLen = 0;
+            binaryWrites++;
+        }
+        if (bufferLen == 0) firstBuffered = t;
+        bufferLen += encoder.encode(t, fields, buffer + bufferLen);
+        if (t - firstBuffered >= flushSeconds) {
+            file.insert(file.end(), buffer, buffer + bufferLen);
+            bufferLen = 0;
+            binaryWrites++;
+        }
+
+        // The old path: one row "YYYY-MM-DD HH:MM:SS.mmm,usd,eur\r\n" per sample
+        char row[96];
+        formatCsvTimestamp(t, row, sizeof(row));
+        size_t len = strlen(row);
+        csvBytes += len + snprintf(row + len, sizeof(row) - len, ".000,%.2f,%.2f\r\n", usd, usd * 0.95f);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    std::vector<Decoded> read;
+    decodeAll(file, read);
+    auto t2 = std::chrono::steady_clock::now();
+
+    // CSV: SD.exists, open, write, close for every sample
+    int csvOps = samples * 4;
+    double encodeNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / samples;
+    double decodeNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / read.size();
+
+    printf("\nDay of 30s prices: %zu bytes binary vs %zu CSV (%.1f vs %.1f bytes/sample), "
+           "%d SD writes vs %d SD calls, encode+CSV %.0f ns, decode %.0f ns per sample\n",
+           file.size(), csvBytes, (double)(file.size() - BTS_HEADER_SIZE) / samples,
+           (double)csvBytes / samples, binaryWrites, csvOps, encodeNs, decodeNs);
+
+    TEST_ASSERT_TRUE(file.size() * 3 < csvBytes);
+    TEST_ASSERT_TRUE(binaryWrites * 10 < (int)samples);
+    TEST_ASSERT_TRUE(binaryWrites * 40 < csvOps);
+}
+
+// Test: A four-hour export reads a sixth of the day instead of all of it
+void test_range_benchmark() {
+    IndexedDay day;
+    writeIndexedDay(day);
+
+    const int queries = 1000;
+    size_t indexedBytes = 0;
+    size_t rows = 0;
+    int probes = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int q = 0; q < queries; q++) {
+        std::vector<Decoded> got;
+        size_t read;
+        uint32_t from = T0 + 36000 + (q % 60) * 60;
+        queryRange(day, from, from + 4 * 3600, got, read, probes);
+        indexedBytes += read;
+        rows += got.size();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    // Without the index: the whole file, filtered
+    size_t scanRows = 0;
+    for (int q = 0; q < queries; q++) {
+        uint32_t from = T0 + 36000 + (q % 60) * 60;
+        BtsReader reader;
+        reader.begin(day.file.data());
+        reader.feed(day.file.data() + BTS_HEADER_SIZE, day.file.size() - BTS_HEADER_SIZE,
+                    [&](uint32_t time, const uint32_t*) {
+                        if (time >= from && time <= from + 4 * 3600) scanRows++;
+                    });
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double indexedUs = std::chrono::duration<double, std::micro>(t1 - t0).count() / queries;
+    double scanUs = std::chrono::duration<double, std::micro>(t2 - t1).count() / queries;
+    double fraction = (double)indexedBytes / queries / day.file.size();
+    printf("\n4h of a 30s price day: %.0f of %zu bytes read (%.0f%%), %d index probes, "
+           "%.1f us vs %.1f us full scan (%zu-byte index)\n",
+           (double)indexedBytes / queries, day.file.size(), fraction * 100, probes,
+           indexedUs, scanUs, day.index.size());
+
+    TEST_ASSERT_EQUAL(scanRows, rows);
+    TEST_ASSERT_TRUE(fraction < 0.2);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_header);
+    RUN_TEST(test_fixed_point);
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_time_marks);
+    RUN_TEST(test_csv_rows);
+    RUN_TEST(test_parse_range);
+    RUN_TEST(test_index_range);
+    RUN_TEST(test_benchmark);
+    RUN_TEST(test_range_benchmark);
+
+    return UNITY_END();
+}
@@ -0,0 +1,175 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "screens/CardModel.h"
+
+// MainScreen layout: 2 columns of 228x80 cards, 88px rows, content below a 29px header
+static const int CONTENT_Y = 29;
+static const int CONTENT_H = 291;
+
+static CardView card(int index, int scrollY, const char* value, uint32_t color = 0xF7931A, bool stale = false) {
+    CardView v;
+    int x = index % 2 == 0 ? 8 : 244;
+    int y = 35 - scrollY + (index / 2) * 88;
+    cardViewSet(v, x, y, 228, 80, "Title", value, color, stale);
+    return v;
+}
+
+static bool visible(const CardView& v) {
+    return v.y > -80 && v.y < 320;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// ========== Diffing ==========
+
+// Test: First frame paints everything, an identical frame paints nothing
+void test_first_and_unchanged_frames(void) {
+    CardModel model;
+    TEST_ASSERT_TRUE(model.beginFrame(0));
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(model.update(i, card(i, 0, "97000")));
+    }
+
+    TEST_ASSERT_FALSE(model.beginFrame(0));
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_FALSE(model.update(i, card(i, 0, "97000")));
+    }
+}
+
+// Test: Value, color, stale marker and title changes repaint only that card
+void test_changed_fields(void) {
+    CardModel model;
+    model.beginFrame(0);
+    for (int i = 0; i < 4; i++) model.update(i, card(i, 0, "1"));
+
+    model.beginFrame(0);
+    TEST_ASSERT_TRUE(model.update(0, card(0, 0, "2")));
+    TEST_ASSERT_FALSE(model.update(1, card(1, 0, "1")));
+    TEST_ASSERT_TRUE(model.update(2, card(2, 0, "1", 0x00FF00)));
+    TEST_ASSERT_TRUE(model.update(3, card(3, 0, "1", 0xF7931A, true)));
+
+    CardView titled = card(1, 0, "1");
+    strcpy(titled.title, "24h +1.0%");
+    TEST_ASSERT_TRUE(model.update(1, titled));
+
+    // Remembered: the same values again are skipped
+    model.beginFrame(0);
+    TEST_ASSERT_FALSE(model.update(0, card(0, 0, "2")));
+    TEST_ASSERT_FALSE(model.update(1, titled));
+}
+
+// Test: A new scroll offset or invalidate() forces a full frame
+void test_scroll_and_invalidate(void) {
+    CardModel model;
+    model.beginFrame(0);
+    model.update(0, card(0, 0, "1"));
+
+    TEST_ASSERT_TRUE(model.beginFrame(12));
+    TEST_ASSERT_FALSE(model.isValid(0));
+    TEST_ASSERT_TRUE(model.update(0, card(0, 12, "1")));
+
+    TEST_ASSERT_FALSE(model.beginFrame(12));
+    TEST_ASSERT_FALSE(model.update(0, card(0, 12, "1")));
+
+    model.invalidate();
+    TEST_ASSERT_TRUE(model.beginFrame(12));
+    TEST_ASSERT_TRUE(model.update(0, card(0, 12, "1")));
+
+    // Out-of-range slot is always painted, never stored
+    TEST_ASSERT_TRUE(model.update(CARD_MODEL_MAX_CARDS, card(0, 12, "1")));
+    TEST_ASSERT_TRUE(model.update(CARD_MODEL_MAX_CARDS, card(0, 12, "1")));
+}
+
+// Test: Long strings are truncated, not overflowed
+void test_truncation(void) {
+    CardView v;
+    char longValue[100];
+    memset(longValue, '9', sizeof(longValue) - 1);
+    longValue[sizeof(longValue) - 1] = '\0';
+    cardViewSet(v, 0, 0, 228, 80, longValue, longValue, 0, false);
+    TEST_ASSERT_EQUAL(CARD_TITLE_LEN - 1, strlen(v.title));
+    TEST_ASSERT_EQUAL(CARD_VALUE_LEN - 1, strlen(v.value));
+}
+
+// ========== Pixel Accounting ==========
+
+// Test: Clipped area of cards partly above, inside and below the content area
+void test_clipped_area(void) {
+    TEST_ASSERT_EQUAL_UINT32(228 * 80, clippedArea(8, 35, 228, 80, 0, CONTENT_Y, 480, CONTENT_H));
+    TEST_ASSERT_EQUAL_UINT32(228 * 51, clippedArea(8, 0, 228, 80, 0, CONTENT_Y, 480, CONTENT_H));
+    TEST_ASSERT_EQUAL_UINT32(228 * 20, clippedArea(8, 300, 228, 80, 0, CONTENT_Y, 480, CONTENT_H));
+    TEST_ASSERT_EQUAL_UINT32(0, clippedArea(8, -100, 228, 80, 0, CONTENT_Y, 480, CONTENT_H));
+    TEST_ASSERT_EQUAL_UINT32(0, clippedArea(8, 320, 228, 80, 0, CONTENT_Y, 480, CONTENT_H));
+    TEST_ASSERT_EQUAL_UINT32(12 * 80, clippedArea(468, 35, 228, 80, 0, CONTENT_Y, 480, CONTENT_H));
+}
+
+// ========== Benchmark ==========
+
+// Test: Pixels pushed over an hour of data ticks, against clearing and redrawing every frame
+void test_pixel_savings(void) {
+    CardModel model;
+    RenderStats stats;
+    memset(&stats, 0, sizeof(stats));
+    const uint32_t headerPixels = 480 * 29;
+
+    // One frame per data tick; price moves every tick, the rest now and then
+    char values[CARD_MODEL_MAX_CARDS][CARD_VALUE_LEN];
+    for (int i = 0; i < CARD_MODEL_MAX_CARDS; i++) strcpy(values[i], "0");
+    int scrollY = 0;
+    for (int tick = 0; tick < 240; tick++) {
+        snprintf(values[0], CARD_VALUE_LEN, "$%d", 97000 + tick % 7);       // Price
+        if (tick % 10 == 0) snprintf(values[1], CARD_VALUE_LEN, "+$%d", tick);  // 24h change
+        if (tick % 40 == 0) snprintf(values[2], CARD_VALUE_LEN, "%d", 875000 + tick / 40);  // Block
+        if (tick % 2 == 0) snprintf(values[3], CARD_VALUE_LEN, "%d TX", 30000 + tick);   // Mempool
+        if (tick == 120) scrollY = 88;  // One scroll step mid-way
+
+        bool full = model.beginFrame(scrollY);
+        uint32_t pixels = full ? 480 * CONTENT_H : 0;
+        stats.fullRedrawPixels += 480 * CONTENT_H + headerPixels;
+        if (full) stats.fullFrames++;
+        if (tick % 120 == 0) pixels += headerPixels;  // Uptime text changes each minute
+
+        for (int i = 0; i < CARD_MODEL_MAX_CARDS; i++) {
+            CardView v = card(i, scrollY, values[i]);
+            if (!visible(v)) continue;
+            uint32_t area = clippedArea(v.x, v.y, v.w, v.h, 0, CONTENT_Y, 480, CONTENT_H);
+            stats.fullRedrawPixels += area;
+            if (model.update(i, v)) {
+                pixels += area;
+                stats.cardsDrawn++;
+            } else {
+                stats.cardsSkipped++;
+            }
+        }
+        stats.frames++;
+        stats.pixels += pixels;
+    }
+
+    double saved = 100.0 * (1.0 - (double)stats.pixels / stats.fullRedrawPixels);
+    printf("Pixels/frame: %llu dirty-region vs %llu full redraw (%.0f%% saved), %u cards drawn, %u skipped\n",
+           (unsigned long long)(stats.pixels / stats.frames),
+           (unsigned long long)(stats.fullRedrawPixels / stats.frames), saved,
+           stats.cardsDrawn, stats.cardsSkipped);
+
+    TEST_ASSERT_EQUAL_UINT32(2, stats.fullFrames);
+    TEST_ASSERT_TRUE(stats.cardsSkipped > stats.cardsDrawn);
+    TEST_ASSERT_TRUE(stats.pixels * 4 < stats.fullRedrawPixels);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_first_and_unchanged_frames);
+    RUN_TEST(test_changed_fields);
+    RUN_TEST(test_scroll_and_invalidate);
+    RUN_TEST(test_truncation);
+    RUN_TEST(test_clipped_area);
+    RUN_TEST(test_pixel_savings);
+
+    return UNITY_END();
+}
@@ -0,0 +1,184 @@
+#include <unity.h>
+#include "network/CircuitBreaker.h"
+
+// Settings used by EndpointHealth (network/EndpointHealth.h)
+#define THRESHOLD 3
+#define OPEN_MS 30000
+#define MAX_OPEN_MS 600000
+#define PROBE_TIMEOUT_MS 60000
+
+static CircuitBreaker makeBreaker() {
+    return CircuitBreaker(THRESHOLD, OPEN_MS, MAX_OPEN_MS, PROBE_TIMEOUT_MS, 42);
+}
+
+// Fail allowed requests until the circuit opens
+static void tripOpen(CircuitBreaker& b, uint32_t now) {
+    for (int i = 0; i < THRESHOLD; i++) {
+        TEST_ASSERT_TRUE(b.allowRequest(now));
+        b.recordFailure(10000, now);
+    }
+}
+
+// Test: Closed circuit allows requests and counts outcomes
+void test_closed_counts_results() {
+    CircuitBreaker b = makeBreaker();
+
+    TEST_ASSERT_TRUE(b.allowRequest(0));
+    b.recordSuccess(200);
+    TEST_ASSERT_TRUE(b.allowRequest(100));
+    b.recordSuccess(400);
+
+    TEST_ASSERT_EQUAL_INT(CIRCUIT_CLOSED, b.getState());
+    TEST_ASSERT_EQUAL_UINT32(2, b.getStats().successes);
+    TEST_ASSERT_EQUAL_UINT32(0, b.getStats().failures);
+    TEST_ASSERT_EQUAL_UINT32(300, b.getAverageLatency());
+    TEST_ASSERT_EQUAL_UINT32(400, b.getStats().maxLatencyMs);
+}
+
+// Test: A success resets the consecutive failure count
+void test_success_resets_failures() {
+    CircuitBreaker b = makeBreaker();
+
+    b.recordFailure(100, 0);
+    b.recordFailure(100, 0);
+    b.recordSuccess(100);
+    b.recordFailure(100, 0);
+    b.recordFailure(100, 0);
+
+    TEST_ASSERT_EQUAL_INT(CIRCUIT_CLOSED, b.getState());
+    TEST_ASSERT_EQUAL_UINT8(2, b.getConsecutiveFailures());
+}
+
+// Test: Threshold consecutive failures open the circuit and reject requests
+void test_opens_after_threshold() {
+    CircuitBreaker b = makeBreaker();
+    tripOpen(b, 1000);
+
+    TEST_ASSERT_EQUAL_INT(CIRCUIT_OPEN, b.getState());
+    TEST_ASSERT_EQUAL_UINT32(1, b.getStats().opens);
+    TEST_ASSERT_FALSE(b.allowRequest(2000));
+    TEST_ASSERT_FALSE(b.allowRequest(3000));
+    TEST_ASSERT_EQUAL_UINT32(2, b.getStats().rejected);
+
+    // Open period is the first backoff step, pulled down by at most 25% jitter
+    uint32_t retry = b.msUntilRetry(1000);
+    TEST_ASSERT_TRUE(retry >= OPEN_MS * 3 / 4 && retry <= OPEN_MS);
+}
+
+// Test: After the backoff exactly one probe is allowed (half-open)
+void test_half_open_single_probe() {
+    CircuitBreaker b = makeBreaker();
+    tripOpen(b, 0);
+
+    uint32_t now = OPEN_MS;
+    TEST_ASSERT_TRUE(b.allowRequest(now));
+    TEST_ASSERT_EQUAL_INT(CIRCUIT_HALF_OPEN, b.getState());
+    TEST_ASSERT_FALSE(b.allowRequest(now + 10));
+
+    b.recordSuccess(300);
+    TEST_ASSERT_EQUAL_INT(CIRCUIT_CLOSED, b.getState());
+    TEST_ASSERT_TRUE(b.allowRequest(now + 20));
+}
+
+// Test: A failed probe reopens with a longer delay, capped at the maximum
+void test_failed_probe_backs_off() {
+    CircuitBreaker b = makeBreaker();
+    uint32_t now = 0;
+    tripOpen(b, now);
+
+    uint32_t previousMax = OPEN_MS;
+    for (int i = 0; i < 8; i++) {
+        now += b.msUntilRetry(now);
+        TEST_ASSERT_TRUE(b.allowRequest(now));
+        b.recordFailure(10000, now);
+        TEST_ASSERT_EQUAL_INT(CIRCUIT_OPEN, b.getState());
+
+        uint32_t retry = b.msUntilRetry(now);
+        uint32_t expectedMax = previousMax * 2 < MAX_OPEN_MS ? previousMax * 2 : MAX_OPEN_MS;
+        TEST_ASSERT_TRUE(retry <= expectedMax);
+        TEST_ASSERT_TRUE(retry >= expectedMax * 3 / 4);
+        previousMax = expectedMax;
+    }
+    TEST_ASSERT_EQUAL_UINT32(9, b.getStats().opens);
+}
+
+// Test: Recovery resets the backoff to the first step
+void test_recovery_resets_backoff() {
+    CircuitBreaker b = makeBreaker();
+    uint32_t now = 0;
+    tripOpen(b, now);
+
+    // Two failed probes push the delay up
+    for (int i = 0; i < 2; i++) {
+        now += b.msUntilRetry(now);
+        b.allowRequest(now);
+        b.recordFailure(10000, now);
+    }
+
+    now += b.msUntilRetry(now);
+    b.allowRequest(now);
+    b.recordSuccess(200);
+
+    tripOpen(b, now);
+    TEST_ASSERT_TRUE(b.msUntilRetry(now) <= OPEN_MS);
+}
+
+// Test: A probe that never reports back does not wedge the circuit
+void test_lost_probe_times_out() {
+    CircuitBreaker b = makeBreaker();
+    tripOpen(b, 0);
+
+    uint32_t now = OPEN_MS;
+    TEST_ASSERT_TRUE(b.allowRequest(now));
+    TEST_ASSERT_FALSE(b.allowRequest(now + PROBE_TIMEOUT_MS - 1));
+    TEST_ASSERT_TRUE(b.allowRequest(now + PROBE_TIMEOUT_MS));
+}
+
+// Test: Late failures from requests started before the trip don't extend it
+void test_late_failure_keeps_retry_time() {
+    CircuitBreaker b = makeBreaker();
+    tripOpen(b, 0);
+
+    uint32_t retry = b.msUntilRetry(0);
+    b.recordFailure(10000, 5000);
+    TEST_ASSERT_EQUAL_UINT32(retry - 5000, b.msUntilRetry(5000));
+    TEST_ASSERT_EQUAL_UINT32(1, b.getStats().opens);
+}
+
+// Test: Open circuit survives millis() wraparound
+void test_millis_wraparound() {
+    CircuitBreaker b = makeBreaker();
+    uint32_t now = 0xFFFFFFFF - 5000;
+    tripOpen(b, now);
+
+    TEST_ASSERT_FALSE(b.allowRequest(now + 10000));  // Wrapped, still open
+    TEST_ASSERT_TRUE(b.allowRequest(now + OPEN_MS)); // Wrapped, probe allowed
+}
+
+// Test: State names
+void test_state_names() {
+    TEST_ASSERT_EQUAL_STRING("closed", CircuitBreaker::stateName(CIRCUIT_CLOSED));
+    TEST_ASSERT_EQUAL_STRING("open", CircuitBreaker::stateName(CIRCUIT_OPEN));
+    TEST_ASSERT_EQUAL_STRING("half-open", CircuitBreaker::stateName(CIRCUIT_HALF_OPEN));
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_closed_counts_results);
+    RUN_TEST(test_success_resets_failures);
+    RUN_TEST(test_opens_after_threshold);
+    RUN_TEST(test_half_open_single_probe);
+    RUN_TEST(test_failed_probe_backs_off);
+    RUN_TEST(test_recovery_resets_backoff);
+    RUN_TEST(test_lost_probe_times_out);
+    RUN_TEST(test_late_failure_keeps_retry_time);
+    RUN_TEST(test_millis_wraparound);
+    RUN_TEST(test_state_names);
+
+    return UNITY_END();
+}
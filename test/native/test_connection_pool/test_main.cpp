@@ -0,0 +1,138 @@
+#include <unity.h>
+#include "network/ConnectionSlots.h"
+
+// Test: Host extraction from URLs
+void test_parse_url_host() {
+    char host[POOL_HOST_MAX_LEN];
+
+    TEST_ASSERT_TRUE(parseUrlHost("https://mempool.space/api/v1/prices", host, sizeof(host)));
+    TEST_ASSERT_EQUAL_STRING("mempool.space", host);
+
+    TEST_ASSERT_TRUE(parseUrlHost("https://192.168.1.10:8443/api/mempool", host, sizeof(host)));
+    TEST_ASSERT_EQUAL_STRING("192.168.1.10:8443", host);
+
+    TEST_ASSERT_TRUE(parseUrlHost("https://example.com?x=1", host, sizeof(host)));
+    TEST_ASSERT_EQUAL_STRING("example.com", host);
+}
+
+// Test: Invalid URLs are rejected
+void test_parse_url_host_invalid() {
+    char host[8];
+
+    TEST_ASSERT_FALSE(parseUrlHost("mempool.space/api", host, sizeof(host)));
+    TEST_ASSERT_FALSE(parseUrlHost("https:///api", host, sizeof(host)));
+    TEST_ASSERT_FALSE(parseUrlHost("https://a-very-long-host.example/", host, sizeof(host)));
+    TEST_ASSERT_FALSE(parseUrlHost(nullptr, host, sizeof(host)));
+}
+
+// Test: Same host always gets the same slot
+void test_same_host_reuses_slot() {
+    ConnectionSlotTable<2> table;
+    bool evicted;
+
+    int a = table.acquire("mempool.space", 0, evicted);
+    int b = table.acquire("mempool.space", 1000, evicted);
+
+    TEST_ASSERT_EQUAL_INT(a, b);
+    TEST_ASSERT_FALSE(evicted);
+    TEST_ASSERT_EQUAL_INT(a, table.find("mempool.space"));
+}
+
+// Test: Different hosts get different slots while capacity allows
+void test_distinct_hosts_distinct_slots() {
+    ConnectionSlotTable<2> table;
+    bool evicted;
+
+    int a = table.acquire("mempool.space", 0, evicted);
+    int b = table.acquire("generativelanguage.googleapis.com", 0, evicted);
+
+    TEST_ASSERT_NOT_EQUAL(a, b);
+    TEST_ASSERT_FALSE(evicted);
+    TEST_ASSERT_EQUAL_UINT32(0, table.getEvictions());
+}
+
+// Test: Least recently used host is evicted when the table is full
+void test_lru_eviction() {
+    ConnectionSlotTable<2> table;
+    bool evicted;
+
+    int a = table.acquire("a.example", 0, evicted);
+    table.acquire("b.example", 100, evicted);
+    table.acquire("a.example", 200, evicted);  // a is now most recent
+
+    int c = table.acquire("c.example", 300, evicted);
+
+    TEST_ASSERT_TRUE(evicted);
+    TEST_ASSERT_NOT_EQUAL(a, c);
+    TEST_ASSERT_EQUAL_INT(-1, table.find("b.example"));
+    TEST_ASSERT_EQUAL_INT(a, table.find("a.example"));
+    TEST_ASSERT_EQUAL_UINT32(1, table.getEvictions());
+}
+
+// Test: One fetch cycle costs one handshake, the rest are reused
+void test_handshake_counters() {
+    ConnectionSlotTable<2> table;
+    bool evicted;
+
+    // 30s cycle: prices, tip/height, fees/recommended, mempool
+    int slot = table.acquire("mempool.space", 0, evicted);
+    table.record(slot, true, true, 900);
+    table.record(slot, false, true, 120);
+    table.record(slot, false, true, 110);
+    table.record(slot, false, false, 170);
+
+    const HostStats& s = table.getStats(slot);
+    TEST_ASSERT_EQUAL_UINT32(4, s.requests);
+    TEST_ASSERT_EQUAL_UINT32(1, s.handshakes);
+    TEST_ASSERT_EQUAL_UINT32(3, s.reused());
+    TEST_ASSERT_EQUAL_UINT32(1, s.failures);
+    TEST_ASSERT_EQUAL_UINT32(170, s.lastLatencyMs);
+    TEST_ASSERT_EQUAL_UINT32(900, s.maxLatencyMs);
+    TEST_ASSERT_EQUAL_UINT32(325, s.averageLatencyMs());
+}
+
+// Test: Stats start fresh when a slot is given to another host
+void test_stats_reset_on_eviction() {
+    ConnectionSlotTable<1> table;
+    bool evicted;
+
+    int slot = table.acquire("a.example", 0, evicted);
+    table.record(slot, true, true, 500);
+
+    slot = table.acquire("b.example", 100, evicted);
+    TEST_ASSERT_TRUE(evicted);
+    TEST_ASSERT_EQUAL_UINT32(0, table.getStats(slot).requests);
+    TEST_ASSERT_EQUAL_STRING("b.example", table.host(slot));
+}
+
+// Test: Idle detection, including millis() wrap-around
+void test_idle_detection() {
+    ConnectionSlotTable<2> table;
+    bool evicted;
+
+    uint32_t start = 0xFFFFFFFFUL - 1000;
+    int slot = table.acquire("mempool.space", start, evicted);
+
+    TEST_ASSERT_FALSE(table.isIdle(slot, start + 30000, 50000));
+    TEST_ASSERT_TRUE(table.isIdle(slot, start + 60000, 50000));
+    TEST_ASSERT_FALSE(table.isIdle(1, start + 60000, 50000));  // Unused slot
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_parse_url_host);
+    RUN_TEST(test_parse_url_host_invalid);
+    RUN_TEST(test_same_host_reuses_slot);
+    RUN_TEST(test_distinct_hosts_distinct_slots);
+    RUN_TEST(test_lru_eviction);
+    RUN_TEST(test_handshake_counters);
+    RUN_TEST(test_stats_reset_on_eviction);
+    RUN_TEST(test_idle_detection);
+
+    return UNITY_END();
+}
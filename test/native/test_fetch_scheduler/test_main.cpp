@@ -0,0 +1,329 @@
+#include <unity.h>
+#include "network/FetchScheduler.h"
+
+// Intervals used by the fetch worker (network/FetchWorker.h)
+#define MARKET_INTERVAL 30000
+#define AI_INTERVAL 300000
+
+static void configureDefaults(FetchScheduler& s) {
+    s.setInterval(FETCH_PRICE, MARKET_INTERVAL);
+    s.setInterval(FETCH_BLOCK, MARKET_INTERVAL);
+    s.setInterval(FETCH_MEMPOOL, MARKET_INTERVAL);
+    s.setInterval(FETCH_AI_SIGNALS, AI_INTERVAL);
+}
+
+// Run one job to completion taking durationMs, return the job that ran
+static FetchJob runNext(FetchScheduler& s, uint32_t& now, uint32_t durationMs, bool success = true) {
+    FetchJob job = s.nextDue(now);
+    if (job == FETCH_JOB_COUNT) return job;
+    s.markStarted(job, now);
+    now += durationMs;
+    s.markFinished(job, success, now);
+    return job;
+}
+
+// Test: Nothing is due until requested
+void test_nothing_due_before_first_interval() {
+    FetchScheduler s;
+    configureDefaults(s);
+
+    // All jobs start due at t=0; advance past them
+    uint32_t now = 0;
+    for (int i = 0; i < FETCH_JOB_COUNT; i++) {
+        runNext(s, now, 10);
+    }
+
+    TEST_ASSERT_EQUAL_INT(FETCH_JOB_COUNT, s.nextDue(now));
+}
+
+// Test: Initial refresh runs jobs in price -> block -> mempool -> AI order
+void test_initial_refresh_order() {
+    FetchScheduler s;
+    configureDefaults(s);
+
+    uint32_t now = 1000;
+    s.requestAll(now);
+
+    TEST_ASSERT_EQUAL_INT(FETCH_PRICE, runNext(s, now, 300));
+    TEST_ASSERT_EQUAL_INT(FETCH_BLOCK, runNext(s, now, 300));
+    TEST_ASSERT_EQUAL_INT(FETCH_MEMPOOL, runNext(s, now, 300));
+    TEST_ASSERT_EQUAL_INT(FETCH_AI_SIGNALS, runNext(s, now, 3000));
+    TEST_ASSERT_EQUAL_INT(FETCH_JOB_COUNT, s.nextDue(now));
+}
+
+// Test: Most overdue job runs first
+void test_most_overdue_runs_first() {
+    FetchScheduler s;
+    configureDefaults(s);
+
+    s.requestNow(FETCH_PRICE, 5000);
+    s.requestNow(FETCH_BLOCK, 5000);
+    s.requestNow(FETCH_MEMPOOL, 2000);  // Due earliest
+    s.requestNow(FETCH_AI_SIGNALS, 9000);
+
+    TEST_ASSERT_EQUAL_INT(FETCH_MEMPOOL, s.nextDue(6000));
+}
+
+// Test: A running job is never handed out twice
+void test_running_job_not_rescheduled() {
+    FetchScheduler s;
+    configureDefaults(s);
+    s.setInterval(FETCH_BLOCK, 0);
+    s.setInterval(FETCH_MEMPOOL, 0);
+    s.setInterval(FETCH_AI_SIGNALS, 0);
+
+    s.requestNow(FETCH_PRICE, 0);
+    s.markStarted(FETCH_PRICE, 0);
+
+    TEST_ASSERT_TRUE(s.isRunning(FETCH_PRICE));
+    TEST_ASSERT_EQUAL_INT(FETCH_JOB_COUNT, s.nextDue(100000));
+}
+
+// Test: Next run is anchored to start time (no drift from latency)
+void test_next_run_anchored_to_start() {
+    FetchScheduler s;
+    configureDefaults(s);
+
+    s.requestNow(FETCH_PRICE, 0);
+    s.markStarted(FETCH_PRICE, 0);
+    s.markFinished(FETCH_PRICE, true, 2500);
+
+    TEST_ASSERT_EQUAL_UINT32(MARKET_INTERVAL, s.getNextDue(FETCH_PRICE));
+}
+
+// Test: A run longer than its interval is rescheduled immediately, not in the past
+void test_slow_run_not_scheduled_in_past() {
+    FetchScheduler s;
+    s.setInterval(FETCH_PRICE, 1000);
+
+    s.requestNow(FETCH_PRICE, 0);
+    s.markStarted(FETCH_PRICE, 0);
+    s.markFinished(FETCH_PRICE, false, 5000);
+
+    TEST_ASSERT_EQUAL_UINT32(5000, s.getNextDue(FETCH_PRICE));
+    TEST_ASSERT_EQUAL_INT(FETCH_PRICE, s.nextDue(5000));
+}
+
+// Test: Latency statistics
+void test_latency_stats() {
+    FetchScheduler s;
+    s.setInterval(FETCH_PRICE, MARKET_INTERVAL);
+
+    uint32_t now = 0;
+    s.requestNow(FETCH_PRICE, now);
+    runNext(s, now, 200);
+    now = s.getNextDue(FETCH_PRICE);
+    runNext(s, now, 600, false);
+
+    const FetchJobStats& stats = s.getStats(FETCH_PRICE);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.runs);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.failures);
+    TEST_ASSERT_EQUAL_UINT32(600, stats.lastLatencyMs);
+    TEST_ASSERT_EQUAL_UINT32(600, stats.maxLatencyMs);
+    TEST_ASSERT_EQUAL_UINT32(400, s.getAverageLatency(FETCH_PRICE));
+}
+
+// Test: Start delay measures how long a job waited behind others
+void test_start_delay_recorded() {
+    FetchScheduler s;
+    configureDefaults(s);
+
+    uint32_t now = 0;
+    s.requestAll(now);
+    runNext(s, now, 10000);  // Price blocks for 10s
+    runNext(s, now, 100);    // Block starts 10s late
+
+    TEST_ASSERT_EQUAL_UINT32(10000, s.getStats(FETCH_BLOCK).lastStartDelayMs);
+    TEST_ASSERT_EQUAL_UINT32(0, s.getStats(FETCH_PRICE).lastStartDelayMs);
+}
+
+// Test: Wait time until the next job
+void test_ms_until_next() {
+    FetchScheduler s;
+    configureDefaults(s);
+
+    uint32_t now = 0;
+    s.requestAll(now);
+    for (int i = 0; i < FETCH_JOB_COUNT; i++) {
+        runNext(s, now, 0);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(MARKET_INTERVAL, s.msUntilNext(0));
+    TEST_ASSERT_EQUAL_UINT32(1000, s.msUntilNext(MARKET_INTERVAL - 1000));
+    TEST_ASSERT_EQUAL_UINT32(0, s.msUntilNext(MARKET_INTERVAL + 50));
+}
+
+// Test: Scheduling survives millis() wrap-around
+void test_millis_wraparound() {
+    FetchScheduler s;
+    s.setInterval(FETCH_PRICE, MARKET_INTERVAL);
+
+    uint32_t now = 0xFFFFFFFFUL - 10000;
+    s.requestNow(FETCH_PRICE, now);
+    runNext(s, now, 0);
+
+    // Not due 20s later (wrapped), due 30s later
+    TEST_ASSERT_EQUAL_INT(FETCH_JOB_COUNT, s.nextDue(now + 20000));
+    TEST_ASSERT_EQUAL_INT(FETCH_PRICE, s.nextDue(now + MARKET_INTERVAL));
+}
+
+// Test: AI job runs once per 5 minutes while market jobs run every 30s
+void test_ai_runs_less_often() {
+    FetchScheduler s;
+    configureDefaults(s);
+
+    uint32_t now = 0;
+    s.requestAll(now);
+    int aiRuns = 0;
+    int priceRuns = 0;
+
+    // Simulate 10 minutes with 1s ticks
+    while (now < 600000) {
+        FetchJob job = runNext(s, now, 500);
+        if (job == FETCH_AI_SIGNALS) aiRuns++;
+        if (job == FETCH_PRICE) priceRuns++;
+        if (job == FETCH_JOB_COUNT) now += 1000;
+    }
+
+    TEST_ASSERT_EQUAL_INT(2, aiRuns);
+    TEST_ASSERT_EQUAL_INT(20, priceRuns);
+}
+
+// Test: Disabled jobs never become due
+void test_disabled_job_skipped() {
+    FetchScheduler s;
+    s.setInterval(FETCH_AI_SIGNALS, 0);
+
+    s.requestAll(0);
+    TEST_ASSERT_EQUAL_INT(FETCH_JOB_COUNT, s.nextDue(1000000));
+}
+
+// Run one job to completion, reporting whether its value changed
+static void runChanged(FetchScheduler& s, FetchJob job, uint32_t& now, bool changed) {
+    now = s.getNextDue(job);
+    s.markStarted(job, now);
+    now += 100;
+    s.markFinished(job, true, now, changed);
+}
+
+// Test: Stable values back off by 50% per run, capped at slowFactor x base
+void test_adaptive_backoff_when_stable() {
+    FetchScheduler s;
+    s.setInterval(FETCH_PRICE, MARKET_INTERVAL);
+    s.setAdaptive(FETCH_PRICE, 100, 4);
+
+    uint32_t now = 0;
+    runChanged(s, FETCH_PRICE, now, false);
+    TEST_ASSERT_EQUAL_UINT32(45000, s.getCurrentInterval(FETCH_PRICE));
+    TEST_ASSERT_EQUAL_UINT32(45000, s.getNextDue(FETCH_PRICE));
+
+    for (int i = 0; i < 10; i++) {
+        runChanged(s, FETCH_PRICE, now, false);
+    }
+    TEST_ASSERT_EQUAL_UINT32(4 * MARKET_INTERVAL, s.getCurrentInterval(FETCH_PRICE));
+
+    // A change snaps back to the configured interval
+    runChanged(s, FETCH_PRICE, now, true);
+    TEST_ASSERT_EQUAL_UINT32(MARKET_INTERVAL, s.getCurrentInterval(FETCH_PRICE));
+    TEST_ASSERT_EQUAL_UINT32(MARKET_INTERVAL, s.getInterval(FETCH_PRICE));
+}
+
+// Test: New block polls the tip faster, never below the minimum interval
+void test_adaptive_fast_after_change() {
+    FetchScheduler s;
+    s.setInterval(FETCH_BLOCK, 60000);
+    s.setAdaptive(FETCH_BLOCK, 25, 4);
+
+    uint32_t now = 0;
+    runChanged(s, FETCH_BLOCK, now, true);
+    TEST_ASSERT_EQUAL_UINT32(15000, s.getCurrentInterval(FETCH_BLOCK));
+    TEST_ASSERT_EQUAL_UINT32(15000, s.getNextDue(FETCH_BLOCK));
+
+    // Then backs off again while the tip is unchanged
+    runChanged(s, FETCH_BLOCK, now, false);
+    TEST_ASSERT_EQUAL_UINT32(22500, s.getCurrentInterval(FETCH_BLOCK));
+
+    // 25% of 10s would be 2.5s: clamped to FETCH_MIN_INTERVAL_MS
+    s.setInterval(FETCH_BLOCK, 10000);
+    s.setAdaptive(FETCH_BLOCK, 25, 4);
+    runChanged(s, FETCH_BLOCK, now, true);
+    TEST_ASSERT_EQUAL_UINT32(FETCH_MIN_INTERVAL_MS, s.getCurrentInterval(FETCH_BLOCK));
+}
+
+// Test: Failures and non-adaptive jobs keep their cadence
+void test_adaptive_ignores_failures() {
+    FetchScheduler s;
+    configureDefaults(s);
+    s.setAdaptive(FETCH_PRICE, 100, 4);
+
+    uint32_t now = 0;
+    s.markStarted(FETCH_PRICE, now);
+    s.markFinished(FETCH_PRICE, false, now + 100, false);
+    TEST_ASSERT_EQUAL_UINT32(MARKET_INTERVAL, s.getCurrentInterval(FETCH_PRICE));
+
+    runChanged(s, FETCH_AI_SIGNALS, now, false);
+    TEST_ASSERT_EQUAL_UINT32(AI_INTERVAL, s.getCurrentInterval(FETCH_AI_SIGNALS));
+
+    // setInterval (e.g. WebSocket fallback) resets adaptation
+    runChanged(s, FETCH_PRICE, now, false);
+    s.setInterval(FETCH_PRICE, MARKET_INTERVAL);
+    TEST_ASSERT_EQUAL_UINT32(MARKET_INTERVAL, s.getCurrentInterval(FETCH_PRICE));
+}
+
+// Test: Jitter stays within +/- percent and separates equal intervals
+void test_jitter_spreads_reschedules() {
+    FetchScheduler s;
+    configureDefaults(s);
+    s.setJitter(10, 12345);
+
+    uint32_t now = 0;
+    bool spread = false;
+    for (int round = 0; round < 20; round++) {
+        s.requestAll(now);
+        for (int i = 0; i < FETCH_MEMPOOL + 1; i++) {
+            FetchJob job = (FetchJob)i;
+            s.markStarted(job, now);
+            s.markFinished(job, true, now);
+            int32_t offset = (int32_t)(s.getNextDue(job) - now) - MARKET_INTERVAL;
+            TEST_ASSERT_TRUE(offset >= -3000 && offset <= 3000);
+        }
+        if (s.getNextDue(FETCH_PRICE) != s.getNextDue(FETCH_BLOCK)) spread = true;
+        now += 1000;
+    }
+    TEST_ASSERT_TRUE(spread);
+}
+
+// Test: Job names
+void test_job_names() {
+    TEST_ASSERT_EQUAL_STRING("price", FetchScheduler::jobName(FETCH_PRICE));
+    TEST_ASSERT_EQUAL_STRING("ai", FetchScheduler::jobName(FETCH_AI_SIGNALS));
+    TEST_ASSERT_EQUAL_STRING("unknown", FetchScheduler::jobName(FETCH_JOB_COUNT));
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_nothing_due_before_first_interval);
+    RUN_TEST(test_initial_refresh_order);
+    RUN_TEST(test_most_overdue_runs_first);
+    RUN_TEST(test_running_job_not_rescheduled);
+    RUN_TEST(test_next_run_anchored_to_start);
+    RUN_TEST(test_slow_run_not_scheduled_in_past);
+    RUN_TEST(test_latency_stats);
+    RUN_TEST(test_start_delay_recorded);
+    RUN_TEST(test_ms_until_next);
+    RUN_TEST(test_millis_wraparound);
+    RUN_TEST(test_ai_runs_less_often);
+    RUN_TEST(test_disabled_job_skipped);
+    RUN_TEST(test_adaptive_backoff_when_stable);
+    RUN_TEST(test_adaptive_fast_after_change);
+    RUN_TEST(test_adaptive_ignores_failures);
+    RUN_TEST(test_jitter_spreads_reschedules);
+    RUN_TEST(test_job_names);
+
+    return UNITY_END();
+}
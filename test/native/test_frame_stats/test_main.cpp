@@ -0,0 +1,93 @@
+#include <unity.h>
+#include <stdio.h>
+#include "screens/FrameStats.h"
+
+static const uint32_t CONTENT_BYTES = 480 * 291 * 2;  // Full content area, RGB565
+static const uint32_t CARD_BYTES = 228 * 80 * 2;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// ========== Frame Times ==========
+
+// Test: Averages and maxima of compose time, DMA wait and bytes per frame
+void test_frame_times(void) {
+    FrameStats stats;
+    TEST_ASSERT_EQUAL_UINT32(0, stats.avgComposeUs());
+    TEST_ASSERT_EQUAL_UINT32(0, stats.avgBytes());
+
+    stats.record(1000000, 4000, 0, CARD_BYTES);
+    stats.record(6000000, 6000, 300, CARD_BYTES * 3);
+    stats.record(11000000, 2000, 0, 0);
+
+    TEST_ASSERT_EQUAL_UINT32(3, stats.frameCount());
+    TEST_ASSERT_EQUAL_UINT32(4000, stats.avgComposeUs());
+    TEST_ASSERT_EQUAL_UINT32(6000, stats.maxComposeUs());
+    TEST_ASSERT_EQUAL_UINT32(100, stats.avgWaitUs());
+    TEST_ASSERT_EQUAL_UINT32(300, stats.maxWaitUs());
+    TEST_ASSERT_EQUAL_UINT32(CARD_BYTES * 4 / 3, stats.avgBytes());
+
+    stats.clear();
+    TEST_ASSERT_EQUAL_UINT32(0, stats.frameCount());
+    TEST_ASSERT_EQUAL_UINT32(0, stats.maxComposeUs());
+}
+
+// Test: Transfer time follows the bus rate
+void test_transfer_time(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, FrameStats::transferUs(0));
+    TEST_ASSERT_EQUAL_UINT32(1000000, FrameStats::transferUs(FRAME_BUS_BYTES_PER_SEC));
+    // Full content area at 20 MB/s: ~14ms, so a full push per frame caps scrolling near 70 fps
+    TEST_ASSERT_UINT32_WITHIN(100, 13968, FrameStats::transferUs(CONTENT_BYTES));
+}
+
+// ========== Bursts ==========
+
+// Test: Data ticks seconds apart are not a burst: no fps or bus load reported
+void test_ticks_are_not_bursts(void) {
+    FrameStats stats;
+    for (uint32_t i = 0; i < 10; i++) {
+        stats.record(i * 5000000, 3000, 0, CARD_BYTES);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(0, stats.burstFps());
+    TEST_ASSERT_EQUAL_FLOAT(0, stats.busUtilization());
+}
+
+// Test: A drag at 16ms per frame with full-area pushes
+void test_scroll_burst(void) {
+    FrameStats stats;
+    stats.record(1000000, 3000, 0, CARD_BYTES);  // Idle tick before the drag
+
+    uint32_t now = 5000000;
+    for (int i = 0; i < 125; i++) {
+        now += 16000;
+        stats.record(now, 4000, 2000, CONTENT_BYTES);
+    }
+
+    // The first drag frame follows a 4s gap and does not count
+    printf("Scroll burst: %.1f fps, bus %.1f%% busy\n", stats.burstFps(), stats.busUtilization());
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 62.5f, stats.burstFps());
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 87.3f, stats.busUtilization());
+}
+
+// Test: micros() wrap inside a burst
+void test_micros_wrap(void) {
+    FrameStats stats;
+    stats.record(0xFFFFF000u, 1000, 0, CARD_BYTES);
+    stats.record(0x00001000u, 1000, 0, CARD_BYTES);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 1000000.0f / 0x2000, stats.burstFps());
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_frame_times);
+    RUN_TEST(test_transfer_time);
+    RUN_TEST(test_ticks_are_not_bursts);
+    RUN_TEST(test_scroll_burst);
+    RUN_TEST(test_micros_wrap);
+
+    return UNITY_END();
+}
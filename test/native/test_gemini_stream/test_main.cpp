@@ -0,0 +1,219 @@
+#include <unity.h>
+#include <stdio.h>
+#include <new>
+#include <string>
+#include <chrono>
+#include "api/GeminiStream.h"
+
+// ---------------------------------------------------------------------------
+// Heap accounting for the benchmark (counts every operator new in this binary)
+// ---------------------------------------------------------------------------
+static size_t heapCurrent = 0;
+static size_t heapPeak = 0;
+
+void* operator new(size_t size) {
+    size_t* p = (size_t*)malloc(size + sizeof(size_t));
+    if (p == nullptr) throw std::bad_alloc();
+    *p = size;
+    heapCurrent += size;
+    if (heapCurrent > heapPeak) heapPeak = heapCurrent;
+    return p + 1;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) return;
+    size_t* p = (size_t*)ptr - 1;
+    heapCurrent -= *p;
+    free(p);
+}
+
+static void resetHeapPeak() { heapPeak = heapCurrent; }
+
+// ---------------------------------------------------------------------------
+// Fixtures
+// ---------------------------------------------------------------------------
+
+// Collects what the parser hands out
+struct Collector {
+    char text[8192];
+    size_t len;
+    int calls;
+    size_t largest;
+    bool splitUtf8;
+};
+
+static Collector out;
+
+static void collect(const char* text, size_t len, void* context) {
+    Collector* c = (Collector*)context;
+    memcpy(c->text + c->len, text, len);
+    c->len += len;
+    c->text[c->len] = '\0';
+    c->calls++;
+    if (len > c->largest) c->largest = len;
+    // A fragment must not start with a continuation byte
+    if (((unsigned char)text[0] & 0xC0) == 0x80) c->splitUtf8 = true;
+}
+
+// Only counts, for the benchmark
+static size_t counted = 0;
+static void count(const char* text, size_t len, void* context) {
+    counted += len;
+}
+
+static void feedAll(GeminiStreamParser& parser, const char* body, size_t step) {
+    size_t n = strlen(body);
+    for (size_t i = 0; i < n; i += step) {
+        parser.feed(body + i, i + step <= n ? step : n - i);
+    }
+    parser.flush();
+}
+
+#define EVENT(text) "data: {\"candidates\": [{\"content\": {\"parts\": [{\"text\": \"" text "\"}],\"role\": \"model\"},\"index\": 0}]}\r\n\r\n"
+
+static const char* STREAM =
+    EVENT("📈 Market Summary\\n\\nBitcoin")
+    EVENT(" holds above $97,000")
+    "data: {\"candidates\": [{\"content\": {\"parts\": [{\"text\": \".\"}],\"role\": \"model\"},"
+    "\"finishReason\": \"STOP\",\"index\": 0}],\"usageMetadata\": {\"promptTokenCount\": 180}}\r\n\r\n";
+
+void setUp(void) {
+    memset(&out, 0, sizeof(out));
+}
+
+void tearDown(void) {}
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+// Test: Text from every event is handed out in order, one callback per part
+void test_extracts_text_per_event() {
+    GeminiStreamParser parser(collect, &out);
+    feedAll(parser, STREAM, strlen(STREAM));
+
+    TEST_ASSERT_EQUAL_STRING("📈 Market Summary\n\nBitcoin holds above $97,000.", out.text);
+    TEST_ASSERT_EQUAL(3, out.calls);
+    TEST_ASSERT_EQUAL_UINT32(3, parser.getEvents());
+    TEST_ASSERT_TRUE(parser.finished());
+    TEST_ASSERT_EQUAL_STRING("STOP", parser.getFinishReason());
+    TEST_ASSERT_FALSE(parser.hasError());
+}
+
+// Test: Result does not depend on how the socket splits the bytes
+void test_any_split_gives_same_text() {
+    for (size_t step = 1; step <= 17; step++) {
+        memset(&out, 0, sizeof(out));
+        GeminiStreamParser parser(collect, &out);
+        feedAll(parser, STREAM, step);
+        TEST_ASSERT_EQUAL_STRING("📈 Market Summary\n\nBitcoin holds above $97,000.", out.text);
+        TEST_ASSERT_EQUAL_UINT32(3, parser.getEvents());
+    }
+}
+
+// Test: JSON escapes and \u sequences (including surrogate pairs) decode to UTF-8
+void test_decodes_escapes() {
+    GeminiStreamParser parser(collect, &out);
+    feedAll(parser, EVENT("say \\\"HODL\\\" \\\\ \\u20ac5 \\ud83d\\ude80\\tend"), 5);
+
+    TEST_ASSERT_EQUAL_STRING("say \"HODL\" \\ €5 🚀\tend", out.text);
+}
+
+// Test: LF-only framing works, comments and other fields are ignored, and
+// "text" inside a string value or under another key is not picked up
+void test_ignores_non_text() {
+    const char* body =
+        ": keep-alive\n"
+        "event: message\n"
+        "data: {\"note\": \"\\\"text\\\": \\\"fake\\\"\", \"texts\": \"no\",\n"
+        "data:  \"candidates\": [{\"content\": {\"parts\": [{\"text\": \"real\"}]}}]}\n"
+        "\n";
+    GeminiStreamParser parser(collect, &out);
+    feedAll(parser, body, 3);
+
+    TEST_ASSERT_EQUAL_STRING("real", out.text);
+    TEST_ASSERT_EQUAL_UINT32(1, parser.getEvents());
+}
+
+// Test: Long parts come out in bounded fragments that never split a character
+void test_fragments_are_bounded() {
+    std::string text;
+    for (int i = 0; i < 100; i++) text += "₿📈a";  // 3 + 4 + 1 bytes
+    std::string body = "data: {\"candidates\":[{\"content\":{\"parts\":[{\"text\":\"" + text + "\"}]}}]}\n\n";
+
+    GeminiStreamParser parser(collect, &out);
+    feedAll(parser, body.c_str(), 7);
+
+    TEST_ASSERT_EQUAL_STRING(text.c_str(), out.text);
+    TEST_ASSERT_TRUE(out.calls > 10);
+    TEST_ASSERT_TRUE(out.largest <= GEMINI_STREAM_FRAGMENT + 3);
+    TEST_ASSERT_FALSE(out.splitUtf8);
+}
+
+// Test: An error object in the stream is reported with its message
+void test_reports_error() {
+    const char* body =
+        "data: {\"error\": {\"code\": 429, \"message\": \"Resource has been exhausted\", \"status\": \"RESOURCE_EXHAUSTED\"}}\r\n\r\n";
+    GeminiStreamParser parser(collect, &out);
+    feedAll(parser, body, 4);
+
+    TEST_ASSERT_TRUE(parser.hasError());
+    TEST_ASSERT_EQUAL_STRING("Resource has been exhausted", parser.getErrorMessage());
+    TEST_ASSERT_EQUAL(0, out.calls);
+    TEST_ASSERT_FALSE(parser.finished());
+}
+
+// Test: Memory is fixed while the full-response approach grows with the answer
+void test_benchmark_vs_get_string() {
+    std::string body;
+    for (int i = 0; i < 150; i++) {
+        body += EVENT("Bitcoin network fees remain low while the mempool clears steadily. ");
+    }
+
+    resetHeapPeak();
+    size_t base = heapCurrent;
+    auto t0 = std::chrono::steady_clock::now();
+    std::string response;  // http.getString()
+    for (size_t i = 0; i < body.size(); i += 256) response.append(body, i, 256);
+    std::string copy = response;  // DynamicJsonDocument keeps the strings
+    auto t1 = std::chrono::steady_clock::now();
+    size_t legacyPeak = heapPeak - base;
+
+    resetHeapPeak();
+    base = heapCurrent;
+    GeminiStreamParser parser(count, nullptr);
+    auto t2 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < body.size(); i += 256) {
+        parser.feed(body.data() + i, body.size() - i < 256 ? body.size() - i : 256);
+    }
+    parser.flush();
+    auto t3 = std::chrono::steady_clock::now();
+    size_t streamPeak = heapPeak - base;
+
+    printf("\nGemini SSE body, %zu bytes, %u events\n", body.size(), parser.getEvents());
+    printf("  %-22s peak heap %7zu B  %8.1f us\n", "getString + document", legacyPeak,
+           std::chrono::duration<double, std::micro>(t1 - t0).count());
+    printf("  %-22s peak heap %7zu B  %8.1f us\n", "GeminiStreamParser", streamPeak,
+           std::chrono::duration<double, std::micro>(t3 - t2).count());
+    printf("  Parser state %zu B on the stack\n", sizeof(GeminiStreamParser));
+
+    TEST_ASSERT_EQUAL_UINT32(150, parser.getEvents());
+    TEST_ASSERT_EQUAL_size_t(parser.getTextBytes(), counted);
+    TEST_ASSERT_EQUAL_size_t(0, streamPeak);
+    TEST_ASSERT_TRUE(legacyPeak >= body.size());
+    TEST_ASSERT_TRUE(sizeof(GeminiStreamParser) < 512);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_extracts_text_per_event);
+    RUN_TEST(test_any_split_gives_same_text);
+    RUN_TEST(test_decodes_escapes);
+    RUN_TEST(test_ignores_non_text);
+    RUN_TEST(test_fragments_are_bounded);
+    RUN_TEST(test_reports_error);
+    RUN_TEST(test_benchmark_vs_get_string);
+
+    return UNITY_END();
+}
@@ -0,0 +1,220 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <chrono>
+#include "screens/GlyphAtlas.h"
+
+// Built-in 6x8 font at text size 3, as card values are drawn
+static const int SCALE = 3;
+static const int CELL_W = 6 * SCALE;
+static const int CELL_H = 8 * SCALE;
+static const uint16_t FG = 0xFFFF;
+static const uint16_t BG = 0x2529;
+
+static const char* ALPHABET = " 0123456789$,.+-%/";
+static const int W = 480;  // Canvas row stride
+static const int H = 80;
+
+// Stand-in glyph bitmap: 8 rows of 6 bits, different per character
+static uint8_t fontRow(char c, int row) {
+    return (uint8_t)(((unsigned char)c * 37 + row * 11) & 0x3F);
+}
+
+// Clipped rectangle fill; not inlined, like the canvas call it stands in for
+static void __attribute__((noinline)) fillRect(std::vector<uint16_t>& canvas, int x, int y, int w, int h, uint16_t color) {
+    if (x < 0) { w += x; x = 0; }
+    if (y < 0) { h += y; y = 0; }
+    if (x + w > W) w = W - x;
+    if (y + h > H) h = H - y;
+    for (int row = y; row < y + h; row++) {
+        for (int col = x; col < x + w; col++) canvas[(size_t)row * W + col] = color;
+    }
+}
+
+// setTextSize(3) path: each run of equal font bits in a row is one scaled fill, background included
+static int printScaled(std::vector<uint16_t>& canvas, int x, int y, const char* text) {
+    for (; *text; text++, x += CELL_W) {
+        for (int row = 0; row < 8; row++) {
+            uint8_t bits = fontRow(*text, row);
+            int col = 0;
+            while (col < 6) {
+                int bit = (bits >> (5 - col)) & 1;
+                int run = 1;
+                while (col + run < 6 && ((bits >> (5 - col - run)) & 1) == bit) run++;
+                fillRect(canvas, x + col * SCALE, y + row * SCALE, run * SCALE, SCALE, bit ? FG : BG);
+                col += run;
+            }
+        }
+    }
+    return x;
+}
+
+// Atlas path: copy each cell row by row (what pushImage does into a sprite)
+static int drawAtlas(const GlyphAtlas& atlas, std::vector<uint16_t>& canvas, int x, int y, const char* text) {
+    for (; *text; text++) {
+        uint8_t w = 0;
+        const uint16_t* cell = atlas.glyph(*text, w);
+        for (int row = 0; row < atlas.cellHeight(); row++) {
+            memcpy(&canvas[(size_t)(y + row) * W + x], cell + row * w, w * sizeof(uint16_t));
+        }
+        x += w;
+    }
+    return x;
+}
+
+// Rasterize the alphabet once, as ValueFont::begin() does
+static void build(GlyphAtlas& atlas, std::vector<uint16_t>& storage) {
+    storage.assign(strlen(ALPHABET) * CELL_W * CELL_H, 0);
+    atlas.begin(storage.data(), storage.size(), CELL_H);
+
+    std::vector<uint16_t> cell((size_t)W * H);
+    for (const char* c = ALPHABET; *c; c++) {
+        char text[2] = { *c, '\0' };
+        printScaled(cell, 0, 0, text);
+        std::vector<uint16_t> packed((size_t)CELL_W * CELL_H);
+        for (int row = 0; row < CELL_H; row++) {
+            memcpy(&packed[(size_t)row * CELL_W], &cell[(size_t)row * W], CELL_W * sizeof(uint16_t));
+        }
+        TEST_ASSERT_TRUE(atlas.add(*c, CELL_W, packed.data()));
+    }
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// ========== Atlas ==========
+
+// Test: Added cells are copied and looked up by character
+void test_add_and_lookup(void) {
+    uint16_t storage[64];
+    uint16_t cell[6] = { 1, 2, 3, 4, 5, 6 };
+    GlyphAtlas atlas;
+    atlas.begin(storage, 64, 2);
+
+    TEST_ASSERT_TRUE(atlas.add('7', 3, cell));
+    cell[0] = 99;  // The atlas keeps its own copy
+    TEST_ASSERT_TRUE(atlas.add('$', 2, cell + 2));
+
+    uint8_t w = 0;
+    const uint16_t* seven = atlas.glyph('7', w);
+    TEST_ASSERT_NOT_NULL(seven);
+    TEST_ASSERT_EQUAL_UINT8(3, w);
+    TEST_ASSERT_EQUAL_UINT16(1, seven[0]);
+    TEST_ASSERT_EQUAL_UINT16(6, seven[5]);
+
+    const uint16_t* dollar = atlas.glyph('$', w);
+    TEST_ASSERT_EQUAL_UINT8(2, w);
+    TEST_ASSERT_EQUAL_UINT16(3, dollar[0]);
+    TEST_ASSERT_EQUAL_UINT16(6, dollar[3]);
+
+    TEST_ASSERT_NULL(atlas.glyph('8', w));
+    TEST_ASSERT_EQUAL(10 * sizeof(uint16_t), atlas.bytesUsed());
+}
+
+// Test: Duplicates, non-printable characters, empty cells and overflow are refused
+void test_add_rejects(void) {
+    uint16_t storage[8];
+    uint16_t cell[8] = { 0 };
+    GlyphAtlas atlas;
+    atlas.begin(storage, 8, 2);
+
+    TEST_ASSERT_TRUE(atlas.add('1', 2, cell));
+    TEST_ASSERT_FALSE(atlas.add('1', 2, cell));
+    TEST_ASSERT_FALSE(atlas.add('\n', 2, cell));
+    TEST_ASSERT_FALSE(atlas.add((char)0xC3, 2, cell));
+    TEST_ASSERT_FALSE(atlas.add('2', 0, cell));
+    TEST_ASSERT_FALSE(atlas.add('3', 3, cell));  // 6 pixels, 4 left
+    TEST_ASSERT_TRUE(atlas.add('3', 2, cell));
+    TEST_ASSERT_EQUAL(8 * sizeof(uint16_t), atlas.bytesUsed());
+}
+
+// Test: Coverage and width of card value strings
+void test_covers_and_width(void) {
+    GlyphAtlas atlas;
+    std::vector<uint16_t> storage;
+    build(atlas, storage);
+
+    TEST_ASSERT_TRUE(atlas.covers("$67,432"));
+    TEST_ASSERT_TRUE(atlas.covers("+$1,204"));
+    TEST_ASSERT_TRUE(atlas.covers(""));
+    TEST_ASSERT_FALSE(atlas.covers("12 sat/vB"));  // Letters are not in this alphabet
+    TEST_ASSERT_EQUAL(7 * CELL_W, atlas.textWidth("$67,432"));
+    TEST_ASSERT_EQUAL(2 * CELL_W, atlas.textWidth("1x2"));  // Missing glyphs take no space
+}
+
+// Test: Storage needed for an alphabet of variable-width glyphs
+void test_pixels_for(void) {
+    struct Proportional {
+        int operator()(char c) const { return c == ' ' ? 5 : c == '1' ? 7 : 12; }
+    };
+    TEST_ASSERT_EQUAL(0, GlyphAtlas::pixelsFor("", 20, Proportional()));
+    TEST_ASSERT_EQUAL((5 + 7 + 12 + 12) * 20, GlyphAtlas::pixelsFor(" 109", 20, Proportional()));
+}
+
+// ========== Rendering ==========
+
+// Test: Atlas copies produce the same pixels as scaling the font
+void test_matches_scaled_font(void) {
+    GlyphAtlas atlas;
+    std::vector<uint16_t> storage;
+    build(atlas, storage);
+
+    std::vector<uint16_t> printed((size_t)W * H, 0), blitted((size_t)W * H, 0);
+    const char* values[] = { "$67,432", "+$1,204", "-0.5%", "874211", "12/3" };
+    for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        int x = 8 + (int)i * 3;
+        TEST_ASSERT_EQUAL(printScaled(printed, x, 35, values[i]), drawAtlas(atlas, blitted, x, 35, values[i]));
+        TEST_ASSERT_TRUE(printed == blitted);
+    }
+}
+
+// ========== Benchmark ==========
+
+// Test: Draw time per card value, atlas copy vs scaling the font. Host memory
+// makes both cheap, so this only reports; TEXT_BENCH measures it on the device.
+void test_text_benchmark(void) {
+    GlyphAtlas atlas;
+    std::vector<uint16_t> storage;
+    build(atlas, storage);
+
+    std::vector<uint16_t> canvas((size_t)W * H, 0);
+    const char* values[] = { "$67,432", "+$1,204", "874211", "12,345" };
+    const int count = sizeof(values) / sizeof(values[0]);
+    const int rounds = 2000;
+    volatile uint32_t sink = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < count; i++) sink += drawAtlas(atlas, canvas, 8, 35, values[i]);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (int i = 0; i < count; i++) sink += printScaled(canvas, 8, 35, values[i]);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double atlasUs = std::chrono::duration<double, std::micro>(t1 - t0).count() / (rounds * count);
+    double printUs = std::chrono::duration<double, std::micro>(t2 - t1).count() / (rounds * count);
+    printf("Card value (host): atlas %.2f us, scaled font %.2f us (%.1fx)\n",
+           atlasUs, printUs, printUs / atlasUs);
+
+    TEST_ASSERT_TRUE(atlasUs > 0 && printUs > 0);
+    (void)sink;
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_add_and_lookup);
+    RUN_TEST(test_add_rejects);
+    RUN_TEST(test_covers_and_width);
+    RUN_TEST(test_pixels_for);
+    RUN_TEST(test_matches_scaled_font);
+    RUN_TEST(test_text_benchmark);
+
+    return UNITY_END();
+}
@@ -0,0 +1,357 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <chrono>
+#include "utils/BinarySeries.h"
+
+static const uint32_t T0 = 1735689600;  // 2025-01-01 00:00:00 UTC
+
+struct Sample {
+    uint32_t time;
+    uint32_t fields[BTS_MAX_FIELDS];
+};
+
+// Price in cents, logged every 30s or so (pushes arrive with jitter)
+static std::vector<Sample> makePrices(uint32_t count, bool jitter) {
+    std::vector<Sample> out;
+    uint32_t rng = 11;
+    double usd = 97000.0;
+    uint32_t t = T0;
+    for (uint32_t i = 0; i < count; i++) {
+        rng = rng * 1664525u + 1013904223u;
+        usd *= 1.0 + ((double)(rng >> 8) / 16777216.0 - 0.5) * 0.001;
+        Sample s = {};
+        s.time = t;
+        s.fields[0] = btsFixed((float)usd, 2);
+        s.fields[1] = btsFixed((float)(usd * 0.95), 2);
+        out.push_back(s);
+        t += 30 + (jitter ? (rng >> 29) : 0);
+    }
+    return out;
+}
+
+// Fast/medium/slow fee in sat/vB, one sample a minute
+static std::vector<Sample> makeFees(uint32_t count) {
+    std::vector<Sample> out;
+    uint32_t rng = 5;
+    int fast = 12;
+    for (uint32_t i = 0; i < count; i++) {
+        rng = rng * 1664525u + 1013904223u;
+        if ((rng >> 24) < 40) fast += (rng & 1) ? 1 : -1;
+        if (fast < 3) fast = 3;
+        Sample s = {};
+        s.time = T0 + i * 60;
+        s.fields[0] = (uint32_t)fast;
+        s.fields[1] = (uint32_t)(fast * 2 / 3);
+        s.fields[2] = (uint32_t)(fast / 3 + 1);
+        out.push_back(s);
+    }
+    return out;
+}
+
+// Whole .bts file image in the current format; blocks close when full, or
+// every flushEvery samples (the logger's 5-minute flush) if non-zero
+static std::vector<uint8_t> writeFile(uint8_t kind, const std::vector<Sample>& samples, size_t flushEvery = 0) {
+    BtsWriter writer;
+    uint8_t header[BTS_HEADER_SIZE];
+    writer.create(kind, samples[0].time, header);
+    std::vector<uint8_t> file(header, header + BTS_HEADER_SIZE);
+
+    const uint8_t* data;
+    size_t len;
+    for (size_t i = 0; i < samples.size(); i++) {
+        if (!writer.append(samples[i].time, samples[i].fields)) {
+            len = writer.take(data);
+            file.insert(file.end(), data, data + len);
+            writer.append(samples[i].time, samples[i].fields);
+        }
+        if (flushEvery && writer.pendingSamples() >= flushEvery) {
+            len = writer.take(data);
+            file.insert(file.end(), data, data + len);
+        }
+    }
+    len = writer.take(data);
+    file.insert(file.end(), data, data + len);
+    return file;
+}
+
+// Same samples as version 1 fixed-size records
+static std::vector<uint8_t> writeFileV1(uint8_t kind, const std::vector<Sample>& samples) {
+    BtsEncoder encoder;
+    uint8_t header[BTS_HEADER_SIZE];
+    encoder.begin(kind, samples[0].time, header);
+    std::vector<uint8_t> file(header, header + BTS_HEADER_SIZE);
+    for (size_t i = 0; i < samples.size(); i++) {
+        uint8_t buf[64];
+        size_t n = encoder.encode(samples[i].time, samples[i].fields, buf);
+        file.insert(file.end(), buf, buf + n);
+    }
+    return file;
+}
+
+// Decode a file image, fed in chunks of `chunk` bytes
+static std::vector<Sample> readFile(const std::vector<uint8_t>& file, size_t chunk) {
+    std::vector<Sample> out;
+    BtsReader reader;
+    if (!reader.begin(file.data())) return out;
+    uint8_t fieldCount = reader.header().fieldCount;
+
+    for (size_t pos = BTS_HEADER_SIZE; pos < file.size(); pos += chunk) {
+        size_t n = file.size() - pos < chunk ? file.size() - pos : chunk;
+        reader.feed(file.data() + pos, n, [&](uint32_t time, const uint32_t* fields) {
+            Sample s = {};
+            s.time = time;
+            memcpy(s.fields, fields, fieldCount * sizeof(uint32_t));
+            out.push_back(s);
+        });
+    }
+    return out;
+}
+
+// CSV text as EXPORT_DATA prints it
+static std::string exportCsv(const std::vector<uint8_t>& file) {
+    BtsReader reader;
+    reader.begin(file.data());
+    const BtsHeader& h = reader.header();
+    char row[128];
+    btsFormatHeader(h, row, sizeof(row));
+    std::string csv = std::string(row) + "\n";
+    reader.feed(file.data() + BTS_HEADER_SIZE, file.size() - BTS_HEADER_SIZE,
+                [&](uint32_t time, const uint32_t* fields) {
+        btsFormatRow(h, time, fields, row, sizeof(row));
+        csv += row;
+        csv += "\n";
+    });
+    return csv;
+}
+
+static void assertSame(const std::vector<Sample>& expected, const std::vector<Sample>& actual, uint8_t fields) {
+    TEST_ASSERT_EQUAL(expected.size(), actual.size());
+    for (size_t i = 0; i < expected.size() && i < actual.size(); i++) {
+        TEST_ASSERT_EQUAL_UINT32(expected[i].time, actual[i].time);
+        for (uint8_t f = 0; f < fields; f++) {
+            TEST_ASSERT_EQUAL_UINT32(expected[i].fields[f], actual[i].fields[f]);
+        }
+    }
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// ---------------------------------------------------------------------------
+// Codec
+// ---------------------------------------------------------------------------
+
+// Test: Bit writer and reader agree on every width
+void test_bits() {
+    uint8_t buf[64];
+    BitWriter writer;
+    writer.begin(buf, sizeof(buf));
+    for (uint8_t w = 1; w <= 31; w++) writer.write(0xA5A5A5A5u >> (32 - w), w);
+    TEST_ASSERT_EQUAL(496, writer.bitCount());
+    TEST_ASSERT_EQUAL(62, writer.byteCount());
+    writer.write(0xFFFFFFFFu, 32);  // Only 16 bits left
+    TEST_ASSERT_EQUAL(512, writer.bitCount());
+
+    BitReader reader;
+    reader.begin(buf, sizeof(buf));
+    for (uint8_t w = 1; w <= 31; w++) {
+        TEST_ASSERT_EQUAL_UINT32(0xA5A5A5A5u >> (32 - w), reader.read(w));
+    }
+    TEST_ASSERT_FALSE(reader.overrun());
+    reader.read(32);
+    TEST_ASSERT_TRUE(reader.overrun());
+}
+
+// Test: Every delta-of-delta bucket, negative steps and long gaps round-trip
+void test_timestamps() {
+    uint32_t steps[] = {30, 30, 31, 95, 30, 300, 29, 2000, 30, 0, 86400 * 3, 30, 30};
+    std::vector<Sample> samples;
+    uint32_t t = T0;
+    for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+        Sample s = {};
+        s.time = t;
+        s.fields[0] = 100;
+        samples.push_back(s);
+        t += steps[i];
+    }
+    Sample back = {};
+    back.time = t - 500;  // NTP stepped the clock back
+    samples.push_back(back);
+
+    std::vector<uint8_t> file = writeFile(BTS_PRICE, samples);
+    assertSame(samples, readFile(file, 4096), 2);
+}
+
+// Test: Unchanged, small, large and float-bit values round-trip exactly
+void test_values() {
+    std::vector<Sample> samples;
+    uint32_t rng = 1;
+    for (int i = 0; i < 2000; i++) {
+        rng = rng * 1664525u + 1013904223u;
+        Sample s = {};
+        s.time = T0 + i * 30;
+        s.fields[0] = (i % 7 == 0) ? 9700000 : 9700000 + (rng >> 20);   // Small changes
+        s.fields[1] = (i % 100 < 50) ? 0xFFFFFFFFu : rng;              // Runs and noise
+        float f = 97000.0f + (float)i * 0.25f;
+        memcpy(&s.fields[2], &f, 4);                                    // Float bits
+        s.fields[3] = (uint32_t)i & 1;
+        samples.push_back(s);
+    }
+
+    std::vector<uint8_t> file = writeFile(BTS_BLOCKS, samples);
+    assertSame(samples, readFile(file, 4096), 4);
+}
+
+// Test: Blocks fill to the buffer size, stand alone, and reassemble from any chunk size
+void test_blocks() {
+    std::vector<Sample> prices = makePrices(5000, true);
+    std::vector<uint8_t> file = writeFile(BTS_PRICE, prices);
+
+    // Walk the block headers
+    size_t blocks = 0;
+    uint32_t samples = 0;
+    size_t pos = BTS_HEADER_SIZE;
+    while (pos < file.size()) {
+        size_t size = GorillaDecoder::blockSize(file.data() + pos, file.size() - pos);
+        TEST_ASSERT_TRUE(size > GORILLA_BLOCK_HEADER && size <= BTS_BLOCK_SIZE);
+
+        // Each block decodes on its own, starting at its first sample's time
+        GorillaDecoder block;
+        TEST_ASSERT_TRUE(block.begin(file.data() + pos, size, 2, GORILLA_DELTA));
+        TEST_ASSERT_EQUAL_UINT32(prices[samples].time, block.startTime());
+        samples += block.count();
+        pos += size;
+        blocks++;
+    }
+    TEST_ASSERT_EQUAL(file.size(), pos);
+    TEST_ASSERT_EQUAL_UINT32(5000, samples);
+    TEST_ASSERT_TRUE(blocks >= 40 && blocks <= 70);
+
+    size_t chunks[] = {1, 7, 13, 512, 100000};
+    for (size_t i = 0; i < 5; i++) {
+        assertSame(prices, readFile(file, chunks[i]), 2);
+    }
+}
+
+// Test: A block torn by a power cut is not emitted, earlier blocks are
+void test_torn_block() {
+    std::vector<Sample> prices = makePrices(600, false);
+    std::vector<uint8_t> file = writeFile(BTS_PRICE, prices);
+    size_t first = GorillaDecoder::blockSize(file.data() + BTS_HEADER_SIZE, BTS_BLOCK_SIZE);
+    uint16_t firstCount = file[BTS_HEADER_SIZE + 2] | (file[BTS_HEADER_SIZE + 3] << 8);
+
+    std::vector<uint8_t> torn(file.begin(), file.begin() + BTS_HEADER_SIZE + first + 100);
+    std::vector<Sample> read = readFile(torn, 64);
+    TEST_ASSERT_EQUAL(firstCount, read.size());
+
+    // A garbage block header stops the reader
+    std::vector<uint8_t> bad(file.begin(), file.begin() + BTS_HEADER_SIZE + first);
+    bad.push_back(0xFF);
+    bad.push_back(0xFF);
+    for (int i = 0; i < 20; i++) bad.push_back(0);
+    BtsReader reader;
+    reader.begin(bad.data());
+    reader.feed(bad.data() + BTS_HEADER_SIZE, bad.size() - BTS_HEADER_SIZE, [](uint32_t, const uint32_t*) {});
+    TEST_ASSERT_TRUE(reader.corrupt());
+}
+
+// ---------------------------------------------------------------------------
+// CSV export
+// ---------------------------------------------------------------------------
+
+// Test: Compressed files export the same CSV as version 1 files and the old rows
+void test_csv_round_trip() {
+    std::vector<Sample> prices = makePrices(2880, true);
+    std::string v2 = exportCsv(writeFile(BTS_PRICE, prices, 10));
+    std::string v1 = exportCsv(writeFileV1(BTS_PRICE, prices));
+    TEST_ASSERT_TRUE(v1 == v2);
+    TEST_ASSERT_EQUAL(0, v2.find("timestamp,price_usd,price_eur\n"));
+
+    // Rows parse back to the logged prices, as the boot replay reads CSV
+    size_t pos = v2.find('\n') + 1;
+    size_t rows = 0;
+    while (pos < v2.size()) {
+        size_t end = v2.find('\n', pos);
+        std::string line = v2.substr(pos, end - pos);
+        uint32_t t;
+        float usd;
+        TEST_ASSERT_TRUE(parsePriceCsvLine(line.c_str(), t, usd));
+        TEST_ASSERT_EQUAL_UINT32(prices[rows].time, t);
+        TEST_ASSERT_EQUAL_UINT32(prices[rows].fields[0], btsFixed(usd, 2));
+        rows++;
+        pos = end + 1;
+    }
+    TEST_ASSERT_EQUAL(2880, rows);
+
+    std::vector<Sample> fees = makeFees(1440);
+    TEST_ASSERT_TRUE(exportCsv(writeFile(BTS_FEES, fees)) == exportCsv(writeFileV1(BTS_FEES, fees)));
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------
+
+static size_t csvSize(const std::vector<Sample>& samples, uint8_t kind) {
+    // Old logger rows carried milliseconds: ".mmm" per row
+    std::string csv = exportCsv(writeFileV1(kind, samples));
+    return csv.size() + 4 * samples.size();
+}
+
+// Test: Bytes per sample and decode throughput against records and CSV
+void test_benchmark() {
+    std::vector<Sample> prices = makePrices(2880, true);  // One day
+    std::vector<Sample> fees = makeFees(1440);
+
+    std::vector<uint8_t> v1 = writeFileV1(BTS_PRICE, prices);
+    std::vector<uint8_t> full = writeFile(BTS_PRICE, prices);
+    std::vector<uint8_t> flushed = writeFile(BTS_PRICE, prices, 10);  // 5-minute flushes
+    std::vector<uint8_t> feeV1 = writeFileV1(BTS_FEES, fees);
+    std::vector<uint8_t> feeFull = writeFile(BTS_FEES, fees);
+
+    double n = (double)prices.size();
+    printf("\nPrice, bytes/sample: CSV %.1f, v1 records %.1f, Gorilla %.2f (full blocks) / %.2f (5-min flushes)\n",
+           csvSize(prices, BTS_PRICE) / n, (v1.size() - BTS_HEADER_SIZE) / n,
+           (full.size() - BTS_HEADER_SIZE) / n, (flushed.size() - BTS_HEADER_SIZE) / n);
+    printf("Fees, bytes/sample: CSV %.1f, v1 records %.1f, Gorilla %.2f\n",
+           csvSize(fees, BTS_FEES) / (double)fees.size(), (feeV1.size() - BTS_HEADER_SIZE) / (double)fees.size(),
+           (feeFull.size() - BTS_HEADER_SIZE) / (double)fees.size());
+    printf("90 days of 30s prices: %.1f MB CSV, %.1f MB v1, %.2f MB Gorilla\n",
+           csvSize(prices, BTS_PRICE) * 90 / 1e6, v1.size() * 90 / 1e6, flushed.size() * 90 / 1e6);
+
+    // Decode throughput over many days of blocks
+    std::vector<Sample> month = makePrices(30 * 2880, true);
+    std::vector<uint8_t> monthFile = writeFile(BTS_PRICE, month);
+    volatile uint32_t sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    BtsReader reader;
+    reader.begin(monthFile.data());
+    size_t decoded = reader.feed(monthFile.data() + BTS_HEADER_SIZE, monthFile.size() - BTS_HEADER_SIZE,
+                                 [&](uint32_t time, const uint32_t* fields) { sink += time ^ fields[0]; });
+    auto t1 = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(t1 - t0).count();
+    printf("Decode: %.1f M samples/s (%zu samples)\n", decoded / seconds / 1e6, decoded);
+
+    TEST_ASSERT_EQUAL(month.size(), decoded);
+    TEST_ASSERT_TRUE((full.size() - BTS_HEADER_SIZE) * 10 < (v1.size() - BTS_HEADER_SIZE) * 6);
+    TEST_ASSERT_TRUE((flushed.size() - BTS_HEADER_SIZE) * 10 < (v1.size() - BTS_HEADER_SIZE) * 7);
+    TEST_ASSERT_TRUE((feeFull.size() - BTS_HEADER_SIZE) * 4 < feeV1.size() - BTS_HEADER_SIZE);
+    (void)sink;
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_bits);
+    RUN_TEST(test_timestamps);
+    RUN_TEST(test_values);
+    RUN_TEST(test_blocks);
+    RUN_TEST(test_torn_block);
+    RUN_TEST(test_csv_round_trip);
+    RUN_TEST(test_benchmark);
+
+    return UNITY_END();
+}
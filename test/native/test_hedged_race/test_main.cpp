@@ -0,0 +1,357 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "network/HedgedRace.h"
+
+#define GEMINI 0
+#define OPENAI 1
+
+// ---------------------------------------------------------------------------
+// Mock providers: a fixed latency and outcome per request, on a simulated
+// clock. runRace() plays the part of AIRouter: it starts what the race
+// launches, delivers results in time order and records every completed
+// request (losers included) into the policy.
+// ---------------------------------------------------------------------------
+struct MockProvider {
+    uint32_t latencyMs;
+    bool ok;
+};
+
+struct RaceOutcome {
+    int winner;
+    uint32_t elapsedMs;
+    bool hedged;
+    uint8_t launched;
+    bool cancelled[HEDGE_MAX_PROVIDERS];  // Still running when the race was decided
+};
+
+static bool bothAvailable[HEDGE_MAX_PROVIDERS] = {true, true};
+
+static RaceOutcome runRace(HedgePolicy& policy, const MockProvider* mocks,
+                           const bool* available = bothAvailable) {
+    uint8_t order[HEDGE_MAX_PROVIDERS];
+    uint8_t count = policy.order(available, HEDGE_MAX_PROVIDERS, order);
+
+    HedgedRace race;
+    race.begin(order, count, count > 0 ? policy.hedgeDelayMs(order[0]) : 0, 0);
+
+    uint32_t startedAt[HEDGE_MAX_PROVIDERS] = {0};
+    bool started[HEDGE_MAX_PROVIDERS] = {false};
+    bool reported[HEDGE_MAX_PROVIDERS] = {false};
+    uint32_t now = 0;
+
+    while (true) {
+        int p;
+        while ((p = race.launch(now)) >= 0) {
+            started[p] = true;
+            startedAt[p] = now;
+        }
+        if (race.done()) break;
+
+        // Next event: a hedge deadline or the earliest pending result
+        uint32_t wait = race.msUntilLaunch(now);
+        uint32_t next = wait == UINT32_MAX ? UINT32_MAX : now + wait;
+        int who = -1;
+        for (int i = 0; i < HEDGE_MAX_PROVIDERS; i++) {
+            if (!started[i] || reported[i]) continue;
+            uint32_t at = startedAt[i] + mocks[i].latencyMs;
+            if (at <= next) {
+                next = at;
+                who = i;
+            }
+        }
+        now = next;
+
+        if (who >= 0) {
+            reported[who] = true;
+            policy.record(who, mocks[who].latencyMs, mocks[who].ok);
+            race.finish(who, mocks[who].ok, now);
+        }
+    }
+
+    RaceOutcome out;
+    out.winner = race.getWinner();
+    out.elapsedMs = race.getElapsedMs();
+    out.hedged = race.wasHedged();
+    out.launched = race.getLaunched();
+    for (int i = 0; i < HEDGE_MAX_PROVIDERS; i++) {
+        out.cancelled[i] = race.isRunning(i);
+        // The cancelled request still completes and is measured
+        if (started[i] && !reported[i]) policy.record(i, mocks[i].latencyMs, mocks[i].ok);
+    }
+    if (out.winner >= 0) policy.recordWin(out.winner);
+    return out;
+}
+
+// Give a provider enough samples around latencyMs
+static void warmUp(HedgePolicy& policy, uint8_t provider, uint32_t latencyMs, int count = HEDGE_MIN_SAMPLES) {
+    for (int i = 0; i < count; i++) policy.record(provider, latencyMs, true);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// ---------------------------------------------------------------------------
+// LatencyHistogram
+// ---------------------------------------------------------------------------
+
+// Test: Percentiles report the upper edge of the bucket holding the sample
+void test_histogram_percentiles() {
+    LatencyHistogram h;
+    TEST_ASSERT_EQUAL_UINT32(0, h.percentile(95));
+
+    for (int i = 0; i < 45; i++) h.record(900);    // <= 1000 bucket
+    for (int i = 0; i < 5; i++) h.record(5000);    // <= 6000 bucket
+
+    TEST_ASSERT_EQUAL_UINT32(1000, h.percentile(50));
+    TEST_ASSERT_EQUAL_UINT32(1000, h.percentile(90));
+    TEST_ASSERT_EQUAL_UINT32(6000, h.percentile(95));
+    TEST_ASSERT_EQUAL_UINT32(250, LatencyHistogram::bucketLimit(0));
+    TEST_ASSERT_EQUAL_UINT32(LATENCY_OVERFLOW_MS, LatencyHistogram::bucketLimit(LATENCY_BUCKETS - 1));
+}
+
+// Test: Failures rank above every answer, answer percentiles ignore them, and old samples fade out
+void test_histogram_failures_and_decay() {
+    LatencyHistogram h;
+    for (int i = 0; i < 3; i++) h.record(400);
+    h.recordFailure();
+    TEST_ASSERT_EQUAL_UINT32(LATENCY_OVERFLOW_MS, h.percentile(95));
+    TEST_ASSERT_EQUAL_UINT32(500, h.answerPercentile(95));
+    TEST_ASSERT_EQUAL_UINT16(1, h.getFailures());
+    TEST_ASSERT_EQUAL_UINT32(4, h.samples());
+
+    // A long run of fast answers pushes the old failure out of the p95
+    for (int i = 0; i < 200; i++) h.record(400);
+    TEST_ASSERT_TRUE(h.samples() <= LATENCY_WINDOW);
+    TEST_ASSERT_EQUAL_UINT32(500, h.percentile(95));
+}
+
+// ---------------------------------------------------------------------------
+// HedgedRace
+// ---------------------------------------------------------------------------
+
+// Test: A primary answering inside its budget is the only request sent
+void test_fast_primary_not_hedged() {
+    HedgePolicy policy(GEMINI);
+    MockProvider mocks[] = {{1200, true}, {900, true}};
+
+    RaceOutcome r = runRace(policy, mocks);
+
+    TEST_ASSERT_EQUAL_INT(GEMINI, r.winner);
+    TEST_ASSERT_EQUAL_UINT32(1200, r.elapsedMs);
+    TEST_ASSERT_FALSE(r.hedged);
+    TEST_ASSERT_EQUAL_UINT8(1, r.launched);
+    TEST_ASSERT_EQUAL_UINT32(0, policy.getStats(OPENAI).attempts);
+}
+
+// Test: A primary slower than its budget gets a hedge; first answer wins and the primary is cancelled
+void test_slow_primary_hedged() {
+    HedgePolicy policy(GEMINI);
+    warmUp(policy, GEMINI, 1800);  // p95 2000ms
+    TEST_ASSERT_EQUAL_UINT32(2000, policy.hedgeDelayMs(GEMINI));
+
+    MockProvider mocks[] = {{25000, true}, {1500, true}};
+    RaceOutcome r = runRace(policy, mocks);
+
+    TEST_ASSERT_EQUAL_INT(OPENAI, r.winner);
+    TEST_ASSERT_EQUAL_UINT32(2000 + 1500, r.elapsedMs);
+    TEST_ASSERT_TRUE(r.hedged);
+    TEST_ASSERT_TRUE(r.cancelled[GEMINI]);
+    TEST_ASSERT_FALSE(r.cancelled[OPENAI]);
+    TEST_ASSERT_EQUAL_UINT32(1, policy.getStats(OPENAI).wins);
+}
+
+// Test: The primary still wins if it answers before the hedge does
+void test_primary_beats_hedge() {
+    HedgePolicy policy(GEMINI);
+    warmUp(policy, GEMINI, 1800);
+
+    MockProvider mocks[] = {{2500, true}, {4000, true}};
+    RaceOutcome r = runRace(policy, mocks);
+
+    TEST_ASSERT_EQUAL_INT(GEMINI, r.winner);
+    TEST_ASSERT_EQUAL_UINT32(2500, r.elapsedMs);
+    TEST_ASSERT_TRUE(r.hedged);
+    TEST_ASSERT_TRUE(r.cancelled[OPENAI]);
+}
+
+// Test: A failing primary hands over at once instead of waiting for the budget
+void test_failover_without_waiting() {
+    HedgePolicy policy(GEMINI);
+    MockProvider mocks[] = {{300, false}, {1000, true}};
+
+    RaceOutcome r = runRace(policy, mocks);
+
+    TEST_ASSERT_EQUAL_INT(OPENAI, r.winner);
+    TEST_ASSERT_EQUAL_UINT32(300 + 1000, r.elapsedMs);
+    TEST_ASSERT_FALSE(r.hedged);
+    TEST_ASSERT_EQUAL_UINT32(1, policy.getStats(GEMINI).failures);
+}
+
+// Test: Unavailable providers are skipped and a race with every provider failing has no winner
+void test_unavailable_and_all_failed() {
+    HedgePolicy policy(GEMINI);
+    bool onlyOpenAI[] = {false, true};
+    MockProvider ok[] = {{500, true}, {700, true}};
+    RaceOutcome r = runRace(policy, ok, onlyOpenAI);
+    TEST_ASSERT_EQUAL_INT(OPENAI, r.winner);
+    TEST_ASSERT_EQUAL_UINT8(1, r.launched);
+
+    MockProvider failing[] = {{500, false}, {700, false}};
+    r = runRace(policy, failing);
+    TEST_ASSERT_EQUAL_INT(-1, r.winner);
+    TEST_ASSERT_EQUAL_UINT8(2, r.launched);
+
+    bool none[] = {false, false};
+    r = runRace(policy, ok, none);
+    TEST_ASSERT_EQUAL_INT(-1, r.winner);
+    TEST_ASSERT_EQUAL_UINT8(0, r.launched);
+}
+
+// ---------------------------------------------------------------------------
+// HedgePolicy
+// ---------------------------------------------------------------------------
+
+// Test: Hedge delay follows the primary's p95 within the clamps
+void test_hedge_delay_clamped() {
+    HedgePolicy policy(GEMINI);
+    TEST_ASSERT_EQUAL_UINT32(HEDGE_DEFAULT_MS, policy.hedgeDelayMs(GEMINI));  // Too few samples
+
+    warmUp(policy, GEMINI, 200);
+    TEST_ASSERT_EQUAL_UINT32(HEDGE_MIN_MS, policy.hedgeDelayMs(GEMINI));
+
+    warmUp(policy, OPENAI, 3500);
+    TEST_ASSERT_EQUAL_UINT32(4000, policy.hedgeDelayMs(OPENAI));
+
+    // Failures fail over on their own; they do not stretch the hedge delay
+    policy.record(GEMINI, 100, false);
+    policy.record(GEMINI, 100, false);
+    TEST_ASSERT_EQUAL_UINT32(HEDGE_MIN_MS, policy.hedgeDelayMs(GEMINI));
+
+    warmUp(policy, GEMINI, 60000, 3);                // Timeouts that did answer
+    TEST_ASSERT_EQUAL_UINT32(HEDGE_MAX_MS, policy.hedgeDelayMs(GEMINI));
+}
+
+// Test: The faster provider becomes primary only with enough samples and a clear margin
+void test_primary_follows_latency() {
+    HedgePolicy policy(GEMINI);
+    warmUp(policy, GEMINI, 3500);                    // median 4000
+    warmUp(policy, OPENAI, 2800, HEDGE_MIN_SAMPLES - 1);
+    TEST_ASSERT_EQUAL_UINT8(GEMINI, policy.getPrimary());  // Not enough samples yet
+
+    policy.record(OPENAI, 2800, true);               // median 3000: 75% of 4000, not below
+    TEST_ASSERT_EQUAL_UINT8(GEMINI, policy.getPrimary());
+
+    warmUp(policy, OPENAI, 1800, 20);                // median 2000
+    TEST_ASSERT_EQUAL_UINT8(OPENAI, policy.getPrimary());
+
+    uint8_t order[HEDGE_MAX_PROVIDERS];
+    TEST_ASSERT_EQUAL_UINT8(2, policy.order(bothAvailable, HEDGE_MAX_PROVIDERS, order));
+    TEST_ASSERT_EQUAL_UINT8(OPENAI, order[0]);
+    TEST_ASSERT_EQUAL_UINT8(GEMINI, order[1]);
+
+    // Mostly failing: its median moves to the overflow bucket
+    for (int i = 0; i < 40; i++) policy.record(OPENAI, 500, false);
+    TEST_ASSERT_EQUAL_UINT8(GEMINI, policy.getPrimary());
+}
+
+// Test: Occasional stalls do not cost the primary its place
+void test_stalls_keep_primary() {
+    HedgePolicy policy(GEMINI);
+    warmUp(policy, OPENAI, 4500, 20);                // Steady 4-6s
+    for (int i = 0; i < 60; i++) {
+        policy.record(GEMINI, i % 10 == 0 ? 20000 : 1800, true);
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(GEMINI, policy.getPrimary());
+    TEST_ASSERT_EQUAL_UINT32(HEDGE_MAX_MS, policy.hedgeDelayMs(GEMINI));  // 10% stalls: p95 in the tail
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark: tail latency, serial primary-only vs hedged
+// ---------------------------------------------------------------------------
+
+static uint32_t rngState = 12345;
+static uint32_t nextRandom() {
+    rngState = rngState * 1664525u + 1013904223u;
+    return rngState >> 8;
+}
+
+// Mostly 1-3s, 3% of requests stall for 15-25s, 1% fail after 1s
+static MockProvider sampleGemini() {
+    uint32_t roll = nextRandom() % 100;
+    if (roll < 1) return {1000, false};
+    if (roll < 4) return {15000 + nextRandom() % 10000, true};
+    return {1000 + nextRandom() % 2000, true};
+}
+
+// Steadier but slower: 2-5s
+static MockProvider sampleOpenAI() {
+    return {2000 + nextRandom() % 3000, true};
+}
+
+static int compareU32(const void* a, const void* b) {
+    uint32_t x = *(const uint32_t*)a;
+    uint32_t y = *(const uint32_t*)b;
+    return x < y ? -1 : x > y;
+}
+
+// Test: Hedging cuts p99 latency at a small cost in extra requests
+void test_benchmark_tail_latency() {
+    const int RUNS = 2000;
+    static uint32_t serial[RUNS];
+    static uint32_t hedged[RUNS];
+
+    HedgePolicy policy(GEMINI);
+    int serialFailures = 0;
+    int hedgedFailures = 0;
+    uint32_t extraRequests = 0;
+
+    for (int i = 0; i < RUNS; i++) {
+        MockProvider mocks[] = {sampleGemini(), sampleOpenAI()};
+
+        // Before: Gemini only, waits out every stall
+        serial[i] = mocks[GEMINI].latencyMs;
+        if (!mocks[GEMINI].ok) serialFailures++;
+
+        RaceOutcome r = runRace(policy, mocks);
+        hedged[i] = r.elapsedMs;
+        if (r.winner < 0) hedgedFailures++;
+        if (r.launched > 1) extraRequests++;
+    }
+
+    qsort(serial, RUNS, sizeof(uint32_t), compareU32);
+    qsort(hedged, RUNS, sizeof(uint32_t), compareU32);
+
+    printf("\nAI request latency over %d requests (simulated providers)\n", RUNS);
+    printf("  %-18s p50 %6u ms  p95 %6u ms  p99 %6u ms  failed %d\n", "serial (gemini)",
+           serial[RUNS / 2], serial[RUNS * 95 / 100], serial[RUNS * 99 / 100], serialFailures);
+    printf("  %-18s p50 %6u ms  p95 %6u ms  p99 %6u ms  failed %d\n", "hedged",
+           hedged[RUNS / 2], hedged[RUNS * 95 / 100], hedged[RUNS * 99 / 100], hedgedFailures);
+    printf("  Second request sent in %.1f%% of races, primary now %s, hedge after %u ms\n",
+           extraRequests * 100.0 / RUNS, policy.getPrimary() == GEMINI ? "gemini" : "openai",
+           policy.hedgeDelayMs(policy.getPrimary()));
+
+    TEST_ASSERT_EQUAL_INT(0, hedgedFailures);
+    TEST_ASSERT_TRUE(hedged[RUNS * 99 / 100] * 2 < serial[RUNS * 99 / 100]);
+    TEST_ASSERT_TRUE(extraRequests * 100 / RUNS < 25);
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_histogram_percentiles);
+    RUN_TEST(test_histogram_failures_and_decay);
+    RUN_TEST(test_fast_primary_not_hedged);
+    RUN_TEST(test_slow_primary_hedged);
+    RUN_TEST(test_primary_beats_hedge);
+    RUN_TEST(test_failover_without_waiting);
+    RUN_TEST(test_unavailable_and_all_failed);
+    RUN_TEST(test_hedge_delay_clamped);
+    RUN_TEST(test_primary_follows_latency);
+    RUN_TEST(test_stalls_keep_primary);
+    RUN_TEST(test_benchmark_tail_latency);
+
+    return UNITY_END();
+}
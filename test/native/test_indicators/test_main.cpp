@@ -0,0 +1,325 @@
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include <chrono>
+#include "api/Indicators.h"
+
+// ---------------------------------------------------------------------------
+// Double-precision reference implementations (textbook definitions)
+// ---------------------------------------------------------------------------
+
+// EMA seeded with the SMA of the first period values
+struct RefEma {
+    int n;
+    int count;
+    double sum;
+    double value;
+
+    explicit RefEma(int period) : n(period), count(0), sum(0), value(0) {}
+
+    void add(double x) {
+        count++;
+        if (count <= n) {
+            sum += x;
+            value = sum / count;
+        } else {
+            value += (x - value) * 2.0 / (n + 1);
+        }
+    }
+    bool ready() const { return count >= n; }
+};
+
+// Population standard deviation based band width over the last n values
+static double refBandWidth(const double* prices, int end, int n) {
+    double sum = 0;
+    for (int i = end - n + 1; i <= end; i++) sum += prices[i];
+    double mean = sum / n;
+    double var = 0;
+    for (int i = end - n + 1; i <= end; i++) var += (prices[i] - mean) * (prices[i] - mean);
+    return 4.0 * sqrt(var / n) / mean;
+}
+
+// Deterministic random walk around $97k, cents
+static uint32_t rngState = 2024;
+static double nextUniform() {
+    rngState = rngState * 1664525u + 1013904223u;
+    return (rngState >> 8) / 16777216.0;
+}
+
+static const int SERIES = 500;
+static double series[SERIES];
+
+static void makeSeries(double start, double stepPct, double driftPct) {
+    double p = start;
+    for (int i = 0; i < SERIES; i++) {
+        series[i] = floor(p * 100.0 + 0.5) / 100.0;
+        p *= 1.0 + (driftPct + (nextUniform() * 2.0 - 1.0) * stepPct) / 100.0;
+    }
+}
+
+static int32_t cents(double price) {
+    return (int32_t)floor(price * 100.0 + 0.5);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+// Test: Integer square root is exact on squares and floors in between
+void test_isqrt() {
+    TEST_ASSERT_EQUAL_UINT64(0, isqrt64(0));
+    TEST_ASSERT_EQUAL_UINT64(1, isqrt64(3));
+    TEST_ASSERT_EQUAL_UINT64(2, isqrt64(4));
+    TEST_ASSERT_EQUAL_UINT64(9999999ULL, isqrt64(99999999999999ULL));
+    TEST_ASSERT_EQUAL_UINT64(10000000ULL, isqrt64(100000000000000ULL));
+    TEST_ASSERT_EQUAL_UINT64(4294967295ULL, isqrt64(0xFFFFFFFFFFFFFFFFULL));
+}
+
+// Test: RSI matches the published Wilder example (StockCharts ChartSchool, 14 periods)
+void test_rsi_reference() {
+    static const double CLOSES[] = {
+        44.34, 44.09, 44.15, 43.61, 44.33, 44.83, 45.10, 45.42, 45.84, 46.08, 45.89, 46.03,
+        45.61, 46.28, 46.28, 46.00, 46.03, 46.41, 46.22, 45.64, 46.21, 46.25, 45.71, 46.45,
+        45.78, 45.35, 44.03, 44.18, 44.22, 44.57, 43.42, 42.66, 43.13
+    };
+    // RSI from the 15th close on; the table rounds its averages, hence the tolerance
+    static const double EXPECTED[] = {
+        70.53, 66.32, 66.55, 69.41, 66.36, 57.97, 62.93, 63.26, 56.06, 62.38,
+        54.71, 50.42, 39.99, 41.46, 41.87, 45.46, 37.30, 33.08, 37.77
+    };
+
+    IndicatorEngine engine;
+    int checked = 0;
+    for (size_t i = 0; i < sizeof(CLOSES) / sizeof(CLOSES[0]); i++) {
+        engine.add(cents(CLOSES[i]));
+        if (i < INDICATOR_RSI_PERIOD) {
+            TEST_ASSERT_EQUAL_INT32(-1, engine.rsiX100());
+            continue;
+        }
+        TEST_ASSERT_FLOAT_WITHIN(0.1, EXPECTED[i - INDICATOR_RSI_PERIOD], engine.rsiX100() / 100.0);
+        checked++;
+    }
+    TEST_ASSERT_EQUAL(19, checked);
+}
+
+// Test: EMAs and MACD track the double-precision reference to within a cent
+void test_ema_macd_reference() {
+    makeSeries(97000.0, 0.3, 0.0);
+
+    IndicatorEngine engine;
+    RefEma fast(INDICATOR_EMA_FAST), slow(INDICATOR_EMA_SLOW), signal(INDICATOR_MACD_SIGNAL);
+    double worstEma = 0, worstMacd = 0;
+
+    for (int i = 0; i < SERIES; i++) {
+        engine.add(cents(series[i]));
+        fast.add(series[i] * 100.0);
+        slow.add(series[i] * 100.0);
+        if (slow.ready()) signal.add(fast.value - slow.value);
+
+        worstEma = fmax(worstEma, fabs(engine.emaFastCents() - fast.value));
+        worstEma = fmax(worstEma, fabs(engine.emaSlowCents() - slow.value));
+        if (signal.ready()) {
+            double macd = engine.macdQ() / 65536.0;
+            double hist = engine.macdHistogramQ() / 65536.0;
+            worstMacd = fmax(worstMacd, fabs(macd - (fast.value - slow.value)));
+            worstMacd = fmax(worstMacd, fabs(hist - (fast.value - slow.value - signal.value)));
+        }
+    }
+
+    TEST_ASSERT_TRUE(engine.ready());
+    TEST_ASSERT_TRUE(worstEma <= 1.0);   // emaCents() truncates
+    TEST_ASSERT_TRUE(worstMacd < 0.01);  // Q16 keeps sub-cent precision
+}
+
+// Test: Bollinger band width and volatility match the reference
+void test_bands_and_volatility_reference() {
+    makeSeries(97000.0, 0.5, 0.0);
+
+    IndicatorEngine engine;
+    double var = 0;
+    double worstWidth = 0, worstVol = 0;
+
+    for (int i = 0; i < SERIES; i++) {
+        engine.add(cents(series[i]));
+
+        if (i > 0) {
+            double r = (series[i] - series[i - 1]) / series[i - 1] * 1e6;
+            var = i == 1 ? r * r : 0.94 * var + 0.06 * r * r;
+            worstVol = fmax(worstVol, fabs(engine.volatilityPpm() - sqrt(var)) / sqrt(var));
+        }
+        if (i >= INDICATOR_BB_PERIOD - 1) {
+            double ref = refBandWidth(series, i, INDICATOR_BB_PERIOD) * 1e6;
+            worstWidth = fmax(worstWidth, fabs(engine.bandWidthPpm() - ref));
+        } else {
+            TEST_ASSERT_EQUAL_UINT32(0, engine.bandWidthPpm());
+        }
+    }
+
+    TEST_ASSERT_TRUE(worstWidth <= 2.0);   // ppm
+    TEST_ASSERT_TRUE(worstVol < 0.01);     // 1% relative; returns are rounded to ppm
+    TEST_ASSERT_FLOAT_WITHIN(sqrt(var * 60) * 0.001, sqrt(var * 60), (double)engine.hourlyVolatilityPpm());
+}
+
+// Test: Prices within the same sample interval are ignored
+void test_sampling_interval() {
+    IndicatorEngine engine;
+
+    TEST_ASSERT_TRUE(engine.update(97000.0f, 1000));
+    TEST_ASSERT_FALSE(engine.update(97100.0f, 1000 + INDICATOR_SAMPLE_MS - 1));
+    TEST_ASSERT_TRUE(engine.update(97200.0f, 1000 + INDICATOR_SAMPLE_MS));
+    TEST_ASSERT_FALSE(engine.update(0.0f, 1000 + 5 * INDICATOR_SAMPLE_MS));
+    TEST_ASSERT_EQUAL_UINT32(2, engine.getSamples());
+    TEST_ASSERT_EQUAL_INT32(9720000, engine.getPriceCents());
+}
+
+// Test: Local signal follows RSI extremes first, then MACD, with a warm-up period
+void test_local_signal() {
+    IndicatorEngine engine;
+    for (int i = 0; i < 20; i++) engine.add(9700000);
+    TEST_ASSERT_EQUAL_INT(LOCAL_SIGNAL_NONE, engine.signal());  // MACD signal line not seeded
+
+    for (int i = 0; i < 20; i++) engine.add(9700000);
+    TEST_ASSERT_TRUE(engine.ready());
+    TEST_ASSERT_EQUAL_INT(LOCAL_SIGNAL_HOLD, engine.signal());
+    TEST_ASSERT_EQUAL_UINT8(50, engine.confidence());
+
+    // Steady selling: RSI collapses
+    for (int i = 0; i < 20; i++) engine.add(9700000 - i * 20000);
+    TEST_ASSERT_TRUE(engine.rsiX100() <= INDICATOR_RSI_OVERSOLD * 100);
+    TEST_ASSERT_EQUAL_INT(LOCAL_SIGNAL_BUY, engine.signal());
+    TEST_ASSERT_TRUE(engine.confidence() >= 60);
+
+    // Choppy climb: RSI stays neutral, the MACD histogram turns positive
+    IndicatorEngine trend;
+    int32_t price = 9700000;
+    for (int i = 0; i < 40; i++) trend.add(price += (i % 2 ? 3000 : -3000));
+    for (int i = 0; i < 8; i++) trend.add(price += (i % 2 ? -9000 : 15000));
+    TEST_ASSERT_TRUE(trend.rsiX100() > INDICATOR_RSI_OVERSOLD * 100);
+    TEST_ASSERT_TRUE(trend.rsiX100() < INDICATOR_RSI_OVERBOUGHT * 100);
+    TEST_ASSERT_TRUE(trend.macdHistogramPpm() > INDICATOR_MACD_DEADBAND_PPM);
+    TEST_ASSERT_EQUAL_INT(LOCAL_SIGNAL_BUY, trend.signal());
+    TEST_ASSERT_TRUE(trend.confidence() >= 40 && trend.confidence() <= 80);
+    TEST_ASSERT_EQUAL_STRING("BUY", IndicatorEngine::signalName(trend.signal()));
+}
+
+// Test: Threshold crossings raise events once until cleared
+void test_events() {
+    IndicatorEngine engine;
+    for (int i = 0; i < 40; i++) engine.add(9700000 + (i % 2) * 1000);
+    engine.clearEvents();
+
+    // Sideways market: nothing to ask about
+    for (int i = 0; i < 30; i++) engine.add(9700000 + (i % 2) * 1000);
+    TEST_ASSERT_EQUAL_UINT8(0, engine.peekEvents());
+
+    // A sharp drop crosses RSI 30 and flips the local signal
+    for (int i = 1; i <= 10; i++) engine.add(9700000 - i * 30000);
+    uint8_t events = engine.peekEvents();
+    TEST_ASSERT_TRUE(events & INDICATOR_EVENT_RSI);
+    TEST_ASSERT_TRUE(events & INDICATOR_EVENT_SIGNAL);
+    TEST_ASSERT_TRUE(events & INDICATOR_EVENT_VOLATILITY);
+
+    engine.clearEvents();
+    engine.add(9400000 - 30000);  // Still falling, still oversold: nothing new
+    TEST_ASSERT_EQUAL_UINT8(0, engine.peekEvents() & (INDICATOR_EVENT_RSI | INDICATOR_EVENT_VOLATILITY));
+
+    // Recovery: MACD crosses back above its signal line
+    for (int i = 1; i <= 15; i++) engine.add(9370000 + i * 25000);
+    TEST_ASSERT_TRUE(engine.peekEvents() & INDICATOR_EVENT_MACD);
+}
+
+// ---------------------------------------------------------------------------
+// Benchmarks
+// ---------------------------------------------------------------------------
+
+// Full recomputation over the last 64 samples, the alternative to incremental state
+static double recomputeAll(const double* prices, int end) {
+    int start = end >= 63 ? end - 63 : 0;
+    RefEma fast(INDICATOR_EMA_FAST), slow(INDICATOR_EMA_SLOW);
+    double gain = 0, loss = 0;
+    for (int i = start; i <= end; i++) {
+        fast.add(prices[i]);
+        slow.add(prices[i]);
+        if (i > start) {
+            double c = prices[i] - prices[i - 1];
+            gain = (gain * 13 + (c > 0 ? c : 0)) / 14;
+            loss = (loss * 13 + (c < 0 ? -c : 0)) / 14;
+        }
+    }
+    double width = end >= INDICATOR_BB_PERIOD ? refBandWidth(prices, end, INDICATOR_BB_PERIOD) : 0;
+    return fast.value - slow.value + gain - loss + width;
+}
+
+// Test: Per-sample cost, and AI calls saved over a simulated day
+void test_benchmark() {
+    makeSeries(97000.0, 0.08, 0.0);
+
+    const int ROUNDS = 200;
+    volatile double sink = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS; r++) {
+        IndicatorEngine engine;
+        for (int i = 0; i < SERIES; i++) engine.add(cents(series[i]));
+        sink += engine.rsiX100();
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < ROUNDS / 10; r++) {
+        for (int i = 0; i < SERIES; i++) sink += recomputeAll(series, i);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double incrementalNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / (ROUNDS * SERIES);
+    double recomputeNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / (ROUNDS / 10 * SERIES);
+
+    // One day of 1-minute samples: AI every 5 minutes vs only on events (plus hourly)
+    const int DAY = 24 * 60;
+    IndicatorEngine engine;
+    double p = 97000.0;
+    int gated = 0, lastCall = -1000;
+    for (int minute = 0; minute < DAY; minute++) {
+        double shock = (minute >= 600 && minute < 620) ? -0.4 : 0.0;  // A 20 minute sell-off
+        p *= 1.0 + ((nextUniform() * 2.0 - 1.0) * 0.08 + shock) / 100.0;
+        engine.add(cents(p));
+
+        if (minute % 5 != 0) continue;  // AI job interval
+        bool warm = engine.ready();
+        if (!warm ? lastCall < 0 : (engine.peekEvents() != 0 || minute - lastCall >= 60)) {
+            gated++;
+            lastCall = minute;
+            engine.clearEvents();
+        }
+    }
+    int ungated = DAY / 5;
+
+    printf("\nIndicator update: %.0f ns/sample incremental, %.0f ns/sample recomputed (64-sample window)\n",
+           incrementalNs, recomputeNs);
+    printf("Engine state: %zu bytes\n", sizeof(IndicatorEngine));
+    printf("AI calls over a simulated day: %d every 5 min, %d gated by indicator events (%.0f%% fewer)\n",
+           ungated, gated, 100.0 - gated * 100.0 / ungated);
+
+    TEST_ASSERT_TRUE(incrementalNs < recomputeNs);
+    TEST_ASSERT_TRUE(sizeof(IndicatorEngine) < 256);
+    TEST_ASSERT_TRUE(gated * 2 < ungated);
+    TEST_ASSERT_TRUE(gated >= 24);  // The hourly floor still applies
+    (void)sink;
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_isqrt);
+    RUN_TEST(test_rsi_reference);
+    RUN_TEST(test_ema_macd_reference);
+    RUN_TEST(test_bands_and_volatility_reference);
+    RUN_TEST(test_sampling_interval);
+    RUN_TEST(test_local_signal);
+    RUN_TEST(test_events);
+    RUN_TEST(test_benchmark);
+
+    return UNITY_END();
+}
@@ -0,0 +1,103 @@
+#include <unity.h>
+#include <string.h>
+#include "api/MarketSignals.h"
+#include "api/AIPrompts.h"
+
+struct Market {
+    float priceUSD;
+    float priceEUR;
+    unsigned long blockHeight;
+    int blockTxCount;
+    unsigned long mempoolCount;
+    float mempoolSize;
+    int feeFast, feeMedium, feeSlow;
+};
+
+static const Market MARKET = {97000.0f, 89000.0f, 870000, 3120, 45231, 35.5f, 12, 8, 3};
+
+static char body[AI_REQUEST_BUFFER_SIZE];
+
+// Test: Request asks for JSON output with a capped token budget
+void test_request_generation_config() {
+    JsonBodyWriter out(body, sizeof(body));
+    TEST_ASSERT_TRUE(writeMarketSignalsRequest(out, MARKET));
+
+    DynamicJsonDocument doc(4096);
+    TEST_ASSERT_FALSE(deserializeJson(doc, out.c_str()));
+    const char* prompt = doc["contents"][0]["parts"][0]["text"].as<const char*>();
+    TEST_ASSERT_NOT_NULL(strstr(prompt, "BTC Price: $97000.00 USD"));
+    TEST_ASSERT_EQUAL_STRING("application/json", doc["generationConfig"]["responseMimeType"].as<const char*>());
+    TEST_ASSERT_EQUAL(SIGNALS_MAX_OUTPUT_TOKENS, doc["generationConfig"]["maxOutputTokens"].as<int>());
+}
+
+// Test: Schema pins the allowed words and requires every key
+void test_request_schema() {
+    JsonBodyWriter out(body, sizeof(body));
+    TEST_ASSERT_TRUE(writeMarketSignalsRequest(out, MARKET));
+
+    DynamicJsonDocument doc(4096);
+    TEST_ASSERT_FALSE(deserializeJson(doc, out.c_str()));
+    JsonObject schema = doc["generationConfig"]["responseSchema"];
+    TEST_ASSERT_EQUAL_STRING("OBJECT", schema["type"].as<const char*>());
+    TEST_ASSERT_EQUAL_STRING("WAIT", schema["properties"]["dca"]["enum"][2].as<const char*>());
+    TEST_ASSERT_EQUAL_STRING("HOLD", schema["properties"]["signal"]["enum"][2].as<const char*>());
+    TEST_ASSERT_EQUAL_STRING("INTEGER", schema["properties"]["confidence"]["type"].as<const char*>());
+    TEST_ASSERT_EQUAL(4, schema["required"].size());
+}
+
+// Test: A well-formed reply fills every field
+void test_parse_valid_reply() {
+    MarketSignals s;
+    TEST_ASSERT_TRUE(parseMarketSignals(
+        "{\"dca\":\"BUY\",\"signal\":\"HOLD\",\"timeframe\":\"1h-4h\",\"confidence\":72}", s));
+
+    TEST_ASSERT_EQUAL_STRING("BUY", s.dca);
+    TEST_ASSERT_EQUAL_STRING("HOLD", s.signal);
+    TEST_ASSERT_EQUAL_STRING("1h-4h", s.timeframe);
+    TEST_ASSERT_EQUAL_UINT8(72, s.confidence);
+}
+
+// Test: Words outside the allowed set are rejected and leave the output untouched
+void test_parse_rejects_unknown_word() {
+    MarketSignals s;
+    strcpy(s.dca, "WAIT");
+    TEST_ASSERT_FALSE(parseMarketSignals(
+        "{\"dca\":\"MAYBE\",\"signal\":\"BUY\",\"timeframe\":\"1h-4h\",\"confidence\":50}", s));
+    TEST_ASSERT_FALSE(parseMarketSignals("{\"dca\":\"BUY\",\"confidence\":50}", s));
+    TEST_ASSERT_EQUAL_STRING("WAIT", s.dca);
+}
+
+// Test: Missing timeframe falls back to the default, confidence is clamped
+void test_parse_defaults_and_clamp() {
+    MarketSignals s;
+    TEST_ASSERT_TRUE(parseMarketSignals("{\"dca\":\"SELL\",\"signal\":\"SELL\",\"confidence\":250}", s));
+    TEST_ASSERT_EQUAL_STRING(SIGNALS_DEFAULT_TIMEFRAME, s.timeframe);
+    TEST_ASSERT_EQUAL_UINT8(100, s.confidence);
+
+    TEST_ASSERT_TRUE(parseMarketSignals("{\"dca\":\"SELL\",\"signal\":\"BUY\",\"confidence\":-5}", s));
+    TEST_ASSERT_EQUAL_UINT8(0, s.confidence);
+}
+
+// Test: Prose or truncated JSON is not accepted
+void test_parse_malformed() {
+    MarketSignals s;
+    TEST_ASSERT_FALSE(parseMarketSignals("DCA: BUY, Signal: HOLD", s));
+    TEST_ASSERT_FALSE(parseMarketSignals("{\"dca\":\"BUY\",\"sig", s));
+    TEST_ASSERT_FALSE(parseMarketSignals(nullptr, s));
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_request_generation_config);
+    RUN_TEST(test_request_schema);
+    RUN_TEST(test_parse_valid_reply);
+    RUN_TEST(test_parse_rejects_unknown_word);
+    RUN_TEST(test_parse_defaults_and_clamp);
+    RUN_TEST(test_parse_malformed);
+
+    return UNITY_END();
+}
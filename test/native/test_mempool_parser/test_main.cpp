@@ -0,0 +1,310 @@
+#include <unity.h>
+#include <stdio.h>
+#include <new>
+#include <string>
+#include <chrono>
+#include "api/MempoolStats.h"
+#include "api/BlockInfo.h"
+
+// ---------------------------------------------------------------------------
+// Heap accounting for the benchmark (counts every operator new in this binary)
+// ---------------------------------------------------------------------------
+static size_t heapCurrent = 0;
+static size_t heapPeak = 0;
+
+void* operator new(size_t size) {
+    size_t* p = (size_t*)malloc(size + sizeof(size_t));
+    if (p == nullptr) throw std::bad_alloc();
+    *p = size;
+    heapCurrent += size;
+    if (heapCurrent > heapPeak) heapPeak = heapCurrent;
+    return p + 1;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) return;
+    size_t* p = (size_t*)ptr - 1;
+    heapCurrent -= *p;
+    free(p);
+}
+
+static void resetHeapPeak() { heapPeak = heapCurrent; }
+
+// ---------------------------------------------------------------------------
+// Fixtures
+// ---------------------------------------------------------------------------
+
+// Socket stand-in: hands out at most segmentSize bytes per readBytes() call
+struct MemorySource {
+    const char* data;
+    size_t size;
+    size_t pos;
+    size_t segmentSize;
+
+    MemorySource(const char* d, size_t n, size_t segment = 1436)
+        : data(d), size(n), pos(0), segmentSize(segment) {}
+
+    size_t readBytes(char* out, size_t n) {
+        size_t copied = 0;
+        while (copied < n && pos < size) {
+            size_t take = size - pos;
+            if (take > n - copied) take = n - copied;
+            if (take > segmentSize) take = segmentSize;
+            memcpy(out + copied, data + pos, take);
+            pos += take;
+            copied += take;
+        }
+        return copied;
+    }
+};
+
+static char body[65536];
+static char chunked[70000];
+
+// Realistic /api/mempool body: fee_histogram sorted by descending fee rate
+static size_t buildMempoolBody(int entries, uint32_t& histogramVsize) {
+    size_t n = snprintf(body, sizeof(body),
+                        "{\"count\":45231,\"vsize\":28123456,\"total_fee\":5123456789,\"fee_histogram\":[");
+    histogramVsize = 0;
+    for (int i = 0; i < entries; i++) {
+        float fee = 150.0f / (1 + i * 0.25f);
+        uint32_t vsize = 50000 + (i % 7) * 1000;
+        histogramVsize += vsize;
+        n += snprintf(body + n, sizeof(body) - n, "%s[%.3f,%u]", i ? "," : "", fee, vsize);
+    }
+    n += snprintf(body + n, sizeof(body) - n, "]}");
+    return n;
+}
+
+// Wrap body in chunked transfer encoding with the given chunk size
+static size_t encodeChunked(const char* data, size_t size, size_t chunkSize) {
+    size_t n = 0;
+    for (size_t off = 0; off < size; off += chunkSize) {
+        size_t len = size - off < chunkSize ? size - off : chunkSize;
+        n += snprintf(chunked + n, sizeof(chunked) - n, "%zx\r\n", len);
+        memcpy(chunked + n, data + off, len);
+        n += len;
+        n += snprintf(chunked + n, sizeof(chunked) - n, "\r\n");
+    }
+    n += snprintf(chunked + n, sizeof(chunked) - n, "0\r\n\r\n");
+    return n;
+}
+
+// Previous approach: whole body in a growing string, then indexOf/substring
+static unsigned long legacyParse(MemorySource& src) {
+    std::string payload;
+    char segment[1436];
+    size_t got;
+    while ((got = src.readBytes(segment, sizeof(segment))) > 0) {
+        payload.append(segment, got);
+    }
+
+    size_t countStart = payload.find("\"count\":");
+    if (countStart == std::string::npos) return 0;
+    countStart += 8;
+    size_t countEnd = payload.find(',', countStart);
+    if (countEnd == std::string::npos) countEnd = payload.find('}', countStart);
+    std::string countStr = payload.substr(countStart, countEnd - countStart);
+    return strtoul(countStr.c_str(), nullptr, 10);
+}
+
+static bool streamingParse(MemorySource& src, bool isChunked, int32_t length, MempoolStats& stats) {
+    FeeHistogramTap tap;
+    HttpBodyReader<MemorySource> reader(src, isChunked, length, &tap);
+    return !parseMempoolStats(reader, tap, stats) && !reader.failed();
+}
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+// Test: Fee bins
+void test_fee_bins() {
+    TEST_ASSERT_EQUAL_INT(0, mempoolFeeBin(1.0f));
+    TEST_ASSERT_EQUAL_INT(1, mempoolFeeBin(2.0f));
+    TEST_ASSERT_EQUAL_INT(3, mempoolFeeBin(9.9f));
+    TEST_ASSERT_EQUAL_INT(5, mempoolFeeBin(20.0f));
+    TEST_ASSERT_EQUAL_INT(MEMPOOL_FEE_BINS - 1, mempoolFeeBin(2500.0f));
+}
+
+// Test: Tap bins histogram pairs regardless of how the bytes are split
+void test_tap_bins_histogram() {
+    const char* json = "{\"count\":3,\"fee_histogram\":[[120.5,1000],[15,2000],[ 1.0 , 3000 ]],\"x\":1}";
+
+    FeeHistogramTap tap;
+    for (const char* p = json; *p; p++) tap.feed(*p);
+
+    TEST_ASSERT_TRUE(tap.found());
+    TEST_ASSERT_EQUAL_UINT16(3, tap.getEntries());
+    TEST_ASSERT_EQUAL_UINT32(1000, tap.getBins()[mempoolFeeBin(120.5f)]);
+    TEST_ASSERT_EQUAL_UINT32(2000, tap.getBins()[mempoolFeeBin(15.0f)]);
+    TEST_ASSERT_EQUAL_UINT32(3000, tap.getBins()[0]);
+}
+
+// Test: Tap ignores the key inside strings and nested objects
+void test_tap_ignores_nested_key() {
+    const char* json = "{\"note\":\"fee_histogram\",\"inner\":{\"fee_histogram\":[[5,100]]},"
+                       "\"fee_histogram\":[[5,700]]}";
+
+    FeeHistogramTap tap;
+    tap.feed(json, strlen(json));
+
+    TEST_ASSERT_TRUE(tap.found());
+    TEST_ASSERT_EQUAL_UINT16(1, tap.getEntries());
+    TEST_ASSERT_EQUAL_UINT32(700, tap.getBins()[mempoolFeeBin(5.0f)]);
+}
+
+// Test: Content-Length body is parsed and the source is not read past the end
+void test_parse_content_length() {
+    uint32_t histogramVsize;
+    size_t size = buildMempoolBody(400, histogramVsize);
+    memcpy(body + size, "HTTP/1.1 200 OK", 15);  // Next response on the same socket
+
+    MemorySource src(body, size + 15);
+    MempoolStats stats;
+    TEST_ASSERT_TRUE(streamingParse(src, false, size, stats));
+
+    TEST_ASSERT_EQUAL_UINT32(45231, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(28123456, stats.vsize);
+    TEST_ASSERT_TRUE(stats.totalFee == 5123456789ULL);
+    TEST_ASSERT_EQUAL_UINT16(400, stats.histogramEntries);
+    TEST_ASSERT_EQUAL_size_t(size, src.pos);
+
+    uint32_t binned = 0;
+    for (int i = 0; i < MEMPOOL_FEE_BINS; i++) binned += stats.feeHistogram[i];
+    TEST_ASSERT_EQUAL_UINT32(histogramVsize, binned);
+}
+
+// Test: Chunked body with tiny TCP segments
+void test_parse_chunked_fragmented() {
+    uint32_t histogramVsize;
+    size_t size = buildMempoolBody(250, histogramVsize);
+    size_t encoded = encodeChunked(body, size, 1000);
+
+    MemorySource src(chunked, encoded, 7);
+    MempoolStats stats;
+    TEST_ASSERT_TRUE(streamingParse(src, true, -1, stats));
+
+    TEST_ASSERT_EQUAL_UINT32(45231, stats.count);
+    TEST_ASSERT_EQUAL_UINT16(250, stats.histogramEntries);
+    TEST_ASSERT_EQUAL_size_t(encoded, src.pos);  // Terminating chunk consumed
+}
+
+// Test: Truncated chunked body reports failure
+void test_parse_truncated_fails() {
+    uint32_t histogramVsize;
+    size_t size = buildMempoolBody(100, histogramVsize);
+    size_t encoded = encodeChunked(body, size, 512);
+
+    MemorySource src(chunked, encoded / 2);
+    MempoolStats stats;
+    TEST_ASSERT_FALSE(streamingParse(src, true, -1, stats));
+}
+
+// Abridged /api/block/:hash response, including fields the filter drops
+static const char* BLOCK_BODY =
+    "{\"id\":\"00000000000000000001c2a8e0e3b1e2f4d6a7b8c9d0e1f2a3b4c5d6e7f8a9b0\","
+    "\"height\":870123,\"version\":536870912,\"timestamp\":1731234567,"
+    "\"bits\":386089497,\"nonce\":1234567890,\"difficulty\":101646843652785.2,"
+    "\"merkle_root\":\"4a5e1e4baab89f3a32518a88c31bc87f618f76673e2cc77ab2127b7afdeda33b\","
+    "\"tx_count\":3512,\"size\":1623456,\"weight\":3993012,"
+    "\"previousblockhash\":\"00000000000000000000a1b2c3d4e5f60718293a4b5c6d7e8f9012345678abcd\","
+    "\"extras\":{\"reward\":318750000,\"feeRange\":[1,2,3,5,8,13,21,300],"
+    "\"pool\":{\"id\":111,\"name\":\"Foundry USA\",\"slug\":\"foundryusa\"}}}";
+
+// Test: Block header fields parsed from a chunked body
+void test_parse_block_info() {
+    size_t size = strlen(BLOCK_BODY);
+    size_t encoded = encodeChunked(BLOCK_BODY, size, 100);
+
+    MemorySource src(chunked, encoded, 13);
+    HttpBodyReader<MemorySource> reader(src, true, -1);
+    BlockInfo info;
+    DeserializationError error = parseBlockInfo(reader, info);
+
+    TEST_ASSERT_FALSE(error);
+    TEST_ASSERT_FALSE(reader.failed());
+    TEST_ASSERT_EQUAL_UINT32(870123, info.height);
+    TEST_ASSERT_EQUAL_STRING("00000000000000000001c2a8e0e3b1e2f4d6a7b8c9d0e1f2a3b4c5d6e7f8a9b0", info.hash);
+    TEST_ASSERT_EQUAL_UINT32(1731234567, info.timestamp);
+    TEST_ASSERT_EQUAL_UINT32(3512, info.txCount);
+    TEST_ASSERT_EQUAL_UINT32(1623456, info.size);
+    TEST_ASSERT_EQUAL_size_t(encoded, src.pos);  // Body fully drained for keep-alive
+}
+
+// Test: Block without a full-length id is rejected
+void test_parse_block_rejects_bad_id() {
+    const char* json = "{\"id\":\"abc\",\"height\":870123,\"tx_count\":1,\"size\":285}";
+    MemorySource src(json, strlen(json));
+    HttpBodyReader<MemorySource> reader(src, false, (int32_t)strlen(json));
+    BlockInfo info;
+
+    TEST_ASSERT_TRUE(parseBlockInfo(reader, info) == DeserializationError::InvalidInput);
+}
+
+// Test: Benchmark peak heap and parse time against String + indexOf
+void test_benchmark_vs_legacy() {
+    const int iterations = 50;
+    uint32_t histogramVsize;
+    size_t size = buildMempoolBody(1500, histogramVsize);  // ~30KB, busy mempool
+
+    size_t legacyPeak = 0;
+    size_t streamPeak = 0;
+    double legacyUs = 0;
+    double streamUs = 0;
+
+    for (int i = 0; i < iterations; i++) {
+        MemorySource src(body, size);
+        resetHeapPeak();
+        size_t base = heapCurrent;
+        auto t0 = std::chrono::steady_clock::now();
+        unsigned long count = legacyParse(src);
+        auto t1 = std::chrono::steady_clock::now();
+        legacyPeak = heapPeak - base;
+        legacyUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+        TEST_ASSERT_EQUAL_UINT32(45231, count);
+    }
+
+    for (int i = 0; i < iterations; i++) {
+        MemorySource src(body, size);
+        MempoolStats stats;
+        resetHeapPeak();
+        size_t base = heapCurrent;
+        auto t0 = std::chrono::steady_clock::now();
+        bool ok = streamingParse(src, false, size, stats);
+        auto t1 = std::chrono::steady_clock::now();
+        streamPeak = heapPeak - base;
+        streamUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+        TEST_ASSERT_TRUE(ok);
+    }
+
+    printf("\n/api/mempool parse, %zu byte body, %d runs\n", size, iterations);
+    printf("  %-22s peak heap %7zu B  %8.1f us/parse\n", "String + indexOf", legacyPeak, legacyUs / iterations);
+    printf("  %-22s peak heap %7zu B  %8.1f us/parse\n", "Filter + stream tap", streamPeak, streamUs / iterations);
+    printf("  Stack: reader %zu B, tap %zu B\n",
+           sizeof(HttpBodyReader<MemorySource>), sizeof(FeeHistogramTap));
+
+    // Legacy holds at least the whole body; streaming must not scale with it
+    TEST_ASSERT_TRUE(legacyPeak >= size);
+    TEST_ASSERT_TRUE(streamPeak < size / 10);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_fee_bins);
+    RUN_TEST(test_tap_bins_histogram);
+    RUN_TEST(test_tap_ignores_nested_key);
+    RUN_TEST(test_parse_content_length);
+    RUN_TEST(test_parse_chunked_fragmented);
+    RUN_TEST(test_parse_truncated_fails);
+    RUN_TEST(test_parse_block_info);
+    RUN_TEST(test_parse_block_rejects_bad_id);
+    RUN_TEST(test_benchmark_vs_legacy);
+
+    return UNITY_END();
+}
@@ -0,0 +1,231 @@
+#include <unity.h>
+#include <string.h>
+#include "network/MempoolSocketSession.h"
+
+// Messages captured from wss://mempool.space/api/v1/ws (trimmed)
+static const char* SUBSCRIBE_REPLY =
+    "{\"mempoolInfo\":{\"loaded\":true,\"size\":45231,\"bytes\":28123456,\"usage\":160000000,"
+    "\"total_fee\":1.23456789,\"maxmempool\":300000000,\"mempoolminfee\":0.00001},"
+    "\"vBytesPerSecond\":1850,"
+    "\"blocks\":[{\"id\":\"00000000000000000001aaaa\",\"height\":870121,\"timestamp\":1700000000,\"tx_count\":3100,\"size\":1600000},"
+    "{\"id\":\"00000000000000000002bbbb\",\"height\":870123,\"timestamp\":1700001200,\"tx_count\":4200,\"size\":1700000},"
+    "{\"id\":\"00000000000000000003cccc\",\"height\":870122,\"timestamp\":1700000600,\"tx_count\":2800,\"size\":1500000}],"
+    "\"conversions\":{\"time\":1700001234,\"USD\":97123,\"EUR\":89456,\"GBP\":76543},"
+    "\"fees\":{\"fastestFee\":12,\"halfHourFee\":8,\"hourFee\":5,\"economyFee\":3,\"minimumFee\":1},"
+    "\"mempool-blocks\":[{\"blockSize\":1600000,\"blockVSize\":997000,\"nTx\":3400,\"totalFees\":12000000,"
+    "\"medianFee\":9.5,\"feeRange\":[5,6,8,10,15,30,120]}]}";
+
+static const char* STATS_PUSH =
+    "{\"mempoolInfo\":{\"size\":45500,\"bytes\":28300000,\"total_fee\":1.25},"
+    "\"vBytesPerSecond\":1700,\"fees\":{\"fastestFee\":14,\"halfHourFee\":9,\"hourFee\":6},"
+    "\"da\":{\"progressPercent\":42.5,\"difficultyChange\":1.2}}";
+
+static const char* BLOCK_PUSH =
+    "{\"block\":{\"id\":\"00000000000000000004dddd\",\"height\":870124,\"timestamp\":1700001800,"
+    "\"tx_count\":3900,\"size\":1650000,\"extras\":{\"medianFee\":10,\"reward\":315000000}},"
+    "\"mempoolInfo\":{\"size\":41000,\"bytes\":25000000,\"total_fee\":1.1}}";
+
+/**
+ * Local stand-in for the mempool.space WebSocket server.
+ *
+ * Replays the events MempoolSocket would receive from the WebSocket library
+ * (connect, text frames, disconnect) on a simulated clock.
+ */
+struct StandInServer {
+    MempoolSocketSession& session;
+    uint32_t now;
+    const char* lastSubscribe;
+    MempoolPush lastPush;
+
+    explicit StandInServer(MempoolSocketSession& s) : session(s), now(0), lastSubscribe(nullptr) {
+        memset(&lastPush, 0, sizeof(lastPush));
+    }
+
+    void accept() { lastSubscribe = session.onConnected(now); }
+
+    uint8_t send(const char* json) {
+        uint8_t flags = parseMempoolSocketMessage(json, strlen(json), lastPush);
+        session.onMessage(flags, now);
+        return flags;
+    }
+
+    uint32_t drop() { return session.onDisconnected(now); }
+    void advance(uint32_t ms) { now += ms; }
+};
+
+// Test: Subscribe reply fills every topic and picks the tip block
+void test_parse_subscribe_reply() {
+    MempoolPush push;
+    uint8_t flags = parseMempoolSocketMessage(SUBSCRIBE_REPLY, strlen(SUBSCRIBE_REPLY), push);
+
+    TEST_ASSERT_EQUAL_UINT8(PUSH_HAS_PRICE | PUSH_HAS_BLOCK | PUSH_HAS_MEMPOOL, flags);
+    TEST_ASSERT_EQUAL_FLOAT(97123.0f, push.priceUSD);
+    TEST_ASSERT_EQUAL_FLOAT(89456.0f, push.priceEUR);
+    TEST_ASSERT_EQUAL_UINT32(870123, push.blockHeight);
+    TEST_ASSERT_EQUAL_STRING("00000000000000000002bbbb", push.blockHash);
+    TEST_ASSERT_EQUAL_INT(4200, push.blockTxCount);
+    TEST_ASSERT_EQUAL_UINT32(45231, push.mempoolCount);
+    TEST_ASSERT_EQUAL_UINT32(28123456, push.mempoolVsize);
+    TEST_ASSERT_TRUE(push.mempoolTotalFee == 123456789ULL);
+    TEST_ASSERT_TRUE(push.hasFees);
+    TEST_ASSERT_EQUAL_INT(12, push.feeFast);
+    TEST_ASSERT_EQUAL_INT(5, push.feeSlow);
+}
+
+// Test: Stats push updates only mempool/fees
+void test_parse_stats_push() {
+    MempoolPush push;
+    uint8_t flags = parseMempoolSocketMessage(STATS_PUSH, strlen(STATS_PUSH), push);
+
+    TEST_ASSERT_EQUAL_UINT8(PUSH_HAS_MEMPOOL, flags);
+    TEST_ASSERT_EQUAL_UINT32(45500, push.mempoolCount);
+    TEST_ASSERT_EQUAL_INT(14, push.feeFast);
+    TEST_ASSERT_EQUAL_INT(9, push.feeMedium);
+}
+
+// Test: New block push
+void test_parse_block_push() {
+    MempoolPush push;
+    uint8_t flags = parseMempoolSocketMessage(BLOCK_PUSH, strlen(BLOCK_PUSH), push);
+
+    TEST_ASSERT_EQUAL_UINT8(PUSH_HAS_BLOCK | PUSH_HAS_MEMPOOL, flags);
+    TEST_ASSERT_EQUAL_UINT32(870124, push.blockHeight);
+    TEST_ASSERT_EQUAL_UINT32(1700001800, push.blockTime);
+    TEST_ASSERT_FALSE(push.hasFees);
+}
+
+// Test: Unrelated and malformed frames are ignored
+void test_parse_ignores_other_messages() {
+    MempoolPush push;
+    const char* pong = "{\"pong\":true}";
+    const char* broken = "{\"block\":{\"height\":";
+
+    TEST_ASSERT_EQUAL_UINT8(0, parseMempoolSocketMessage(pong, strlen(pong), push));
+    TEST_ASSERT_EQUAL_UINT8(0, parseMempoolSocketMessage(broken, strlen(broken), push));
+}
+
+// Test: Backoff doubles, is capped, jitters downward only, and resets
+void test_backoff_growth_and_cap() {
+    ReconnectBackoff backoff(1000, 60000, 42);
+
+    uint32_t expected[] = {1000, 2000, 4000, 8000, 16000, 32000, 60000, 60000};
+    for (int i = 0; i < 8; i++) {
+        uint32_t delay = backoff.nextDelay();
+        TEST_ASSERT_TRUE(delay <= expected[i]);
+        TEST_ASSERT_TRUE(delay >= expected[i] - expected[i] / 4);
+    }
+
+    backoff.reset();
+    TEST_ASSERT_TRUE(backoff.nextDelay() <= 1000);
+}
+
+// Test: Backoff never overflows after many failures
+void test_backoff_many_failures() {
+    ReconnectBackoff backoff(1000, 60000, 7);
+    for (int i = 0; i < 100; i++) {
+        uint32_t delay = backoff.nextDelay();
+        TEST_ASSERT_TRUE(delay > 0 && delay <= 60000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(100, backoff.getAttempts());
+}
+
+// Test: Connect sends the subscription and initial data covers every topic
+void test_session_subscribe_and_cover() {
+    MempoolSocketSession session(1);
+    StandInServer server(session);
+
+    TEST_ASSERT_FALSE(session.covers(PUSH_TOPIC_MEMPOOL, server.now));
+
+    server.accept();
+    TEST_ASSERT_EQUAL_STRING(MEMPOOL_WS_SUBSCRIBE, server.lastSubscribe);
+    TEST_ASSERT_FALSE(session.covers(PUSH_TOPIC_BLOCK, server.now));  // Nothing received yet
+
+    server.send(SUBSCRIBE_REPLY);
+    TEST_ASSERT_TRUE(session.covers(PUSH_TOPIC_PRICE, server.now));
+    TEST_ASSERT_TRUE(session.covers(PUSH_TOPIC_BLOCK, server.now));
+    TEST_ASSERT_TRUE(session.covers(PUSH_TOPIC_MEMPOOL, server.now));
+}
+
+// Test: Topics fall back to polling when they go quiet
+void test_session_stale_topics_fall_back() {
+    MempoolSocketSession session(1);
+    StandInServer server(session);
+    server.accept();
+    server.send(SUBSCRIBE_REPLY);
+
+    // Stats keep flowing every 5s for 2 minutes
+    for (int i = 0; i < 24; i++) {
+        server.advance(5000);
+        server.send(STATS_PUSH);
+    }
+    TEST_ASSERT_TRUE(session.covers(PUSH_TOPIC_MEMPOOL, server.now));
+    TEST_ASSERT_TRUE(session.covers(PUSH_TOPIC_BLOCK, server.now));
+    TEST_ASSERT_TRUE(session.covers(PUSH_TOPIC_PRICE, server.now));
+
+    // Price not refreshed for 10+ minutes
+    for (int i = 0; i < 100; i++) {
+        server.advance(5000);
+        server.send(STATS_PUSH);
+    }
+    TEST_ASSERT_FALSE(session.covers(PUSH_TOPIC_PRICE, server.now));
+    TEST_ASSERT_TRUE(session.covers(PUSH_TOPIC_MEMPOOL, server.now));
+
+    // Server goes silent: everything polls
+    server.advance(MEMPOOL_WS_SILENCE_MS + 1);
+    TEST_ASSERT_FALSE(session.isLive(server.now));
+    TEST_ASSERT_FALSE(session.covers(PUSH_TOPIC_BLOCK, server.now));
+    TEST_ASSERT_FALSE(session.covers(PUSH_TOPIC_MEMPOOL, server.now));
+}
+
+// Test: Disconnect, backoff and resubscribe
+void test_session_reconnect_cycle() {
+    MempoolSocketSession session(3);
+    StandInServer server(session);
+    server.accept();
+    server.send(SUBSCRIBE_REPLY);
+
+    uint32_t first = server.drop();
+    TEST_ASSERT_FALSE(session.isConnected());
+    TEST_ASSERT_FALSE(session.covers(PUSH_TOPIC_BLOCK, server.now));
+    TEST_ASSERT_TRUE(first <= MEMPOOL_WS_BACKOFF_BASE);
+
+    // Two failed attempts grow the delay
+    server.advance(first);
+    server.drop();
+    server.advance(2000);
+    uint32_t third = server.drop();
+    TEST_ASSERT_TRUE(third > first);
+    TEST_ASSERT_EQUAL_UINT32(1, session.getDisconnects());  // Failed attempts are not disconnects
+    TEST_ASSERT_EQUAL_UINT32(3, session.getFailedAttempts());
+
+    // Reconnect: fresh subscription, topics must be re-received
+    server.advance(third);
+    server.accept();
+    TEST_ASSERT_EQUAL_UINT32(0, session.getFailedAttempts());
+    TEST_ASSERT_FALSE(session.covers(PUSH_TOPIC_MEMPOOL, server.now));
+
+    server.send(BLOCK_PUSH);
+    TEST_ASSERT_EQUAL_UINT32(870124, server.lastPush.blockHeight);
+    TEST_ASSERT_TRUE(session.covers(PUSH_TOPIC_BLOCK, server.now));
+    TEST_ASSERT_EQUAL_UINT32(2, session.getConnects());
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_parse_subscribe_reply);
+    RUN_TEST(test_parse_stats_push);
+    RUN_TEST(test_parse_block_push);
+    RUN_TEST(test_parse_ignores_other_messages);
+    RUN_TEST(test_backoff_growth_and_cap);
+    RUN_TEST(test_backoff_many_failures);
+    RUN_TEST(test_session_subscribe_and_cover);
+    RUN_TEST(test_session_stale_topics_fall_back);
+    RUN_TEST(test_session_reconnect_cycle);
+
+    return UNITY_END();
+}
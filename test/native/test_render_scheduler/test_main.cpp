@@ -0,0 +1,223 @@
+#include <unity.h>
+#include <stdio.h>
+#include "screens/RenderScheduler.h"
+#include "screens/DragScroll.h"
+
+static const uint32_t TICK = RENDER_FRAME_BUDGET_US;
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// ========== Pacing ==========
+
+// Test: Invalidations between two ticks render as one frame with all reasons
+void test_coalesces_invalidations(void) {
+    RenderScheduler s;
+    uint8_t reasons = 0;
+    TEST_ASSERT_FALSE(s.due(1000, reasons));  // Nothing to draw
+
+    s.invalidate(RENDER_DATA);
+    TEST_ASSERT_TRUE(s.due(1000, reasons));   // First frame renders at once
+    TEST_ASSERT_EQUAL_UINT8(RENDER_DATA, reasons);
+
+    s.invalidate(RENDER_TOUCH);
+    s.invalidate(RENDER_TOUCH);
+    s.invalidate(RENDER_CLOCK);
+    TEST_ASSERT_FALSE(s.due(1000 + TICK / 2, reasons));
+    TEST_ASSERT_TRUE(s.pending());
+    TEST_ASSERT_TRUE(s.due(1000 + TICK, reasons));
+    TEST_ASSERT_EQUAL_UINT8(RENDER_TOUCH | RENDER_CLOCK, reasons);
+    TEST_ASSERT_FALSE(s.due(1000 + TICK, reasons));
+
+    TEST_ASSERT_EQUAL_UINT32(4, s.invalidationCount());
+    TEST_ASSERT_EQUAL_UINT32(1, s.framesFor(1));  // Touch
+    TEST_ASSERT_EQUAL_UINT32(1, s.framesFor(0));  // Data
+}
+
+// Test: A drag invalidating every loop renders exactly once per tick, on the tick
+void test_steady_cadence(void) {
+    RenderScheduler s;
+    uint8_t reasons;
+    uint32_t frames = 0;
+    uint32_t lastFrameUs = 0;
+    bool cadenceKept = true;
+
+    // Loop iterations land at odd times (1.3 ms apart), frames must not drift with them
+    for (uint32_t now = 500000; now < 1500000; now += 1300) {
+        s.invalidate(RENDER_TOUCH);
+        if (s.due(now, reasons)) {
+            if (frames > 0 && now - lastFrameUs > TICK + 1300) cadenceKept = false;
+            frames++;
+            lastFrameUs = now;
+        }
+    }
+    printf("Drag for 1s, a loop every 1.3ms: %u frames\n", frames);
+    TEST_ASSERT_UINT32_WITHIN(1, 60, frames);
+    TEST_ASSERT_TRUE(cadenceKept);
+}
+
+// Test: After an idle gap or a frame longer than a tick, the phase restarts
+void test_rephase(void) {
+    RenderScheduler s;
+    uint8_t reasons;
+    s.invalidate(RENDER_DATA);
+    TEST_ASSERT_TRUE(s.due(0, reasons));
+
+    // Idle 5 s: the next invalidation renders immediately, no burst of missed ticks
+    s.invalidate(RENDER_DATA);
+    TEST_ASSERT_TRUE(s.due(5000000, reasons));
+    s.invalidate(RENDER_TOUCH);
+    TEST_ASSERT_FALSE(s.due(5000000 + TICK - 1, reasons));
+    TEST_ASSERT_TRUE(s.due(5000000 + TICK, reasons));
+
+    // A 40 ms frame: the next one follows when it ends, then a tick later
+    uint32_t end = 5000000 + TICK + 40000;
+    s.invalidate(RENDER_TOUCH);
+    TEST_ASSERT_TRUE(s.due(end, reasons));
+    s.invalidate(RENDER_TOUCH);
+    TEST_ASSERT_FALSE(s.due(end + TICK - 1, reasons));
+    TEST_ASSERT_TRUE(s.due(end + TICK, reasons));
+}
+
+// Test: Sleep time for the main loop
+void test_until_next_tick(void) {
+    RenderScheduler s;
+    uint8_t reasons;
+    TEST_ASSERT_EQUAL_UINT32(TICK, s.untilNextTickUs(0));  // Idle: a whole tick
+
+    s.invalidate(RENDER_LAYOUT);
+    TEST_ASSERT_EQUAL_UINT32(0, s.untilNextTickUs(0));     // First frame is due now
+    TEST_ASSERT_TRUE(s.due(100, reasons));
+    TEST_ASSERT_EQUAL_UINT32(TICK - 4000, s.untilNextTickUs(4100));
+
+    // Tick passed with nothing to draw: sleep a tick; something pending: don't sleep
+    TEST_ASSERT_EQUAL_UINT32(TICK, s.untilNextTickUs(100 + TICK + 10));
+    s.invalidate(RENDER_DATA);
+    TEST_ASSERT_EQUAL_UINT32(0, s.untilNextTickUs(100 + TICK + 10));
+
+    // Switching screens drops what the old one asked for
+    s.cancel();
+    TEST_ASSERT_FALSE(s.due(100 + TICK + 10, reasons));
+}
+
+// Test: micros() wrap between frames
+void test_micros_wrap(void) {
+    RenderScheduler s;
+    uint8_t reasons;
+    s.invalidate(RENDER_TOUCH);
+    TEST_ASSERT_TRUE(s.due(0xFFFFF000u, reasons));
+    s.invalidate(RENDER_TOUCH);
+    TEST_ASSERT_FALSE(s.due(0x00000100u, reasons));
+    TEST_ASSERT_TRUE(s.due(0xFFFFF000u + TICK, reasons));
+}
+
+// ========== Histogram ==========
+
+// Test: Buckets, percentiles and frames over budget
+void test_histogram(void) {
+    FrameTimeHistogram h;
+    TEST_ASSERT_EQUAL_UINT32(0, h.percentileUs(50));
+
+    TEST_ASSERT_EQUAL(0, FrameTimeHistogram::bucketOf(999));
+    TEST_ASSERT_EQUAL(1, FrameTimeHistogram::bucketOf(1000));
+    TEST_ASSERT_EQUAL(5, FrameTimeHistogram::bucketOf(TICK - 1));
+    TEST_ASSERT_EQUAL(6, FrameTimeHistogram::bucketOf(TICK));
+    TEST_ASSERT_EQUAL(RENDER_HIST_BUCKETS - 1, FrameTimeHistogram::bucketOf(250000));
+
+    // 90 data/clock frames of 3 ms, 8 drag frames of 14 ms, 2 long ones
+    for (int i = 0; i < 90; i++) h.record(3000);
+    for (int i = 0; i < 8; i++) h.record(14000);
+    h.record(30000);
+    h.record(180000);
+
+    TEST_ASSERT_EQUAL_UINT32(100, h.frameCount());
+    TEST_ASSERT_EQUAL_UINT32(90, h.count(2));
+    TEST_ASSERT_EQUAL_UINT32(4000, h.percentileUs(50));
+    TEST_ASSERT_EQUAL_UINT32(TICK, h.percentileUs(95));
+    TEST_ASSERT_EQUAL_UINT32(33333, h.percentileUs(99));
+    TEST_ASSERT_EQUAL_UINT32(180000, h.percentileUs(100));  // Slowest bucket reports the max
+    TEST_ASSERT_EQUAL_UINT32(2, h.overBudget());
+    TEST_ASSERT_EQUAL_UINT32((90 * 3000 + 8 * 14000 + 30000 + 180000) / 100, h.avgUs());
+    TEST_ASSERT_EQUAL_UINT32(180000, h.maxUs());
+
+    h.clear();
+    TEST_ASSERT_EQUAL_UINT32(0, h.frameCount());
+    TEST_ASSERT_EQUAL_UINT32(0, h.overBudget());
+}
+
+// Test: Frames reported to the scheduler land in its histogram
+void test_frame_done(void) {
+    RenderScheduler s;
+    uint8_t reasons;
+    s.invalidate(RENDER_DATA);
+    TEST_ASSERT_TRUE(s.due(0, reasons));
+    s.frameDone(2500);
+
+    TEST_ASSERT_EQUAL_UINT32(1, s.frameTimes().frameCount());
+    TEST_ASSERT_EQUAL_UINT32(1, s.frameTimes().count(2));
+}
+
+// ========== Drag ==========
+
+// Test: First point anchors, later points scroll, clamped; release ends the gesture
+void test_drag_scroll(void) {
+    DragScroll drag;
+    TEST_ASSERT_FALSE(drag.dragging());
+    TEST_ASSERT_EQUAL(100, drag.move(200, 100, 412));  // Anchor only
+    TEST_ASSERT_TRUE(drag.dragging());
+    TEST_ASSERT_EQUAL(130, drag.move(170, 100, 412));  // Finger up 30px: content scrolls down
+    TEST_ASSERT_EQUAL(0, drag.move(400, 130, 412));    // Clamped at the top
+    TEST_ASSERT_EQUAL(412, drag.move(-300, 0, 412));   // And at the bottom
+
+    drag.release();
+    TEST_ASSERT_FALSE(drag.dragging());
+    TEST_ASSERT_EQUAL(412, drag.move(50, 412, 412));   // New gesture: no jump from the old point
+}
+
+// Test: Consecutive moves across paced frames all scroll, whatever else invalidates
+void test_drag_across_frames(void) {
+    RenderScheduler s;
+    DragScroll drag;
+    uint8_t reasons;
+    int offset = 0;
+    int frames = 0;
+    bool everyMoveScrolled = true;
+
+    // Touch down, then 60 moves of 3px up every 4ms; data and clock land mid-drag
+    uint32_t now = 1000000;
+    offset = drag.move(300, offset, 1000);
+    for (int i = 1; i <= 60; i++) {
+        now += 4000;
+        int before = offset;
+        offset = drag.move((int16_t)(300 - 3 * i), offset, 1000);
+        if (offset != before + 3) everyMoveScrolled = false;
+        s.invalidate(RENDER_TOUCH);
+        if (i == 20) s.invalidate(RENDER_DATA);
+        if (i == 40) s.invalidate(RENDER_CLOCK);
+        if (s.due(now, reasons)) frames++;  // Rendering leaves the drag alone
+    }
+    drag.release();
+
+    TEST_ASSERT_TRUE(everyMoveScrolled);
+    TEST_ASSERT_EQUAL(180, offset);
+    TEST_ASSERT_UINT32_WITHIN(1, 240000 / TICK, frames);  // One frame per tick, not per move
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_coalesces_invalidations);
+    RUN_TEST(test_steady_cadence);
+    RUN_TEST(test_rephase);
+    RUN_TEST(test_until_next_tick);
+    RUN_TEST(test_micros_wrap);
+    RUN_TEST(test_histogram);
+    RUN_TEST(test_frame_done);
+    RUN_TEST(test_drag_scroll);
+    RUN_TEST(test_drag_across_frames);
+
+    return UNITY_END();
+}
@@ -0,0 +1,256 @@
+#include <unity.h>
+#include <stdio.h>
+#include <new>
+#include <string>
+#include <chrono>
+#include "api/AIPrompts.h"
+
+// ---------------------------------------------------------------------------
+// Heap accounting for the benchmark (counts every operator new in this binary)
+// ---------------------------------------------------------------------------
+static size_t heapCurrent = 0;
+static size_t heapPeak = 0;
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    size_t* p = (size_t*)malloc(size + sizeof(size_t));
+    if (p == nullptr) throw std::bad_alloc();
+    *p = size;
+    heapCurrent += size;
+    allocations++;
+    if (heapCurrent > heapPeak) heapPeak = heapCurrent;
+    return p + 1;
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr == nullptr) return;
+    size_t* p = (size_t*)ptr - 1;
+    heapCurrent -= *p;
+    free(p);
+}
+
+static void resetHeapPeak() { heapPeak = heapCurrent; }
+
+// ---------------------------------------------------------------------------
+// Fixtures
+// ---------------------------------------------------------------------------
+
+// Same field names as BTCData (which needs Arduino.h)
+struct Market {
+    float priceUSD;
+    float priceEUR;
+    unsigned long blockHeight;
+    int blockTxCount;
+    unsigned long mempoolCount;
+    float mempoolSize;
+    int feeFast, feeMedium, feeSlow;
+};
+
+static const Market MARKET = {97123.45f, 89456.10f, 870000, 3120, 45231, 35.5f, 12, 8, 3};
+
+static char buffer[AI_REQUEST_BUFFER_SIZE];
+
+// Old GeminiClient approach: String concatenation, then a JsonDocument copy
+// and a serialized String (modelled with std::string and an escaped copy)
+static std::string legacyNewsBody(const Market& data) {
+    char num[32];
+    std::string prompt = "You are a Bitcoin market analyst. Based on the following real-time data, ";
+    prompt += "provide a concise market analysis (max 800 words):\n\n";
+    prompt += "CURRENT DATA:\n";
+    snprintf(num, sizeof(num), "%.2f", data.priceUSD);
+    prompt += "- BTC Price: $" + std::string(num) + " USD";
+    snprintf(num, sizeof(num), "%.2f", data.priceEUR);
+    prompt += " (€" + std::string(num) + " EUR)";
+    prompt += "\n";
+    prompt += "- Latest Block: #" + std::to_string(data.blockHeight);
+    prompt += " (" + std::to_string(data.blockTxCount) + " transactions)";
+    prompt += "\n";
+    prompt += "- Mempool: " + std::to_string(data.mempoolCount) + " pending transactions";
+    snprintf(num, sizeof(num), "%.2f", data.mempoolSize);
+    prompt += " (" + std::string(num) + " MB)";
+    prompt += "\n";
+    prompt += "- Network Fees: Fast=" + std::to_string(data.feeFast);
+    prompt += " Medium=" + std::to_string(data.feeMedium);
+    prompt += " Slow=" + std::to_string(data.feeSlow) + " sat/vB\n";
+    prompt += "\nProvide:\n";
+    prompt += "1. 📈 Market Summary (2-3 sentences)\n";
+    prompt += "2. 💡 Technical Analysis (key levels, trends)\n";
+    prompt += "3. 📊 Market Sentiment (bullish/bearish indicators)\n";
+    prompt += "4. ⚠️ Risk Assessment (volatility, warnings)\n";
+    prompt += "5. 🎯 Price Outlook (short-term forecast)\n\n";
+    prompt += "Format with clear sections using emoji headers. Be concise and actionable.";
+
+    std::string docCopy = prompt;  // part["text"] = prompt copies into the document
+    std::string body = "{\"contents\":[{\"parts\":[{\"text\":\"";
+    for (char c : docCopy) {
+        if (c == '\n') body += "\\n";
+        else if (c == '"') body += "\\\"";
+        else body += c;
+    }
+    body += "\"}]}],\"generationConfig\":{\"temperature\":0.7,\"maxOutputTokens\":1024}}";
+    return body;
+}
+
+// ---------------------------------------------------------------------------
+// Tests
+// ---------------------------------------------------------------------------
+
+// Test: Quotes, backslashes and control characters are escaped; UTF-8 passes through
+void test_escapes_text() {
+    JsonBodyWriter out(buffer, sizeof(buffer));
+    out.raw("\"").text("say \"hi\"\\\n\tend\x01 📈").raw("\"");
+
+    TEST_ASSERT_TRUE(out.ok());
+    TEST_ASSERT_EQUAL_STRING("\"say \\\"hi\\\"\\\\\\n\\tend\\u0001 📈\"", out.c_str());
+    TEST_ASSERT_EQUAL_size_t(strlen(out.c_str()), out.length());
+}
+
+// Test: Formatted text is escaped in place
+void test_escapes_formatted_text() {
+    JsonBodyWriter out(buffer, sizeof(buffer));
+    out.raw("[").textf("%s=%d\n", "\"fee\"", 12).rawf(",%d]", 7);
+
+    TEST_ASSERT_TRUE(out.ok());
+    TEST_ASSERT_EQUAL_STRING("[\\\"fee\\\"=12\\n,7]", out.c_str());
+}
+
+// Test: Overflow is reported, sticky, and never writes past the buffer
+void test_overflow_is_sticky() {
+    char small[24];
+    memset(small, 'X', sizeof(small));
+    JsonBodyWriter out(small, 16);
+
+    out.raw("{\"text\":\"").text("0123456789");
+    TEST_ASSERT_FALSE(out.ok());
+    out.raw("}");
+    TEST_ASSERT_FALSE(out.ok());
+    TEST_ASSERT_TRUE(out.length() < 16);
+    for (size_t i = 16; i < sizeof(small); i++) {
+        TEST_ASSERT_EQUAL_INT('X', small[i]);
+    }
+
+    // Escaping that no longer fits fails too, even if the raw text did
+    JsonBodyWriter tight(small, 16);
+    tight.textf("%s", "\"\"\"\"\"\"\"\"\"");
+    TEST_ASSERT_FALSE(tight.ok());
+
+    out.reset();
+    TEST_ASSERT_TRUE(out.raw("{}").ok());
+    TEST_ASSERT_EQUAL_STRING("{}", small);
+}
+
+// Test: News request is valid JSON and carries the market data
+void test_news_request() {
+    JsonBodyWriter out(buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(writeGeminiNewsRequest(out, MARKET));
+
+    DynamicJsonDocument doc(8192);
+    TEST_ASSERT_FALSE(deserializeJson(doc, out.c_str()));
+    const char* prompt = doc["contents"][0]["parts"][0]["text"].as<const char*>();
+    TEST_ASSERT_NOT_NULL(prompt);
+    TEST_ASSERT_NOT_NULL(strstr(prompt, "- BTC Price: $97123.45 USD (€89456.10 EUR)\n"));
+    TEST_ASSERT_NOT_NULL(strstr(prompt, "- Latest Block: #870000 (3120 transactions)\n"));
+    TEST_ASSERT_NOT_NULL(strstr(prompt, "Fast=12 Medium=8 Slow=3 sat/vB"));
+    TEST_ASSERT_EQUAL(GEMINI_MAX_OUTPUT_TOKENS, doc["generationConfig"]["maxOutputTokens"].as<int>());
+}
+
+// Test: OpenAI request is valid JSON with model and both messages
+void test_openai_request() {
+    JsonBodyWriter out(buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(writeOpenAITradingRequest(out, "gpt-3.5-turbo", MARKET));
+
+    DynamicJsonDocument doc(8192);
+    TEST_ASSERT_FALSE(deserializeJson(doc, out.c_str()));
+    TEST_ASSERT_EQUAL_STRING("gpt-3.5-turbo", doc["model"].as<const char*>());
+    TEST_ASSERT_EQUAL(OPENAI_MAX_TOKENS, doc["max_tokens"].as<int>());
+    TEST_ASSERT_EQUAL_STRING("system", doc["messages"][0]["role"].as<const char*>());
+    const char* prompt = doc["messages"][1]["content"].as<const char*>();
+    TEST_ASSERT_NOT_NULL(strstr(prompt, "- Block Height: 870000\n"));
+    TEST_ASSERT_NOT_NULL(strstr(prompt, "Confidence: [0-100]%\n"));
+}
+
+// Test: OpenAI market signals request asks for JSON mode and carries the shared prompt
+void test_openai_signals_request() {
+    JsonBodyWriter out(buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(writeOpenAIMarketSignalsRequest(out, "gpt-3.5-turbo", MARKET));
+
+    DynamicJsonDocument doc(8192);
+    TEST_ASSERT_FALSE(deserializeJson(doc, out.c_str()));
+    TEST_ASSERT_EQUAL_STRING("json_object", doc["response_format"]["type"].as<const char*>());
+    TEST_ASSERT_EQUAL(SIGNALS_MAX_OUTPUT_TOKENS, doc["max_tokens"].as<int>());
+    TEST_ASSERT_NOT_NULL(strstr(doc["messages"][0]["content"].as<const char*>(), "\"dca\":\"BUY|SELL|WAIT\""));
+    const char* prompt = doc["messages"][1]["content"].as<const char*>();
+    TEST_ASSERT_NOT_NULL(strstr(prompt, "give a DCA (Dollar Cost Average) recommendation"));
+    TEST_ASSERT_NOT_NULL(strstr(prompt, "- BTC Price: $97123.45 USD\n"));
+}
+
+// Test: Benchmark heap use and build time against String concatenation
+void test_benchmark_vs_legacy() {
+    const int iterations = 200;
+
+    size_t legacyPeak = 0;
+    size_t legacyAllocs = 0;
+    double legacyUs = 0;
+    size_t legacySize = 0;
+
+    for (int i = 0; i < iterations; i++) {
+        resetHeapPeak();
+        size_t base = heapCurrent;
+        size_t allocBase = allocations;
+        auto t0 = std::chrono::steady_clock::now();
+        legacySize = legacyNewsBody(MARKET).size();
+        auto t1 = std::chrono::steady_clock::now();
+        legacyPeak = heapPeak - base;
+        legacyAllocs = allocations - allocBase;
+        legacyUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+    }
+
+    size_t writerAllocs = 0;
+    double writerUs = 0;
+    size_t writerSize = 0;
+
+    for (int i = 0; i < iterations; i++) {
+        JsonBodyWriter out(buffer, sizeof(buffer));
+        size_t allocBase = allocations;
+        auto t0 = std::chrono::steady_clock::now();
+        bool ok = writeGeminiNewsRequest(out, MARKET) &&
+                  writeMarketSignalsRequest(out, MARKET) &&
+                  writeOpenAITradingRequest(out, "gpt-3.5-turbo", MARKET) &&
+                  writeGeminiNewsRequest(out, MARKET);
+        auto t1 = std::chrono::steady_clock::now();
+        writerAllocs += allocations - allocBase;
+        writerUs += std::chrono::duration<double, std::micro>(t1 - t0).count() / 4;
+        writerSize = out.length();
+        TEST_ASSERT_TRUE(ok);
+    }
+
+    printf("\nGemini news body, %zu bytes, %d runs\n", writerSize, iterations);
+    printf("  %-22s %3zu allocs  peak heap %6zu B  %6.2f us/body\n", "String concatenation",
+           legacyAllocs, legacyPeak, legacyUs / iterations);
+    printf("  %-22s %3zu allocs  peak heap %6d B  %6.2f us/body\n", "JsonBodyWriter",
+           writerAllocs, 0, writerUs / iterations);
+    printf("  Request buffer %d B per provider (allocated once), writer %zu B on the stack\n",
+           AI_REQUEST_BUFFER_SIZE, sizeof(JsonBodyWriter));
+
+    TEST_ASSERT_EQUAL_size_t(0, writerAllocs);
+    TEST_ASSERT_TRUE(legacyAllocs > 10);
+    TEST_ASSERT_TRUE(legacyPeak >= legacySize);
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_escapes_text);
+    RUN_TEST(test_escapes_formatted_text);
+    RUN_TEST(test_overflow_is_sticky);
+    RUN_TEST(test_news_request);
+    RUN_TEST(test_openai_request);
+    RUN_TEST(test_openai_signals_request);
+    RUN_TEST(test_benchmark_vs_legacy);
+
+    return UNITY_END();
+}
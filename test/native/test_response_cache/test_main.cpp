@@ -0,0 +1,157 @@
+#include <unity.h>
+#include <stdio.h>
+#include "network/HttpResponseCache.h"
+
+#define PRICE_URL "https://mempool.space/api/v1/prices"
+#define FEES_URL "https://mempool.space/api/v1/fees/recommended"
+
+struct Price {
+    float usd;
+    float eur;
+};
+
+// Test: Nothing is cached before the first full response
+void test_empty_cache() {
+    HttpResponseCache cache;
+    Price p;
+
+    TEST_ASSERT_NULL(cache.lookup(PRICE_URL));
+    TEST_ASSERT_FALSE(cache.notModified(PRICE_URL, &p, sizeof(p), 0));
+    TEST_ASSERT_EQUAL_UINT8(0, cache.hitRate());
+}
+
+// Test: Validators are stored and returned for the next request
+void test_store_validators() {
+    HttpResponseCache cache;
+    Price p = {97123.0f, 89456.0f};
+
+    TEST_ASSERT_TRUE(cache.store(PRICE_URL, "\"abc123\"", "Wed, 21 Oct 2025 07:28:00 GMT", &p, sizeof(p), 100));
+
+    const HttpCacheEntry* e = cache.lookup(PRICE_URL);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_STRING("\"abc123\"", e->etag);
+    TEST_ASSERT_EQUAL_STRING("Wed, 21 Oct 2025 07:28:00 GMT", e->lastModified);
+    TEST_ASSERT_TRUE(e->hasValidators());
+}
+
+// Test: A 304 returns the last parsed value
+void test_not_modified_returns_value() {
+    HttpResponseCache cache;
+    Price stored = {97123.0f, 89456.0f};
+    cache.store(PRICE_URL, "\"v1\"", "", &stored, sizeof(stored), 0);
+
+    Price p = {0, 0};
+    TEST_ASSERT_TRUE(cache.notModified(PRICE_URL, &p, sizeof(p), 30000));
+    TEST_ASSERT_EQUAL_FLOAT(97123.0f, p.usd);
+    TEST_ASSERT_EQUAL_FLOAT(89456.0f, p.eur);
+}
+
+// Test: Size mismatch refuses the cached value
+void test_not_modified_size_mismatch() {
+    HttpResponseCache cache;
+    Price stored = {1, 2};
+    cache.store(PRICE_URL, "\"v1\"", "", &stored, sizeof(stored), 0);
+
+    float only;
+    TEST_ASSERT_FALSE(cache.notModified(PRICE_URL, &only, sizeof(only), 0));
+}
+
+// Test: Hit rate over a polling session
+void test_hit_rate() {
+    HttpResponseCache cache;
+    Price p = {1, 2};
+
+    // 1 full response then 3 not-modified, twice
+    for (int round = 0; round < 2; round++) {
+        cache.store(PRICE_URL, "\"v\"", "", &p, sizeof(p), round * 4);
+        for (int i = 0; i < 3; i++) {
+            cache.notModified(PRICE_URL, &p, sizeof(p), round * 4 + i + 1);
+        }
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(6, cache.getHits());
+    TEST_ASSERT_EQUAL_UINT32(2, cache.getMisses());
+    TEST_ASSERT_EQUAL_UINT8(75, cache.hitRate());
+}
+
+// Test: Responses without validators never send conditional headers
+void test_no_validators() {
+    HttpResponseCache cache;
+    Price p = {1, 2};
+    cache.store(PRICE_URL, "", nullptr, &p, sizeof(p), 0);
+
+    const HttpCacheEntry* e = cache.lookup(PRICE_URL);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_FALSE(e->hasValidators());
+}
+
+// Test: Over-long validators are dropped, never truncated
+void test_long_validator_dropped() {
+    HttpResponseCache cache;
+    char etag[HTTP_CACHE_VALIDATOR_LEN + 10];
+    memset(etag, 'x', sizeof(etag) - 1);
+    etag[sizeof(etag) - 1] = '\0';
+
+    Price p = {1, 2};
+    cache.store(PRICE_URL, etag, "", &p, sizeof(p), 0);
+    TEST_ASSERT_EQUAL_STRING("", cache.lookup(PRICE_URL)->etag);
+}
+
+// Test: Values larger than an entry are rejected
+void test_value_too_large() {
+    HttpResponseCache cache;
+    uint8_t big[HTTP_CACHE_VALUE_SIZE + 1] = {0};
+    TEST_ASSERT_FALSE(cache.store(PRICE_URL, "\"v\"", "", big, sizeof(big), 0));
+    TEST_ASSERT_NULL(cache.lookup(PRICE_URL));
+}
+
+// Test: Least recently used URL is evicted when full
+void test_lru_eviction() {
+    HttpResponseCache cache;
+    Price p = {1, 2};
+    char url[64];
+
+    for (int i = 0; i < HTTP_CACHE_ENTRIES; i++) {
+        snprintf(url, sizeof(url), "https://example.com/%d", i);
+        cache.store(url, "\"v\"", "", &p, sizeof(p), i * 10);
+    }
+    cache.notModified("https://example.com/0", &p, sizeof(p), 1000);  // Refresh 0
+
+    cache.store(FEES_URL, "\"f\"", "", &p, sizeof(p), 2000);
+
+    TEST_ASSERT_NOT_NULL(cache.lookup("https://example.com/0"));
+    TEST_ASSERT_NULL(cache.lookup("https://example.com/1"));
+    TEST_ASSERT_NOT_NULL(cache.lookup(FEES_URL));
+}
+
+// Test: Invalidate forgets a URL
+void test_invalidate() {
+    HttpResponseCache cache;
+    Price p = {1, 2};
+    cache.store(PRICE_URL, "\"v\"", "", &p, sizeof(p), 0);
+    cache.invalidate(PRICE_URL);
+
+    TEST_ASSERT_NULL(cache.lookup(PRICE_URL));
+    TEST_ASSERT_FALSE(cache.notModified(PRICE_URL, &p, sizeof(p), 0));
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_empty_cache);
+    RUN_TEST(test_store_validators);
+    RUN_TEST(test_not_modified_returns_value);
+    RUN_TEST(test_not_modified_size_mismatch);
+    RUN_TEST(test_hit_rate);
+    RUN_TEST(test_no_validators);
+    RUN_TEST(test_long_validator_dropped);
+    RUN_TEST(test_value_too_large);
+    RUN_TEST(test_lru_eviction);
+    RUN_TEST(test_invalidate);
+
+    return UNITY_END();
+}
@@ -0,0 +1,232 @@
+#include <unity.h>
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include <vector>
+#include <chrono>
+#include "utils/RollingChange.h"
+#include "utils/PriceCsv.h"
+
+static const uint32_t T0 = 1735689600;  // 2025-01-01 00:00:00 UTC
+
+struct Sample {
+    uint32_t time;
+    float value;
+};
+
+// Deterministic random walk, one sample per step seconds
+static std::vector<Sample> makeWalk(uint32_t start, uint32_t count, uint32_t step) {
+    std::vector<Sample> walk;
+    uint32_t rng = 7;
+    float p = 97000.0f;
+    for (uint32_t i = 0; i < count; i++) {
+        rng = rng * 1664525u + 1013904223u;
+        p *= 1.0f + ((float)(rng >> 8) / 16777216.0f - 0.5f) * 0.002f;
+        Sample s = {start + i * step, p};
+        walk.push_back(s);
+    }
+    return walk;
+}
+
+// Brute force: value of the first sample at or after t
+static float valueAtOrAfter(const std::vector<Sample>& walk, size_t end, uint32_t t) {
+    for (size_t i = 0; i < end; i++) {
+        if (walk[i].time >= t) return walk[i].value;
+    }
+    return 0;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+// ---------------------------------------------------------------------------
+// CSV replay helpers
+// ---------------------------------------------------------------------------
+
+// Test: Calendar to unix time matches known dates
+void test_unix_from_civil() {
+    TEST_ASSERT_EQUAL_UINT32(0, unixFromCivil(1970, 1, 1, 0, 0, 0));
+    TEST_ASSERT_EQUAL_UINT32(T0, unixFromCivil(2025, 1, 1, 0, 0, 0));
+    TEST_ASSERT_EQUAL_UINT32(1709208000, unixFromCivil(2024, 2, 29, 12, 0, 0));
+    TEST_ASSERT_EQUAL_UINT32(1767225599, unixFromCivil(2025, 12, 31, 23, 59, 59));
+}
+
+// Test: Logger rows parse; header and malformed rows are skipped
+void test_parse_price_row() {
+    uint32_t t = 0;
+    float usd = 0;
+
+    TEST_ASSERT_TRUE(parsePriceCsvLine("2025-01-01 12:00:30.123,97123.45,93000.10\r", t, usd));
+    TEST_ASSERT_EQUAL_UINT32(T0 + 12 * 3600 + 30, t);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 97123.45, usd);
+
+    TEST_ASSERT_TRUE(parsePriceCsvLine("2025-01-01 00:00:05,96000.00,92000.00", t, usd));
+    TEST_ASSERT_EQUAL_UINT32(T0 + 5, t);
+
+    TEST_ASSERT_FALSE(parsePriceCsvLine("timestamp,price_usd,price_eur", t, usd));
+    TEST_ASSERT_FALSE(parsePriceCsvLine("", t, usd));
+    TEST_ASSERT_FALSE(parsePriceCsvLine("2025-01-01 00:00:05.000,0.00,0.00", t, usd));
+    TEST_ASSERT_FALSE(parsePriceCsvLine("1970-01-01 00:00:05.000,97000.00,0.00", t, usd));  // Clock not synced
+}
+
+// ---------------------------------------------------------------------------
+// Rolling change
+// ---------------------------------------------------------------------------
+
+// Test: No change is reported until the history covers the window
+void test_needs_full_window() {
+    PriceChanges changes;
+    changes.add(T0, 100000.0f);
+    changes.add(T0 + 3599, 101000.0f);
+    TEST_ASSERT_FALSE(changes.get(CHANGE_1H).valid);
+
+    changes.add(T0 + 3600, 102000.0f);
+    PriceChange hour = changes.get(CHANGE_1H);
+    TEST_ASSERT_TRUE(hour.valid);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 2000.0, hour.delta);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 2.0, hour.pct);
+    TEST_ASSERT_FALSE(changes.get(CHANGE_24H).valid);
+    TEST_ASSERT_FALSE(changes.get(CHANGE_7D).valid);
+}
+
+// Test: 24h change matches a brute-force search to within one slot
+void test_matches_reference() {
+    std::vector<Sample> walk = makeWalk(T0 + 17, 4 * 2880, 30);  // 4 days at 30s
+    PriceChanges changes;
+    int checked = 0;
+
+    for (size_t i = 0; i < walk.size(); i++) {
+        changes.add(walk[i].time, walk[i].value);
+        if (walk[i].time - walk[0].time < 86400) continue;
+
+        uint32_t target = walk[i].time - 86400;
+        uint32_t slotStart = target - target % 300;
+        float ref = valueAtOrAfter(walk, i + 1, slotStart);
+        PriceChange c = changes.get(CHANGE_24H);
+
+        TEST_ASSERT_TRUE(c.valid);
+        TEST_ASSERT_FLOAT_WITHIN(0.02, walk[i].value - ref, c.delta);
+        checked++;
+    }
+    TEST_ASSERT_TRUE(checked > 8000);
+}
+
+// Test: Polling gaps are bridged, long outages are not
+void test_gaps() {
+    PriceChanges changes;
+
+    // Stable price backs polling off to every 2 minutes: 1h change still available
+    for (uint32_t t = 0; t <= 7200; t += 120) changes.add(T0 + t, 90000.0f + t);
+    TEST_ASSERT_TRUE(changes.get(CHANGE_1H).valid);
+    TEST_ASSERT_FLOAT_WITHIN(0.5, 3600.0, changes.get(CHANGE_1H).delta);
+
+    // 25 hours of data, then the device is off for 4 hours
+    PriceChanges outage;
+    uint32_t t = T0;
+    for (; t <= T0 + 25 * 3600; t += 60) outage.add(t, 97000.0f);
+    t = T0 + 29 * 3600;
+    for (; t <= T0 + 49 * 3600 + 1800; t += 60) outage.add(t, 98000.0f);
+
+    // 24h ago falls in the outage and the next data is 3.5h later: not used
+    TEST_ASSERT_FALSE(outage.get(CHANGE_24H).valid);
+    TEST_ASSERT_TRUE(outage.get(CHANGE_1H).valid);
+
+    // Within 10% of the window (2.4h) the first sample after the outage is the reference
+    for (; t <= T0 + 51 * 3600; t += 60) outage.add(t, 99000.0f);
+    TEST_ASSERT_TRUE(outage.get(CHANGE_24H).valid);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 1000.0, outage.get(CHANGE_24H).delta);
+}
+
+// Test: Out-of-order and zero samples are rejected
+void test_rejects_bad_samples() {
+    PriceChanges changes;
+    TEST_ASSERT_TRUE(changes.add(T0 + 100, 97000.0f));
+    TEST_ASSERT_FALSE(changes.add(T0 + 99, 96000.0f));
+    TEST_ASSERT_FALSE(changes.add(T0 + 200, 0.0f));
+    TEST_ASSERT_EQUAL_UINT32(1, changes.getSamples());
+}
+
+// Test: A week of replayed CSV rows gives all three changes on the first live price
+void test_csv_bootstrap() {
+    std::vector<Sample> walk = makeWalk(T0, 7 * 2880 + 60, 30);
+    PriceChanges changes;
+    int replayed = 0;
+
+    for (size_t i = 0; i + 1 < walk.size(); i++) {
+        // Row as SDLogger::logPrice writes it (UTC clock)
+        time_t tt = walk[i].time;
+        struct tm tm;
+        gmtime_r(&tt, &tm);
+        char row[96];
+        snprintf(row, sizeof(row), "%04d-%02d-%02d %02d:%02d:%02d.%03d,%.2f,%.2f\r",
+                 tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec,
+                 (int)(i % 1000), walk[i].value, walk[i].value * 0.95f);
+
+        uint32_t t;
+        float usd;
+        TEST_ASSERT_TRUE(parsePriceCsvLine(row, t, usd));
+        TEST_ASSERT_EQUAL_UINT32(walk[i].time, t);
+        changes.add(t, usd);
+        replayed++;
+    }
+
+    const Sample& live = walk.back();
+    changes.add(live.time, live.value);
+
+    for (int w = 0; w < CHANGE_WINDOW_COUNT; w++) {
+        TEST_ASSERT_TRUE(changes.get((ChangeWindow)w).valid);
+    }
+    float dayRef = valueAtOrAfter(walk, walk.size(), (live.time - 86400) - (live.time - 86400) % 300);
+    TEST_ASSERT_FLOAT_WITHIN(0.1, live.value - dayRef, changes.get(CHANGE_24H).delta);
+    TEST_ASSERT_EQUAL(7 * 2880 + 59, replayed);
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------
+
+// Test: Per-sample update vs scanning a 24h sample buffer
+void test_benchmark() {
+    std::vector<Sample> walk = makeWalk(T0, 3 * 2880, 30);
+
+    volatile float sink = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    PriceChanges changes;
+    for (size_t i = 0; i < walk.size(); i++) {
+        changes.add(walk[i].time, walk[i].value);
+        for (int w = 0; w < CHANGE_WINDOW_COUNT; w++) sink += changes.get((ChangeWindow)w).delta;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    // The alternative: keep 24h of samples and search for the reference each time
+    for (size_t i = 2880; i < walk.size(); i++) {
+        sink += walk[i].value - valueAtOrAfter(walk, i + 1, walk[i].time - 86400);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double rollingNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / walk.size();
+    double scanNs = std::chrono::duration<double, std::nano>(t2 - t1).count() / (walk.size() - 2880);
+
+    printf("\nPriceChanges: %zu bytes, %.0f ns per sample (add + 3 windows) vs %.0f ns scanning for the 24h reference\n",
+           sizeof(PriceChanges), rollingNs, scanNs);
+
+    TEST_ASSERT_TRUE(sizeof(PriceChanges) < 5000);
+    TEST_ASSERT_TRUE(rollingNs < scanNs);
+    (void)sink;
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_unix_from_civil);
+    RUN_TEST(test_parse_price_row);
+    RUN_TEST(test_needs_full_window);
+    RUN_TEST(test_matches_reference);
+    RUN_TEST(test_gaps);
+    RUN_TEST(test_rejects_bad_samples);
+    RUN_TEST(test_csv_bootstrap);
+    RUN_TEST(test_benchmark);
+
+    return UNITY_END();
+}
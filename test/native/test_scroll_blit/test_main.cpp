@@ -0,0 +1,197 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <chrono>
+#include "screens/ScrollBlit.h"
+#include "screens/CardModel.h"
+
+// MainScreen content area and layout: 2 columns of 228x80 cards in 88px rows
+static const int W = 480;
+static const int H = 291;
+static const int CONTENT_Y = 29;
+static const int CARDS = 10;
+
+static std::vector<uint16_t> frame(int fill = 0) {
+    return std::vector<uint16_t>((size_t)W * H, (uint16_t)fill);
+}
+
+// Screen y of a card at this scroll offset
+static int cardY(int index, int scrollY) {
+    return 35 - scrollY + (index / 2) * 88;
+}
+
+// Stand-in for drawing the cards: each card's pixels encode its index and row,
+// so a pixel in the wrong place shows up in a compare. Only rows [from, to) are drawn.
+static void render(std::vector<uint16_t>& buf, int scrollY, int from, int to) {
+    for (int row = from; row < to; row++) {
+        memset(&buf[(size_t)row * W], 0, W * sizeof(uint16_t));
+        for (int i = 0; i < CARDS; i++) {
+            int top = cardY(i, scrollY) - CONTENT_Y;
+            if (row < top || row >= top + 80) continue;
+            int x = i % 2 == 0 ? 8 : 244;
+            for (int c = x; c < x + 228; c++) {
+                buf[(size_t)row * W + c] = (uint16_t)(0x1000 * (i + 1) + (row - top) * 16 + (c - x) % 16);
+            }
+        }
+    }
+}
+
+static CardView view(int index, int scrollY, const char* value) {
+    CardView v;
+    cardViewSet(v, index % 2 == 0 ? 8 : 244, cardY(index, scrollY), 228, 80, "Title", value, 0xF7931A, false);
+    return v;
+}
+
+void setUp(void) {
+}
+
+void tearDown(void) {
+}
+
+// ========== Blit ==========
+
+// Test: Scrolling down moves rows up and exposes a strip at the bottom
+void test_blit_down(void) {
+    std::vector<uint16_t> src = frame(), dst = frame(0xFFFF);
+    for (int row = 0; row < H; row++) src[(size_t)row * W] = (uint16_t)row;
+
+    ScrollStrip strip = scrollBlit(dst.data(), src.data(), W, H, 10);
+    TEST_ASSERT_EQUAL(H - 10, strip.y);
+    TEST_ASSERT_EQUAL(10, strip.h);
+    for (int row = 0; row < H - 10; row++) {
+        TEST_ASSERT_EQUAL_UINT16(row + 10, dst[(size_t)row * W]);
+    }
+    TEST_ASSERT_EQUAL_UINT16(0xFFFF, dst[(size_t)(H - 10) * W]);  // Strip left for the caller
+}
+
+// Test: Scrolling up moves rows down and exposes a strip at the top
+void test_blit_up(void) {
+    std::vector<uint16_t> src = frame(), dst = frame(0xFFFF);
+    for (int row = 0; row < H; row++) src[(size_t)row * W + W - 1] = (uint16_t)row;
+
+    ScrollStrip strip = scrollBlit(dst.data(), src.data(), W, H, -7);
+    TEST_ASSERT_EQUAL(0, strip.y);
+    TEST_ASSERT_EQUAL(7, strip.h);
+    for (int row = 7; row < H; row++) {
+        TEST_ASSERT_EQUAL_UINT16(row - 7, dst[(size_t)row * W + W - 1]);
+    }
+    TEST_ASSERT_EQUAL_UINT16(0xFFFF, dst[(size_t)6 * W + W - 1]);
+}
+
+// Test: No movement copies everything; a jump of a whole frame copies nothing
+void test_blit_limits(void) {
+    std::vector<uint16_t> src = frame(0x1234), dst = frame();
+
+    ScrollStrip strip = scrollBlit(dst.data(), src.data(), W, H, 0);
+    TEST_ASSERT_EQUAL(0, strip.h);
+    TEST_ASSERT_TRUE(src == dst);
+
+    dst = frame();
+    strip = scrollBlit(dst.data(), src.data(), W, H, H);
+    TEST_ASSERT_EQUAL(0, strip.y);
+    TEST_ASSERT_EQUAL(H, strip.h);
+    TEST_ASSERT_EQUAL_UINT16(0, dst[0]);
+
+    strip = scrollBlit(dst.data(), src.data(), W, H, -H - 50);
+    TEST_ASSERT_EQUAL(H, strip.h);
+}
+
+// Test: Blit plus strip matches a full render, in place and across a drag both ways
+void test_blit_matches_full_render(void) {
+    std::vector<uint16_t> shown = frame(), expected = frame();
+    int scrollY = 0;
+    render(shown, scrollY, 0, H);
+
+    static const int STEPS[] = { 6, 6, 13, 1, 40, -3, -25, 90, -150, 200, -12 };
+    for (size_t s = 0; s < sizeof(STEPS) / sizeof(STEPS[0]); s++) {
+        int next = scrollY + STEPS[s];
+        ScrollStrip strip = scrollBlit(shown.data(), shown.data(), W, H, next - scrollY);
+        render(shown, next, strip.y, strip.y + strip.h);
+        scrollY = next;
+
+        render(expected, scrollY, 0, H);
+        TEST_ASSERT_TRUE(shown == expected);
+    }
+}
+
+// ========== Card Model ==========
+
+// Test: A blitted model keeps unchanged cards and sees only content changes
+void test_model_scroll_from(void) {
+    CardModel front, back;
+    front.beginFrame(0);
+    for (int i = 0; i < 4; i++) front.update(i, view(i, 0, "1"));
+
+    back.scrollFrom(front, 20);
+    int scrollY = -1;
+    TEST_ASSERT_TRUE(back.lastScroll(scrollY));
+    TEST_ASSERT_EQUAL(20, scrollY);
+    TEST_ASSERT_FALSE(back.beginFrame(20));  // Not a full frame
+
+    TEST_ASSERT_FALSE(back.update(0, view(0, 20, "1")));
+    TEST_ASSERT_FALSE(back.update(3, view(3, 20, "1")));
+    TEST_ASSERT_TRUE(back.update(1, view(1, 20, "2")));
+
+    // Cards the front frame never drew stay invalid
+    TEST_ASSERT_FALSE(back.isValid(8));
+
+    // A model with no frame yet cannot be blitted from
+    CardModel empty, target;
+    target.scrollFrom(empty, 10);
+    TEST_ASSERT_FALSE(target.lastScroll(scrollY));
+    TEST_ASSERT_TRUE(target.beginFrame(10));
+}
+
+// ========== Benchmark ==========
+
+// Test: A 6px scroll step, blit plus strip vs rendering the whole frame
+void test_scroll_benchmark(void) {
+    std::vector<uint16_t> a = frame(), b = frame();
+    const int frames = 400;
+    const int step = 6;
+    volatile uint32_t sink = 0;
+
+    int scrollY = 0;
+    render(a, scrollY, 0, H);
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < frames; i++) {
+        int dy = (i / 50) % 2 == 0 ? step : -step;
+        std::vector<uint16_t>& dst = i % 2 == 0 ? b : a;
+        std::vector<uint16_t>& src = i % 2 == 0 ? a : b;
+        ScrollStrip strip = scrollBlit(dst.data(), src.data(), W, H, dy);
+        scrollY += dy;
+        render(dst, scrollY, strip.y, strip.y + strip.h);
+        sink += dst[0];
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    scrollY = 0;
+    for (int i = 0; i < frames; i++) {
+        scrollY += (i / 50) % 2 == 0 ? step : -step;
+        render(a, scrollY, 0, H);
+        sink += a[0];
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double blitUs = std::chrono::duration<double, std::micro>(t1 - t0).count() / frames;
+    double fullUs = std::chrono::duration<double, std::micro>(t2 - t1).count() / frames;
+    printf("Scroll frame (host): blit + %d-row strip %.1f us, full render %.1f us (%.1fx)\n",
+           step, blitUs, fullUs, fullUs / blitUs);
+
+    TEST_ASSERT_TRUE(blitUs < fullUs);
+    (void)sink;
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_blit_down);
+    RUN_TEST(test_blit_up);
+    RUN_TEST(test_blit_limits);
+    RUN_TEST(test_blit_matches_full_render);
+    RUN_TEST(test_model_scroll_from);
+    RUN_TEST(test_scroll_benchmark);
+
+    return UNITY_END();
+}
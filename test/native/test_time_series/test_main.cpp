@@ -0,0 +1,242 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+#include "utils/TimeSeries.h"
+
+static const uint32_t T0 = 1735689600;  // 2025-01-01 00:00:00 UTC (day, hour and minute aligned)
+
+static const TimeSeriesCapacity SMALL = { 16, { 8, 4, 2 } };
+static uint8_t smallStorage[4096];
+
+static TieredSeries series;
+
+void setUp(void) {
+    TEST_ASSERT_TRUE(TieredSeries::bytesFor(SMALL) <= sizeof(smallStorage));
+    series.attach(smallStorage, SMALL);
+}
+
+void tearDown(void) {}
+
+// ---------------------------------------------------------------------------
+// Ring
+// ---------------------------------------------------------------------------
+
+// Test: Ring keeps the newest items in order once it wraps
+void test_ring_wraps() {
+    TimeSeriesSample storage[4];
+    TimeSeriesRing<TimeSeriesSample> ring;
+    ring.attach(storage, 4);
+
+    for (uint32_t i = 0; i < 6; i++) {
+        TimeSeriesSample s = {T0 + i, (float)i};
+        ring.push(s);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(4, ring.size());
+    TEST_ASSERT_EQUAL_UINT32(T0 + 2, ring.at(0).time);
+    TEST_ASSERT_EQUAL_UINT32(T0 + 5, ring.newest().time);
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, ring.newest().value);
+}
+
+// Test: Binary search finds the first item at or after a time across the wrap point
+void test_ring_lower_bound() {
+    TimeSeriesSample storage[5];
+    TimeSeriesRing<TimeSeriesSample> ring;
+    ring.attach(storage, 5);
+
+    for (uint32_t i = 0; i < 8; i++) {
+        TimeSeriesSample s = {T0 + i * 10, (float)i};
+        ring.push(s);  // Holds T0+30 .. T0+70
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, ring.lowerBound(T0));
+    TEST_ASSERT_EQUAL_UINT32(0, ring.lowerBound(T0 + 30));
+    TEST_ASSERT_EQUAL_UINT32(1, ring.lowerBound(T0 + 31));
+    TEST_ASSERT_EQUAL_UINT32(4, ring.lowerBound(T0 + 70));
+    TEST_ASSERT_EQUAL_UINT32(5, ring.lowerBound(T0 + 71));
+
+    TimeSeriesSample out[5];
+    TEST_ASSERT_EQUAL_UINT32(3, ring.copyRange(T0 + 35, T0 + 60, out, 5));
+    TEST_ASSERT_EQUAL_UINT32(T0 + 40, out[0].time);
+    TEST_ASSERT_EQUAL_UINT32(T0 + 60, out[2].time);
+    TEST_ASSERT_EQUAL_UINT32(2, ring.copyRange(T0, T0 + 100, out, 2));  // Capped at max
+    TEST_ASSERT_EQUAL_UINT32(T0 + 30, out[0].time);
+}
+
+// ---------------------------------------------------------------------------
+// Tiers
+// ---------------------------------------------------------------------------
+
+// Test: Minute buckets hold min, max and average of their samples
+void test_minute_aggregates() {
+    series.append(T0 + 0, 100.0f);
+    series.append(T0 + 20, 130.0f);
+    series.append(T0 + 40, 70.0f);
+    series.append(T0 + 60, 200.0f);  // Closes the first minute
+
+    TimeSeriesBucket out[4];
+    TEST_ASSERT_EQUAL_UINT32(1, series.getTier(TS_TIER_MINUTE).size());
+    uint32_t n = series.queryTier(TS_TIER_MINUTE, T0, T0 + 3600, out, 4);
+    TEST_ASSERT_EQUAL_UINT32(2, n);  // Closed bucket plus the open one
+
+    TEST_ASSERT_EQUAL_UINT32(T0, out[0].start);
+    TEST_ASSERT_EQUAL_FLOAT(70.0f, out[0].min);
+    TEST_ASSERT_EQUAL_FLOAT(130.0f, out[0].max);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 100.0, out[0].avg);
+    TEST_ASSERT_EQUAL_UINT32(3, out[0].count);
+
+    TEST_ASSERT_EQUAL_UINT32(T0 + 60, out[1].start);
+    TEST_ASSERT_EQUAL_UINT32(1, out[1].count);
+}
+
+// Test: Hour and day tiers aggregate the same samples at their own width
+void test_hour_and_day_tiers() {
+    // One sample every 30 minutes for 2 days: 1, 2, 3, ...
+    for (uint32_t i = 0; i < 96; i++) {
+        series.append(T0 + i * 1800, (float)(i + 1));
+    }
+
+    TimeSeriesBucket out[8];
+    uint32_t n = series.queryTier(TS_TIER_DAY, T0, T0 + 10 * TS_DAY_SECONDS, out, 8);
+    TEST_ASSERT_EQUAL_UINT32(2, n);
+    TEST_ASSERT_EQUAL_UINT32(T0, out[0].start);
+    TEST_ASSERT_EQUAL_UINT32(48, out[0].count);
+    TEST_ASSERT_EQUAL_FLOAT(1.0f, out[0].min);
+    TEST_ASSERT_EQUAL_FLOAT(48.0f, out[0].max);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 24.5, out[0].avg);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 72.5, out[1].avg);
+
+    // The hour ring holds 4 closed buckets, the last 4 closed hours
+    n = series.queryTier(TS_TIER_HOUR, T0, T0 + 10 * TS_DAY_SECONDS, out, 8);
+    TEST_ASSERT_EQUAL_UINT32(5, n);
+    TEST_ASSERT_EQUAL_UINT32(T0 + 43 * TS_HOUR_SECONDS, out[0].start);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 87.5, out[0].avg);  // Samples 87 and 88
+    TEST_ASSERT_EQUAL_UINT32(T0 + 47 * TS_HOUR_SECONDS, out[4].start);
+    TEST_ASSERT_EQUAL_UINT32(T0 + 43 * TS_HOUR_SECONDS, series.oldest(TS_TIER_HOUR));
+}
+
+// Test: Raw range queries are inclusive and the raw ring keeps the newest samples
+void test_raw_query() {
+    for (uint32_t i = 0; i < 40; i++) {
+        series.append(T0 + i * 30, (float)i);
+    }
+
+    TimeSeriesSample out[16];
+    TEST_ASSERT_EQUAL_UINT32(T0 + 24 * 30, series.oldestRaw());
+    TEST_ASSERT_EQUAL_UINT32(3, series.query(T0 + 30 * 30, T0 + 32 * 30, out, 16));
+    TEST_ASSERT_EQUAL_FLOAT(30.0f, out[0].value);
+    TEST_ASSERT_EQUAL_FLOAT(32.0f, out[2].value);
+    TEST_ASSERT_EQUAL_UINT32(0, series.query(T0, T0 + 23 * 30, out, 16));  // Evicted
+
+    TimeSeriesSample last;
+    TEST_ASSERT_TRUE(series.latest(last));
+    TEST_ASSERT_EQUAL_FLOAT(39.0f, last.value);
+}
+
+// Test: Samples older than the newest are dropped, equal timestamps are kept
+void test_out_of_order() {
+    TEST_ASSERT_TRUE(series.append(T0 + 100, 1.0f));
+    TEST_ASSERT_TRUE(series.append(T0 + 100, 2.0f));
+    TEST_ASSERT_FALSE(series.append(T0 + 99, 3.0f));
+
+    TimeSeriesBucket out[2];
+    TEST_ASSERT_EQUAL_UINT32(1, series.queryTier(TS_TIER_MINUTE, T0, T0 + 200, out, 2));
+    TEST_ASSERT_EQUAL_UINT32(2, out[0].count);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f, out[0].max);
+}
+
+// Test: An empty or unattached series answers nothing
+void test_empty() {
+    TieredSeries none;
+    TimeSeriesSample s;
+    TimeSeriesBucket b;
+    TEST_ASSERT_FALSE(none.latest(s));
+    TEST_ASSERT_EQUAL_UINT32(0, none.query(0, 0xFFFFFFFF, &s, 1));
+    TEST_ASSERT_EQUAL_UINT32(0, none.queryTier(TS_TIER_DAY, 0, 0xFFFFFFFF, &b, 1));
+    TEST_ASSERT_EQUAL_UINT32(0, series.oldest(TS_TIER_MINUTE));
+
+    // Device sizing: raw 4096, 2 days of minutes, 90 days of hours, 3 years of days
+    TimeSeriesCapacity device = { 4096, { 2880, 2160, 1100 } };
+    TEST_ASSERT_EQUAL_size_t(155568, TieredSeries::bytesFor(device));
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark
+// ---------------------------------------------------------------------------
+
+// Test: Append cost and range query cost vs scanning the ring
+void test_benchmark() {
+    const TimeSeriesCapacity DEVICE = { 4096, { 2880, 2160, 1100 } };
+    uint8_t* storage = (uint8_t*)malloc(TieredSeries::bytesFor(DEVICE));
+    TieredSeries big;
+    big.attach(storage, DEVICE);
+
+    // 30 days of 30s samples (raw ring wraps many times)
+    const uint32_t SAMPLES = 30 * 2880;
+    float p = 97000.0f;
+    auto t0 = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < SAMPLES; i++) {
+        p += (float)((int)(i * 2654435761u >> 22) - 512) * 0.1f;
+        big.append(T0 + i * 30, p);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    // One-hour windows of raw data: binary search vs linear scan
+    const int QUERIES = 20000;
+    TimeSeriesSample out[128];
+    uint32_t newest = T0 + (SAMPLES - 1) * 30;
+    volatile uint32_t sink = 0;
+    auto t2 = std::chrono::steady_clock::now();
+    for (int q = 0; q < QUERIES; q++) {
+        uint32_t from = newest - 30 * 3600 + (q % 29) * 3600;
+        sink += big.query(from, from + 3600, out, 128);
+    }
+    auto t3 = std::chrono::steady_clock::now();
+    const TimeSeriesRing<TimeSeriesSample>& raw = big.getRaw();
+    for (int q = 0; q < QUERIES; q++) {
+        uint32_t from = newest - 30 * 3600 + (q % 29) * 3600;
+        uint32_t n = 0;
+        for (uint32_t i = 0; i < raw.size(); i++) {
+            uint32_t t = raw.at(i).time;
+            if (t >= from && t <= from + 3600 && n < 128) out[n++] = raw.at(i);
+        }
+        sink += n;
+    }
+    auto t4 = std::chrono::steady_clock::now();
+
+    double appendNs = std::chrono::duration<double, std::nano>(t1 - t0).count() / SAMPLES;
+    double searchUs = std::chrono::duration<double, std::micro>(t3 - t2).count() / QUERIES;
+    double scanUs = std::chrono::duration<double, std::micro>(t4 - t3).count() / QUERIES;
+
+    printf("\nTieredSeries: %zu bytes per series, %u samples appended\n",
+           TieredSeries::bytesFor(DEVICE), SAMPLES);
+    printf("  append          %.0f ns/sample\n", appendNs);
+    printf("  1h raw query    %.2f us (binary search) vs %.2f us (scan of %u samples)\n",
+           searchUs, scanUs, raw.size());
+
+    TimeSeriesBucket days[40];
+    TEST_ASSERT_EQUAL_UINT32(30, big.queryTier(TS_TIER_DAY, 0, 0xFFFFFFFF, days, 40));
+    TEST_ASSERT_EQUAL_UINT32(2880, days[0].count);
+    TEST_ASSERT_EQUAL_UINT32(DEVICE.tiers[TS_TIER_MINUTE], big.getTier(TS_TIER_MINUTE).size());
+    TEST_ASSERT_TRUE(searchUs < scanUs);
+
+    free(storage);
+    (void)sink;
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_ring_wraps);
+    RUN_TEST(test_ring_lower_bound);
+    RUN_TEST(test_minute_aggregates);
+    RUN_TEST(test_hour_and_day_tiers);
+    RUN_TEST(test_raw_query);
+    RUN_TEST(test_out_of_order);
+    RUN_TEST(test_empty);
+    RUN_TEST(test_benchmark);
+
+    return UNITY_END();
+}
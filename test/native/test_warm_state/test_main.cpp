@@ -0,0 +1,248 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include "api/WarmState.h"
+
+static const uint32_t T0 = 1735689600;  // 2025-01-01 00:00:00 UTC
+
+// Stand-in for BTCData (which pulls in Arduino.h): the blob treats it as bytes
+struct Snapshot {
+    float priceUSD;
+    unsigned long blockHeight;
+    char blockHash[65];
+    int feeFast;
+    uint32_t feeHistogram[8];
+    char dcaRecommendation[32];
+    float rsi;
+};
+
+static Snapshot makeSnapshot() {
+    Snapshot s;
+    memset(&s, 0, sizeof(s));
+    s.priceUSD = 97123.0f;
+    s.blockHeight = 875000;
+    strcpy(s.blockHash, "00000000000000000001a2b3c4d5e6f7");
+    s.feeFast = 12;
+    for (int i = 0; i < 8; i++) s.feeHistogram[i] = 1000u * (i + 1);
+    strcpy(s.dcaRecommendation, "BUY");
+    s.rsi = 55.5f;
+    return s;
+}
+
+static uint8_t blob[sizeof(WarmStateHeader) + sizeof(Snapshot)];
+
+void setUp(void) {
+    memset(blob, 0, sizeof(blob));
+}
+
+void tearDown(void) {
+}
+
+// ========== Round Trip ==========
+
+// Test: Snapshot, sources and per-job times survive encode/decode
+void test_round_trip(void) {
+    WarmState saved;
+    saved.update(FETCH_PRICE, T0 + 100);
+    saved.update(FETCH_BLOCK, T0 + 50);
+    Snapshot in = makeSnapshot();
+
+    size_t len = saved.encode(&in, sizeof(in), blob, sizeof(blob));
+    TEST_ASSERT_EQUAL(sizeof(blob), len);
+
+    WarmState loaded;
+    Snapshot out;
+    memset(&out, 0, sizeof(out));
+    TEST_ASSERT_TRUE(loaded.decode(blob, len, &out, sizeof(out)));
+    TEST_ASSERT_EQUAL_MEMORY(&in, &out, sizeof(in));
+
+    TEST_ASSERT_TRUE(loaded.has(FETCH_PRICE));
+    TEST_ASSERT_TRUE(loaded.has(FETCH_BLOCK));
+    TEST_ASSERT_FALSE(loaded.has(FETCH_MEMPOOL));
+    TEST_ASSERT_FALSE(loaded.has(FETCH_AI_SIGNALS));
+    TEST_ASSERT_EQUAL_UINT32(T0 + 100, loaded.updatedAt(FETCH_PRICE));
+    TEST_ASSERT_EQUAL_UINT32(T0 + 50, loaded.updatedAt(FETCH_BLOCK));
+
+    // A restored state is not dirty: nothing to save until a job reports
+    TEST_ASSERT_FALSE(loaded.saveDue(0));
+
+    // Too small a buffer
+    TEST_ASSERT_EQUAL(0, saved.encode(&in, sizeof(in), blob, sizeof(blob) - 1));
+}
+
+// ========== Rejected Blobs ==========
+
+// Test: Corrupt, foreign-layout and empty blobs leave the snapshot untouched
+void test_rejects_bad_blobs(void) {
+    WarmState saved;
+    saved.update(FETCH_PRICE, T0);
+    Snapshot in = makeSnapshot();
+    size_t len = saved.encode(&in, sizeof(in), blob, sizeof(blob));
+
+    Snapshot out;
+    memset(&out, 0, sizeof(out));
+    Snapshot untouched = out;
+    WarmState loaded;
+
+    // Flipped snapshot byte (CRC)
+    blob[sizeof(WarmStateHeader) + 3] ^= 0x40;
+    TEST_ASSERT_FALSE(loaded.decode(blob, len, &out, sizeof(out)));
+    blob[sizeof(WarmStateHeader) + 3] ^= 0x40;
+
+    // Truncated blob, or a snapshot of a different size (new firmware)
+    TEST_ASSERT_FALSE(loaded.decode(blob, len - 1, &out, sizeof(out)));
+    TEST_ASSERT_FALSE(loaded.decode(blob, len, &out, sizeof(out) - 4));
+
+    // Another version
+    WarmStateHeader h;
+    memcpy(&h, blob, sizeof(h));
+    h.version = WARM_STATE_VERSION + 1;
+    memcpy(blob, &h, sizeof(h));
+    TEST_ASSERT_FALSE(loaded.decode(blob, len, &out, sizeof(out)));
+
+    // Bad magic (erased flash)
+    memset(blob, 0xFF, sizeof(blob));
+    TEST_ASSERT_FALSE(loaded.decode(blob, len, &out, sizeof(out)));
+
+    // Valid blob with no job data
+    WarmState empty;
+    len = empty.encode(&in, sizeof(in), blob, sizeof(blob));
+    TEST_ASSERT_FALSE(loaded.decode(blob, len, &out, sizeof(out)));
+
+    TEST_ASSERT_EQUAL_MEMORY(&untouched, &out, sizeof(out));
+    TEST_ASSERT_EQUAL(0, loaded.sources());
+}
+
+// ========== Save Throttling ==========
+
+// Test: First result saves at once, then at most one save per WARM_STATE_SAVE_MS
+void test_save_throttling(void) {
+    WarmState state;
+    TEST_ASSERT_FALSE(state.saveDue(1000));  // Nothing reported yet
+
+    state.update(FETCH_PRICE, T0);
+    TEST_ASSERT_TRUE(state.saveDue(1000));
+    state.markSaved(1000);
+    TEST_ASSERT_FALSE(state.saveDue(1000));
+
+    // Price every 30s: dirty, but not due until the interval has passed
+    uint32_t saves = 0;
+    for (uint32_t ms = 31000; ms <= 1000 + 3600000; ms += 30000) {
+        state.update(FETCH_PRICE, T0 + ms / 1000);
+        if (state.saveDue(ms)) {
+            state.markSaved(ms);
+            saves++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(3600000 / WARM_STATE_SAVE_MS, saves);
+
+    // Not dirty: no save however long it has been
+    state.markSaved(5000000);
+    TEST_ASSERT_FALSE(state.saveDue(5000000 + 2 * WARM_STATE_SAVE_MS));
+
+    // millis() wrap
+    state.markSaved(0xFFFFF000u);
+    state.update(FETCH_BLOCK, T0);
+    TEST_ASSERT_FALSE(state.saveDue(0x1000u));
+    TEST_ASSERT_TRUE(state.saveDue(0xFFFFF000u + WARM_STATE_SAVE_MS));
+}
+
+// ========== Ages ==========
+
+// Test: Ages per job, oldest across a mask, unknown without a synced clock
+void test_ages(void) {
+    WarmState state;
+    uint32_t age = 99;
+
+    TEST_ASSERT_FALSE(state.age(FETCH_PRICE, T0, age));  // No data
+
+    state.update(FETCH_PRICE, T0 + 600);
+    state.update(FETCH_BLOCK, T0);
+    state.update(FETCH_AI_SIGNALS, 0);  // Fetched before the clock synced
+
+    TEST_ASSERT_TRUE(state.age(FETCH_PRICE, T0 + 720, age));
+    TEST_ASSERT_EQUAL_UINT32(120, age);
+    TEST_ASSERT_FALSE(state.age(FETCH_AI_SIGNALS, T0 + 720, age));
+    TEST_ASSERT_FALSE(state.age(FETCH_PRICE, 0, age));  // Clock not synced yet
+
+    // Clock behind the saved time: age 0, not a wrapped value
+    TEST_ASSERT_TRUE(state.age(FETCH_PRICE, T0 + 500, age));
+    TEST_ASSERT_EQUAL_UINT32(0, age);
+
+    // Oldest of the masked jobs with a known age
+    TEST_ASSERT_TRUE(state.oldestAge(0xFF, T0 + 720, age));
+    TEST_ASSERT_EQUAL_UINT32(720, age);
+    TEST_ASSERT_TRUE(state.oldestAge(1u << FETCH_PRICE, T0 + 720, age));
+    TEST_ASSERT_EQUAL_UINT32(120, age);
+    TEST_ASSERT_FALSE(state.oldestAge(1u << FETCH_AI_SIGNALS | 1u << FETCH_MEMPOOL, T0 + 720, age));
+}
+
+// Test: Header age text
+void test_format_age(void) {
+    char buf[8];
+    warmFormatAge(0, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("0s", buf);
+    warmFormatAge(59, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("59s", buf);
+    warmFormatAge(60, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("1m", buf);
+    warmFormatAge(3599, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("59m", buf);
+    warmFormatAge(3 * 3600 + 5, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("3h", buf);
+    warmFormatAge(2 * 86400, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("2d", buf);
+}
+
+// ========== Benchmark ==========
+
+// Test: Decode (the part on the boot path) takes microseconds, not a network round trip
+void test_benchmark(void) {
+    WarmState state;
+    state.update(FETCH_PRICE, T0);
+    state.update(FETCH_MEMPOOL, T0);
+    Snapshot in = makeSnapshot();
+
+    const int rounds = 20000;
+    volatile uint32_t sink = 0;
+    size_t len = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < rounds; i++) {
+        in.feeFast = i;
+        len = state.encode(&in, sizeof(in), blob, sizeof(blob));
+        sink += blob[len - 1];
+    }
+    auto t1 = std::chrono::steady_clock::now();
+
+    Snapshot out;
+    int restored = 0;
+    for (int i = 0; i < rounds; i++) {
+        WarmState loaded;
+        restored += loaded.decode(blob, len, &out, sizeof(out)) ? 1 : 0;
+        sink += out.feeFast;
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double encodeUs = std::chrono::duration<double, std::micro>(t1 - t0).count() / rounds;
+    double decodeUs = std::chrono::duration<double, std::micro>(t2 - t1).count() / rounds;
+    printf("Warm state blob: %zu bytes, encode %.2f us, decode %.2f us (host)\n", len, encodeUs, decodeUs);
+
+    TEST_ASSERT_EQUAL(rounds, restored);
+    TEST_ASSERT_EQUAL(rounds - 1, out.feeFast);
+    (void)sink;
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_round_trip);
+    RUN_TEST(test_rejects_bad_blobs);
+    RUN_TEST(test_save_throttling);
+    RUN_TEST(test_ages);
+    RUN_TEST(test_format_age);
+    RUN_TEST(test_benchmark);
+
+    return UNITY_END();
+}